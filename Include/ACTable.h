@@ -74,19 +74,37 @@ enum ACTColumnsTy {
 /// @brief Selected cached infos from the LTFlightData/LTAircraft classes
 /// @details The LTFlightData object can be removed at any time, so we cannot
 ///          keep pointers to them. And we don't want to build up all lists
-///          every frame for performance. So we chache what we need
+///          every frame for performance. So we chache what we need.\n
+///          Numeric values are only converted to text when needed,
+///          i.e. when the row is visible or a filter needs to be applied, see Format().
 class FDInfo {
 public:
     /// Key into the flight data map
     LTFlightData::FDKeyTy key;
-    /// The values (converted to string) to show for each column
+    /// The values (converted to string) to show for each column, numeric columns only after Format()
     std::array<std::string,ACT_COL_COUNT> v;
+    /// Interned values of columns with static aircraft data, the matching element in `v` stays empty
+    std::array<LTAtom,ACT_COL_COUNT> va;
     /// The original numeric value (if any) for faster comparison
     std::array<float,ACT_COL_COUNT> vf;
 protected:
     /// Did the last update succeed?
     bool bUpToDate = false;
+    /// Columns changed since ACTable last looked at this row
+    std::bitset<ACT_COL_COUNT> changed;
+    /// Numeric columns not yet converted to text
+    std::bitset<ACT_COL_COUNT> fmtDirty;
+    /// ACTable's update cycle in which this row was last found in the flight data map
+    unsigned gen = 0;
+    /// Does this row match ACTable's current filter?
+    bool bMatch = false;
+    /// Is this row currently listed in ACTable's sorted list?
+    bool bListed = false;
+    
+    friend class ACTable;
 public:
+    /// Default constructor creates an empty row
+    FDInfo ();
     /// Constructor copies relevant data from the fd object
     FDInfo (const LTFlightData& fd);
     
@@ -100,13 +118,41 @@ public:
     /// Did the last update succeed?
     bool upToDate () const { return bUpToDate; }
     
+    /// Convert those numeric values to text, which changed since last call
+    void Format ();
+    
+    /// Text to show for the given column, taken from `va` or `v`, call Format() before for numeric columns
+    const std::string& text (size_t col) const { return va[col].empty() ? v[col] : va[col].str(); }
+    
     /// @brief Return the related LTFlightData object
     /// @warning Can return `nullptr`!
     LTFlightData* GetFD () const;
     
     /// @brief Does any value match this filter string?
+    /// @details Call Format() before, so that numeric values are included
     /// @param _s Substring to be searched for, expected in upper case
     bool matches (const std::string& _s) const;
+
+protected:
+    /// Set a text value, remember if it changed
+    void SetV (size_t col, const std::string& s);
+    /// Set an interned text value, remember if it changed
+    void SetVa (size_t col, const LTAtom& a);
+    /// Set a numeric value, remember if it changed, conversion to text is deferred to Format()
+    void SetVf (size_t col, double val);
+    /// Clear a column's values
+    void ClearCol (size_t col);
+};
+
+/// Compares two rows by a given column in the given direction, empty values last
+struct FDInfoLessTy {
+    ACTColumnsTy    col;                    ///< column to compare
+    bool            bAsc;                   ///< ascending?
+    bool            bNum;                   ///< compare numeric values (or texts)?
+    /// Constructor determines how to compare the column
+    FDInfoLessTy (ACTColumnsTy _col, bool _asc);
+    /// Is `a` to be listed before `b`?
+    bool operator() (const FDInfo* a, const FDInfo* b) const;
 };
 
 //
@@ -119,8 +165,16 @@ public:
     bool        bFilterAcOnly = false;
     
 protected:
-    /// The data to be listed: info on aircraft
-    std::vector<FDInfo> vecFDI;
+    /// All rows, keyed by flight data, kept across updates
+    std::unordered_map<LTFlightData::FDKeyTy,FDInfo,FDKeyHashTy> mapFDI;
+    /// The rows to be listed, filtered and sorted, pointing into `mapFDI`
+    std::vector<FDInfo*> vecFDI;
+    /// Column the list is sorted by
+    ACTColumnsTy sortCol = ACT_COL_ID;
+    /// Sorted ascending?
+    bool        bSortAsc = true;
+    /// Counts update cycles, to find rows of removed flight data
+    unsigned    gen = 0;
     /// Time when list was updated last
     float lastUpdate = 0.0f;
     /// The filter applied to the above list
@@ -140,6 +194,9 @@ public:
     LTFlightData* build (const std::string& _filter, int _x = 0, int _y = 0);
     
     /// @brief Update the list of FDIs (periodically or if filter changed)
+    /// @details Updates the rows from the flight data, then re-sorts incrementally:
+    ///          Rows, whose sort value didn't change, keep their order, all others
+    ///          are sorted separately and then merged in.
     /// @return Did an update take place?
     bool UpdateFDIs (const std::string& _filter);
     
@@ -68,8 +68,28 @@ constexpr double TEMP_LAPS_R    = -0.0065f;     ///< K/m
 //MARK: Flight Data-related
 constexpr unsigned MAX_TRANSP_ICAO = 0xFFFFFF;  // max transponder ICAO code (24bit)
 constexpr int    MAX_NUM_AIRCRAFT   = 200;      ///< maximum number of aircraft allowed to be rendered
+constexpr size_t FD_MAP_SHARDS      = 16;       ///< number of lock-striped segments of the flight data map
+constexpr size_t FD_POS_INLINE      = 16;       ///< positions held inline (without allocation) per position queue, power of 2
+constexpr size_t FD_DYN_INLINE      = 16;       ///< dynamic data records held inline per flight data, power of 2
+constexpr size_t FD_POS_HANDOFF_CAP = 8192;     ///< capacity of the queue handing new positions from network threads to the main thread, power of 2
+constexpr size_t FD_POS_HANDOFF_PER_FRAME = 1000; ///< max new positions the main thread takes from the hand-off queue per flight loop call
 constexpr double FLIGHT_LOOP_INTVL  = -5.0;     // call ourselves every 5 frames
 constexpr double AC_MAINT_INTVL     = 2.0;      // seconds (calling a/c maintenance periodically)
+constexpr size_t AC_MAINT_FD_PER_CALL = 250;    ///< a/c maintenance maintains segments of the flight data map per flight loop call until at least this many flight data objects are done
+constexpr int    AC_MAINT_CREATE_PER_CALL = 3;  ///< max number of aircraft created per flight loop call, nearest first
+constexpr double AC_HYST_DIST_F     = 0.10;     ///< hysteresis: aircraft are removed only this share beyond the standard distance, and make room only for aircraft this share closer
+constexpr double AC_RECREATE_HOLD   = 20.0;     ///< [s] hysteresis: an aircraft removed at the range edge or to make room isn't re-created for this long
+constexpr size_t AC_POOL_MAX        = 32;       ///< max number of memory blocks of removed aircraft kept for re-use
+constexpr float  STRESS_LOG_INTVL   = 10.0f;    ///< [s] stress mode: interval of logging stage timings
+constexpr float  GOV_EVAL_INTVL     = 1.0f;     ///< [s] frame-time governor: interval of evaluating LiveTraffic's main thread time per frame
+constexpr int    GOV_MAX_LEVEL      = 6;        ///< frame-time governor: maximum level of reduction
+constexpr double GOV_REDUCE_F       = 0.75;     ///< frame-time governor: each level reduces max number of aircraft, level of detail distances, and positions processed per frame by this factor
+constexpr double GOV_RELAX_F        = 0.7;      ///< frame-time governor: relax only when below this share of the budget (hysteresis)
+constexpr int    GOV_HOLD_UP        = 2;        ///< frame-time governor: number of evaluations over budget before reducing a level
+constexpr int    GOV_HOLD_DOWN      = 5;        ///< frame-time governor: number of evaluations well below budget before relaxing a level
+constexpr int    GOV_MIN_NUM_AC     = 5;        ///< frame-time governor: never reduce max number of aircraft below this
+constexpr size_t GOV_MIN_POS_PER_FRAME = 100;   ///< frame-time governor: never reduce positions taken from the hand-off queue per flight loop call below this
+constexpr double GOV_LABEL_INTVL    = 2.0;      ///< [s] frame-time governor: per level, aircraft labels are updated at most this often
 constexpr double TIME_REQU_POS      = 0.5;      // seconds before reaching current 'to' position we request calculation of next position
 constexpr double SIMILAR_TS_INTVL = 3;          // seconds: Less than that difference and position-timestamps are considered "similar" -> positions are merged rather than added additionally
 constexpr double SIMILAR_POS_DIST = 7;          // [m] if distance between positions less than this then favor heading from flight data over vector between positions
@@ -78,13 +98,39 @@ constexpr double FD_GND_AGL =       10;         // [m] consider pos 'ON GRND' if
 constexpr double FD_GND_AGL_EXT =   20;         // [m] consider pos 'ON GRND' if this close to YProbe - extended, e.g. for RealTraffic
 constexpr double PROBE_HEIGHT_LIM[] = {5000,1000,500,-999999};  // if height AGL is more than ... feet
 constexpr double PROBE_DELAY[]      = {  10,   1,0.5,    0.2};  // delay next Y-probe ... seconds.
+constexpr double LOD_MID_CALC_INTVL = 0.25;     ///< [s] level of detail: full position calculation for aircraft between near and far distance, linear extrapolation in between
+constexpr double LOD_FAR_CALC_INTVL = 1.0;      ///< [s] level of detail: full position calculation for far or hidden aircraft, linear extrapolation in between
 constexpr double MAX_HOVER_AGL      = 2000;     // [ft] max hovering altitude for hover-along-the-runway detection
 constexpr double KEEP_ABOVE_MAX_ALT    = 18000.0 * M_per_FT;///< [m] Maximum altitude to which the "keep above 2.5° glidescope" algorithm is applied (highest airports are below 15,000ft + 3,000 for approach)
 constexpr double KEEP_ABOVE_MAX_AGL    =  3000.0 * M_per_FT;///< [m] Maximum height above ground to which the "keep above 2.5° glidescope" algorithm is applied (highest airports are below 15,000ft + 3,000 for approach)
 constexpr double KEEP_ABOVE_RATIO      = 0.043495397807572; ///< = tan(2.5°), slope ratio for keeping a plane above the approach to a runway
 constexpr double BEZIER_MIN_HEAD_DIFF = 2.5;    ///< [°] turns of less than this will not be modeled with Bezier curves
 constexpr float  EXPORT_USER_AC_PERIOD = 15.0f; ///< [s] how often to write user's aircraft data into the export file
+constexpr size_t SIM_WIND_MAX_LAYERS = 16;     ///< Maximum number of the region's wind layers considered for wind at altitude
+constexpr unsigned long EXPORT_DUE_AHEAD = 5;   ///< [s] export lines are written once sim time is this close to their timestamp
+constexpr int    FILE_WRITE_INTVL_MS = 500;     ///< [ms] how often the asynchronous file writer writes collected lines
 constexpr const char* EXPORT_USER_CALL = "USER";///< call sign used for user's plabe
+constexpr double FD_NEAR_AREA_F     = 1.0/3.0;  ///< [-] size of the near area (requested with every request) relative to the full search area, see DataRefs::GetFdFullAreaEvery()
+constexpr double FD_AREA_GRID_F     = 1.0/16.0; ///< [-] grid size, to which requested areas are snapped, relative to the full search area
+constexpr double FD_PREDICT_STEP    = 2.0;      ///< [s] dead-reckoning: time between predicted positions
+constexpr double FD_PREDICT_MAX     = 30.0;     ///< [s] dead-reckoning: predict at most this long beyond the latest live position
+constexpr double FD_KF_RESET_GAP    = 120.0;    ///< [s] dead-reckoning: restart the state estimator after a pause in live data this long
+constexpr double FD_KF_REBASE_DIST  = 50000.0;  ///< [m] dead-reckoning: move the state estimator's reference point when farther away than this
+constexpr double FD_KF_MAX_TURN     = 6.0;      ///< [°/s] dead-reckoning: max turn rate (twice a standard rate turn)
+constexpr double FD_KF_SD_POS       = 15.0;     ///< [m] dead-reckoning: standard deviation of live positions
+constexpr double FD_KF_SD_ALT       = 15.0;     ///< [m] dead-reckoning: standard deviation of live altitudes
+constexpr double FD_KF_SD_SPD       = 2.0;      ///< [m/s] dead-reckoning: standard deviation of live speeds
+constexpr double FD_KF_SD_TRACK     = 5.0;      ///< [°] dead-reckoning: standard deviation of live tracks (often a heading)
+constexpr double FD_KF_SD_TURN      = 0.5;      ///< [°/s] dead-reckoning: standard deviation of live turn rates
+constexpr double FD_KF_SD_VSI       = 2.5;      ///< [m/s] dead-reckoning: standard deviation of live vertical speeds
+constexpr double FD_KF_ACC          = 1.5;      ///< [m/s²] dead-reckoning: assumed unknown acceleration (process noise)
+constexpr double FD_KF_TURN_ACC     = 0.5;      ///< [°/s²] dead-reckoning: assumed unknown change of turn rate (process noise)
+constexpr double FD_KF_VACC         = 1.0;      ///< [m/s²] dead-reckoning: assumed unknown vertical acceleration (process noise)
+constexpr time_t MD_CACHE_TTL_MASTER = 30L*24*60*60;///< [s] how long cached a/c master data stays valid
+constexpr time_t MD_CACHE_TTL_ROUTE  =  2L*24*60*60;///< [s] how long cached route info stays valid
+constexpr time_t MD_CACHE_TTL_IGNORE =  7L*24*60*60;///< [s] how long a cached "not found" stays valid
+constexpr size_t MD_CACHE_COMPACT_F  = 2;       ///< compact the master data cache file when it has this many times more lines than valid entries
+constexpr size_t MD_CACHE_MAX_ENTRIES = 250000; ///< maximum number of master data cache records kept when reading, those expiring first are dropped
 
 //MARK: Flight Model
 constexpr double MDL_ALT_MIN =         -1500;   // [ft] minimum allowed altitude
@@ -130,6 +176,14 @@ constexpr double APT_MAX_SIMILAR_NODE_DIST_M = 2.0; ///< [m] Max distance for tw
 constexpr double APT_STARTUP_VIA_DIST = 50.0;   ///< [m] distance of StartupLoc::viaLoc from startup location
 constexpr double APT_STARTUP_MOVE_BACK = 10.0;  ///< [m] move back startup location so that it sits about in plane's center instead of at its head
 constexpr double APT_JOIN_MAX_DIST_M = 15.0;    ///< [m] Max distance for an open node to be joined with another edge
+constexpr double APT_GRID_CELL_M = 32.0;        ///< [m] Cell size of the temporary grid indexes used while building an airport's taxi network
+constexpr size_t APT_READ_MAX_THREADS = 4;      ///< Maximum number of threads reading `apt.dat` files in parallel
+constexpr double APT_TILE_DEG = 1.0;            ///< [°] Airports are read and evicted in tiles of this many degrees latitude and longitude
+constexpr double APT_PREFETCH_LOOKAHEAD_S = 1200.0; ///< [s] Airports are prefetched along the user's track as far as the user's plane gets in this time
+constexpr double APT_PREFETCH_MIN_SPEED = 50.0; ///< [m/s] Minimum speed of the user's plane for prefetching airports ahead
+constexpr double APT_PREFETCH_MAX_CAM_DIST = 20000.0;   ///< [m] No prefetching if the camera is farther away than this from the user's plane
+constexpr size_t APT_PREFETCH_TILES_PER_READ = 2;   ///< Maximum number of tiles ahead of the user's plane read at a time, spreads out the reading load
+constexpr size_t APT_MEM_BUDGET = 32 * 1024 * 1024; ///< [bytes] Airports in tiles no longer needed are evicted when all airports' estimated memory use exceeds this budget
 constexpr double APT_JOIN_ANGLE_TOLERANCE=15.0; ///< [°] tolerance of angle for an open node to be joined with another edge
 constexpr double APT_JOIN_ANGLE_TOLERANCE_EXT=45.0; ///< [°] extended (second prio) tolerance of angle for an open node to be joined with another edge
 constexpr double APT_MAX_PATH_TURN=100.0;       ///< [°] Maximum turn allowed during shortest path calculation
@@ -193,6 +247,11 @@ constexpr const char* REMOTE_SIGNATURE      =  "TwinFan.plugin.XPMP2.Remote";
 #define MSG_CSL_PACKAGE_LOADED  "Successfully loaded CSL package %s"
 #define MSG_MDL_FORCED          "Settings > Debug: Model matching forced to '%s'/'%s'/'%s'"
 #define MSG_MDL_NOT_FORCED      "Settings > Debug: Model matching no longer forced"
+#define MSG_STRESS_QUEUE        "Stress mode: %d aircraft, calc queue length %lu, %lu requests waited avg %.1f ms, max %.1f ms"
+#define MSG_STRESS_LABELS       "Stress mode: %lu labels rebuilt, %lu unchanged"
+#define MSG_GOV_LEVEL           "Frame-time governor: %.2f ms per frame (budget %d ms), now at level %d of %d: max %d aircraft, level of detail distances and position processing at %d%%"
+#define MSG_GOV_OFF             "Frame-time governor: switched off, all limits restored"
+#define MSG_STRESS_STAGE        "Stress mode: %-12s %8llu calls, avg %8.3f ms, max %8.3f ms, total %9.1f ms"
 #define WHITESPACE              " \t\f\v\r\n"
 #define CSL_DEFAULT_ICAO_TYPE   "A320"
 #define CSL_CAR_ICAO_TYPE       "ZZZC"      // fake code for a ground vehicle
@@ -216,6 +275,7 @@ constexpr const char* REMOTE_SIGNATURE      =  "TwinFan.plugin.XPMP2.Remote";
 #define CFG_RT_LICENSE          "RealTraffic_License"
 #define CFG_FSC_USER            "FSC_User"
 #define CFG_FSC_PWD             "FSC_Pwd"
+#define CFG_ADSBHUB_HOST        "ADSBHub_Host"
 
 //MARK: Menu Items
 #define MENU_INFO_LIST_WND      "Status / Information..."
@@ -288,8 +348,10 @@ constexpr const char* REMOTE_SIGNATURE      =  "TwinFan.plugin.XPMP2.Remote";
 // these are under X-Plane's root dir
 #define PATH_DEBUG_RAW_FD       "LTRawFD.log"
 #define PATH_DEBUG_EXPORT_FD    "Output/LTExportFD - %Y-%m-%d %H.%M.%S.csv"
+#define PATH_ROTATED_SUFFIX     ".old"          ///< suffix for a rotated file if the file name has no timestamp
 #define PATH_RES_PLUGINS        "Resources/plugins"
 #define PATH_CONFIG_FILE        "Output/preferences/LiveTraffic.prf"
+#define PATH_MASTER_DATA_CACHE  "Output/caches/LTMasterData.cache"
 // Standard path delimiter
 constexpr const char* PATH_DELIMS = "/\\";      ///< potential path delimiters in all OS
 #if IBM
@@ -300,6 +362,7 @@ constexpr const char* PATH_DELIMS = "/\\";      ///< potential path delimiters i
 
 //MARK: Error Texsts
 constexpr long HTTP_OK =            200;
+constexpr long HTTP_NOT_MODIFIED =  304;        ///< conditional request: data has not changed since last request
 constexpr long HTTP_BAD_REQUEST =   400;
 constexpr long HTTP_UNAUTHORIZED =  401;
 constexpr long HTTP_PAYMENT_REQU =  402;
@@ -317,6 +380,9 @@ constexpr long HTTP_FLAG_SENDING =   -1;        ///< used only internal to loggi
 constexpr long HTTP_FLAG_UDP =       -2;        ///< used only internal to logging: received UDP data
 constexpr int CH_MAC_ERR_CNT =      5;          // max number of tolerated errors, afterwards invalid channel
 constexpr int SERR_LEN = 100;                   // size of buffer for IO error texts (strerror_s)
+constexpr size_t LOG_RING_SIZE = 512;           ///< number of log messages a thread can buffer until next FlushMsg()
+constexpr size_t LOG_RATE_SLOTS = 256;          ///< number of slots for per-call-site log rate limiting
+constexpr unsigned LOG_RATE_MAX_PER_SEC = 20;   ///< max number of log messages per call site and second
 #define ERR_XPLANE_ONLY         "LiveTraffic works in X-Plane only, version 10 or higher"
 #define ERR_INIT_XPMP           "Could not initialize XPMP2: %s"
 #define ERR_LOAD_CSL            "Could not load CSL Package: %s"
@@ -358,6 +424,7 @@ constexpr int SERR_LEN = 100;                   // size of buffer for IO error t
 #define ERR_AC_CALC_PPOS        "Could not calculate position when creating aircraft %s"
 #define ERR_Y_PROBE             "Y Probe returned %d at %s"
 #define ERR_POS_UNNORMAL        "A/c %s reached invalid pos: %s"
+#define ERR_POS_HANDOFF_FULL    "Queue of new positions is full (%lu entries), dropping positions until the flight loop catches up"
 #define ERR_IGNORE_POS          "A/c %s: Ignoring data leading to sharp turn or invalid speed: %s"
 #define ERR_INV_TRANP_ICAO      "Ignoring data for invalid transponder code '%s'"
 #define ERR_TIME_NONLINEAR      "Time moved non-linear/jumped by %.1f seconds, will re-init aircraft."
@@ -399,6 +466,7 @@ constexpr int SERR_LEN = 100;                   // size of buffer for IO error t
 #define ERR_SOCK_SEND_FAILED    "%s: Could not send position: send operation failed"
 #define ERR_UDP_SOCKET_CREAT    "%s: Error creating UDP socket for %s: %s"
 #define ERR_UDP_RCVR_RCVR       "%s: Error receiving UDP: %s"
+#define ERR_MD_CACHE_OPEN       "Could not open master data cache %s: %s"
 constexpr int ERR_CFG_FILE_MAXWARN = 10;     // maximum number of warnings while reading config file, then: dead
 
 //MARK: Debug Texts
@@ -410,11 +478,15 @@ constexpr int ERR_CFG_FILE_MAXWARN = 10;     // maximum number of warnings while
 #define DBG_MAP_DUP_INSERT      "Duplicate insert into LTAircraftMap with key %s"
 #define DBG_SENDING_HTTP        "%s: Sending HTTP: %s"
 #define DBG_RECEIVED_BYTES      "%s: Received %ld characters"
+#define DBG_NOT_MODIFIED        "%s: Data not modified since last request for %s"
 #define DBG_RAW_FD_START        "DEBUG Starting to log raw flight data to %s"
 #define DBG_RAW_FD_STOP         "DEBUG Stopped logging raw flight data to %s"
 #define DBG_EXPORT_FD_START     "Starting to export tracking data to %s"
 #define DBG_EXPORT_FD_STOP      "Stopped exporting tracking data to %s"
 #define DBG_RAW_FD_ERR_OPEN_OUT "DEBUG Could not open output file %s: %s"
+#define DBG_FILE_ROTATED        "Rotated file %s after %lu bytes"
+#define DBG_MD_CACHE_LOADED     "Master data cache: %lu valid entries read from %lu lines of %s"
+#define DBG_MD_CACHE_COMPACTED  "Master data cache: compacted %s to %lu entries"
 #define DBG_FILTER_AC           "DEBUG Filtering for a/c '%s'"
 #define DBG_FILTER_AC_REMOVED   "DEBUG Filtering for a/c REMOVED"
 #define DBG_POS_DATA            "DEBUG POS DATA: %s"
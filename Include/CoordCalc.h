@@ -24,7 +24,7 @@
 #define CoordCalc_h
 
 #include "XPLMScenery.h"
-#include <deque>
+#include "LTRingBuf.h"
 
 // positions and angles are in degrees
 // distances and altitude are in meters
@@ -346,20 +346,21 @@ public:
         angleUnitE   unitAngle   : 1;   ///< heading in degree or radians?
         specialPosE  specialPos  : 2;   ///< position is somehow special`
         bool         bCutCorner  : 1;   ///< is this an (inserted) position, that can be cut short? (-> use quadratic Bezier instead of cubic)
+        bool         bPredicted  : 1;   ///< dead-reckoned by the state estimator, gives way to live data
     } f;
     
     /// The taxiway network's edge this pos is on, index into Apt::vecTaxiEdges
     size_t edgeIdx = EDGE_UNKNOWN;
 public:
     positionTy () : _lat(NAN), _lon(NAN), _alt(NAN), _ts(NAN), _head(NAN), _pitch(NAN), _roll(NAN),
-    f{FPH_UNKNOWN,false,GND_UNKNOWN,UNIT_WORLD,UNIT_DEG,SPOS_NONE,false}
+    f{FPH_UNKNOWN,false,GND_UNKNOWN,UNIT_WORLD,UNIT_DEG,SPOS_NONE,false,false}
     {}
     positionTy (double dLat, double dLon, double dAlt_m=NAN,
                 double dTS=NAN, double dHead=NAN, double dPitch=NAN, double dRoll=NAN,
                 onGrndE grnd=GND_UNKNOWN, coordUnitE uCoord=UNIT_WORLD, angleUnitE uAngle=UNIT_DEG,
                 flightPhaseE fPhase = FPH_UNKNOWN) :
         _lat(dLat), _lon(dLon), _alt(dAlt_m), _ts(dTS), _head(dHead), _pitch(dPitch), _roll(dRoll),
-        f{fPhase,false,grnd,uCoord,uAngle,SPOS_NONE,false}
+        f{fPhase,false,grnd,uCoord,uAngle,SPOS_NONE,false,false}
     {}
     positionTy ( const XPLMProbeInfo_t& probe ) :
         positionTy ( probe.locationZ, probe.locationX, probe.locationY ) { f.unitCoord=UNIT_LOCAL; }
@@ -464,7 +465,8 @@ public:
     positionTy& WorldToLocal ();
 };
 
-typedef std::deque<positionTy> dequePositionTy;
+/// Queue of positions, held inline up to FD_POS_INLINE elements
+typedef LTRingBufTy<positionTy, FD_POS_INLINE> dequePositionTy;
 
 // stringify all elements of a list for debugging purposes
 std::string positionDeque2String (const dequePositionTy& l,
@@ -30,6 +30,7 @@
 #include "XPLMDataAccess.h"
 #include "TextIO.h"
 #include "CoordCalc.h"
+#include "LTSeqLock.h"
 
 class RealTrafficConnection;
 
@@ -44,6 +45,11 @@ const int DEF_FD_REFRESH_INTVL  = 20;           ///< how often to fetch new flig
 const int DEF_FD_LONG_REFR_INTVL= 60;           ///< how often to fetch new flight data if flying high
 const int DEF_FD_BUF_PERIOD     = 90;           ///< seconds to buffer before simulating aircraft
 const int DEF_FD_REDUCE_HEIGHT  = 10000;        ///< height AGL considered "flying high"
+const int DEF_FD_FULL_AREA_EVERY= 1;            ///< request the full search area every n-th request only, in between just the near area (1 = always full area)
+const int DEF_FD_PREDICT        = 0;            ///< dead-reckon aircraft with a state estimator when live data is late? (0 = off)
+const int DEF_LOD_NEAR_DIST     = 5;            ///< [nm] aircraft closer than this to the camera are calculated with full detail every frame
+const int DEF_LOD_FAR_DIST      = 20;           ///< [nm] aircraft farther than this from the camera are updated least often
+const int DEF_FRAME_BUDGET_MS   = 0;            ///< [ms] frame-time governor: budget of LiveTraffic's main thread time per frame (0 = off)
 const int DEF_CONTR_ALT_MIN     = 25000;        ///< [ft] Auto Contrails: Minimum altitude
 const int DEF_CONTR_ALT_MAX     = 45000;        ///< [ft] Auto Contrails: Maximum altitude
 const int DEF_CONTR_LIFETIME    = 25;           ///< [s] Contrail default time to live
@@ -65,18 +71,18 @@ constexpr int DEF_UI_OPACITY    =  25;  ///< [%] Default background opacity
 //
 class Doc8643 {
 public:
-    std::string manufacturer;
-    std::string model;
-    std::string typeDesignator;
-    std::string classification;
-    std::string wtc;
+    LTAtom manufacturer;
+    LTAtom model;
+    LTAtom typeDesignator;
+    LTAtom classification;
+    LTAtom wtc;
 public:
     Doc8643 () {}
-    Doc8643 (std::string&& _manufacturer,
-             std::string&& _model,
-             std::string&& _typeDesignator,
-             std::string&& _classification,
-             std::string&& _wtc);
+    Doc8643 (const std::string& _manufacturer,
+             const std::string& _model,
+             const std::string& _typeDesignator,
+             const std::string& _classification,
+             const std::string& _wtc);
     
     // copying and moving is all as per default
 public:
@@ -105,7 +111,8 @@ public:
     // and returning information from it
 public:
     static bool ReadDoc8643File ();
-    static const Doc8643& get (const std::string& _type);
+    /// Lookup by type designator, returns `DOC8643_EMPTY` if not found
+    static const Doc8643& get (const LTAtom& _type);
 };
 
 //
@@ -123,7 +130,7 @@ namespace ModelIcaoType
     /// Read the `model_typecode.txt` file
     bool ReadFile ();
     /// Lookup ICAO type designator for human-readable model text, empty if nothing found
-    const std::string& getIcaoType (const std::string& _model);
+    const LTAtom& getIcaoType (const LTAtom& _model);
 }
 
 
@@ -351,6 +358,10 @@ enum dataRefsLT {
     DR_LT_VER,                      ///< LiveTraffic's version number, like 201 for v2.01
     DR_LT_VER_DATE,                 ///< LiveTraffic's version date, like 20200430 for 30-APR-2020
     
+    // frame-time governor
+    DR_GOV_LEVEL,                   ///< current level of reduction (0 = none)
+    DR_GOV_FRAME_TIME,              ///< [µs] LiveTraffic's main thread time per frame
+    
     // UI information
     DR_UI_OPACITY,
     DR_UI_FONT_SCALE,
@@ -381,6 +392,11 @@ enum dataRefsLT {
     DR_CFG_FD_LONG_REFRESH_INTVL,
     DR_CFG_FD_BUF_PERIOD,
     DR_CFG_FD_REDUCE_HEIGHT,
+    DR_CFG_FD_FULL_AREA_EVERY,
+    DR_CFG_FD_PREDICT,
+    DR_CFG_LOD_NEAR_DIST,
+    DR_CFG_LOD_FAR_DIST,
+    DR_CFG_FRAME_BUDGET,
     DR_CFG_MAX_NETW_TIMEOUT,
     DR_CFG_LND_LIGHTS_TAXI,
     DR_CFG_HIDE_BELOW_AGL,
@@ -408,6 +424,8 @@ enum dataRefsLT {
     DR_DBG_EXPORT_USER_AC,
     DR_DBG_EXPORT_NORMALIZE_TS,
     DR_DBG_EXPORT_FORMAT,
+    DR_DBG_FILE_ROTATE_MB,
+    DR_DBG_STRESS_MODE,
 
     // channel configuration options
     DR_CFG_FSC_ENV,
@@ -661,7 +679,9 @@ protected:
     int bDebugExportUserAc      = false;///< export user's aircraft data to LTExportFD.csv
     float lastExportUserAc      = 0.0f; ///< last time user's aircraft data has been written to export file
     int bDebugExportNormTS      = true; ///< normalize the timestamp when writing LTExportFD.csv, starting at 0 by the time exporting starts
+    int debugFileRotateMB       = 0;    ///< [MB] rotate export and raw network log files after this size (0 = no rotation)
     int bDebugModelMatching     = false;// output debug info on model matching in xplanemp?
+    int bDebugStressMode        = false;///< stress mode: log timings of processing stages
     std::string XPSystemPath;
     std::string LTPluginPath;           // path to plugin directory
     std::string DirSeparator;
@@ -697,6 +717,11 @@ protected:
     int fdCurrRefrIntvl = DEF_FD_REFRESH_INTVL;     ///< current value of how often to fetch new flight data
     int fdBufPeriod     = DEF_FD_BUF_PERIOD;        ///< seconds to buffer before simulating aircraft
     int fdReduceHeight  = DEF_FD_REDUCE_HEIGHT;     ///< [ft] reduce flight data usage when user aircraft is flying above this altitude
+    int fdFullAreaEvery = DEF_FD_FULL_AREA_EVERY;   ///< request the full search area only every n-th request, in between only the near area around the camera (1 = off)
+    int bFdPredict      = DEF_FD_PREDICT;           ///< dead-reckon aircraft with a state estimator when live data is late?
+    int lodNearDist     = DEF_LOD_NEAR_DIST;        ///< [nm] level of detail: full calculation every frame for aircraft closer than this
+    int lodFarDist      = DEF_LOD_FAR_DIST;         ///< [nm] level of detail: least frequent updates for aircraft farther than this
+    int frameBudget_ms  = DEF_FRAME_BUDGET_MS;      ///< [ms] frame-time governor: budget of LiveTraffic's main thread time per frame (0 = off)
     int netwTimeoutMax  = DEF_MAX_NETW_TIMEOUT;     ///< [s] of max network request timeout
     int bLndLightsTaxi = false;         // keep landing lights on while taxiing? (to be able to see the a/c as there is no taxi light functionality)
     int hideBelowAGL    = 0;            // if positive: a/c visible only above this height AGL
@@ -739,11 +764,17 @@ protected:
     std::string sRTLicense;             ///< RealTraffic License
     std::string sFSCUser;               ///< FSCharter login user
     std::string sFSCPwd;                ///< FSCharter login password
+    std::string sADSBHubHost;           ///< ADSBHub server as `host[:port]` if not the default one, only set in config file, e.g. for a local load generator
     
     // live values
     bool bReInitAll     = false;        // shall all a/c be re-initiaized (e.g. time jumped)?
     
     int cntAc           = 0;            // number of a/c being displayed
+    
+    // Frame-time governor
+    int govLevel        = 0;            ///< current level of reduction (0 = none)
+    double govFactor    = 1.0;          ///< factor applied to limits at current level, `GOV_REDUCE_F` to the power of `govLevel`
+    int govFrameTime_us = 0;            ///< [µs] LiveTraffic's main thread time per frame as last measured
     std::string keyAc;                  // key (transpIcao) for a/c whose data is returned
     const LTAircraft* pAc = nullptr;    // ptr to that a/c
     
@@ -808,6 +839,44 @@ protected:
     void* getVarAddr (dataRefsLT dr);
 
 //MARK: DataRef access, partly cached for thread-safe access
+public:
+    /// Wind Layer Data
+    struct WindLayerTy {
+        double  alt_m       = 0.0f;             ///< [m] Wind Layer's altitude
+        double  spd_msc     = 0.0f;             ///< [m/s] Wind Layer's speed
+        double  dir_degt    = 0.0f;             ///< [degree] Wind Layer's direction
+        WindLayerTy () {}
+        WindLayerTy (float a, float s, float d) :
+        alt_m(double(a)), spd_msc(double(s)), dir_degt(double(d)) {}
+    };
+    /// The region's wind layers, in a fixed-size array so that they can be part of SimStateTy
+    struct SimWindTy {
+        size_t      n = 0;                      ///< number of valid layers in `layer`
+        WindLayerTy layer[SIM_WIND_MAX_LAYERS]; ///< wind layers, lowest first
+        void clear () { n = 0; }
+        /// Add a layer, ignored if all SIM_WIND_MAX_LAYERS are in use already
+        void emplace_back (float a, float s, float d)
+        { if (n < SIM_WIND_MAX_LAYERS) layer[n++] = WindLayerTy(a, s, d); }
+        /// Wind at given altitude, interpolated between layers
+        vectorTy At (double alt_m) const;
+    };
+    /// @brief Simulator state as of the last flight loop
+    /// @details Published once per flight loop by UpdateCachedValues(),
+    ///          so that other threads get a consistent set of values
+    ///          without ever waiting for the flight loop.
+    struct SimStateTy {
+        positionTy  camPos;                     ///< camera position
+        positionTy  usersPlanePos;              ///< user's plane position
+        double      usersTrueAirspeed = 0.0;    ///< [m/s] user's plane's air speed
+        double      usersTrack = 0.0;           ///< user's plane's track
+        double      simTime = NAN;              ///< simulated time
+        float       netwTime = 0.0f;            ///< network time
+        long long   XPSimTime_ms = 0;           ///< X-Plane's simulated time in milliseconds since the Unix epoch
+        bool        bReplay = true;             ///< replay mode?
+        bool        bVREnabled = false;         ///< VR enabled?
+        SimWindTy   wind;                       ///< the region's wind layers
+    };
+
 protected:
     static positionTy lastCamPos;               ///< cached read camera position
     float       lastNetwTime    = 0.0f;         ///< cached network time
@@ -820,16 +889,8 @@ protected:
     int         lastUsersAGL_ft = 0;            ///< cached user's plane height above ground
     double      lastUsersTrueAirspeed = 0.0;    ///< [m/s] cached user's plane's air speed
     double      lastUsersTrack        = 0.0;    ///< cacher user's plane's track
-
-    /// Wind Layer Data
-    struct WindLayerTy {
-        double  alt_m       = 0.0f;             ///< [m] Wind Layer's altitude
-        double  spd_msc     = 0.0f;             ///< [m/s] Wind Layer's speed
-        double  dir_degt    = 0.0f;             ///< [degree] Wind Layer's direction
-        WindLayerTy (float a, float s, float d) :
-        alt_m(double(a)), spd_msc(double(s)), dir_degt(double(d)) {}
-    };
-    std::vector<WindLayerTy> lastWind;          ///< the region's wind layers
+    SimWindTy   lastWind;                       ///< the region's wind layers
+    LTSeqLockTy<SimStateTy> simState;           ///< the above values as published for other threads
 public:
     void ThisThreadIsXP() { xpThread = std::this_thread::get_id();  }
     bool IsXPThread() const { return std::this_thread::get_id() == xpThread; }
@@ -837,13 +898,13 @@ public:
     inline bool  IsViewExternal() const         { return XPLMGetDatai(adrXP[DR_VIEW_EXTERNAL]) != 0; }
     inline XPViewTypes GetViewType () const     { return (XPViewTypes)XPLMGetDatai(adrXP[DR_VIEW_TYPE]); }
     inline bool UsingModernDriver () const      { return bUsingModernDriver; }
-    inline bool  IsVREnabled() const            { return lastVREnabled; }
+    bool IsVREnabled() const                    { return IsXPThread() ? lastVREnabled : simState.Load().bVREnabled; }
 
     bool IsUsingSystemTime() const              { return XPLMGetDatai(adrXP[DR_USE_SYSTEM_TIME]); }
     int GetLocalDateDays() const                { return XPLMGetDatai(adrXP[DR_LOCAL_DATE_DAYS]); }
     float GetLocalTimeSec() const               { return XPLMGetDataf(adrXP[DR_LOCAL_TIME_SEC]); }
     float GetZuluTimeSec() const                { return XPLMGetDataf(adrXP[DR_ZULU_TIME_SEC]); }
-    long long GetXPSimTime_ms() const           { return lastXPSimTime_ms; }
+    long long GetXPSimTime_ms() const           { return IsXPThread() ? lastXPSimTime_ms : simState.Load().XPSimTime_ms; }
     void UpdateXPSimTime();                     ///< Calculate X-Plane's current simulation time as Unix epoch time in milliseconds (Java timestamp)
     std::string GetXPSimTimeStr() const;        ///< Return a nicely formated time string with XP's simulated time in UTC
     
@@ -877,7 +938,7 @@ public:
     static void ClearCameraAc(void*);           ///< shared dataRef callback: Whenever someone else writes to the shared dataRef we clear our a/c camera information
     
     // seconds since epoch including fractionals
-    double GetSimTime() const { return lastSimTime; }
+    double GetSimTime() const { return IsXPThread() ? lastSimTime : simState.Load().simTime; }
     /// Current sim time as a human readable string, including 10th of seconds
     std::string GetSimTimeString() const;
     
@@ -885,7 +946,7 @@ public:
     static int LTGetSimDateTime(void* p);
 
     /// Are we in replay mode?
-    bool IsReplayMode() const { return lastReplay; }
+    bool IsReplayMode() const { return IsXPThread() ? lastReplay : simState.Load().bReplay; }
     
     // livetraffic/cfg/aircrafts_displayed: Aircraft Displayed
     static void LTSetAircraftDisplayed(void* p, int i);
@@ -930,6 +991,8 @@ public:
     inline int GetLabelColor() const { return labelColor; }
     void GetLabelColor (float outColor[4]) const;
     inline int GetMaxNumAc() const { return maxNumAc; }
+    /// Max number of aircraft, reduced by the frame-time governor
+    inline int GetEffMaxNumAc() const { return std::max(std::min(maxNumAc, GOV_MIN_NUM_AC), int(maxNumAc * govFactor)); }
     void SetMaxNumAc(int n) { maxNumAc = n; }
     inline int GetFdStdDistance_nm() const { return fdStdDistance; }
     inline int GetFdStdDistance_m() const { return fdStdDistance * M_per_NM; }
@@ -938,6 +1001,22 @@ public:
     inline int GetFdRefreshIntvl() const { return fdCurrRefrIntvl; }
     inline int GetFdBufPeriod() const { return fdBufPeriod; }
     inline int GetAcOutdatedIntvl() const { return 2 * GetFdBufPeriod(); }
+    /// Request full search area every n-th request only, limited so that the full area is still requested within the buffering period
+    int GetFdFullAreaEvery() const { return std::max(1, std::min(fdFullAreaEvery, GetFdBufPeriod() / std::max(1, GetFdRefreshIntvl()))); }
+    /// Dead-reckon aircraft with the state estimator when live data is late?
+    inline bool GetFdPredict() const { return bFdPredict != 0; }
+    inline int GetLODNearDist_m() const { return int(lodNearDist * M_per_NM * govFactor); }   ///< [m] level of detail: full detail closer than this, reduced by the frame-time governor
+    inline int GetLODFarDist_m() const { return int(std::max(lodNearDist, lodFarDist) * M_per_NM * govFactor); }  ///< [m] level of detail: least detail farther than this, reduced by the frame-time governor
+    /// Max new positions taken from the hand-off queue per flight loop call, reduced by the frame-time governor
+    inline size_t GetPosHandoffPerFrame() const { return std::max(GOV_MIN_POS_PER_FRAME, size_t(double(FD_POS_HANDOFF_PER_FRAME) * govFactor)); }
+    /// [s] Minimum interval between updates of an aircraft's label, increased by the frame-time governor
+    inline double GetLabelUpdIntvl() const { return GOV_LABEL_INTVL * govLevel; }
+    inline int GetFrameBudget_ms() const { return frameBudget_ms; }
+    inline int GetGovLevel() const { return govLevel; }
+    inline double GetGovFactor() const { return govFactor; }
+    inline int GetGovFrameTime_us() const { return govFrameTime_us; }
+    void SetGovLevel (int lvl) { govLevel = lvl; govFactor = std::pow(GOV_REDUCE_F, lvl); }
+    void SetGovFrameTime_us (int us) { govFrameTime_us = us; }
     inline int GetNetwTimeoutMax() const { return netwTimeoutMax; }
     inline bool GetLndLightsTaxi() const { return bLndLightsTaxi != 0; }
     inline int GetHideBelowAGL() const { return hideBelowAGL; }
@@ -997,6 +1076,9 @@ public:
     void SetFSCharterUser (const std::string& user) { sFSCUser = user; }
     void SetFSCharterPwd (const std::string& pwd)   { sFSCPwd = pwd; }
     
+    const std::string& GetADSBHubHost () const      { return sADSBHubHost; }
+    void SetADSBHubHost (const std::string& host)   { sADSBHubHost = host; }
+    
     // timestamp offset network vs. system clock
     inline void ChTsOffsetReset() { chTsOffset = 0.0f; chTsOffsetCnt = 0; }
     inline double GetChTsOffset () const { return chTsOffset; }
@@ -1026,6 +1108,7 @@ public:
     void SetDebugExportUserAc (bool bExport)    { bDebugExportUserAc = bExport; }
     void ExportUserAcData ();                   ///< Write out an export record for the user aircraft
     bool ShallExportNormalizeTS () const        { return bDebugExportNormTS; }
+    int GetDebugFileRotateMB () const           { return debugFileRotateMB; }
     
     bool AnyExportData() const                  { return GetDebugExportFD() || GetDebugExportUserAc(); }
     void SetAllExportData (bool bExport)        { SetDebugExportFD(bExport); SetDebugLogRawFD(bExport); }
@@ -1033,6 +1116,9 @@ public:
     // livetraffic/dbg/model_matching: Debug Model Matching (by XPMP2)
     inline bool GetDebugModelMatching() const   { return bDebugModelMatching; }
     
+    // livetraffic/dbg/stress_mode: Log timings of processing stages
+    inline bool GetDebugStressMode() const      { return bDebugStressMode; }
+    
     // Number of aircraft
     inline int GetNumAc() const                 { return cntAc; }
     int IncNumAc();
@@ -1058,6 +1144,7 @@ protected:
     void UpdateUsersPlanePos ();                ///< fetches user's plane position
     static void UpdateViewPos();                ///< read and cache camera position
     void UpdateSimWind ();                      ///< Update local (in sim!) wind at user's plane
+    void PublishSimState ();                    ///< publish cached values as SimStateTy for other threads
 
     
 //MARK: Processed values
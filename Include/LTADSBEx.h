@@ -169,6 +169,8 @@ protected:
     // need to add/cleanup API key
     bool InitCurl () override;
     void CleanupCurl () override;
+    /// The API key header
+    struct curl_slist* GetCurlHeaders () const override { return slistKey; }
     
     /// Specific handling for authentication errors
     bool ProcessErrors (const JSON_Object* pObj) override;
@@ -193,6 +193,15 @@ public:
     std::string dbgTxt() const;
 };
 
+/// @brief Level of detail, in which an aircraft's position and animations are updated
+/// @see DataRefs::GetLODNearDist_m(), DataRefs::GetLODFarDist_m()
+enum lodTierE : unsigned char {
+    LOD_NEAR = 0,                       ///< full calculation and all animations every frame
+    LOD_MID,                            ///< full calculation every LOD_MID_CALC_INTVL, linear extrapolation in between, no animations
+    LOD_FAR,                            ///< full calculation every LOD_FAR_CALC_INTVL, linear extrapolation in between, no animations; also for hidden aircraft
+    LOD_CNT                             ///< number of tiers
+};
+
 //
 //MARK: LTAircraft
 //      Represents an aircraft as displayed in XP by use of the
@@ -292,6 +301,10 @@ protected:
     positionTy          ppos;
     // and this the current vector from 'from' to 'to'
     vectorTy            vec;
+    /// values the label was last composed for
+    LTFlightData::LabelValsTy labelVals;
+    /// next time the label may be updated, see DataRefs::GetLabelUpdIntvl()
+    double              labelNextTs = 0.0;
     
     // timestamp we last requested new positions from flight data
     double              tsLastCalcRequested;
@@ -322,6 +335,15 @@ protected:
     // bearing/dist from viewpoint to a/c
     vectorTy            vecView;        // degrees/meters
     
+    // Level of detail
+    lodTierE            lodTier = LOD_NEAR;     ///< current level of detail
+    double              lodNextCalcTs = NAN;    ///< when is the next full position calculation due?
+    positionTy          lodBasePos;             ///< ppos as of last full calculation, basis for extrapolation
+    double              lodDLat = 0.0;          ///< [°/s] latitude change per second, for extrapolation
+    double              lodDLon = 0.0;          ///< [°/s] longitude change per second, for extrapolation
+    double              lodDAlt = 0.0;          ///< [m/s] altitude change per second, for extrapolation
+    static int          cntLOD[LOD_CNT];        ///< number of aircraft per level of detail
+    
 #ifdef DEBUG
     bool                bIsSelected = false;    // is selected for logging/debugging?
 #endif
@@ -339,6 +361,10 @@ protected:
 public:
     LTAircraft(LTFlightData& fd);
     ~LTAircraft() override;
+    /// Allocates from the pool of memory blocks of removed aircraft, main thread only
+    static void* operator new (size_t sz);
+    /// Returns the memory block to the pool for re-use, main thread only
+    static void operator delete (void* p, size_t sz);
     
     // key for maps
     inline const std::string& key() const { return fd.key().key; }
@@ -385,6 +411,9 @@ public:
     inline double GetPHeight_ft() const { return GetPHeight_m() / M_per_FT; }   ///< height above ground converted to ft
     inline vectorTy GetVec() const { return vec; }
     inline vectorTy GetVecView() const { return vecView; }
+    inline lodTierE GetLODTier() const { return lodTier; }
+    /// Number of aircraft currently in the given level of detail
+    static int GetNumAcLOD (lodTierE tier) { return cntLOD[tier]; }
     std::string GetLightsStr() const;
     void CopyBulkData (LTAPIAircraft::LTAPIBulkData* pOut, size_t size) const;       ///< copies a/c info into bulk structure
     void CopyBulkData (LTAPIAircraft::LTAPIBulkInfoTexts* pOut, size_t size) const;  ///< copies a/c text info into bulk structure
@@ -409,8 +438,8 @@ protected:
     bool CalcPPos ();
     // determine other parameters like gear, flap, roll etc. based on flight model assumptions
     void CalcFlightModel (const positionTy& from, const positionTy& to);
-    /// determine roll, based on a previous and a current heading
-    void CalcRoll (double _prevHeading);
+    /// determine roll, based on a previous and a current heading and the time passed in between
+    void CalcRoll (double _prevHeading, double _dt);
     /// determine correction angle
     void CalcCorrAngle ();
     /// determines terrain altitude via XPLM's Y Probe
@@ -419,6 +448,14 @@ protected:
     bool CalcVisible ();
     /// Determines AI priority based on bearing to user's plane and ground status
     void CalcAIPrio ();
+    /// Determines level of detail based on distance to camera and visibility
+    void CalcLODTier ();
+    /// Is a full position calculation due in this frame?
+    bool IsLODCalcDue () const;
+    /// After a full position calculation: remember ppos for extrapolation, schedule next calculation
+    void LODSaveCalc ();
+    /// In between full calculations: linearly extrapolate ppos
+    void LODExtrapolate ();
     
     /// @brief change the model (e.g. when model-defining static data changed)
     /// @note Should be used in main thread only
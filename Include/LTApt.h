@@ -76,6 +76,22 @@ bool LTAptSnap (LTFlightData& fd, dequePositionTy::iterator& posIter,
 /// Cleanup
 void LTAptDisable ();
 
+/// @brief Synchronously read airports within `_box` from one given `apt.dat` file
+/// @details Meant for tools and benchmarks, which don't run X-Plane's flight loop,
+///          as opposed to LTAptRefresh(), which reads all scenery asynchronously.
+/// @return Number of airports known afterwards, or -1 if the file could not be opened
+int LTAptReadFile (const std::string& _path, const boundingBoxTy& _box);
+
+/// Key figures of one airport's taxi network
+struct LTAptInfoTy {
+    std::string id;                     ///< airport id
+    size_t nNodes = 0;                  ///< number of taxi nodes
+    size_t nEdges = 0;                  ///< number of taxi edges
+};
+
+/// List all currently known airports with the size of their taxi network
+std::vector<LTAptInfoTy> LTAptList ();
+
 /// @brief Dumps the entire taxi network into a CSV file readable by GPS Visualizer
 /// @see https://www.gpsvisualizer.com/
 bool LTAptDump (const std::string& _aptId);
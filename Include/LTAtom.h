@@ -0,0 +1,111 @@
+/// @file       LTAtom.h
+/// @brief      Interned strings for repeated static aircraft data
+/// @details    Aircraft types, operators, manufacturers, models and the like
+///             repeat across thousands of flight data objects.
+///             An LTAtom refers to the one immutable copy of its text
+///             in a global table, so that storing and copying it is
+///             just copying a pointer, and comparing two atoms for equality
+///             is comparing pointers.\n
+///             Atoms are never removed from the table. Only intern text,
+///             which is drawn from a limited set of values.
+/// @author     Birger Hoppe
+/// @copyright  (c) 2024 Birger Hoppe
+/// @copyright  Permission is hereby granted, free of charge, to any person obtaining a
+///             copy of this software and associated documentation files (the "Software"),
+///             to deal in the Software without restriction, including without limitation
+///             the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the
+///             Software is furnished to do so, subject to the following conditions:\n
+///             The above copyright notice and this permission notice shall be included in
+///             all copies or substantial portions of the Software.\n
+///             THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///             IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///             FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///             AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///             LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///             OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+///             THE SOFTWARE.
+
+#ifndef LTAtom_h
+#define LTAtom_h
+
+#include <string>
+#include <atomic>
+#include <functional>
+
+/// @brief Interned, immutable string, comparable by pointer
+/// @details Converts implicitly from and to `std::string`, so that it can
+///          replace a `std::string` member in most places. Construction
+///          from text looks up (or adds) the text in the global table under a lock,
+///          copying and assigning atoms doesn't.
+///          The default-constructed atom is the empty string and never touches the table.
+class LTAtom
+{
+public:
+    /// Hash functor for using atoms as keys in unordered containers, hashes the pointer only
+    struct HashTy {
+        size_t operator() (const LTAtom& a) const { return std::hash<const void*>()(a.p); }
+    };
+
+protected:
+    /// An entry in the table, never changes or moves once added
+    struct EntryTy {
+        std::string s;                                      ///< the text
+        mutable std::atomic<const EntryTy*> pUpper {nullptr};   ///< upper-case variant, determined on first request
+        EntryTy (const std::string& _s) : s(_s) {}
+    };
+    const EntryTy* p = nullptr;             ///< the interned text, `nullptr` for the empty string
+    static const std::string emptyStr;      ///< text of the empty atom
+
+    struct TableTy;                         ///< the table of interned texts, see LTAtom.cpp
+    static TableTy& GetTable ();            ///< the one table
+
+public:
+    /// Empty string
+    LTAtom () noexcept {}
+    /// Intern text
+    LTAtom (const std::string& s);
+    /// Intern text
+    LTAtom (const char* s) : LTAtom(std::string(s ? s : "")) {}
+
+    /// The text
+    const std::string& str () const { return p ? p->s : emptyStr; }
+    /// The text
+    operator const std::string& () const { return str(); }
+
+    const char* c_str () const { return str().c_str(); }
+    bool empty () const { return p == nullptr; }
+    size_t size () const { return str().size(); }
+    size_t length () const { return str().length(); }
+    char operator[] (size_t i) const { return str()[i]; }
+    size_t find (const char* s, size_t pos = 0) const { return str().find(s, pos); }
+    size_t find (const std::string& s, size_t pos = 0) const { return str().find(s, pos); }
+    /// Reset to the empty string
+    void clear () { p = nullptr; }
+
+    /// @brief The upper-case variant of this atom
+    /// @details Determined once per interned text and then remembered,
+    ///          so that case-insensitive filtering doesn't need to convert each time
+    LTAtom upper () const;
+
+    /// Number of interned texts
+    static size_t TableSize ();
+
+    // Equality of atoms is identity of pointers
+    bool operator== (const LTAtom& o) const { return p == o.p; }
+    bool operator!= (const LTAtom& o) const { return p != o.p; }
+    // Comparison with text compares text
+    bool operator== (const std::string& s) const { return str() == s; }
+    bool operator!= (const std::string& s) const { return str() != s; }
+    bool operator== (const char* s) const { return str() == s; }
+    bool operator!= (const char* s) const { return str() != s; }
+    /// Ordering is alphabetical
+    bool operator< (const LTAtom& o) const { return p != o.p && str() < o.str(); }
+    /// Ordering is alphabetical
+    bool operator> (const LTAtom& o) const { return o < *this; }
+};
+
+inline bool operator== (const std::string& s, const LTAtom& a) { return a == s; }
+inline bool operator!= (const std::string& s, const LTAtom& a) { return a != s; }
+
+#endif /* LTAtom_h */
@@ -32,11 +32,57 @@
 
 // MARK: Thread control
 extern std::thread CalcPosThread;              // the thread for pos calc (TriggerCalcNewPos)
-extern std::mutex  FDThreadSynchMutex;         // supports wake-up and stop synchronization
-extern std::condition_variable FDThreadSynchCV;
 // stop all threads?
 extern volatile bool bFDMainStop;
 
+/// @brief Wakeup primitive owned by one consumer thread
+/// @details Each channel and the position calculation thread own one,
+///          so that triggering one of them doesn't wake up all others.
+///          Scheduled wakeups are deadlines of the consumer's own timed wait,
+///          other threads wake it up immediately with Wake().
+///          A stop broadcast reaches all threads via WakeAll().
+class LTWakeup {
+protected:
+    std::mutex mtx;                 ///< protects `bSignaled`
+    std::condition_variable cv;     ///< the owning thread waits on this one only
+    bool bSignaled = false;         ///< woken since last wait? Prevents lost wakeups
+
+public:
+    LTWakeup ();                    ///< Constructor registers for WakeAll()
+    ~LTWakeup ();                   ///< Destructor unregisters
+    LTWakeup (const LTWakeup&) = delete;
+    LTWakeup& operator= (const LTWakeup&) = delete;
+
+    /// Wake up the owning thread now
+    void Wake ();
+    /// Wake up all threads, e.g. to have them check for stopping
+    static void WakeAll ();
+
+    /// @brief Sleep until `tp`, woken up, or `pred` is true
+    /// @return Result of `pred`
+    template <class Pred>
+    bool WaitUntil (std::chrono::steady_clock::time_point tp, Pred pred)
+    {
+        std::unique_lock<std::mutex> lk(mtx);
+        while (!bSignaled && !pred()) {
+            if (tp == std::chrono::steady_clock::time_point::max())
+                cv.wait(lk);
+            else if (cv.wait_until(lk, tp) == std::cv_status::timeout)
+                break;
+        }
+        bSignaled = false;
+        return pred();
+    }
+    /// Sleep for at most `d`, until woken up, or `pred` is true
+    template <class Rep, class Period, class Pred>
+    bool WaitFor (const std::chrono::duration<Rep,Period>& d, Pred pred)
+    { return WaitUntil(std::chrono::steady_clock::now() + d, pred); }
+    /// Sleep until woken up or `pred` is true
+    template <class Pred>
+    void Wait (Pred pred)
+    { WaitUntil(std::chrono::steady_clock::time_point::max(), pred); }
+};
+
 //
 //MARK: Flight Data Connection (abstract base class)
 //
@@ -62,6 +108,7 @@ public:
 protected:
     std::thread thr;                ///< Main Thread the channel runs in
     std::chrono::time_point<std::chrono::steady_clock> tNextWakeup; ///< when to wake up next for networking?
+    LTWakeup wakeup;                ///< the thread sleeps on this one, wakes up for requests, timeouts, or stopping
     typedef enum {
         THR_NONE = 0,               ///< no thread, not running
         THR_STARTING,               ///< Start of thread requested
@@ -87,6 +134,7 @@ public:
     bool isRunning () const         ///< Is channel's thread running?
     { return thr.joinable(); }
     virtual bool shallRun () const; ///< all conditions met to continue the thread loop?
+    void Wake () { wakeup.Wake(); } ///< Wake up the channel's thread, e.g. to check for new requests or for stopping
     /// Thread has ended but still needs to be joined
     bool hasEnded () const { return eThrStatus == THR_ENDED; }
 
@@ -121,9 +169,7 @@ public:
     virtual bool ProcessFetchedData () = 0;
 };
 
-// Mutex and condition variable with which threads are woken up
-extern std::mutex               FDThreadSynchMutex;
-extern std::condition_variable  FDThreadSynchCV;
+// Flag with which all threads are stopped
 extern volatile bool            bFDMainStop;
 
 // Collection of smart pointers requires C++ 17 to compile correctly!
@@ -153,8 +199,12 @@ protected:
     size_t netDataSize;             // current size of netData
     char curl_errtxt[CURL_ERROR_SIZE];    // where error text goes
     long httpResponse;              // last HTTP response code
+    std::string requETag;           ///< if set, is sent as `If-None-Match` with the next request
+    std::string requLastModified;   ///< if set, is sent as `If-Modified-Since` with the next request
+    std::string respETag;           ///< `ETag` header received with the last response
+    std::string respLastModified;   ///< `Last-Modified` header received with the last response
     
-    static std::ofstream outRaw;    // output file for raw logging
+    static LTAsyncWriter outRaw;    ///< output file for raw logging, written asynchronously
     
 public:
     LTOnlineChannel (dataRefsLT ch, LTChannelType t, const char* chName);
@@ -163,8 +213,12 @@ public:
 protected:
     virtual bool InitCurl ();
     virtual void CleanupCurl ();
+    /// The channel's own HTTP header list as set by InitCurl(), conditional request headers are added to a copy of it
+    virtual struct curl_slist* GetCurlHeaders () const { return nullptr; }
     // CURL callback
     static size_t ReceiveData ( const char *ptr, size_t size, size_t nmemb, void *userdata );
+    /// CURL header callback, stores validators (`ETag`, `Last-Modified`) for conditional requests
+    static size_t ReceiveHeader ( char *buffer, size_t size, size_t nitems, void *userdata );
     /// @brief logs raw data to a text file
     /// @param data The data to print, assumed to be zero-terminated text
     /// @param httpCode `-1` for SENDing data, any other code is a received HTTP response code
@@ -192,10 +246,44 @@ class LTFlightDataChannel : public LTOnlineChannel {
 protected:
     mutable float timeLastAcCnt = 0.0;      ///< when did we last count the a/c served by this channel?
     mutable int     numAcServed = 0;        ///< how many a/c do we feed when counted last?
+
+    /// @brief Area to request, as planned by PlanRequestArea()
+    /// @details `extent_m` has the same meaning as the `fullExtent_m` parameter
+    ///          passed into PlanRequestArea(), be it a radius or the width of a box.
+    struct RequAreaTy {
+        positionTy center;                  ///< center of the area to request, snapped to a grid
+        double extent_m = 0.0;              ///< [m] extent of the area to request
+        bool bFull = true;                  ///< full search area (or just the near area around the camera)?
+        std::string eTag;                   ///< `ETag` received last time this very area was requested
+        std::string lastModified;           ///< `Last-Modified` received last time this very area was requested
+        /// Is this the same area as `o`? (Only then validators can be reused)
+        bool sameArea (const RequAreaTy& o) const;
+    };
+    RequAreaTy areaLast[2];                 ///< last requested near [0] and full [1] area
+    int nAreaPlanned = -1;                  ///< index into `areaLast` of the currently planned request, `-1` if not planned
+    unsigned nRequSinceFull = 0;            ///< number of requests since the last full-area request
+    positionTy posLastFull;                 ///< camera position at the time of last full-area request
+
 public:
     LTFlightDataChannel (dataRefsLT ch, const char* chName, LTChannelType eType = CHT_TRACKING_DATA) :
         LTOnlineChannel(ch, eType, chName) {}
     int GetNumAcServed () const override;   ///< how many a/c do we feed when counted last?
+
+    /// Fetches data, remembers validators of the requested area for the next conditional request
+    bool FetchAllData (const positionTy& pos) override;
+    
+protected:
+    /// @brief Plans which area to request around the camera
+    /// @details If configured (DataRefs::GetFdFullAreaEvery() > 1) then the full
+    ///          search area is requested only every n-th time, or when the
+    ///          camera has moved too far, and only the near area around the camera in between.
+    ///          The area's center is snapped to a grid so that repeated
+    ///          requests for an unchanged camera position lead to the very
+    ///          same URL, which allows for conditional requests.
+    /// @param pos Camera position
+    /// @param fullExtent_m Extent (radius or box width, as the channel needs it) of the full search area
+    /// @return The area to request, `center` and `extent_m` to be used for the URL
+    const RequAreaTy& PlanRequestArea (const positionTy& pos, double fullExtent_m);
 };
 
 //
@@ -209,6 +297,8 @@ public:
     LTFlightData::FDKeyTy acKey;    ///< a/c key to find a/c master data
     std::string callSign;           ///< call sign to query route information
     unsigned long dist = UINT_MAX;  ///< distance of plane to camera, influences priority
+    /// Priority tier: 0 - about to be rendered, 1 - rendered already, 2 - beyond display range
+    unsigned tier = 2;
 
     DatRequTy type = DATREQU_NONE;   ///< type of this master data request
     
@@ -220,30 +310,155 @@ public:
     /// @param k Key to aircraft, is always required to be able to update the aircraft after having fetched data
     /// @param cs callSign if and only if a route is requested, empty if a/c master data is requested
     /// @param d Distance of aircraft to camera, influence priority in which requests are processed
-    acStatUpdateTy(const LTFlightData::FDKeyTy& k, const std::string& cs, unsigned long d) :
-    acKey(k), callSign(cs), dist(d), type(cs.empty() ? DATREQU_AC_MASTER : DATREQU_ROUTE) {}
+    acStatUpdateTy(const LTFlightData::FDKeyTy& k, const std::string& cs, double d) :
+    acKey(k), callSign(cs), type(cs.empty() ? DATREQU_AC_MASTER : DATREQU_ROUTE)
+    { SetPrio(d, false); }
     
     /// Default constructor creates an empty, invalid object
     acStatUpdateTy () : type(DATREQU_NONE) {}
     
-    /// @brief Priority order is: route info has lower prio than master data, and within that: longer distance has lower order
-    /// @see confusing definition of std::priority_queue's `Compare` template parameter at https://en.cppreference.com/w/cpp/container/priority_queue
+    /// Set priority based on current distance to camera and if the aircraft is rendered already
+    void SetPrio (double distance, bool bRendered);
+    
+    /// @brief Priority order is: route info has lower prio than master data, within that by tier, and within that: longer distance has lower order
+    /// @details "Lower order" is served first
     bool operator < (const acStatUpdateTy& o) const
-    { return type == o.type ? dist < o.dist : type < o.type; }
+    {
+        if (type != o.type) return type < o.type;
+        if (tier != o.tier) return tier < o.tier;
+        return dist < o.dist;
+    }
     
     /// Equality is used to test of a likewise request is included already and does _not_ take distance into account
     bool operator == (const acStatUpdateTy& o) const
-    { return type == o.type && acKey == o.acKey && callSign == callSign; }
+    { return type == o.type && acKey == o.acKey && callSign == o.callSign; }
     
     /// Valid request? (need an a/c key, and if it is a route request also a call sign)
     operator bool () const { return type != DATREQU_NONE && !acKey.empty() && (type != DATREQU_ROUTE || !callSign.empty()); }
 };
 
-/// Set of all master data requests, ordered by `acStatUpdateTy::operator<`
-typedef std::set<acStatUpdateTy> setAcStatUpdateTy;
+/// @brief Indexed priority queue of master data requests
+/// @details A binary heap ordered by `acStatUpdateTy::operator<`, so that
+///          the front element is served first, plus a hash index by (a/c key, request type),
+///          which allows to find a request, lower its priority value (decrease-key),
+///          or remove it in O(log n).
+/// @note Not thread-safe, protected by LTACMasterdataChannel::mtxMaster
+class MasterDataQueueTy {
+protected:
+    std::vector<acStatUpdateTy> heap;                       ///< the heap, `heap[0]` is served next
+    std::unordered_map<unsigned long long, size_t> idx;     ///< index into `heap` by IdxKey()
+
+public:
+    bool empty () const { return heap.empty(); }            ///< no request waiting?
+    size_t size () const { return heap.size(); }            ///< number of waiting requests
+    void clear () { heap.clear(); idx.clear(); }            ///< remove all requests
+    /// The request to be served next, must not be empty
+    const acStatUpdateTy& front () const { return heap.front(); }
+    std::vector<acStatUpdateTy>::const_iterator begin () const { return heap.cbegin(); }
+    std::vector<acStatUpdateTy>::const_iterator end () const { return heap.cend(); }
+
+    /// @brief Add a new request, or update an existing one for the same a/c and type
+    /// @details An existing request gets the new call sign and the better of both priorities.
+    /// @return `true` if added, `false` if a request existed already
+    bool push (const acStatUpdateTy& r);
+    /// Remove the request to be served next, must not be empty
+    void pop () { erase(0); }
+    
+    /// @brief Recalculate the priority of all requests, removing some
+    /// @param f Function that updates the request's priority, returns `false` if the request shall be removed
+    template <class F>
+    void reprioritize (F f)
+    {
+        std::vector<acStatUpdateTy> v;
+        v.reserve(heap.size());
+        for (acStatUpdateTy& r: heap)
+            if (f(r))
+                v.push_back(std::move(r));
+        heap = std::move(v);
+        std::make_heap(heap.begin(), heap.end(), HeapCmp);     // O(n) rebuild is cheaper than n decrease-keys
+        idx.clear();
+        for (size_t i = 0; i < heap.size(); ++i)
+            idx[IdxKey(heap[i])] = i;
+    }
+
+protected:
+    /// Index key combines numeric a/c key and request type
+    static unsigned long long IdxKey (const acStatUpdateTy& r)
+    { return (unsigned long long)(r.acKey.num) << 2 | (unsigned long long)(r.type); }
+    /// Heap comparison: the _lowest_ request per `operator<` is at the heap's top
+    static bool HeapCmp (const acStatUpdateTy& a, const acStatUpdateTy& b) { return b < a; }
+    void erase (size_t i);                  ///< remove element at position `i`
+    void siftUp (size_t i);                 ///< move element at `i` up as far as needed
+    void siftDown (size_t i);               ///< move element at `i` down as far as needed
+    void place (size_t i, acStatUpdateTy&& r);  ///< put `r` at `heap[i]` and update the index
+};
+
 typedef std::set<LTFlightData::FDKeyTy> setFdKeyTy;
 typedef std::set<std::string> setStringTy;
 
+/// @brief Persistent cache of a/c master data, route info, and "not found" results
+/// @details Kept in an append-only text file with one record per line:
+///          `<type><id> TAB <expiry> TAB <fields>...`. When reading the file
+///          later lines override earlier ones, all valid records are indexed
+///          in memory by type and id. Opening reads the file in a worker thread
+///          and compacts it if it contains too many outdated records
+///          or more than `MD_CACHE_MAX_ENTRIES` valid ones.
+class MasterDataCacheTy {
+public:
+    /// Type of a cache record, first character of each line
+    enum RecTy : char {
+        REC_MASTER = 'M',           ///< a/c master data, id is the transponder hex code
+        REC_ROUTE  = 'R',           ///< route info, id is the call sign
+        REC_IGN_AC = 'I',           ///< a channel has no master data for the a/c, id is `channel:hex code`
+        REC_IGN_CS = 'C',           ///< a channel has no route info for the call sign, id is `channel:call sign`
+    };
+protected:
+    /// One cache record
+    struct EntryTy {
+        time_t tExpire = 0;                 ///< wall clock time after which the record is outdated
+        std::vector<std::string> fields;    ///< data fields
+    };
+    /// Index of all valid records by record type + id
+    std::unordered_map<std::string, EntryTy> mapEntries;
+    std::mutex mtx;                         ///< guards all access
+    std::condition_variable cvLoaded;       ///< notified when the worker thread finished reading the file
+    bool bLoading = false;                  ///< worker thread still reading the file? Guarded by `mtx`
+    std::future<void> futLoad;              ///< the worker thread reading the file
+    std::string path;                       ///< cache file path
+    std::ofstream fOut;                     ///< cache file, open for appending
+public:
+    void Open (const std::string& _path);   ///< start reading the cache file in a worker thread, which then opens it for appending
+    void Close ();                          ///< wait for any reading to finish, close the cache file, clear memory
+    void WaitLoaded ();                     ///< wait till the worker thread has read the file
+    
+    /// Fetch cached master data for the a/c, `true` if found
+    bool GetMaster (const LTFlightData::FDKeyTy& key, LTFlightData::FDStaticData& dat);
+    /// Fetch cached route info for the call sign, `true` if found
+    bool GetRoute (const std::string& callSign, LTFlightData::FDStaticData& dat);
+    /// Fill the channel's ignore lists from cache
+    void GetIgnores (const char* chName, setFdKeyTy& setAc, setStringTy& setCallSign);
+    
+    /// Store master data received for the a/c
+    void PutMaster (const LTFlightData::FDKeyTy& key, const LTFlightData::FDStaticData& dat);
+    /// Store route info received for the call sign
+    void PutRoute (const std::string& callSign, const LTFlightData::FDStaticData& dat);
+    /// Store that the channel found no data for the request
+    void PutIgnore (const char* chName, const acStatUpdateTy& requ);
+    
+protected:
+    /// Worker thread: read the cache file, compact it if needed, and open it for appending
+    void Load (const std::string& _path);
+    /// Find a valid record, expects `mtx` to be locked
+    const EntryTy* Find (RecTy t, const std::string& id) const;
+    /// Add/replace a record in memory and append it to the file
+    void Put (RecTy t, const std::string& id, time_t ttl, std::vector<std::string>&& fields);
+    /// Write one record as a line
+    static void WriteLine (std::ostream& o, const std::string& key, const EntryTy& e);
+};
+
+/// The one global master data cache
+extern MasterDataCacheTy mdCache;
+
 /// @brief Parent class for master data channels, handles queue for master data requests
 /// @details Static functions of LTACMasterdataChannel handle the queue of
 ///          requests for master data. Implementations of this class register
@@ -260,8 +475,10 @@ protected:
     static std::recursive_mutex mtxMaster;
     /// List of register master data services, in order of priority
     static std::list<LTACMasterdataChannel*> lstChn;
-    /// list of static data requests for the current channel
-    setAcStatUpdateTy setAcStatRequ;
+    /// queue of static data requests for the current channel
+    MasterDataQueueTy queAcStatRequ;
+    /// Number of requests in `queAcStatRequ`, readable without `mtxMaster`, see HaveAnyRequest()
+    std::atomic<size_t> nAcStatRequ {0};
     /// Last time the above list of requests got maintained, ie. cleared from outdated stuff
     float tSetRequCleared = 0.0f;
     /// List of a/c to ignore, as we know we don't get data online
@@ -283,12 +500,16 @@ protected:
     virtual bool AcceptRequest (const acStatUpdateTy& requ) = 0;
     /// Add the request to the set if not duplicate
     bool InsertRequest (const acStatUpdateTy& requ);
-    /// Is any request waiting?;
-    bool HaveAnyRequest () const { return !setAcStatRequ.empty(); }
+    /// @brief Is any request waiting?
+    /// @note Called from wakeup predicates, which run while holding the wakeup's lock,
+    ///       so must not take `mtxMaster`: InsertRequest() calls Wake() while holding `mtxMaster`
+    bool HaveAnyRequest () const { return nAcStatRequ > 0; }
+    /// Update `nAcStatRequ` after changing `queAcStatRequ`, call with `mtxMaster` locked
+    void UpdRequCount () { nAcStatRequ = queAcStatRequ.size(); }
     /// @brief Fetch next master data request from our set into `currRequ`
     /// @returns `true` if a request has been passed, `false` if no request was waiting
     bool FetchNextRequest ();
-    /// Called regularly to keep the request queue updated
+    /// Called regularly to keep the request queue updated, refreshes priorities from current distance to camera
     void MaintainMasterDataRequests ();
 
     /// Perform the update to flight's static data
@@ -362,7 +583,14 @@ LTChannel* LTFlightDataGetCh (dataRefsLT ch);
 //
 //MARK: Aircraft Maintenance (called from flight loop callback)
 //
+/// @brief Every `AC_MAINT_INTVL`: start a new round of aircraft maintenance
+/// @details A round walks all segments of `mapFd`, spread across flight loop calls
+///          by LTFlightDataAcMaintenanceSlice(), so that no single frame carries it all.
 void LTFlightDataAcMaintenance();
+/// @brief Every flight loop call: maintain the next segments of `mapFd`, create the nearest aircraft due
+/// @details Maintains at least `AC_MAINT_FD_PER_CALL` flight data objects (or what's left),
+///          creates at most `AC_MAINT_CREATE_PER_CALL` aircraft
+void LTFlightDataAcMaintenanceSlice();
 
 //
 //MARK: Parson Helper Functions
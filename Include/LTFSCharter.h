@@ -106,6 +106,8 @@ public:
 
     bool InitCurl () override;
     void CleanupCurl () override;
+    /// The authorization and JSON headers
+    struct curl_slist* GetCurlHeaders () const override { return pCurlHeader; }
     std::string GetURL (const positionTy& pos) override;
     void ComputeBody (const positionTy& pos) override;
     bool ProcessFetchedData () override;
@@ -61,6 +61,7 @@ public:
         // movement
         double          spd;            // speed              190.0 [kt]
         double          vsi;            // vertical speed      2241 [ft/min]
+        double          turnRate;       // rate of turn         -0.09 [°/s], negative = left, NAN if n/a
 
         // timestamp is in seconds since Unix epoch (like time_t) but including fractional seconds
         double          ts;             // last update of dyn data?           1523789873,329 [Epoch s]
@@ -85,7 +86,8 @@ public:
         std::string GetSquawk() const;
     };
     
-    typedef std::deque<FDDynamicData> dequeFDDynDataTy;
+    /// Queue of dynamic data, held inline up to FD_DYN_INLINE elements
+    typedef LTRingBufTy<FDDynamicData, FD_DYN_INLINE> dequeFDDynDataTy;
     
     // data, which stays static during one flight
     class FDStaticData
@@ -93,11 +95,11 @@ public:
     public:
         // aircraft details                Field                                        Example
         std::string     reg;            // Registration                                 D-ABQE
-        std::string     country;        // registry country (based on transpIcao)       Germany
-        std::string     acTypeIcao;     // XPMP API: "ICAOCode" as the aircraft type    DH8D
-        std::string     man;            // aircraft manufacturer                        Bombardier
-        std::string     mdl;            // aircraft model (long text)                   Bombardier DHC-8 402
-        std::string     catDescr;       // category description
+        LTAtom          country;        // registry country (based on transpIcao)       Germany
+        LTAtom          acTypeIcao;     // XPMP API: "ICAOCode" as the aircraft type    DH8D
+        LTAtom          man;            // aircraft manufacturer                        Bombardier
+        LTAtom          mdl;            // aircraft model (long text)                   Bombardier DHC-8 402
+        LTAtom          catDescr;       // category description
         int             engType = -1;   // type of engine
         int             engMount = -1;  // type of engine mount
         int             year = 0;       // year built                                   2008
@@ -108,13 +110,13 @@ public:
 
         // flight details
         std::string     call;           // Call sign          EWG8AY
-        std::vector<std::string> stops; ///< stops on the route, typically origin-destination, but can contain more stops
+        std::vector<LTAtom> stops;      ///< stops on the route, typically origin-destination, but can contain more stops
         std::string     flight;         // flight code
         std::string     slug;           ///< URL to flight details
         
         // operator
-        std::string     op;             // operator                                     Air Berlin
-        std::string     opIcao;         // XPMP API: "Airline"                          BER
+        LTAtom          op;             // operator                                     Air Berlin
+        LTAtom          opIcao;         // XPMP API: "Airline"                          BER
         
         // Filled from master data requests?
         bool    bDataMaster = false;    ///< Filled from requested master data?
@@ -139,16 +141,16 @@ public:
         /// Fill stops from given origin/dest
         void setOrigDest (const std::string& o, const std::string& d);
         /// Origin = first stop on the route
-        const std::string& origin () const { return stops.empty() ? emptyStr : stops.front(); }
+        const std::string& origin () const { return stops.empty() ? emptyStr : stops.front().str(); }
         /// Destination = last stop on the route
-        const std::string& dest () const { return stops.size() < 2 ? emptyStr : stops.back(); }
+        const std::string& dest () const { return stops.size() < 2 ? emptyStr : stops.back().str(); }
         /// Lists all stops separated with dashes
         std::string route() const;
         // flight + route
         std::string flightRoute() const;
         // best guess for an airline livery: opIcao if exists, otherwise first 3 digits of call sign
         inline std::string airlineCode() const
-            { return opIcao.empty() ? call.substr(0,3) : opIcao; }
+            { return opIcao.empty() ? call.substr(0,3) : opIcao.str(); }
         /// is this a ground vehicle?
         bool isGrndVehicle() const;
         /// is this a static object? (marked by a/c type being TWR)
@@ -187,6 +189,8 @@ public:
         inline bool operator==(const FDKeyTy& o) const { return eKeyType == o.eKeyType && num == o.num; }
         inline bool operator!=(const FDKeyTy& o) const { return eKeyType != o.eKeyType || num != o.num; }
         inline bool operator<(const FDKeyTy& o) const { return eKeyType == o.eKeyType ? num < o.num : eKeyType < o.eKeyType; }
+        /// Key type and number packed into one 64-bit value, all that's needed for hashing and comparison
+        inline uint64_t packed() const { return (uint64_t(eKeyType) << 32) | uint64_t(num & 0xFFFFFFFFUL); }
 
         // imitate some (std::)string functionality
         inline bool operator==(const std::string o) const { return key == o; }
@@ -211,6 +215,7 @@ protected:
     int             sig;            // signal level
     
     std::string     labelStat;      // static part of the a/c label
+    unsigned long   labelStatVer = 0;   ///< incremented whenever `labelStat` is recomposed
     DataRefs::LabelCfgTy labelCfg = { 0,0,0,0,0,0,0,0, 0,0,0,0,0,0 };  // the configuration the label was saved for
     
 protected:
@@ -218,8 +223,12 @@ protected:
     // buffered positions / dynamic data as deque, sorted by timestamp
     // first element is oldest and current (the 'from' position/data)
     // second is pos a/c is currently headed for, and the others then further on into the future
-    dequePositionTy         posDeque, posToAdd;
+    dequePositionTy         posDeque;
+    dequePositionTy         posToAdd;           ///< new positions taken from the hand-off queue, to be analysed by AppendNewPos(), main thread only
+    unsigned                nPosQueued = 0;     ///< number of new positions still in the hand-off queue
+    double                  tsLastQueued = NAN; ///< timestamp of the latest position put into the hand-off queue
     dequeFDDynDataTy        dynDataDeque;
+    LTCtrKalmanTy           kf;                 ///< state estimator for dead-reckoning when live data is late, fed with live positions
     double                  rotateTS;
     double                  youngestTS;
     positionTy              posRwy;     ///< determined rwy (likely) to land on (position)
@@ -232,6 +241,8 @@ protected:
     // the simulated aircraft, which is based on this flight data
     // see Create/DestroyAircraft
     LTAircraft*             pAc;
+    /// Sim time before which no aircraft is to be (re)created, set when removing it at the range edge or to make room (hysteresis)
+    double                  tsAcHold = NAN;
     // Y probe reference
     XPLMProbeRef        probeRef;
     
@@ -245,16 +256,17 @@ public:
 public:
     // the lock we use to update / fetch data for thread safety
     mutable std::recursive_mutex   dataAccessMutex;
-    /// Export file for tracking data
-    static std::ofstream fileExport;
+    /// Export file for tracking data, written asynchronously and sorted by timestamp
+    static LTAsyncWriter fileExport;
     static double fileExportTsBase;         ///< when normalizing timestamps this is the base
 
     /// Cache for flight model in use, actually of type LTAircraft::FlightModel, but we can't forward-declare it here
     const void* pMdl = nullptr;
+    /// Cache for the CSL model last matched, so that re-creating the aircraft can skip model matching
+    std::string cslMdlCache;
+    /// Type, operator, and livery `cslMdlCache` was matched for
+    std::string cslMdlCacheKey;
     
-protected:
-    static std::string fileExportName;      ///< current export file's name
-
 protected:
     // find two positions around given timestamp ts (before <= ts < after)
     // pBefore and pAfter can come back NULL!
@@ -301,7 +313,35 @@ public:
 
     // produce a/c label
     void UpdateStaticLabel();
-    std::string ComposeLabel() const;
+    /// Label values at display precision, as last used for composing a label, to detect changes
+    struct LabelValsTy {
+        bool            bInit = false;      ///< composed at least once?
+        unsigned long   statVer = 0;        ///< version of the static label part
+        unsigned        cfg = 0;            ///< label configuration, see DataRefs::LabelCfgTy::GetUInt()
+        int             phase = 0;          ///< flight phase
+        long            heading = 0;        ///< [°] heading, rounded
+        long            alt = 0;            ///< [ft] altitude, rounded
+        long            height = 0;         ///< [ft] height AGL, `LONG_MIN` if on the ground
+        long            speed = 0;          ///< [kt] speed, rounded
+        long            vsi = 0;            ///< [ft/min] vertical speed, rounded
+
+        bool operator== (const LabelValsTy& o) const
+        { return bInit == o.bInit && statVer == o.statVer && cfg == o.cfg && phase == o.phase &&
+                 heading == o.heading && alt == o.alt && height == o.height &&
+                 speed == o.speed && vsi == o.vsi; }
+    };
+    /// @brief Compose the a/c label into `label`, but only if any value changed at display precision
+    /// @param[in,out] label The label, its buffer is reused
+    /// @param[in,out] vals The values `label` was composed for
+    /// @return Has `label` been rebuilt?
+    bool ComposeLabel (std::string& label, LabelValsTy& vals) const;
+    /// Label composition statistics
+    struct LabelStatsTy {
+        unsigned long   nRebuilt = 0;       ///< number of labels rebuilt since last reset
+        unsigned long   nSkipped = 0;       ///< number of labels left unchanged since last reset
+    };
+    /// Returns label composition statistics, optionally resets them
+    static LabelStatsTy GetLabelStats (bool bReset = false);
     
     // based on buffered positions calculate the next position to fly to in a separate thread
     void DataCleansing (bool& bChanged);
@@ -311,10 +351,24 @@ public:
     static void CalcNextPosMain ();
     void TriggerCalcNewPos ( double simTime );
 
+    /// Statistics of the position calculation queue
+    struct CalcQueueStatsTy {
+        size_t          len = 0;            ///< current queue length
+        unsigned long   cnt = 0;            ///< number of requests taken off the queue since last reset
+        double          avgWait_ms = 0.0;   ///< average time a request waited in the queue
+        double          maxWait_ms = 0.0;   ///< longest time a request waited in the queue
+    };
+    /// Returns statistics of the position calculation queue, optionally resets them
+    static CalcQueueStatsTy GetCalcQueueStats (bool bReset = false);
+
     // new pos read from data stream to be stored
-    void AddNewPos ( positionTy& pos ); // called from network thread, no terrain calc
-    static void AppendAllNewPos();      // called from main thread, can calc terrain
+    void AddNewPos ( positionTy& pos ); // called from network thread, no terrain calc, hands pos to main thread
+    static void AppendAllNewPos();      // called from main thread, drains the hand-off queue, can calc terrain
     void AppendNewPos();                // called from AppendAllNewPos
+    /// Feed a live position, and the dynamic data of the same time, to the state estimator
+    void KalmanUpdate (const positionTy& pos);
+    /// Live data is late: add a position dead-reckoned by the state estimator after `from`
+    void AddPredictedPos (const positionTy& from, double simTime, bool& bChanged);
 
     // check if thisPos would be OK after lastPos
     bool IsPosOK (const positionTy& lastPos,
@@ -377,23 +431,13 @@ public:
 
     // Export of tracking data
 protected:
-    /// Temporary storage for data to be written to the export file
-    struct ExportDataTy {
-        unsigned long ts = 0;
-        std::string s;
-        ExportDataTy (unsigned long _ts, const char* _s) : ts(_ts), s(_s) {}
-        bool operator> (const ExportDataTy& o) const { return ts > o.ts; }
-    };
-    /// Export data needs to be sorted by timestampe, written out only when that timestamp passed
-    typedef std::priority_queue<ExportDataTy, std::deque<ExportDataTy>, std::greater<ExportDataTy> > quExportTy;
-    static quExportTy quExport;             ///< the priority queue holding data to be exported for sorting
-    /// Coordinates writing into the export file to avoid lines overwriting
+    /// Coordinates opening/closing the export file
     static std::recursive_mutex exportFdMutex;
     /// Export Flight Data to a file LTExportFD.csv
     void ExportFD (const FDDynamicData& inDyn,
                    const positionTy& pos);
 public:
-    /// Moves a line to the export priority queue, flushes data which is ready to be written
+    /// Hands a line over to the export writer thread, which sorts by `ts` and writes once due
     static void ExportAddOutput (unsigned long ts, const char* s);
     /// Export Weather data record, based on DataRefs::GetWeather()
     static void ExportLastWeather ();
@@ -408,7 +452,11 @@ public:
     //
     
     // access/create/destroy aircraft
-    bool AircraftMaintenance ( double simTime );    // returns: delete me?
+    /// @brief Maintenance: destroys aircraft out of range, determines if an aircraft is due for creation
+    /// @param simTime Current simulated time
+    /// @param[out] createDist [m] Distance to camera if an aircraft is due for creation, `NAN` otherwise, see CreateAircraft()
+    /// @return Delete me?
+    bool AircraftMaintenance ( double simTime, double& createDist );
     bool DetermineAcModel ();                       ///< try interpreting model text or check for ground vehicle, last resort: default a/c type
     bool AcSlotAvailable ();                        ///< checks if there is a slot available to create this a/c, tries to remove the farest a/c if too many a/c rendered
     bool CreateAircraft ( double simTime );
@@ -426,29 +474,140 @@ public:
     friend Apt;
 };
 
-// global map of flight data, keyed by transpIcao
-typedef std::map<LTFlightData::FDKeyTy,LTFlightData>  mapLTFlightDataTy;
+/// Hash of a flight data key, only based on the packed numeric key
+struct FDKeyHashTy {
+    size_t operator() (const LTFlightData::FDKeyTy& k) const
+    { return std::hash<uint64_t>()(k.packed()); }
+};
+
+/// @brief Map of flight data within one segment of FDMapTy, hashed by key
+/// @note Unordered! Elements don't move (references stay valid) when the map grows
+typedef std::unordered_map<LTFlightData::FDKeyTy,LTFlightData,FDKeyHashTy>  mapLTFlightDataTy;
 
-// the global map of all received flight data,
-// which also includes pointer to the simulated aircraft
-extern mapLTFlightDataTy mapFd;
-// modifying the map is controlled by a mutex
-// (note that mapFdMutex must be locked before dataAccessMutex
-//  to avoid deadlocks, mapFdMutex is considered a higher-level lock)
-extern std::mutex      mapFdMutex;
+/// @brief The map of all flight data, sharded into lock-striped segments
+/// @details Flight data is distributed across `FD_MAP_SHARDS` segments by its numeric key,
+///          each segment with its own lock, so that channels updating different aircraft
+///          and the flight loop walking the map don't contend on one global lock.
+///          Flight data with the same number but different key types
+///          always share a segment (see LTFlightData::CheckDupKey()).\n
+///          Iterating functions lock one segment at a time.
+/// @note    Lock order: A segment's lock is to be acquired before LTFlightData::dataAccessMutex.
+///          Never _wait_ for another segment's lock while holding one.
+/// @note    Flight data is only ever removed by the main thread. The main thread
+///          can therefore keep pointers to flight data without holding a lock.
+class FDMapTy {
+public:
+    typedef std::recursive_mutex MutexTy;   ///< type of a segment's lock
+    typedef std::unique_lock<MutexTy> LockTy;   ///< lock on a segment
+    /// One segment: a lock and the map of flight data it guards
+    struct ShardTy {
+        MutexTy mtx;                        ///< guards `map`
+        mapLTFlightDataTy map;              ///< flight data in this segment
+    };
+protected:
+    std::array<ShardTy, FD_MAP_SHARDS> aShards; ///< all segments
+public:
+    /// The segment, in which flight data for the given key lives
+    ShardTy& Shard (const LTFlightData::FDKeyTy& k) { return aShards[k.num % FD_MAP_SHARDS]; }
+    /// Lock the segment of the given key
+    LockTy Lock (const LTFlightData::FDKeyTy& k) { return LockTy(Shard(k).mtx); }
+    /// Fetch or create flight data, the key's segment must be locked
+    LTFlightData& operator[] (const LTFlightData::FDKeyTy& k) { return Shard(k).map[k]; }
+    /// Find flight data, the key's segment must be locked, `nullptr` if not found
+    LTFlightData* Find (const LTFlightData::FDKeyTy& k)
+    {
+        mapLTFlightDataTy& m = Shard(k).map;
+        mapLTFlightDataTy::iterator i = m.find(k);
+        return i == m.end() ? nullptr : &i->second;
+    }
+    /// @brief Lock the key's segment just for finding flight data
+    /// @return Pointer to the flight data, only safe to use in the main thread, `nullptr` if not found
+    LTFlightData* FindMain (const LTFlightData::FDKeyTy& k)
+    {
+        std::lock_guard<MutexTy> lock (Shard(k).mtx);
+        return Find(k);
+    }
+    /// Is there flight data for the key? The key's segment must be locked
+    bool Contains (const LTFlightData::FDKeyTy& k) { return Shard(k).map.count(k) > 0; }
+    
+    /// Call `f(LTFlightData&)` for all flight data, locking one segment at a time
+    template <class F>
+    void ForEach (F f)
+    {
+        for (ShardTy& s: aShards) {
+            std::lock_guard<MutexTy> lock (s.mtx);
+            for (mapLTFlightDataTy::value_type& p: s.map)
+                f(p.second);
+        }
+    }
+    /// @brief Like ForEach(), but skips segments, which are locked by another thread
+    /// @return `false` if any segment had to be skipped
+    template <class F>
+    bool TryForEach (F f)
+    {
+        bool bAll = true;
+        for (ShardTy& s: aShards) {
+            LockTy lock (s.mtx, std::try_to_lock);
+            if (!lock) { bAll = false; continue; }
+            for (mapLTFlightDataTy::value_type& p: s.map)
+                f(p.second);
+        }
+        return bAll;
+    }
+    /// @brief Call `f(LTFlightData&)` for all flight data, locking one segment at a time, removes flight data for which `f` returns `true`
+    /// @note Only to be called from the main thread
+    template <class F>
+    void EraseIf (F f)
+    {
+        for (size_t idx = 0; idx < FD_MAP_SHARDS; ++idx)
+            EraseIfShard(idx, f);
+    }
+    /// @brief Like EraseIf(), but for the `idx`-th segment only, so that callers can spread the work
+    /// @return Number of flight data objects `f` was called for
+    /// @note Only to be called from the main thread
+    template <class F>
+    size_t EraseIfShard (size_t idx, F f)
+    {
+        ShardTy& s = aShards[idx];
+        std::lock_guard<MutexTy> lock (s.mtx);
+        const size_t n = s.map.size();
+        for (mapLTFlightDataTy::iterator i = s.map.begin(); i != s.map.end();) {
+            if (f(i->second))
+                i = s.map.erase(i);
+            else
+                ++i;
+        }
+        return n;
+    }
+    /// @brief Find the first flight data, for which `f(const LTFlightData&)` returns `true`, locking one segment at a time
+    /// @return Pointer to the flight data, only safe to use in the main thread, `nullptr` if not found
+    template <class F>
+    LTFlightData* FindIf (F f)
+    {
+        for (ShardTy& s: aShards) {
+            std::lock_guard<MutexTy> lock (s.mtx);
+            for (mapLTFlightDataTy::value_type& p: s.map)
+                if (f(p.second))
+                    return &p.second;
+        }
+        return nullptr;
+    }
+    
+    size_t size ();                         ///< total number of flight data objects, locks all segments one by one
+    bool empty () { return size() == 0; }   ///< no flight data at all?
+    void clear ();                          ///< remove all flight data, locks all segments one by one
+};
 
-/// @brief Returns the next flight data, which has a defined aircraft (pAc)
-/// @param iter Starting point
-inline mapLTFlightDataTy::iterator mapFdNextWithAc (mapLTFlightDataTy::iterator iter)
-{   return std::find_if(std::next(iter), mapFd.end(),
-                        [](const mapLTFlightDataTy::value_type& fd){return fd.second.hasAc();} );
-}
+/// @brief The global map of all received flight data,
+///        which also includes pointers to the simulated aircraft
+extern FDMapTy mapFd;
 
 /// @brief Find "i-th" aircraft, i.e. the i-th flight data with assigned pAc
 /// @param idx Index of aircraft to find, 1-based: pass in 1 to find the first
-mapLTFlightDataTy::iterator mapFdAcByIdx (int idx);
+/// @return Flight data or `nullptr`, to be used from the main thread only
+LTFlightData* mapFdAcByIdx (int idx);
 
 /// Find a/c by text, compares with key, call sigh, registration etc., passes pure numbers to mapFdAcByIdx()
-mapLTFlightDataTy::iterator mapFdSearchAc (const std::string& _s);
+LTFlightData* mapFdSearchAc (const std::string& _s);
 
 #endif /* LTFlightData_h */
@@ -353,6 +353,8 @@ protected:
     XPLMFlightLoopID flChangeWndMode = nullptr;
     // Last known in-sim position before moving out
     WndRect rectFloat;
+    /// Start of building and rendering the window, for the frame-time governor
+    std::chrono::steady_clock::time_point tDrawStart;
     
 public:
     /// Constructor sets up the window basically (no title, not visible yet)
@@ -375,6 +377,11 @@ public:
     bool ReturnKeyboardFocus ();
     
 protected:
+    /// Starts timing the window's building and rendering, subclasses overriding this must call it
+    ImGuiWindowFlags_ beforeBegin() override;
+    /// Records the window's building and rendering time with the frame-time governor
+    void afterRendering() override;
+
     /// Schedule the callback for window mode changes
     void ScheduleWndModeChange () { XPLMScheduleFlightLoop(flChangeWndMode, -1.0, 1); }
 
@@ -0,0 +1,100 @@
+/// @file       LTKalman.h
+/// @brief      State estimator for dead-reckoning aircraft when live data is late
+/// @details    A constant-turn-rate Kalman filter per aircraft, fed by the
+///             live positions and the accompanying speed, track, vertical speed,
+///             and (if the channel provides it) turn rate.
+///             From its state, positions can be predicted for some time ahead,
+///             so that aircraft keep moving along their track and turn
+///             until the next live position arrives.
+/// @author     Birger Hoppe
+/// @copyright  (c) 2024 Birger Hoppe
+/// @copyright  Permission is hereby granted, free of charge, to any person obtaining a
+///             copy of this software and associated documentation files (the "Software"),
+///             to deal in the Software without restriction, including without limitation
+///             the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the
+///             Software is furnished to do so, subject to the following conditions:\n
+///             The above copyright notice and this permission notice shall be included in
+///             all copies or substantial portions of the Software.\n
+///             THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///             IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///             FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///             AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///             LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///             OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+///             THE SOFTWARE.
+
+#ifndef LTKalman_h
+#define LTKalman_h
+
+#include <cmath>
+
+/// @brief Constant-turn-rate state estimator for one aircraft
+/// @details Horizontally an extended Kalman filter with the state
+///          east and north offset from a reference point, ground speed, track, and turn rate.
+///          Vertically a linear Kalman filter with the state altitude and vertical speed.
+///          Measurements are applied one value at a time, so no matrix inversion is needed.
+class LTCtrKalmanTy
+{
+public:
+    /// One set of measurements, values not available are `NAN`
+    struct MeasTy {
+        double ts       = NAN;          ///< timestamp
+        double lat      = NAN;          ///< [°] latitude
+        double lon      = NAN;          ///< [°] longitude
+        double alt_m    = NAN;          ///< [m] altitude
+        double spd_m_s  = NAN;          ///< [m/s] ground speed
+        double track    = NAN;          ///< [°] track (or heading, if that's all there is)
+        double turnRate = NAN;          ///< [°/s] rate of turn, negative = left
+        double vsi_m_s  = NAN;          ///< [m/s] vertical speed
+    };
+
+    /// A predicted state
+    struct PredTy {
+        double lat      = NAN;          ///< [°] latitude
+        double lon      = NAN;          ///< [°] longitude
+        double alt_m    = NAN;          ///< [m] altitude
+        double spd_m_s  = NAN;          ///< [m/s] ground speed
+        double track    = NAN;          ///< [°] track
+        double vsi_m_s  = NAN;          ///< [m/s] vertical speed
+    };
+
+protected:
+    /// Indexes into the horizontal state
+    enum { X_E = 0, X_N, X_V, X_PSI, X_OMEGA, NX };
+    /// Indexes into the vertical state
+    enum { Z_ALT = 0, Z_VSI, NZ };
+
+    double lat0 = NAN;                  ///< [°] reference point latitude, `NAN` if not initialized
+    double lon0 = NAN;                  ///< [°] reference point longitude
+    double ts = NAN;                    ///< timestamp of the state
+    double x[NX] = {};                  ///< horizontal state: east [m], north [m], speed [m/s], track [rad], turn rate [rad/s]
+    double P[NX][NX] = {};              ///< horizontal covariance
+    double z[NZ] = {};                  ///< vertical state: altitude [m], vertical speed [m/s]
+    double Pz[NZ][NZ] = {};             ///< vertical covariance
+
+public:
+    /// Has received measurements?
+    bool IsInit () const { return !std::isnan(lat0); }
+    /// Timestamp of the latest measurement
+    double GetTs () const { return ts; }
+    /// Forget everything
+    void Reset () { lat0 = lon0 = ts = NAN; }
+
+    /// Apply a set of measurements, ignored if not newer than the current state
+    void Update (const MeasTy& m);
+    /// Predict the state at time `t`, doesn't change the filter
+    PredTy Predict (double t) const;
+
+protected:
+    /// Initialize state from the first measurement
+    void Init (const MeasTy& m);
+    /// Move the state (and covariance) forward by `dt` seconds
+    void TimeUpdate (double dt);
+    /// Constant-turn-rate motion model: moves the horizontal state `s` forward by `dt` seconds
+    static void Propagate (double (&s)[NX], double dt);
+    /// Convert east/north offsets to latitude/longitude
+    void ToLatLon (double e, double n, double& lat, double& lon) const;
+};
+
+#endif /* LTKalman_h */
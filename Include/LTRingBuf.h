@@ -0,0 +1,400 @@
+/// @file       LTRingBuf.h
+/// @brief      Circular buffers: Inline storage replacing `std::deque` for position queues,
+///             and a lock-free queue handing data from network threads to the main thread
+/// @details    A `std::deque` allocates a chunk map plus a 512 byte block
+///             already when constructed, and then again whenever its queue moves
+///             across a block boundary. Flight data keeps its positions in queues,
+///             which are constantly appended at the end and consumed at the front,
+///             while only holding a handful of elements.\n
+///             LTRingBufTy keeps up to `N` elements inline in a circular buffer,
+///             so that these queues don't allocate at all in the usual case.
+///             Only when growing beyond `N` elements it moves to heap storage
+///             of twice the capacity.\n
+///             Iterators are random access, and behave like a `std::deque`'s
+///             in that they stay valid when removing at the front, and
+///             also when adding elements at either end (which a deque doesn't guarantee).
+///             Inserting or erasing in the middle invalidates iterators
+///             at and after the position (before for positions in the front half).
+///             Pointers and references stay valid until the element is removed,
+///             moved by insert/erase, or the buffer grows.\n
+///             LTMPSCQueueTy is a bounded, lock-free queue with many producers
+///             and one consumer, so that network threads can pass data to the
+///             flight loop without either side ever waiting for a lock.
+/// @author     Birger Hoppe
+/// @copyright  (c) 2024 Birger Hoppe
+/// @copyright  Permission is hereby granted, free of charge, to any person obtaining a
+///             copy of this software and associated documentation files (the "Software"),
+///             to deal in the Software without restriction, including without limitation
+///             the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the
+///             Software is furnished to do so, subject to the following conditions:\n
+///             The above copyright notice and this permission notice shall be included in
+///             all copies or substantial portions of the Software.\n
+///             THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///             IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///             FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///             AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///             LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///             OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+///             THE SOFTWARE.
+
+#ifndef LTRingBuf_h
+#define LTRingBuf_h
+
+#include <cstddef>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+
+/// @brief Circular buffer of `T` with inline capacity for `N` elements, heap storage only on overflow
+/// @details Elements are addressed by an ever increasing sequence number,
+///          of which the lower bits determine the slot in the buffer.
+///          `head` is the sequence number of the first element.
+///          Iterators store the container and the sequence number,
+///          that's why they survive removal at the front and growth.
+/// @tparam T Element type
+/// @tparam N Inline capacity, must be a power of 2
+template <class T, size_t N>
+class LTRingBufTy
+{
+    static_assert(N > 0 && (N & (N-1)) == 0, "Inline capacity of LTRingBufTy must be a power of 2");
+
+public:
+    typedef T                   value_type;
+    typedef size_t              size_type;
+    typedef std::ptrdiff_t      difference_type;
+    typedef T&                  reference;
+    typedef const T&            const_reference;
+    typedef T*                  pointer;
+    typedef const T*            const_pointer;
+
+    /// Random access iterator, `bConst` selects the `const_iterator`
+    template <bool bConst>
+    class IterTy {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T                               value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef std::conditional_t<bConst, const T*, T*>    pointer;
+        typedef std::conditional_t<bConst, const T&, T&>    reference;
+        typedef std::conditional_t<bConst, const LTRingBufTy*, LTRingBufTy*> ContainerPtrTy;
+    protected:
+        ContainerPtrTy pRing = nullptr;     ///< the container
+        size_t seq = 0;                     ///< sequence number of the element
+        friend class LTRingBufTy;
+        friend class IterTy<!bConst>;
+    public:
+        IterTy () {}
+        IterTy (ContainerPtrTy _pRing, size_t _seq) : pRing(_pRing), seq(_seq) {}
+        /// Conversion from `iterator` to `const_iterator`
+        template <bool bOtherConst, class = std::enable_if_t<bConst && !bOtherConst>>
+        IterTy (const IterTy<bOtherConst>& o) : pRing(o.pRing), seq(o.seq) {}
+
+        reference operator* () const { return pRing->slot(seq); }
+        pointer operator-> () const { return &pRing->slot(seq); }
+        reference operator[] (difference_type d) const { return pRing->slot(seq + size_t(d)); }
+
+        IterTy& operator++ () { ++seq; return *this; }
+        IterTy& operator-- () { --seq; return *this; }
+        IterTy operator++ (int) { IterTy i(*this); ++seq; return i; }
+        IterTy operator-- (int) { IterTy i(*this); --seq; return i; }
+        IterTy& operator+= (difference_type d) { seq += size_t(d); return *this; }
+        IterTy& operator-= (difference_type d) { seq -= size_t(d); return *this; }
+        IterTy operator+ (difference_type d) const { return IterTy(pRing, seq + size_t(d)); }
+        IterTy operator- (difference_type d) const { return IterTy(pRing, seq - size_t(d)); }
+        friend IterTy operator+ (difference_type d, const IterTy& i) { return i + d; }
+
+        // Differences and comparison are calculated in signed space, so that sequence numbers may wrap around
+        template <bool b2> difference_type operator- (const IterTy<b2>& o) const { return difference_type(seq - o.seq); }
+        template <bool b2> bool operator== (const IterTy<b2>& o) const { return seq == o.seq; }
+        template <bool b2> bool operator!= (const IterTy<b2>& o) const { return seq != o.seq; }
+        template <bool b2> bool operator<  (const IterTy<b2>& o) const { return (*this - o) <  0; }
+        template <bool b2> bool operator>  (const IterTy<b2>& o) const { return (*this - o) >  0; }
+        template <bool b2> bool operator<= (const IterTy<b2>& o) const { return (*this - o) <= 0; }
+        template <bool b2> bool operator>= (const IterTy<b2>& o) const { return (*this - o) >= 0; }
+    };
+    typedef IterTy<false>   iterator;           ///< iterator
+    typedef IterTy<true>    const_iterator;     ///< const iterator
+
+protected:
+    /// inline storage for up to `N` elements
+    alignas(T) unsigned char inlBuf[N * sizeof(T)];
+    T* buf = reinterpret_cast<T*>(inlBuf);      ///< current storage, inline or heap
+    size_t cap = N;                             ///< capacity of `buf`, always a power of 2
+    size_t head = 0;                            ///< sequence number of first element
+    size_t n = 0;                               ///< number of elements
+
+public:
+    /// Empty buffer, no allocation
+    LTRingBufTy () {}
+    /// Copy, allocates only if `o` holds more than `N` elements
+    LTRingBufTy (const LTRingBufTy& o) { *this = o; }
+    /// Move, takes over heap storage, or moves inline elements
+    LTRingBufTy (LTRingBufTy&& o) noexcept { *this = std::move(o); }
+    /// Destroys all elements, frees heap storage
+    ~LTRingBufTy () { clear(); }
+
+    /// Copy assignment
+    LTRingBufTy& operator= (const LTRingBufTy& o)
+    {
+        if (this != &o) {
+            clear();
+            reserve(o.n);
+            for (const T& e: o)
+                emplace_back(e);
+        }
+        return *this;
+    }
+
+    /// Move assignment
+    LTRingBufTy& operator= (LTRingBufTy&& o) noexcept
+    {
+        if (this != &o) {
+            clear();
+            if (o.isHeap()) {                   // steal heap storage
+                buf = o.buf;    cap = o.cap;
+                head = o.head;  n = o.n;
+                o.buf = o.inlBuf_T(); o.cap = N;
+                o.head = o.n = 0;
+            } else {                            // move inline elements one by one
+                for (T& e: o)
+                    emplace_back(std::move(e));
+                o.clear();
+            }
+        }
+        return *this;
+    }
+
+    // --- Iterators ---
+    iterator begin () { return iterator(this, head); }
+    iterator end () { return iterator(this, head + n); }
+    const_iterator begin () const { return const_iterator(this, head); }
+    const_iterator end () const { return const_iterator(this, head + n); }
+    const_iterator cbegin () const { return begin(); }
+    const_iterator cend () const { return end(); }
+
+    // --- Capacity ---
+    bool empty () const { return n == 0; }
+    size_t size () const { return n; }
+    size_t capacity () const { return cap; }
+    bool isHeap () const { return buf != inlBuf_T(); }  ///< has the buffer moved to the heap?
+
+    /// Make sure there is room for `c` elements
+    void reserve (size_t c)
+    {
+        if (c <= cap) return;
+        size_t newCap = cap;
+        while (newCap < c) newCap *= 2;
+        grow(newCap);
+    }
+
+    // --- Element access ---
+    T& operator[] (size_t i) { return slot(head + i); }
+    const T& operator[] (size_t i) const { return slot(head + i); }
+    T& front () { return slot(head); }
+    const T& front () const { return slot(head); }
+    T& back () { return slot(head + n - 1); }
+    const T& back () const { return slot(head + n - 1); }
+
+    // --- Modifiers ---
+
+    /// Construct a new element at the end
+    template <class... Args>
+    T& emplace_back (Args&&... args)
+    {
+        if (n == cap) grow(cap * 2);
+        T* p = ::new (static_cast<void*>(&slot(head + n))) T(std::forward<Args>(args)...);
+        ++n;
+        return *p;
+    }
+
+    /// Construct a new element at the front
+    template <class... Args>
+    T& emplace_front (Args&&... args)
+    {
+        if (n == cap) grow(cap * 2);
+        T* p = ::new (static_cast<void*>(&slot(head - 1))) T(std::forward<Args>(args)...);
+        --head;
+        ++n;
+        return *p;
+    }
+
+    void push_back (const T& v) { emplace_back(v); }
+    void push_back (T&& v) { emplace_back(std::move(v)); }
+    void push_front (const T& v) { emplace_front(v); }
+    void push_front (T&& v) { emplace_front(std::move(v)); }
+
+    /// Remove the first element
+    void pop_front ()
+    {
+        slot(head).~T();
+        ++head;
+        --n;
+    }
+
+    /// Remove the last element
+    void pop_back ()
+    {
+        slot(head + n - 1).~T();
+        --n;
+    }
+
+    /// Insert `v` before `pos`, moving the shorter side of the buffer
+    /// @return Iterator to the inserted element
+    iterator insert (const_iterator pos, const T& v)
+    {
+        const size_t idx = size_t(pos.seq - head);
+        if (idx < n / 2) {
+            emplace_front(v);
+            std::rotate(begin(), begin() + 1, begin() + difference_type(idx + 1));
+        } else {
+            emplace_back(v);
+            std::rotate(begin() + difference_type(idx), end() - 1, end());
+        }
+        return begin() + difference_type(idx);
+    }
+
+    /// Remove the element at `pos`, moving the shorter side of the buffer
+    /// @return Iterator to the element following the removed one
+    iterator erase (const_iterator pos)
+    {
+        const size_t idx = size_t(pos.seq - head);
+        if (idx < n / 2) {
+            std::move_backward(begin(), begin() + difference_type(idx), begin() + difference_type(idx + 1));
+            pop_front();
+        } else {
+            std::move(begin() + difference_type(idx + 1), end(), begin() + difference_type(idx));
+            pop_back();
+        }
+        return begin() + difference_type(idx);
+    }
+
+    /// Remove all elements, and return to inline storage
+    void clear ()
+    {
+        while (n > 0)
+            pop_back();
+        if (isHeap()) {
+            std::allocator<T>().deallocate(buf, cap);
+            buf = inlBuf_T();
+            cap = N;
+        }
+        head = 0;
+    }
+
+protected:
+    /// Element slot for a given sequence number
+    T& slot (size_t s) { return buf[s & (cap-1)]; }
+    const T& slot (size_t s) const { return buf[s & (cap-1)]; }
+    /// The inline buffer, typed
+    T* inlBuf_T () { return reinterpret_cast<T*>(inlBuf); }
+    const T* inlBuf_T () const { return reinterpret_cast<const T*>(inlBuf); }
+
+    /// Move to heap storage of the given capacity, elements keep their sequence numbers
+    void grow (size_t newCap)
+    {
+        T* newBuf = std::allocator<T>().allocate(newCap);
+        for (size_t s = head; s != head + n; ++s) {
+            T& e = slot(s);
+            ::new (static_cast<void*>(&newBuf[s & (newCap-1)])) T(std::move(e));
+            e.~T();
+        }
+        if (isHeap())
+            std::allocator<T>().deallocate(buf, cap);
+        buf = newBuf;
+        cap = newCap;
+    }
+};
+
+/// @brief Bounded lock-free queue with multiple producers and a single consumer
+/// @details Each cell carries a sequence number telling whether it is free
+///          for the producer of a given round or filled for the consumer.
+///          Producers claim a cell by advancing `enqPos` with compare-and-swap,
+///          then fill it and publish it by updating the cell's sequence number.
+///          The one consumer reads cells in order and frees them for the next round.
+///          Neither side ever blocks: push() fails if the queue is full,
+///          pop() fails if there is nothing (published) to take.
+/// @tparam T Element type, must be default constructible and move assignable
+/// @tparam N Capacity, must be a power of 2
+template <class T, size_t N>
+class LTMPSCQueueTy
+{
+    static_assert(N > 1 && (N & (N-1)) == 0, "Capacity of LTMPSCQueueTy must be a power of 2");
+
+protected:
+    /// One cell of the queue
+    struct CellTy {
+        std::atomic<size_t> seq;            ///< `pos` if free for the producer of `pos`, `pos+1` if filled for the consumer
+        T data;                             ///< the payload
+    };
+    std::unique_ptr<CellTy[]> cells;        ///< the cells, allocated once
+    alignas(64) std::atomic<size_t> enqPos {0};     ///< next position to fill (producers)
+    alignas(64) size_t deqPos = 0;                  ///< next position to take (consumer only)
+
+public:
+    /// Constructor allocates all cells
+    LTMPSCQueueTy () : cells(new CellTy[N])
+    {
+        for (size_t i = 0; i < N; ++i)
+            cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    // Not copyable nor movable, producers and consumer refer to the one object
+    LTMPSCQueueTy (const LTMPSCQueueTy&) = delete;
+    LTMPSCQueueTy& operator= (const LTMPSCQueueTy&) = delete;
+
+    /// Capacity
+    static constexpr size_t capacity () { return N; }
+
+    /// @brief Add an element, callable from any thread
+    /// @return `false` if the queue is full, the element is then not added
+    bool push (T&& v)
+    {
+        size_t pos = enqPos.load(std::memory_order_relaxed);
+        for (;;) {
+            CellTy& c = cells[pos & (N-1)];
+            const size_t seq = c.seq.load(std::memory_order_acquire);
+            const std::ptrdiff_t dif = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+            if (dif == 0) {
+                // cell is free for this round, try claiming it
+                if (enqPos.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed)) {
+                    c.data = std::move(v);
+                    c.seq.store(pos+1, std::memory_order_release);
+                    return true;
+                }
+                // another producer was faster, `pos` has been updated, retry
+            }
+            else if (dif < 0)
+                return false;               // cell still holds last round's element: full
+            else
+                pos = enqPos.load(std::memory_order_relaxed);
+        }
+    }
+    /// Add a copy of an element, callable from any thread
+    bool push (const T& v) { T cpy(v); return push(std::move(cpy)); }
+
+    /// @brief Take the oldest element, only to be called from the one consumer thread
+    /// @return `false` if the queue is empty
+    bool pop (T& v)
+    {
+        CellTy& c = cells[deqPos & (N-1)];
+        if (c.seq.load(std::memory_order_acquire) != deqPos+1)
+            return false;                   // not (yet) published
+        v = std::move(c.data);
+        c.seq.store(deqPos + N, std::memory_order_release);
+        ++deqPos;
+        return true;
+    }
+
+    /// Approximate number of elements, only to be called from the consumer thread
+    size_t size () const
+    {
+        const size_t e = enqPos.load(std::memory_order_relaxed);
+        return e > deqPos ? e - deqPos : 0;
+    }
+};
+
+#endif /* LTRingBuf_h */
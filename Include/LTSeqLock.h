@@ -0,0 +1,100 @@
+/// @file       LTSeqLock.h
+/// @brief      Sequence lock: One writer publishes a value, which any number of readers copy without locking
+/// @details    The writer increments a sequence counter before and after
+///             updating the value, so that the counter is odd while the update
+///             is in progress. Readers copy the value and compare the counter
+///             before and after, and copy again if it changed in between.
+///             Readers never block the writer, and never wait on each other.
+///             They only repeat their copy in the rare case of reading during
+///             an update, which is a copy of a few hundred bytes.\n
+///             The value is stored in relaxed atomic words, so that overlapping
+///             reads and writes are well-defined, which requires `T` to be
+///             trivially copyable.
+/// @author     Birger Hoppe
+/// @copyright  (c) 2024 Birger Hoppe
+/// @copyright  Permission is hereby granted, free of charge, to any person obtaining a
+///             copy of this software and associated documentation files (the "Software"),
+///             to deal in the Software without restriction, including without limitation
+///             the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the
+///             Software is furnished to do so, subject to the following conditions:\n
+///             The above copyright notice and this permission notice shall be included in
+///             all copies or substantial portions of the Software.\n
+///             THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///             IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///             FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///             AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///             LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///             OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+///             THE SOFTWARE.
+
+#ifndef LTSeqLock_h
+#define LTSeqLock_h
+
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <type_traits>
+
+/// @brief Value of type `T`, published by one writer, copied by any number of readers without locking
+/// @tparam T Trivially copyable value type
+/// @note There must be only one writer at a time
+template <class T>
+class LTSeqLockTy
+{
+    static_assert(std::is_trivially_copyable<T>::value, "LTSeqLockTy requires a trivially copyable type");
+
+protected:
+    /// number of words needed to store `T`
+    static constexpr size_t N_WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> seq {0};              ///< sequence counter, odd while an update is in progress
+    std::atomic<uint64_t> words[N_WORDS];       ///< the value, stored word by word
+
+public:
+    /// Stores a default-constructed `T`
+    LTSeqLockTy () { Store(T()); }
+    /// Stores the given value
+    LTSeqLockTy (const T& v) { Store(v); }
+    // not copyable
+    LTSeqLockTy (const LTSeqLockTy&) = delete;
+    LTSeqLockTy& operator= (const LTSeqLockTy&) = delete;
+
+    /// Publish a new value, returns its version
+    uint64_t Store (const T& v)
+    {
+        uint64_t buf[N_WORDS] = {0};
+        std::memcpy(buf, &v, sizeof(T));
+        const uint64_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s+1, std::memory_order_relaxed);              // odd: update in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < N_WORDS; ++i)
+            words[i].store(buf[i], std::memory_order_relaxed);
+        seq.store(s+2, std::memory_order_release);              // even: done
+        return (s+2) / 2;
+    }
+
+    /// @brief Copy the latest published value
+    /// @param[out] pVersion Optionally receives the value's version, which increases with every Store()
+    T Load (uint64_t* pVersion = nullptr) const
+    {
+        uint64_t buf[N_WORDS];
+        uint64_t s0, s1;
+        do {
+            s0 = seq.load(std::memory_order_acquire);
+            for (size_t i = 0; i < N_WORDS; ++i)
+                buf[i] = words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            s1 = seq.load(std::memory_order_relaxed);
+        } while ((s0 & 1) || s0 != s1);                         // update in progress or happened meanwhile? -> copy again
+        if (pVersion) *pVersion = s0 / 2;
+        T v;
+        std::memcpy(static_cast<void*>(&v), buf, sizeof(T));
+        return v;
+    }
+
+    /// Version of the latest published value
+    uint64_t GetVersion () const { return seq.load(std::memory_order_acquire) / 2; }
+};
+
+#endif /* LTSeqLock_h */
@@ -65,10 +65,13 @@
 #include <utility>
 #include <string>
 #include <array>
+#include <bitset>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <list>
 #include <deque>
+#include <fstream>
 #include <set>
 #include <thread>
 #include <future>
@@ -114,12 +117,14 @@
 
 // LiveTraffic Includes
 #include "Constants.h"
+#include "LTAtom.h"
 #include "DataRefs.h"
 
 // Global DataRef object, which also includes 'global' variables
 extern DataRefs dataRefs;
 
 #include "CoordCalc.h"
+#include "LTKalman.h"
 #include "TextIO.h"
 #include "LTFlightData.h"
 #include "LTAircraft.h"
@@ -262,6 +267,16 @@ inline std::string& trim(std::string& s, const char* t = WHITESPACE)
 
 /// trim whitespace
 inline std::string& trim_ws(std::string& s) { return trim(s); }
+/// trim an interned string, only interns new text if there actually is something to trim
+inline LTAtom& trim(LTAtom& a, const char* t = WHITESPACE)
+{
+    const std::string& s = a.str();
+    if (!s.empty() && (strchr(t, s.front()) || strchr(t, s.back()))) {
+        std::string cpy (s);
+        a = trim(cpy, t);
+    }
+    return a;
+}
 
 /// Cut off everything after `from` from `s`, `from` including
 std::string& cut_off(std::string& s, const std::string& from);
@@ -305,9 +320,15 @@ std::string Cleartext (const std::string& _obfuscated);
 
 // MARK: Time Functions
 
+/// @brief Optional replacement of the system clock, returning seconds since the epoch
+/// @details Only set by headless tools like `lt_replay_bench`, which replay data on an accelerated clock.
+///          `nullptr` (the default and the plugin's case) means the system clock is used.
+extern double (*gpfnSysTime)();
+
 /// System time in seconds with fractionals
 inline double GetSysTime ()
-{   return
+{   if (gpfnSysTime) return gpfnSysTime();
+    return
     // system time in microseconds
     double(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
     // divided by 1000000 to create seconds with fractionals
@@ -479,4 +500,63 @@ public:
     ~ThreadSettings();
 };
 
+// MARK: Stress Mode
+
+/// Processing stages, which are timed in stress mode (`livetraffic/dbg/stress_mode`)
+enum StressStageTy : unsigned {
+    STS_CHN_PROCESS = 0,        ///< channel thread: processing of received stream data (RealTraffic, ADSBHub)
+    STS_APPEND_NEW_POS,         ///< flight loop: LTFlightData::AppendAllNewPos()
+    STS_CALC_NEXT_POS,          ///< calculation thread: LTFlightData::CalcNextPos() for one aircraft
+    STS_AC_UPDATE,              ///< flight loop: LTAircraft::UpdatePosition() for one aircraft
+    STS_AC_MAINT,               ///< flight loop: LTFlightDataAcMaintenance() and LTFlightDataAcMaintenanceSlice()
+    STS_APT_REFRESH,            ///< flight loop: LTAptRefresh()
+    STS_CNT                     ///< always last: number of stages
+};
+
+/// Record one execution of a stage, thread-safe and lock-free
+void StressRecord (StressStageTy eStage, std::chrono::steady_clock::duration d);
+
+/// In stress mode, logs the stage timings collected during the last STRESS_LOG_INTVL seconds
+void StressLogTimings ();
+
+/// @brief Times the execution of a stage from construction to destruction, if stress mode is active
+class StressTimer {
+protected:
+    const StressStageTy eStage;                     ///< stage being timed
+    const bool bActive;                             ///< stress mode active when timing began?
+    std::chrono::steady_clock::time_point tStart;   ///< start of timing
+public:
+    /// Starts timing if stress mode is active
+    StressTimer (StressStageTy _stage) :
+    eStage(_stage), bActive(dataRefs.GetDebugStressMode())
+    { if (bActive) tStart = std::chrono::steady_clock::now(); }
+    /// Records the duration
+    ~StressTimer ()
+    { if (bActive) StressRecord(eStage, std::chrono::steady_clock::now() - tStart); }
+};
+
+// MARK: Frame-Time Governor
+
+/// Add main thread time spent in LiveTraffic, to be evaluated by GovEvaluate()
+void GovRecord (std::chrono::steady_clock::duration d);
+
+/// @brief Every GOV_EVAL_INTVL: determine LiveTraffic's main thread time per frame, and adjust the governor's level
+/// @details If the time per frame exceeds the budget (DataRefs::GetFrameBudget_ms())
+///          for GOV_HOLD_UP evaluations, the level is increased, which reduces
+///          max number of aircraft, level of detail distances, positions processed
+///          per frame, and label updates. Only when well below budget for GOV_HOLD_DOWN
+///          evaluations, the level is decreased again.
+void GovEvaluate ();
+
+/// @brief Adds main thread time from construction to destruction via GovRecord()
+/// @details Timers may nest, only the outermost one records, so that time isn't counted twice
+class GovTimer {
+protected:
+    const bool bOuter;                              ///< is this the outermost timer?
+    std::chrono::steady_clock::time_point tStart;   ///< start of timing
+public:
+    GovTimer ();                                    ///< Starts timing if outermost timer
+    ~GovTimer ();                                   ///< Records the duration if outermost timer
+};
+
 #endif /* LiveTraffic_h */
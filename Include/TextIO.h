@@ -24,6 +24,9 @@
 #define TextIO_h
 
 #include <stdexcept>
+#include <fstream>
+#include <queue>
+#include <condition_variable>
 
 /// @brief To apply printf-style warnings to our functions.
 /// @see Taken from imgui.h's definition of IM_FMTARGS
@@ -100,13 +103,15 @@ typedef std::list<LogMsgTy> LogMsgListTy;
 ///          throughout all operations, except deletions of the element.
 typedef std::list<LogMsgListTy::const_iterator> LogMsgIterListTy;
 
-/// The global list of log messages
+/// @brief The global list of log messages
+/// @details Only accessed from X-Plane's main thread, filled by FlushMsg()
 extern LogMsgListTy gLog;
 
-/// Add a message to the list, flush immediately if in main thread
+/// @brief Add a message to the calling thread's log buffer, flush immediately if in main thread
+/// @details Messages are rate-limited per call site to `LOG_RATE_MAX_PER_SEC`
 void LogMsg ( const char* szFile, int ln, const char* szFunc, logLevelTy lvl, const char* szMsg, ... ) LT_FMTARGS(5);
 
-/// Force writing of all not yet flushed messages
+/// Move all messages from all threads' buffers into `gLog` and write them to `Log.txt` (main thread only!)
 void FlushMsg ();
 
 /// @brief Remove old message
@@ -149,10 +154,89 @@ ImColor LogLvlColor (logLevelTy _lvl);
         THROW_ERROR(logFATAL,ERR_ASSERT,#cond);                     \
     }
 
+//
+// MARK: Asynchronous file writer
+//
+
+/// @brief Writes text to a file in a separate thread, so that callers never wait for disk I/O
+/// @details Any thread can Add() text without blocking: Lines are pushed onto a
+///          lock-free stack. The writer thread takes over all pending lines
+///          every `FILE_WRITE_INTVL_MS`, optionally sorts them by timestamp,
+///          and writes them in one block.
+///          Close() waits for Add() calls in progress before writing the last lines,
+///          so that no accepted line is lost.
+///          If configured (DataRefs::GetDebugFileRotateMB()) files are rotated by size.
+class LTAsyncWriter {
+protected:
+    /// One line (or block of text) to be written
+    struct LineTy {
+        unsigned long ts = 0;       ///< timestamp, if sorting then lines are written in `ts` order, and only once `ts` is close to sim time
+        std::string s;              ///< text to write, including any line feed
+        LineTy* pNext = nullptr;    ///< next element in the lock-free stack
+        LineTy (unsigned long _ts, std::string&& _s) : ts(_ts), s(std::move(_s)) {}
+        /// Order by timestamp, for use in std::priority_queue with std::greater
+        bool operator> (const LineTy& o) const { return ts > o.ts; }
+    };
+    /// Compares pointers to lines by the lines' timestamps
+    struct LinePtrGreater {
+        bool operator() (const LineTy* a, const LineTy* b) const { return *a > *b; }
+    };
+
+    const char* const szThrName;                ///< name of the writer thread
+    const bool bSortByTs;                       ///< sort lines by timestamp before writing?
+    std::atomic<LineTy*> pHead {nullptr};       ///< lock-free stack of lines not yet taken over by the writer thread
+    std::atomic<bool> bOpen {false};            ///< file open and accepting lines?
+    std::atomic<int> nAdding {0};               ///< number of Add() calls in progress, Close() waits for them
+    std::mutex mtxOpenClose;                    ///< serializes Open() and Close(), which may be called from any thread
+    std::thread thr;                            ///< the writer thread
+    std::mutex mtxStop;                         ///< protects `cvStop` (only used when stopping the thread)
+    std::condition_variable cvStop;             ///< wakes up the writer thread for stopping
+    std::atomic<bool> bStop {false};            ///< shall the writer thread stop?
+    std::string pathPattern;                    ///< file path, potentially with `strftime` formats
+    bool bTimeFmt = false;                      ///< does `pathPattern` contain `strftime` formats?
+    std::string fileName;                       ///< actual name of the currently open file
+    std::ofstream f;                            ///< the output file
+    size_t nBytesWritten = 0;                   ///< number of bytes written into current file
+    /// Lines waiting for their timestamp to become due (only if `bSortByTs`), accessed by writer thread only
+    std::priority_queue<LineTy*, std::vector<LineTy*>, LinePtrGreater> quSorted;
+
+public:
+    /// Constructor only sets up the object, does not yet open any file
+    LTAsyncWriter (const char* _thrName, bool _bSortByTs) :
+    szThrName(_thrName), bSortByTs(_bSortByTs) {}
+    /// Destructor makes sure the file is closed and all memory freed
+    ~LTAsyncWriter ();
+    
+    /// @brief Opens the file (appending) and starts the writer thread
+    /// @param _path File path, relative paths are relative to X-Plane's root
+    /// @param _bTimeFmt If `true` then `_path` is passed through `strftime`, rotated files will then get a new name
+    /// @return Success? If not, `errno` tells why
+    bool Open (const std::string& _path, bool _bTimeFmt);
+    /// Stops the writer thread, writes all remaining lines, closes the file; no-op if already closed
+    void Close ();
+    /// Is the file open?
+    bool IsOpen () const { return bOpen; }
+    /// Name of the currently open file
+    const std::string& GetFileName () const { return fileName; }
+    
+    /// @brief Adds text to be written, never blocks
+    /// @details Text added after Close() started, or after the file failed to reopen, is discarded
+    /// @param ts Timestamp, if sorting: written after sim time passed `ts - 5s`, otherwise ignored
+    /// @param s Text to write, must include line feeds as needed
+    void Add (unsigned long ts, std::string&& s);
+    
+protected:
+    void Main ();                               ///< writer thread's main function
+    void DoClose ();                            ///< Close() implementation, expects `mtxOpenClose` to be locked
+    bool OpenFile ();                           ///< opens `f` based on `pathPattern`
+    void WriteLines (bool bAll);                ///< takes over all pending lines and writes those which are due (or all)
+    void Rotate ();                             ///< closes and renames/reopens the file if it grew too large, stops the writer if reopening fails
+};
+
 // MARK: LiveTraffic Exception class
 class LTError : public std::logic_error {
 protected:
-    LogMsgListTy::iterator msgIter;
+    std::string msg;                ///< formatted message text
 public:
     LTError (const char* szFile, int ln, const char* szFunc, logLevelTy lvl,
              const char* szMsg, ...) LT_FMTARGS(6);
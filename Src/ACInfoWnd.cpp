@@ -127,15 +127,15 @@ std::string ACIWnd::GetWndTitle () const
 // Taking user's temporary input `keyEntry` searches for a valid a/c, sets acKey on success
 bool ACIWnd::SearchAndSetFlightData ()
 {
-    mapLTFlightDataTy::iterator fdIter = mapFd.end();
+    LTFlightData* pFd = nullptr;
     
     trim(keyEntry);
     if (!keyEntry.empty())
-        fdIter = mapFdSearchAc(keyEntry);
+        pFd = mapFdSearchAc(keyEntry);
     
     // found?
-    if (fdIter != mapFd.cend()) {
-        SetAcKey(fdIter->second.key());         // save the a/c key so we can start rendering its info
+    if (pFd) {
+        SetAcKey(pFd->key());                   // save the a/c key so we can start rendering its info
         return true;
     }
     
@@ -157,10 +157,8 @@ LTFlightData* ACIWnd::GetFlightData () const
     if (acKey.empty())
         return nullptr;
     
-    // find the flight data by key
-    mapLTFlightDataTy::iterator fdIter = mapFd.find(acKey);
-    // return flight data if found
-    return fdIter != mapFd.end() ? &fdIter->second : nullptr;
+    // find the flight data by key, return flight data if found
+    return mapFd.FindMain(acKey);
 }
 
 // switch to another focus a/c?
@@ -193,6 +191,9 @@ bool ACIWnd::UpdateFocusAc ()
 // Some setup before UI building starts, here text size calculations
 ImGuiWindowFlags_ ACIWnd::beforeBegin()
 {
+    // Parent class starts timing for the frame-time governor
+    LTImgWindow::beforeBegin();
+    
     // If not yet done calculate some common widths
     if (std::isnan(ACI_LABEL_SIZE)) {
         /// Size of longest text plus some room for tree indenttion, rounded up to the next 10
@@ -319,7 +320,7 @@ void ACIWnd::buildInterface()
             buildRow("Manufacturer",    stat.man,           pFD);
             buildRow("Model",           stat.mdl,           pFD);
             buildRow("Operator",
-                     stat.opIcao.empty() ? stat.op : stat.opIcao + ": " + stat.op,
+                     stat.opIcao.empty() ? stat.op.str() : stat.opIcao.str() + ": " + stat.op.str(),
                      pFD);
 
             // end of the tree
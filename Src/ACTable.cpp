@@ -95,56 +95,80 @@ std::array<ACTColDefTy,ACT_COL_COUNT> gCols {{
     {"Actions",         100,    ImGui::IM_ALIGN_LEFT,   ImGuiTableColumnFlags_NoSort},
 }};
 
+/// printf format of columns showing a numeric value, `nullptr` for text columns
+static const std::array<const char*,ACT_COL_COUNT> gColFmt = []()
+{
+    std::array<const char*,ACT_COL_COUNT> a;
+    a.fill(nullptr);
+    a[ACT_COL_LAT]      = "%.4f";
+    a[ACT_COL_LON]      = "%.4f";
+    a[ACT_COL_ALT]      = "%.f";
+    a[ACT_COL_AGL]      = "%.f";
+    a[ACT_COL_VSI]      = "%.f";
+    a[ACT_COL_SPEED]    = "%.f";
+    a[ACT_COL_TRACK]    = "%.f";
+    a[ACT_COL_HEADING]  = "%.f";
+    a[ACT_COL_PITCH]    = "%.1f";
+    a[ACT_COL_ROLL]     = "%.1f";
+    a[ACT_COL_BEARING]  = "%.f";
+    a[ACT_COL_DIST]     = "%.1f";
+    a[ACT_COL_LASTDATA] = "%+.f";
+    a[ACT_COL_GEAR]     = "%.f%%";
+    a[ACT_COL_FLAPS]    = "%.f%%";
+    a[ACT_COL_TCAS_IDX] = "%.f";
+    return a;
+}();
+
 //
 // MARK: FDInfo Implementation
 //
 
-FDInfo::FDInfo (const LTFlightData& fd)
+FDInfo::FDInfo ()
 {
     std::fill(vf.begin(), vf.end(), NAN);
+}
+
+FDInfo::FDInfo (const LTFlightData& fd) : FDInfo()
+{
     UpdateFrom(fd);
 }
 
 // Reads relevant data from the fd object
 bool FDInfo::UpdateFrom (const LTFlightData& fd)
 {
-    // buffer and macro for converting numeric data
-    char s[50];
-#define v_f(idx,fmt,val) vf[idx] = float(val); snprintf(s, sizeof(s), fmt, vf[idx]); v[idx] = s;
-
     bUpToDate = true;
-    v[ACT_COL_KEY] = key = fd.key();    // possible without lock
-    v[ACT_COL_KEY_TYPE]  = key.GetKeyTypeText();
+    key = fd.key();                     // possible without lock
+    SetV(ACT_COL_KEY,       key.key);
+    SetV(ACT_COL_KEY_TYPE,  key.GetKeyTypeText());
 
     // try fetching some static data
     LTFlightData::FDStaticData stat;
     if (fd.TryGetSafeCopy(stat)) {
-        v[ACT_COL_ID]           = stat.acId(v[ACT_COL_KEY]);
-        v[ACT_COL_REG]          = stat.reg;
-        v[ACT_COL_TYPE]         = stat.acTypeIcao;
-        v[ACT_COL_CLASS]        = Doc8643::get(stat.acTypeIcao).classification;
-        v[ACT_COL_MAN]          = stat.man;
-        v[ACT_COL_MDL]          = stat.mdl;
-        v[ACT_COL_CAT_DESCR]    = stat.catDescr;
-        v[ACT_COL_OP]           = stat.op;
-        v[ACT_COL_CALLSIGN]     = stat.call;
-        v[ACT_COL_FLIGHT]       = stat.flight;
-        v[ACT_COL_ROUTE]        = stat.route();
+        SetV(ACT_COL_ID,        stat.acId(key.key));
+        SetV(ACT_COL_REG,       stat.reg);
+        SetVa(ACT_COL_TYPE,     stat.acTypeIcao);
+        SetVa(ACT_COL_CLASS,    Doc8643::get(stat.acTypeIcao).classification);
+        SetVa(ACT_COL_MAN,      stat.man);
+        SetVa(ACT_COL_MDL,      stat.mdl);
+        SetVa(ACT_COL_CAT_DESCR,stat.catDescr);
+        SetVa(ACT_COL_OP,       stat.op);
+        SetV(ACT_COL_CALLSIGN,  stat.call);
+        SetV(ACT_COL_FLIGHT,    stat.flight);
+        SetV(ACT_COL_ROUTE,     stat.route());
     } else
         bUpToDate = false;
     
     // try fetching some dynamic data
     LTFlightData::FDDynamicData dyn;
     if (fd.TryGetSafeCopy(dyn)) {
-        v[ACT_COL_SQUAWK]       = std::to_string(dyn.radar.code);
+        SetV(ACT_COL_SQUAWK,    std::to_string(dyn.radar.code));
         if (dyn.pChannel) {
-            v[ACT_COL_CHANNEL]  = dyn.pChannel->ChName();
+            SetV(ACT_COL_CHANNEL,   dyn.pChannel->ChName());
             // last flight data / channel
-            v_f(ACT_COL_LASTDATA, "%+.f", fd.GetYoungestTS() - dataRefs.GetSimTime());
+            SetVf(ACT_COL_LASTDATA, fd.GetYoungestTS() - dataRefs.GetSimTime());
         } else {
-            v[ACT_COL_CHANNEL].clear();
-            v[ACT_COL_LASTDATA].clear();
-            vf[ACT_COL_LASTDATA] = NAN;
+            ClearCol(ACT_COL_CHANNEL);
+            ClearCol(ACT_COL_LASTDATA);
         }
     } else
         bUpToDate = false;
@@ -153,39 +177,37 @@ bool FDInfo::UpdateFrom (const LTFlightData& fd)
     // try fetching some actual flight data
     LTAircraft* pAc = fd.GetAircraft();
     if (pAc) {
-        v[ACT_COL_POS]          = pAc->RelativePositionText();
-        v_f(ACT_COL_LAT,    "%.4f",     pAc->GetPPos().lat());
-        v_f(ACT_COL_LON,    "%.4f",     pAc->GetPPos().lon());
-        v_f(ACT_COL_ALT,    "%.f",      pAc->GetAlt_ft());
-        v_f(ACT_COL_AGL,    "%.f",      pAc->GetPHeight_ft());
-        v_f(ACT_COL_VSI,    "%.f",      pAc->GetVSI_ft());
+        SetV(ACT_COL_POS,       pAc->RelativePositionText());
+        SetVf(ACT_COL_LAT,      pAc->GetPPos().lat());
+        SetVf(ACT_COL_LON,      pAc->GetPPos().lon());
+        SetVf(ACT_COL_ALT,      pAc->GetAlt_ft());
+        SetVf(ACT_COL_AGL,      pAc->GetPHeight_ft());
+        SetVf(ACT_COL_VSI,      pAc->GetVSI_ft());
         if (vf[ACT_COL_VSI] < -pAc->pMdl->VSI_STABLE)     // up/down arrow depending on value of VSI
-            v[ACT_COL_UPDOWN] = ICON_FA_CHEVRON_DOWN;
+            SetV(ACT_COL_UPDOWN, ICON_FA_CHEVRON_DOWN);
         else if (vf[ACT_COL_VSI] > pAc->pMdl->VSI_STABLE)
-            v[ACT_COL_UPDOWN] = ICON_FA_CHEVRON_UP;
+            SetV(ACT_COL_UPDOWN, ICON_FA_CHEVRON_UP);
         else
-            v[ACT_COL_UPDOWN].clear();
-        v_f(ACT_COL_SPEED,  "%.f",      pAc->GetSpeed_kt());
-        v_f(ACT_COL_TRACK,  "%.f",      pAc->GetTrack());
-        v_f(ACT_COL_HEADING,"%.f",      pAc->GetHeading());
-        v_f(ACT_COL_PITCH,  "%.1f",     pAc->GetPitch());
-        v_f(ACT_COL_ROLL,   "%.1f",     pAc->GetRoll());
-        v_f(ACT_COL_BEARING,"%.f",      pAc->GetCameraBearing());
-        v_f(ACT_COL_DIST,   "%.1f",     pAc->GetCameraDist() / M_per_NM);
+            ClearCol(ACT_COL_UPDOWN);
+        SetVf(ACT_COL_SPEED,    pAc->GetSpeed_kt());
+        SetVf(ACT_COL_TRACK,    pAc->GetTrack());
+        SetVf(ACT_COL_HEADING,  pAc->GetHeading());
+        SetVf(ACT_COL_PITCH,    pAc->GetPitch());
+        SetVf(ACT_COL_ROLL,     pAc->GetRoll());
+        SetVf(ACT_COL_BEARING,  pAc->GetCameraBearing());
+        SetVf(ACT_COL_DIST,     pAc->GetCameraDist() / M_per_NM);
         
-        v[ACT_COL_CSLMDL]       = pAc->GetModelName();
-        v[ACT_COL_PHASE]        = pAc->GetFlightPhaseRwyString();
-        vf[ACT_COL_PHASE]       = float(pAc->GetFlightPhase()); // sort flight phase by its index
-        v_f(ACT_COL_GEAR,   "%.f%%",    pAc->GetGearPos() * 100.0);
-        v_f(ACT_COL_FLAPS,  "%.f%%",    pAc->GetFlapsPos() * 100.0);
-        v[ACT_COL_LIGHTS]       = pAc->GetLightsStr();
-        if (pAc->IsCurrentlyShownAsTcasTarget()) {
-            v_f(ACT_COL_TCAS_IDX, "%.f", pAc->GetTcasTargetIdx());
-        } else {
-            vf[ACT_COL_TCAS_IDX] = NAN;
-            v[ACT_COL_TCAS_IDX].clear();
-        }
-        v[ACT_COL_FLIGHTMDL]    = pAc->pMdl->modelName;
+        SetV(ACT_COL_CSLMDL,    pAc->GetModelName());
+        SetV(ACT_COL_PHASE,     pAc->GetFlightPhaseRwyString());
+        SetVf(ACT_COL_PHASE,    double(pAc->GetFlightPhase())); // sort flight phase by its index
+        SetVf(ACT_COL_GEAR,     pAc->GetGearPos() * 100.0);
+        SetVf(ACT_COL_FLAPS,    pAc->GetFlapsPos() * 100.0);
+        SetV(ACT_COL_LIGHTS,    pAc->GetLightsStr());
+        if (pAc->IsCurrentlyShownAsTcasTarget())
+            SetVf(ACT_COL_TCAS_IDX, double(pAc->GetTcasTargetIdx()));
+        else
+            ClearCol(ACT_COL_TCAS_IDX);
+        SetV(ACT_COL_FLIGHTMDL, pAc->pMdl->modelName);
             
     }
     else {
@@ -198,29 +220,26 @@ bool FDInfo::UpdateFrom (const LTFlightData& fd)
                 ACT_COL_CSLMDL, ACT_COL_PHASE, ACT_COL_GEAR, ACT_COL_FLAPS,
                 ACT_COL_LIGHTS, ACT_COL_TCAS_IDX, ACT_COL_FLIGHTMDL
             })
-            { vf[idx] = NAN; v[idx].clear(); }
+                ClearCol(idx);
         }
         
         // We can try finding some positional information in the pos deque
         const dequePositionTy& posDeque = fd.GetPosDeque();
         if (!posDeque.empty()) {
             const positionTy& firstPos = posDeque.front();
-            v_f(ACT_COL_LAT,    "%.4f",     firstPos.lat());
-            v_f(ACT_COL_LON,    "%.4f",     firstPos.lon());
-            v_f(ACT_COL_ALT,    "%.f",      firstPos.alt_ft());
+            SetVf(ACT_COL_LAT,      firstPos.lat());
+            SetVf(ACT_COL_LON,      firstPos.lon());
+            SetVf(ACT_COL_ALT,      firstPos.alt_ft());
             const vectorTy vecCam = firstPos.between(dataRefs.GetViewPos());
-            v_f(ACT_COL_BEARING,"%.f",      vecCam.angle);
-            v_f(ACT_COL_DIST,   "%.1f",     vecCam.dist / M_per_NM);
-            if (!std::isnan(firstPos.heading())) {
-                v_f(ACT_COL_HEADING, "%.f", firstPos.heading());
-            }
-        }
-        if (!std::isnan(dyn.spd)) {
-            v_f(ACT_COL_SPEED,  "%.f",      dyn.spd);
-        }
-        if (!std::isnan(dyn.vsi)) {
-            v_f(ACT_COL_VSI,    "%.f",      dyn.vsi);
+            SetVf(ACT_COL_BEARING,  vecCam.angle);
+            SetVf(ACT_COL_DIST,     vecCam.dist / M_per_NM);
+            if (!std::isnan(firstPos.heading()))
+                SetVf(ACT_COL_HEADING, firstPos.heading());
         }
+        if (!std::isnan(dyn.spd))
+            SetVf(ACT_COL_SPEED,    dyn.spd);
+        if (!std::isnan(dyn.vsi))
+            SetVf(ACT_COL_VSI,      dyn.vsi);
     }
     
     // Have we successfully updated?
@@ -238,13 +257,67 @@ bool FDInfo::Update ()
 }
 
 
+// Convert those numeric values to text, which changed since last call
+void FDInfo::Format ()
+{
+    if (fmtDirty.none()) return;
+    char s[50];
+    for (size_t col = 0; col < ACT_COL_COUNT; ++col) {
+        if (!fmtDirty.test(col)) continue;
+        if (std::isnan(vf[col]))
+            v[col].clear();
+        else {
+            snprintf(s, sizeof(s), gColFmt[col], vf[col]);
+            v[col] = s;
+        }
+    }
+    fmtDirty.reset();
+}
+
+// Set a text value, remember if it changed
+void FDInfo::SetV (size_t col, const std::string& s)
+{
+    if (v[col] != s) {
+        v[col] = s;
+        changed.set(col);
+    }
+}
+
+// Set an interned text value, remember if it changed
+void FDInfo::SetVa (size_t col, const LTAtom& a)
+{
+    if (va[col] != a) {
+        va[col] = a;
+        changed.set(col);
+    }
+}
+
+// Set a numeric value, remember if it changed, conversion to text is deferred to Format()
+void FDInfo::SetVf (size_t col, double val)
+{
+    const float f = float(val);
+    // same bits means no change, which also covers NAN
+    if (std::memcmp(&f, &vf[col], sizeof(f)) == 0)
+        return;
+    vf[col] = f;
+    changed.set(col);
+    if (gColFmt[col])
+        fmtDirty.set(col);
+}
+
+// Clear a column's values
+void FDInfo::ClearCol (size_t col)
+{
+    SetVf(col, NAN);
+    if (!gColFmt[col])
+        SetV(col, std::string());
+}
+
 // Return the related LTFlightData object
 LTFlightData* FDInfo::GetFD () const
 {
-    // find the flight data by key
-    mapLTFlightDataTy::iterator fdIter = mapFd.find(key);
-    // return flight data if found
-    return fdIter != mapFd.end() ? &fdIter->second : nullptr;
+    // find the flight data by key, return flight data if found
+    return mapFd.FindMain(key);
 }
 
 // Does _any_ value match this filter string?
@@ -254,16 +327,55 @@ bool FDInfo::matches (const std::string& _s) const
     if (_s.empty()) return true;
     
     // Otherwise search all values
-    for (const std::string& val: v) {
-        std::string cpy(val);
-        str_toupper(cpy);
-        if (cpy.find(_s) != std::string::npos)
-            return true;
+    for (size_t col = 0; col < ACT_COL_COUNT; ++col) {
+        // interned values remember their upper-case variant, others need converting
+        if (!va[col].empty()) {
+            if (va[col].upper().find(_s) != std::string::npos)
+                return true;
+        } else {
+            std::string cpy(v[col]);
+            str_toupper(cpy);
+            if (cpy.find(_s) != std::string::npos)
+                return true;
+        }
     }
     return false;
 }
 
 
+//
+// MARK: FDInfoLessTy Implementation
+//
+
+// Constructor determines how to compare the column
+FDInfoLessTy::FDInfoLessTy (ACTColumnsTy _col, bool _asc) :
+col(_col), bAsc(_asc),
+// All right-aligned data is treated as numeric, using the numeric `vf` array,
+// so is the "flight phase", which gets sorted by its numeric value, too:
+bNum(gCols.at(_col).colAlign == ImGui::IM_ALIGN_RIGHT || _col == ACT_COL_PHASE)
+{}
+
+// Is `a` to be listed before `b`?
+bool FDInfoLessTy::operator() (const FDInfo* a, const FDInfo* b) const
+{
+    int cmp = 0;
+    if (bNum) {
+        const float af = a->vf[col]; const bool a_nan = std::isnan(af);
+        const float bf = b->vf[col]; const bool b_nan = std::isnan(bf);
+        if (a_nan != b_nan)             // one of them is NAN -> make NAN appear always at the end
+            return b_nan;
+        if (!a_nan)                     // standard case: both value defined
+            cmp = af < bf ? -1 : af > bf ? 1 : 0;
+    } else {
+        // equal atoms are identical, no need to compare their text
+        cmp = a->va[col] == b->va[col] ? a->v[col].compare(b->v[col]) : a->text(col).compare(b->text(col));
+    }
+    // in case of equality let the key decide for a stable sorting order
+    if (cmp == 0)
+        return bAsc ? a->key < b->key : b->key < a->key;
+    return bAsc ? cmp < 0 : cmp > 0;
+}
+
 //
 // MARK: ACTable Implementation
 //
@@ -306,15 +418,13 @@ LTFlightData* ACTable::build (const std::string& _filter, int _x, int _y)
         }
         ImGui::TableAutoHeaders();
 
-        // Set up a/c list
-        bool bUpdated = UpdateFDIs(_filter);
+        // Set up a/c list, updates keep the current sort order
+        UpdateFDIs(_filter);
 
-        // Sort the data if and as needed
+        // Sort the data if the sort order changed
         const ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs();
-        if (bUpdated ||
-            (sortSpecs && sortSpecs->SpecsChanged &&
-             sortSpecs->Specs && sortSpecs->SpecsCount >= 1 &&
-             vecFDI.size() > 1))
+        if (sortSpecs && sortSpecs->SpecsChanged &&
+            sortSpecs->Specs && sortSpecs->SpecsCount >= 1)
         {
             // We sort only by one column, no multi-column sort yet
             const ImGuiTableSortSpecsColumn& colSpec = *(sortSpecs->Specs);
@@ -322,130 +432,135 @@ LTFlightData* ACTable::build (const std::string& _filter, int _x, int _y)
                  colSpec.SortDirection == ImGuiSortDirection_Ascending);
         }
         
-        // Fill the data into the list
-        for (const FDInfo& fdi: vecFDI) {
-            ImGui::TableNextRow();
-            for (size_t col = 0; col < ACT_COL_COUNT; ++col) {
-                switch (col) {
-                    // There are a few columns with special treatment,
-                    case ACT_COL_UPDATE:
-                    case ACT_COL_ACTIONS:
-                        continue;
-                     // the others are just to be drawn
-                    default:
-                        if (ImGui::TableSetColumnIndex(int(col))) {
-                            ImGui::TextAligned(gCols[col].colAlign, fdi.v[col]);
-                        }
+        // Fill the data into the list, only the rows actually visible
+        ImGuiListClipper clipper (int(vecFDI.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                FDInfo& fdi = *vecFDI[size_t(row)];
+                fdi.Format();
+                ImGui::TableNextRow();
+                for (size_t col = 0; col < ACT_COL_COUNT; ++col) {
+                    switch (col) {
+                        // There are a few columns with special treatment,
+                        case ACT_COL_UPDATE:
+                        case ACT_COL_ACTIONS:
+                            continue;
+                         // the others are just to be drawn
+                        default:
+                            if (ImGui::TableSetColumnIndex(int(col))) {
+                                ImGui::TextAligned(gCols[col].colAlign, fdi.text(col));
+                            }
+                    }
                 }
-            }
-            
-            // --- prepare for columns with action buttons ---
-            
-            // Make sure all the buttons have a unique id
-            ImGui::PushID(fdi.key.c_str());
-            
-            // Make selected buttons more visible: Exchange Hovered (lighter) and std color (darker)
-            const ImU32 colHeader = ImGui::GetColorU32(ImGuiCol_Header);
-            ImGui::PushStyleColor(ImGuiCol_Header,          ImGui::GetColorU32(ImGuiCol_HeaderHovered));
-            ImGui::PushStyleColor(ImGuiCol_HeaderHovered,   colHeader);
-            
-            // Limit the width of the selectables
-            ImVec2 selSize (ImGui::GetWidthIconBtn(), 0.0f);
-            
-            // (Potential) access to the aircraft, can be `nullptr`!
-            LTFlightData* pFD = fdi.GetFD();
-            LTAircraft* pAc = pFD ? pFD->GetAircraft() : nullptr;
-            
-            // Update columnd
-            if (ImGui::TableSetColumnIndex(ACT_COL_UPDATE)) {
-                // Aircraft Profile update (if there is an ICAO key)
-                if (ImGui::SelectableTooltip(ICON_FA_PLANE "##AircraftProfile",
-                                             false,                                         // selected?
-                                             fdi.key.eKeyType == LTFlightData::KEY_ICAO,    // enabled?
-                                             "Update aircraft profile at OpenSky",
-                                             ImGuiSelectableFlags_None, selSize))
-                    LTOpenURL(OPSKY_EDIT_AC, fdi.key);
                 
-                // Route update (if there is a call sign)
-                ImGui::SameLine();
-                if (ImGui::SelectableTooltip(ICON_FA_ROUTE "##Route",
-                                             false,                                         // selected?
-                                             !fdi.v[ACT_COL_CALLSIGN].empty(),              // enabled?
-                                             "Update flight/route at OpenSky",
-                                             ImGuiSelectableFlags_None, selSize))
-                    LTOpenURL(OPSKY_EDIT_ROUTE, fdi.v[ACT_COL_CALLSIGN]);
-            }
-
-            // Action column
-            if (ImGui::TableSetColumnIndex(ACT_COL_ACTIONS)) {
-                // Is a/c visible/auto-visible?
-                bool bVisible       = pAc ? pAc->IsVisible()        : false;
-                bool bAutoVisible   = pAc ? pAc->IsAutoVisible()    : false;
-
-                // Open a/c info window
-                ACIWnd* pACIWnd = ACIWnd::GetWnd(fdi.key);
-                if (ImGui::SelectableTooltip(ICON_FA_INFO_CIRCLE "##ACIWnd",
-                                             pACIWnd != nullptr, true,              // selected?, enabled!
-                                             "Open Aircraft Info Window",
-                                             ImGuiSelectableFlags_None, selSize))
-                {
-                    // Toggle a/c info wnd (safe/restore our context as we are now dealing with another ImGui window,
-                    // which can mess up context pointers)
-                    ImGuiContext* pCtxt = ImGui::GetCurrentContext();
-                    if (pACIWnd) {
-                        delete pACIWnd;
-                        pACIWnd = nullptr;
-                    } else {
-                        ACIWnd::OpenNewWnd(fdi.key);
+                // --- prepare for columns with action buttons ---
+                
+                // Make sure all the buttons have a unique id
+                ImGui::PushID(fdi.key.c_str());
+                
+                // Make selected buttons more visible: Exchange Hovered (lighter) and std color (darker)
+                const ImU32 colHeader = ImGui::GetColorU32(ImGuiCol_Header);
+                ImGui::PushStyleColor(ImGuiCol_Header,          ImGui::GetColorU32(ImGuiCol_HeaderHovered));
+                ImGui::PushStyleColor(ImGuiCol_HeaderHovered,   colHeader);
+                
+                // Limit the width of the selectables
+                ImVec2 selSize (ImGui::GetWidthIconBtn(), 0.0f);
+                
+                // (Potential) access to the aircraft, can be `nullptr`!
+                LTFlightData* pFD = fdi.GetFD();
+                LTAircraft* pAc = pFD ? pFD->GetAircraft() : nullptr;
+                
+                // Update columnd
+                if (ImGui::TableSetColumnIndex(ACT_COL_UPDATE)) {
+                    // Aircraft Profile update (if there is an ICAO key)
+                    if (ImGui::SelectableTooltip(ICON_FA_PLANE "##AircraftProfile",
+                                                 false,                                         // selected?
+                                                 fdi.key.eKeyType == LTFlightData::KEY_ICAO,    // enabled?
+                                                 "Update aircraft profile at OpenSky",
+                                                 ImGuiSelectableFlags_None, selSize))
+                        LTOpenURL(OPSKY_EDIT_AC, fdi.key);
+                    
+                    // Route update (if there is a call sign)
+                    ImGui::SameLine();
+                    if (ImGui::SelectableTooltip(ICON_FA_ROUTE "##Route",
+                                                 false,                                         // selected?
+                                                 !fdi.v[ACT_COL_CALLSIGN].empty(),              // enabled?
+                                                 "Update flight/route at OpenSky",
+                                                 ImGuiSelectableFlags_None, selSize))
+                        LTOpenURL(OPSKY_EDIT_ROUTE, fdi.v[ACT_COL_CALLSIGN]);
+                }
+
+                // Action column
+                if (ImGui::TableSetColumnIndex(ACT_COL_ACTIONS)) {
+                    // Is a/c visible/auto-visible?
+                    bool bVisible       = pAc ? pAc->IsVisible()        : false;
+                    bool bAutoVisible   = pAc ? pAc->IsAutoVisible()    : false;
+
+                    // Open a/c info window
+                    ACIWnd* pACIWnd = ACIWnd::GetWnd(fdi.key);
+                    if (ImGui::SelectableTooltip(ICON_FA_INFO_CIRCLE "##ACIWnd",
+                                                 pACIWnd != nullptr, true,              // selected?, enabled!
+                                                 "Open Aircraft Info Window",
+                                                 ImGuiSelectableFlags_None, selSize))
+                    {
+                        // Toggle a/c info wnd (safe/restore our context as we are now dealing with another ImGui window,
+                        // which can mess up context pointers)
+                        ImGuiContext* pCtxt = ImGui::GetCurrentContext();
+                        if (pACIWnd) {
+                            delete pACIWnd;
+                            pACIWnd = nullptr;
+                        } else {
+                            ACIWnd::OpenNewWnd(fdi.key);
+                        }
+                        ImGui::SetCurrentContext(pCtxt);
+
+                        // Open an ACIWnd, which is another ImGui window, so safe/restore our context
                     }
-                    ImGui::SetCurrentContext(pCtxt);
 
-                    // Open an ACIWnd, which is another ImGui window, so safe/restore our context
-                }
+                    // Camera view
+                    ImGui::SameLine();
+                    if (ImGui::SelectableTooltip(ICON_FA_CAMERA "##CameraView",
+                                                 pAc ? pAc->IsInCameraView() : false,   // selected?
+                                                 pAc != nullptr,                        // enabled?
+                                                 "Toggle camera view",
+                                                 ImGuiSelectableFlags_None, selSize))
+                        pAc->ToggleCameraView();
 
-                // Camera view
-                ImGui::SameLine();
-                if (ImGui::SelectableTooltip(ICON_FA_CAMERA "##CameraView",
-                                             pAc ? pAc->IsInCameraView() : false,   // selected?
-                                             pAc != nullptr,                        // enabled?
-                                             "Toggle camera view",
-                                             ImGuiSelectableFlags_None, selSize))
-                    pAc->ToggleCameraView();
-
-                // Link to browser for following the flight
-                ImGui::SameLine();
-                const std::string url (pFD ? pFD->GetUnsafeStat().slug : "");
-                if (ImGui::SelectableTooltip(ICON_FA_EXTERNAL_LINK_SQUARE_ALT "##FlightURL",
-                                             false,                                 // selected?
-                                             !url.empty(),                          // enabled?
-                                             "Open flight in browser",
-                                             ImGuiSelectableFlags_None, selSize))
-                    LTOpenURL(url);
-                
-                // Visible
-                ImGui::SameLine();
-                if (ImGui::SelectableTooltip(ICON_FA_EYE "##Visible", &bVisible,
-                                             pAc != nullptr,      // enabled/disabled?
-                                             "Toggle aircraft's visibility",
-                                             ImGuiSelectableFlags_None, selSize))
-                    pAc->SetVisible(bVisible);
-
-                // "Auto Visible" only if some auto-hiding option is on
-                if (dataRefs.IsAutoHidingActive()) {
+                    // Link to browser for following the flight
                     ImGui::SameLine();
-                    if (ImGui::SelectableTooltip(ICON_FA_EYE "##AutoVisible", &bAutoVisible,
-                                                 pAc != nullptr,  // enabled/disabled
-                                                 "Toggle aircraft's auto visibility",
+                    const std::string url (pFD ? pFD->GetUnsafeStat().slug : "");
+                    if (ImGui::SelectableTooltip(ICON_FA_EXTERNAL_LINK_SQUARE_ALT "##FlightURL",
+                                                 false,                                 // selected?
+                                                 !url.empty(),                          // enabled?
+                                                 "Open flight in browser",
                                                  ImGuiSelectableFlags_None, selSize))
-                        pAc->SetAutoVisible(bAutoVisible);
-                }
-            } // action column
+                        LTOpenURL(url);
+                    
+                    // Visible
+                    ImGui::SameLine();
+                    if (ImGui::SelectableTooltip(ICON_FA_EYE "##Visible", &bVisible,
+                                                 pAc != nullptr,      // enabled/disabled?
+                                                 "Toggle aircraft's visibility",
+                                                 ImGuiSelectableFlags_None, selSize))
+                        pAc->SetVisible(bVisible);
+
+                    // "Auto Visible" only if some auto-hiding option is on
+                    if (dataRefs.IsAutoHidingActive()) {
+                        ImGui::SameLine();
+                        if (ImGui::SelectableTooltip(ICON_FA_EYE "##AutoVisible", &bAutoVisible,
+                                                     pAc != nullptr,  // enabled/disabled
+                                                     "Toggle aircraft's auto visibility",
+                                                     ImGuiSelectableFlags_None, selSize))
+                            pAc->SetAutoVisible(bAutoVisible);
+                    }
+                } // action column
 
-            // Restore styles
-            ImGui::PopStyleColor(2);
-            ImGui::PopID();
+                // Restore styles
+                ImGui::PopStyleColor(2);
+                ImGui::PopID();
 
-        }   // for all a/c rows
+            }   // for all visible a/c rows
+        }
         
         // End of aircraft list
         ImGui::EndTable();
@@ -459,41 +574,75 @@ LTFlightData* ACTable::build (const std::string& _filter, int _x, int _y)
 bool ACTable::UpdateFDIs (const std::string& _filter)
 {
     // short-cut in case of no change
+    const bool bFilterChanged = _filter != filterInUse || bFilterAcOnly != bAcOnlyInUse;
     if (!CheckEverySoOften(lastUpdate, ACT_AC_UPDATE_PERIOD) &&
-        _filter == filterInUse &&
-        bFilterAcOnly == bAcOnlyInUse)
+        !bFilterChanged)
         return false;
     filterInUse = _filter;
     bAcOnlyInUse = bFilterAcOnly;
+    ++gen;
+    
+    // First pass: Update all rows and remember those we couldn't get
+    std::vector<FDInfo*> vecAgain;
+    mapFd.ForEach([&](const LTFlightData& fd)
+    {
+        // First filter: Visible a/c only? (Rows not updated will be removed below)
+        if (bFilterAcOnly && (!fd.hasAc() || !fd.GetAircraft()->IsVisible()))
+            return;
+        FDInfo& fdi = mapFDI[fd.key()];
+        fdi.gen = gen;
+        if (!fdi.UpdateFrom(fd))
+            vecAgain.push_back(&fdi);
+    });
+    
+    // Second pass: Try those again, which couldn't yet fully update
+    for (FDInfo* pFdi: vecAgain)
+        pFdi->Update();
     
-    // Walk all aircraft, test for match, then add
-    vecFDI.clear();
-    if (filterInUse.empty())        // reserve storage (if no filter defined)
-        vecFDI.reserve(mapFd.size());
+    // Test rows for the filter, which requires their texts
+    for (auto& p: mapFDI) {
+        FDInfo& fdi = p.second;
+        if (fdi.gen != gen) continue;
+        if (!filterInUse.empty())
+            fdi.Format();
+        fdi.bMatch = fdi.matches(filterInUse);
+    }
     
-    // First pass: Add all matching and remember those we couldn't get
-    std::vector<FDInfo> vecAgain;
-    for (const mapLTFlightDataTy::value_type& p: mapFd) {
-        // First filter: Visible a/c only?
-        if (bFilterAcOnly && (!p.second.hasAc() || !p.second.GetAircraft()->IsVisible()))
+    // Rows keep their place in the list if still there, matching, and if their sort value didn't change
+    std::vector<FDInfo*> vecNew;
+    vecNew.reserve(mapFDI.size());
+    for (FDInfo* pFdi: vecFDI) {
+        if (pFdi->gen != gen)               // to be removed below
             continue;
-        // others: test if filter matches
-        FDInfo fdi(p.second);
-        if (fdi.upToDate()) {
-            if (fdi.matches(filterInUse))
-                vecFDI.emplace_back(std::move(fdi));
-        } else {
-            vecAgain.emplace_back(std::move(fdi));
-        }
+        if (pFdi->bMatch && !bFilterChanged && !pFdi->changed.test(sortCol))
+            vecNew.push_back(pFdi);
+        else
+            pFdi->bListed = false;
     }
+    const std::ptrdiff_t nKept = std::ptrdiff_t(vecNew.size());
     
-    // Second pass: Try those again, which couldn't yet fully update
-    for (FDInfo& fdi: vecAgain) {
-        fdi.Update();
-        if (fdi.matches(filterInUse))
-            vecFDI.emplace_back(std::move(fdi));
+    // Remove rows of flight data, which is gone,
+    // collect all other matching rows not yet listed
+    for (auto iter = mapFDI.begin(); iter != mapFDI.end();) {
+        FDInfo& fdi = iter->second;
+        if (fdi.gen != gen) {
+            iter = mapFDI.erase(iter);
+            continue;
+        }
+        if (fdi.bMatch && !fdi.bListed) {
+            vecNew.push_back(&fdi);
+            fdi.bListed = true;
+        }
+        fdi.changed.reset();
+        ++iter;
     }
     
+    // Sort the new rows and merge them in
+    const FDInfoLessTy less (sortCol, bSortAsc);
+    std::sort(vecNew.begin() + nKept, vecNew.end(), less);
+    std::inplace_merge(vecNew.begin(), vecNew.begin() + nKept, vecNew.end(), less);
+    vecFDI.swap(vecNew);
+    
     // Did do an update
     return true;
 }
@@ -501,34 +650,7 @@ bool ACTable::UpdateFDIs (const std::string& _filter)
 // Sort the aircraft list by given column
 void ACTable::Sort (ACTColumnsTy _col, bool _asc)
 {
-    // All right-aligned data is treated as numeric, using the numeric `vf` array,
-    // so is the "flight phase", which gets sorted by its numeric value, too:
-    if (gCols.at(_col).colAlign == ImGui::IM_ALIGN_RIGHT ||
-        _col == ACT_COL_PHASE) {
-        std::sort(vecFDI.begin(), vecFDI.end(),
-                  [_col,_asc](const FDInfo& a, const FDInfo& b)
-        {
-            const float af = a.vf[_col]; const bool a_nan = std::isnan(af);
-            const float bf = b.vf[_col]; const bool b_nan = std::isnan(bf);
-            if (!a_nan && !b_nan)       // standard case: both value defined
-                return af < bf;
-            if (a_nan && b_nan)         // both NAN -> considered equal, for a stable sort let the key decide
-                return a.key < b.key;
-            return a_nan != _asc;       // one of them is NAN -> make NAN appear always at the end
-        });
-    } else {
-        // otherwise we sort by text
-        std::sort(vecFDI.begin(), vecFDI.end(),
-                  [_col](const FDInfo& a, const FDInfo& b)
-        {
-            const int cmp = a.v[_col].compare(b.v[_col]);
-            return
-            cmp == 0 ? a.key < b.key :  // in case of equality let the key decide for a stable sorting order
-            cmp < 0;
-        });
-    }
-    
-    // Sort descending?
-    if (!_asc)
-        std::reverse(vecFDI.begin(), vecFDI.end());
+    sortCol = _col;
+    bSortAsc = _asc;
+    std::sort(vecFDI.begin(), vecFDI.end(), FDInfoLessTy(sortCol, bSortAsc));
 }
@@ -0,0 +1,229 @@
+/// @file       LTAptBench.cpp
+/// @brief      `lt_apt_bench`: Time to build the taxi networks of large airports from `apt.dat`
+/// @details    Reads one `apt.dat` file repeatedly, as the `LT_ReadApt` thread does,
+///             and reports how long it took to build all airports' taxi networks,
+///             followed by the largest airports by number of taxi edges.
+///             The first run includes building the file's index of airports,
+///             later runs reuse it like later refreshes in X-Plane do.\n
+///             Without `--apt` the bench writes a synthetic excerpt first:
+///             One mega airport with a grid of 120-series taxi centerlines
+///             plus gate lead-ins ending in open nodes, which need joining,
+///             and one airport of the same size defined by a 1200-series taxi route network.
+/// @author     Birger Hoppe
+/// @copyright  (c) 2024 Birger Hoppe
+/// @copyright  Permission is hereby granted, free of charge, to any person obtaining a
+///             copy of this software and associated documentation files (the "Software"),
+///             to deal in the Software without restriction, including without limitation
+///             the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the
+///             Software is furnished to do so, subject to the following conditions:\n
+///             The above copyright notice and this permission notice shall be included in
+///             all copies or substantial portions of the Software.\n
+///             THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///             IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///             FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///             AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///             LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///             OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+///             THE SOFTWARE.
+
+#include "LiveTraffic.h"
+
+#include <filesystem>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// Replacements for what LiveTraffic.cpp provides: see LTBenchStubs.cpp
+
+//
+// MARK: Configuration
+//
+
+/// Bench parameters as per command line
+struct BenchCfgTy {
+    std::string sAptDat;                ///< `apt.dat` file to read, synthetic excerpt if empty
+    int         nLines = 40;            ///< synthetic excerpt: number of taxiways in each direction
+    int         nRepeat = 3;            ///< number of times the file is read
+    size_t      nTop = 10;              ///< number of airports listed in the result
+};
+static BenchCfgTy cfg;                  ///< the bench's configuration
+
+/// Print usage info
+static void Usage (const char* prog)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --apt <file>        apt.dat file to read (default: synthetic excerpt)\n"
+        "  --lines <n>         synthetic excerpt: taxiways in each direction (default: %d)\n"
+        "  --repeat <n>        number of times the file is read (default: %d)\n"
+        "  --top <n>           number of largest airports listed (default: %lu)\n",
+        prog, cfg.nLines, cfg.nRepeat, (unsigned long)cfg.nTop);
+}
+
+/// Parse command line
+static bool ParseArgs (int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool bHasVal = i+1 < argc;
+        if      (arg == "--apt"    && bHasVal) cfg.sAptDat = argv[++i];
+        else if (arg == "--lines"  && bHasVal) cfg.nLines = std::stoi(argv[++i]);
+        else if (arg == "--repeat" && bHasVal) cfg.nRepeat = std::stoi(argv[++i]);
+        else if (arg == "--top"    && bHasVal) cfg.nTop = std::stoul(argv[++i]);
+        else return false;
+    }
+    return cfg.nLines > 1 && cfg.nRepeat > 0;
+}
+
+//
+// MARK: Synthetic apt.dat excerpt
+//
+
+constexpr double BENCH_TAXI_SPACING_M = 150.0;  ///< [m] distance between parallel taxiways
+constexpr double BENCH_NODE_SPACING_M = 30.0;   ///< [m] distance between nodes along a taxiway
+constexpr double BENCH_GATE_LEN_M     = 60.0;   ///< [m] length of a gate lead-in
+constexpr double BENCH_GATE_GAP_M     = 8.0;    ///< [m] gap between a gate lead-in's open end and its taxiway
+
+/// Converts local meters to lat/lon around a reference point
+struct LocalGridTy {
+    double lat0, lon0;                  ///< reference point, south-west corner
+    double mLat, mLon;                  ///< [m] per degree latitude/longitude
+    LocalGridTy (double _lat, double _lon) :
+    lat0(_lat), lon0(_lon),
+    mLat(111120.0), mLon(111120.0 * std::cos(deg2rad(_lat))) {}
+    double lat (double y_m) const { return lat0 + y_m / mLat; }
+    double lon (double x_m) const { return lon0 + x_m / mLon; }
+};
+
+/// Airport header and one runway along the southern edge
+static void WriteAptHeader (std::ostream& out, const LocalGridTy& g,
+                            const char* id, const char* name, double len_m)
+{
+    out << "1 600 1 0 " << id << ' ' << name << "\n";
+    out << "100 60.00 1 0 0.25 1 3 0 09 "
+        << g.lat(-200.0) << ' ' << g.lon(0.0)   << " 0 0 2 0 0 0 27 "
+        << g.lat(-200.0) << ' ' << g.lon(len_m) << " 0 0 2 0 0 0\n";
+}
+
+/// @brief Airport with a grid of 120-series taxi centerlines
+/// @details Taxiways cross at shared nodes. Every second node of the east-west taxiways
+///          has a gate lead-in going north, which starts a few meters off the taxiway,
+///          so that its open end needs to be joined to the taxiway's edge.
+static void WriteCenterlineApt (std::ostream& out, const LocalGridTy& g, int n)
+{
+    const double len_m = BENCH_TAXI_SPACING_M * (n-1);
+    const int nNodes = int(len_m / BENCH_NODE_SPACING_M) + 1;
+    WriteAptHeader(out, g, "XCTL", "Synthetic centerline airport", len_m);
+
+    for (int i = 0; i < n; ++i) {
+        const double fix_m = BENCH_TAXI_SPACING_M * i;
+        // east-west taxiway
+        out << "120 Taxiway E" << i << "\n";
+        for (int j = 0; j < nNodes; ++j)
+            out << (j+1 < nNodes ? "111 " : "115 ")
+                << g.lat(fix_m) << ' ' << g.lon(BENCH_NODE_SPACING_M * j)
+                << (j+1 < nNodes ? " 1\n" : "\n");
+        // north-south taxiway
+        out << "120 Taxiway N" << i << "\n";
+        for (int j = 0; j < nNodes; ++j)
+            out << (j+1 < nNodes ? "111 " : "115 ")
+                << g.lat(BENCH_NODE_SPACING_M * j) << ' ' << g.lon(fix_m)
+                << (j+1 < nNodes ? " 1\n" : "\n");
+        // gate lead-ins north of the east-west taxiway
+        if (i+1 < n) {
+            out << "120 Gates G" << i << "\n";
+            for (int j = 1; j+1 < nNodes; j += 2) {
+                const double x_m = BENCH_NODE_SPACING_M * j + BENCH_NODE_SPACING_M / 2.0;
+                out << "111 " << g.lat(fix_m + BENCH_GATE_GAP_M) << ' ' << g.lon(x_m) << " 1\n"
+                    << "115 " << g.lat(fix_m + BENCH_GATE_LEN_M) << ' ' << g.lon(x_m) << "\n";
+            }
+        }
+    }
+}
+
+/// Airport of the same size with a 1200-series taxi route network
+static void WriteTaxiRouteApt (std::ostream& out, const LocalGridTy& g, int n)
+{
+    const double len_m = BENCH_TAXI_SPACING_M * (n-1);
+    const int nNodes = int(len_m / BENCH_NODE_SPACING_M) + 1;
+    WriteAptHeader(out, g, "XRTE", "Synthetic taxi route airport", len_m);
+
+    out << "1200\n";
+    for (int y = 0; y < nNodes; ++y)
+        for (int x = 0; x < nNodes; ++x)
+            out << "1201 " << g.lat(BENCH_NODE_SPACING_M * y) << ' ' << g.lon(BENCH_NODE_SPACING_M * x)
+                << " both " << (y * nNodes + x) << "\n";
+    for (int y = 0; y < nNodes; ++y)
+        for (int x = 0; x < nNodes; ++x) {
+            const int idx = y * nNodes + x;
+            if (x+1 < nNodes) out << "1202 " << idx << ' ' << idx+1 << " twoway taxiway\n";
+            if (y+1 < nNodes) out << "1202 " << idx << ' ' << idx+nNodes << " twoway taxiway\n";
+        }
+}
+
+/// Write the synthetic `apt.dat` excerpt, returns its path
+static std::string WriteSyntheticAptDat ()
+{
+    const fs::path path = fs::temp_directory_path() / ("lt_apt_bench_" + std::to_string(getpid()) + ".dat");
+    std::ofstream out (path);
+    out.precision(10);
+    out << "I\n1100 Generated by lt_apt_bench\n\n";
+    WriteCenterlineApt(out, LocalGridTy(32.88, -97.06), cfg.nLines);
+    WriteTaxiRouteApt (out, LocalGridTy(39.49, 116.40), cfg.nLines);
+    out << "99\n";
+    return path.string();
+}
+
+//
+// MARK: Main
+//
+
+int main (int argc, char* argv[])
+{
+    if (!ParseArgs(argc, argv)) {
+        Usage(argv[0]);
+        return 1;
+    }
+    const bool bSynthetic = cfg.sAptDat.empty();
+    const std::string sAptDat = bSynthetic ? WriteSyntheticAptDat() : cfg.sAptDat;
+
+    // The entire world
+    const boundingBoxTy box (positionTy(90.0, -180.0), positionTy(-90.0, 180.0));
+
+    // Read the file the given number of times, from scratch each time
+    printf("Reading %s\n", sAptDat.c_str());
+    printf("%-8s %10s %14s\n", "run", "airports", "time [ms]");
+    double tMin = 0.0, tSum = 0.0;
+    for (int r = 0; r < cfg.nRepeat; ++r) {
+        LTAptDisable();
+        const auto t0 = std::chrono::steady_clock::now();
+        const int nApt = LTAptReadFile(sAptDat, box);
+        const double ms = std::chrono::duration<double,std::milli>(std::chrono::steady_clock::now() - t0).count();
+        if (nApt < 0) return 2;
+        printf("%-8d %10d %14.1f\n", r+1, nApt, ms);
+        tSum += ms;
+        if (r == 0 || ms < tMin) tMin = ms;
+    }
+    printf("%-8s %10s %14.1f\n", "average", "", tSum / cfg.nRepeat);
+    printf("%-8s %10s %14.1f\n", "minimum", "", tMin);
+
+    // The largest airports
+    std::vector<LTAptInfoTy> vApt = LTAptList();
+    std::sort(vApt.begin(), vApt.end(),
+              [](const LTAptInfoTy& a, const LTAptInfoTy& b)
+              { return a.nEdges > b.nEdges; });
+    if (vApt.size() > cfg.nTop)
+        vApt.resize(cfg.nTop);
+    printf("\n%-8s %10s %10s\n", "airport", "nodes", "edges");
+    for (const LTAptInfoTy& apt: vApt)
+        printf("%-8s %10lu %10lu\n", apt.id.c_str(),
+               (unsigned long)apt.nNodes, (unsigned long)apt.nEdges);
+
+    LTAptDisable();
+    if (bSynthetic) {
+        std::error_code ec;
+        fs::remove(sAptDat, ec);
+    }
+    return 0;
+}
@@ -0,0 +1,43 @@
+/// @file       LTBenchStubs.cpp
+/// @brief      Replacements for LiveTraffic.cpp in benchmark tools linking LTCore
+/// @details    LiveTraffic.cpp contains the plugin's entry points and is not part
+///             of LTCore. The few globals it defines for use by LTCore are defined here
+///             for tools like `lt_replay_bench` and `lt_map_bench`.
+/// @author     Birger Hoppe
+/// @copyright  (c) 2024 Birger Hoppe
+/// @copyright  Permission is hereby granted, free of charge, to any person obtaining a
+///             copy of this software and associated documentation files (the "Software"),
+///             to deal in the Software without restriction, including without limitation
+///             the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the
+///             Software is furnished to do so, subject to the following conditions:\n
+///             The above copyright notice and this permission notice shall be included in
+///             all copies or substantial portions of the Software.\n
+///             THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///             IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///             FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///             AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///             LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///             OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+///             THE SOFTWARE.
+
+#include "LiveTraffic.h"
+
+// access to data refs
+DataRefs dataRefs(logWARN);
+
+// There are no menus to update
+void MenuUpdateAllItemStatus()
+{}
+
+// Nobody to tell about a new version
+void HandleNewVersionAvail ()
+{}
+
+// Log current timestamp and sim-time-stamp
+void LogTimestamps ()
+{
+    LOG_MSG(logMSG, MSG_TIMESTAMPS,
+            ts2string(std::time(nullptr)).c_str(),
+            dataRefs.GetSimTimeString().c_str());
+}
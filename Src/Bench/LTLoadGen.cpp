@@ -0,0 +1,711 @@
+/// @file       LTLoadGen.cpp
+/// @brief      `lt_loadgen`: Generates synthetic traffic around an airport for load testing
+/// @details    Simulates any number of aircraft around a given runway:
+///             departures (taxi out, take off, climb out), arrivals (final approach,
+///             roll out, taxi in), aircraft taxiing between apron and runway,
+///             and overflights at cruise level. Once an aircraft leaves the area
+///             it is replaced by a new one with a new transponder code.\n
+///             Positions are sent out at a configurable rate per aircraft,
+///             either like RealTraffic does (`RTTFC` records via UDP, received
+///             by LiveTraffic's RealTraffic channel with connection type "RealTraffic App"),
+///             or as SBS stream (BaseStation format, as served e.g. by ADSBHub or dump1090 on port 30003)
+///             via a TCP server, to which LiveTraffic's ADSBHub channel connects if
+///             `ADSBHub_Host localhost:30003` is added to `LiveTraffic.prf`.\n
+///             No network access is needed, so with X-Plane positioned at the airport
+///             and Settings > Debug > "Stress Mode: Log Timings" activated
+///             LiveTraffic's scaling limits can be measured on any machine.
+/// @author     Birger Hoppe
+/// @copyright  (c) 2024 Birger Hoppe
+/// @copyright  Permission is hereby granted, free of charge, to any person obtaining a
+///             copy of this software and associated documentation files (the "Software"),
+///             to deal in the Software without restriction, including without limitation
+///             the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the
+///             Software is furnished to do so, subject to the following conditions:\n
+///             The above copyright notice and this permission notice shall be included in
+///             all copies or substantial portions of the Software.\n
+///             THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///             IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///             FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///             AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///             LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///             OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+///             THE SOFTWARE.
+
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <cmath>
+#include <ctime>
+#include <csignal>
+#include <string>
+#include <vector>
+#include <array>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#include <unistd.h>
+
+//
+// MARK: Constants
+//
+
+constexpr double PI             = 3.1415926535897932384626433832795028841971693993751;
+constexpr double EARTH_D_M      = 6371000.0 * 2.0;  ///< earth diameter [m], as in CoordCalc.h
+constexpr double M_per_NM       = 1852.0;           ///< meters per nautical mile
+constexpr double M_per_FT       = 0.3048;           ///< meters per foot
+constexpr double M_per_S_per_KN = M_per_NM / 3600.0;///< [m/s] per knot
+constexpr double FPM_per_KN     = M_per_NM / M_per_FT / 60.0;   ///< [ft/min] per knot
+
+constexpr double LG_RWY_LEN     = 3000.0;   ///< [m] simulated runway length
+constexpr double LG_APRON_DIST  = 500.0;    ///< [m] distance of apron from runway center line
+constexpr double LG_TWY_DIST    = 200.0;    ///< [m] distance of parallel taxiway from runway center line
+constexpr double LG_GS_DEG      = 3.0;      ///< [°] glide slope
+constexpr double LG_TAXI_KN     = 15.0;     ///< [kn] taxi speed
+constexpr double LG_ROTATE_KN   = 150.0;    ///< [kn] rotation speed
+constexpr double LG_APPR_KN     = 150.0;    ///< [kn] approach speed
+constexpr double LG_CLIMB_KN    = 250.0;    ///< [kn] final climb speed
+constexpr double LG_CLIMB_FPM   = 2500.0;   ///< [ft/min] climb rate
+constexpr double LG_CLIMB_TO_FT = 10000.0;  ///< [ft] above airport departures level off
+constexpr double LG_TICK_S      = 0.05;     ///< [s] simulation step
+constexpr double LG_REPORT_S    = 5.0;      ///< [s] report interval
+
+inline double deg2rad (double deg) { return deg * PI / 180.0; }
+inline double rad2deg (double rad) { return rad * 180.0 / PI; }
+/// Normalize a heading to [0..360)
+inline double HeadingNormalize (double h) { h = std::fmod(h, 360.0); return h < 0.0 ? h + 360.0 : h; }
+
+//
+// MARK: Configuration
+//
+
+/// Output format
+enum LGFormatTy { LG_FMT_RT, LG_FMT_SBS };
+
+/// Load generator parameters as per command line
+struct LGCfgTy {
+    double      lat = NAN;              ///< airport latitude (runway center)
+    double      lon = NAN;              ///< airport longitude (runway center)
+    double      elev_ft = 0.0;          ///< airport elevation
+    double      rwyHdg = 90.0;          ///< runway heading (true) in use for take off and landing
+    int         num = 200;              ///< number of simultaneously simulated aircraft
+    double      rate = 1.0;             ///< position updates per aircraft per second
+    std::array<int,4> mix = {30, 30, 20, 20};   ///< share of departures, arrivals, taxiing, overflights
+    double      radius_nm = 30.0;       ///< radius of the simulated area
+    LGFormatTy  fmt = LG_FMT_RT;        ///< output format
+    std::string host = "127.0.0.1";     ///< UDP target (RealTraffic format)
+    int         port = 0;               ///< UDP target port / TCP listening port, 0 = default per format
+    double      duration = 0.0;         ///< stop after this many seconds, 0 = run until Ctrl-C
+    double      delay = 0.0;            ///< push timestamps this many seconds into the past
+    unsigned    seed = 0;               ///< random seed, 0 = random
+    bool        bVerbose = false;       ///< print every sent line
+};
+static LGCfgTy cfg;                     ///< the load generator's configuration
+
+/// Print usage info
+static void Usage (const char* prog)
+{
+    std::printf(
+        "Usage: %s --lat <deg> --lon <deg> [options]\n"
+        "Sends synthetic traffic around an airport to LiveTraffic for load testing.\n"
+        "  --lat <deg>, --lon <deg>  position of the runway center\n"
+        "  --elev <ft>         airport elevation (default: 0)\n"
+        "  --rwy <deg>         true heading of the runway in use (default: %.0f)\n"
+        "  --num <n>           number of simultaneous aircraft (default: %d)\n"
+        "  --rate <hz>         position updates per aircraft and second (default: %.1f)\n"
+        "  --mix <d,a,t,o>     share of departures, arrivals, taxiing, overflights (default: %d,%d,%d,%d)\n"
+        "  --radius <nm>       radius of the simulated area (default: %.0f)\n"
+        "  --fmt <rt|sbs>      RealTraffic UDP or SBS TCP stream (default: rt)\n"
+        "  --host <host>       UDP target host for RealTraffic format (default: %s)\n"
+        "  --port <n>          UDP target port (rt, default: 49005) or TCP listening port (sbs, default: 30003)\n"
+        "  --duration <s>      stop after this many seconds (default: run until Ctrl-C)\n"
+        "  --delay <s>         push timestamps this many seconds into the past (default: 0)\n"
+        "  --seed <n>          random seed for reproducible traffic\n"
+        "  -v                  print every sent record\n",
+        prog, cfg.rwyHdg, cfg.num, cfg.rate,
+        cfg.mix[0], cfg.mix[1], cfg.mix[2], cfg.mix[3],
+        cfg.radius_nm, cfg.host.c_str());
+}
+
+/// Parse the command line into `cfg`
+static bool ParseArgs (int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool bHasVal = i+1 < argc;
+        if      (arg == "--lat"      && bHasVal) cfg.lat = std::stod(argv[++i]);
+        else if (arg == "--lon"      && bHasVal) cfg.lon = std::stod(argv[++i]);
+        else if (arg == "--elev"     && bHasVal) cfg.elev_ft = std::stod(argv[++i]);
+        else if (arg == "--rwy"      && bHasVal) cfg.rwyHdg = HeadingNormalize(std::stod(argv[++i]));
+        else if (arg == "--num"      && bHasVal) cfg.num = std::stoi(argv[++i]);
+        else if (arg == "--rate"     && bHasVal) cfg.rate = std::stod(argv[++i]);
+        else if (arg == "--radius"   && bHasVal) cfg.radius_nm = std::stod(argv[++i]);
+        else if (arg == "--host"     && bHasVal) cfg.host = argv[++i];
+        else if (arg == "--port"     && bHasVal) cfg.port = std::stoi(argv[++i]);
+        else if (arg == "--duration" && bHasVal) cfg.duration = std::stod(argv[++i]);
+        else if (arg == "--delay"    && bHasVal) cfg.delay = std::stod(argv[++i]);
+        else if (arg == "--seed"     && bHasVal) cfg.seed = unsigned(std::stoul(argv[++i]));
+        else if (arg == "-v")                    cfg.bVerbose = true;
+        else if (arg == "--mix"      && bHasVal) {
+            if (std::sscanf(argv[++i], "%d,%d,%d,%d",
+                            &cfg.mix[0], &cfg.mix[1], &cfg.mix[2], &cfg.mix[3]) != 4)
+                return false;
+        }
+        else if (arg == "--fmt"      && bHasVal) {
+            const std::string fmt = argv[++i];
+            if (fmt == "rt")        cfg.fmt = LG_FMT_RT;
+            else if (fmt == "sbs")  cfg.fmt = LG_FMT_SBS;
+            else return false;
+        }
+        else return false;
+    }
+    if (!cfg.port)
+        cfg.port = cfg.fmt == LG_FMT_RT ? 49005 : 30003;
+    cfg.num = std::max(cfg.num, 1);
+    cfg.rate = std::clamp(cfg.rate, 0.01, 1.0 / LG_TICK_S);
+    cfg.radius_nm = std::max(cfg.radius_nm, 5.0);
+    for (int& m: cfg.mix) m = std::max(m, 0);
+    return !std::isnan(cfg.lat) && !std::isnan(cfg.lon) &&
+           cfg.mix[0] + cfg.mix[1] + cfg.mix[2] + cfg.mix[3] > 0;
+}
+
+//
+// MARK: Aircraft Simulation
+//
+
+/// Random number generator for everything
+static std::mt19937 gRnd;
+
+/// Random value in the range [a..b]
+static double RndRange (double a, double b)
+{ return std::uniform_real_distribution<double>(a, b)(gRnd); }
+
+/// Random element of a list
+template <class T, size_t N>
+static const T& RndOf (const std::array<T,N>& arr)
+{ return arr[std::uniform_int_distribution<size_t>(0, N-1)(gRnd)]; }
+
+/// A point in local coordinates [m], `x` pointing east, `y` pointing north, origin at the runway center
+struct LGPointTy {
+    double x = 0.0;
+    double y = 0.0;
+
+    LGPointTy () {}
+    LGPointTy (double _x, double _y) : x(_x), y(_y) {}
+    /// Point moved by `dist` meters into direction `hdg`
+    LGPointTy Moved (double hdg, double dist) const
+    { return LGPointTy(x + dist * std::sin(deg2rad(hdg)), y + dist * std::cos(deg2rad(hdg))); }
+    /// Distance to another point
+    double Dist (const LGPointTy& o) const { return std::hypot(o.x - x, o.y - y); }
+    /// Bearing to another point
+    double Angle (const LGPointTy& o) const { return HeadingNormalize(rad2deg(std::atan2(o.x - x, o.y - y))); }
+    /// Distance to the origin
+    double Len () const { return std::hypot(x, y); }
+};
+
+/// Kind of simulated traffic
+enum LGKindTy { LG_DEP = 0, LG_ARR, LG_TAXI, LG_OVF, LG_CNT_KIND };
+
+/// Flight phase
+enum LGPhaseTy {
+    PH_TAXI_OUT = 0,                    ///< taxiing from apron to runway threshold
+    PH_TAKEOFF,                         ///< take off roll
+    PH_CLIMB,                           ///< climbing out along runway heading
+    PH_APPROACH,                        ///< on final, following the glide slope
+    PH_ROLLOUT,                         ///< after touch down, decelerating on the runway
+    PH_TAXI_IN,                         ///< taxiing from runway to apron
+    PH_TAXI,                            ///< just taxiing between apron and taxiway
+    PH_CRUISE,                          ///< overflight at cruise level
+};
+
+/// Total number of aircraft created, serves to generate unique ids
+static unsigned long gnAcCreated = 0;
+
+/// One simulated aircraft
+class LGAircraft {
+public:
+    LGKindTy    kind = LG_DEP;          ///< kind of traffic
+    LGPhaseTy   phase = PH_TAXI_OUT;    ///< current flight phase
+    unsigned long hexId = 0;            ///< transponder code
+    int         squawk = 0;             ///< squawk code (decimal representation of the octal digits)
+    std::string call;                   ///< call sign
+    std::string acType;                 ///< ICAO aircraft type
+    std::string reg;                    ///< registration
+    std::string from, to;               ///< origin and destination (IATA)
+    LGPointTy   pos;                    ///< current position
+    double      alt_ft = 0.0;           ///< altitude
+    double      trk = 0.0;              ///< track
+    double      gs_kn = 0.0;            ///< ground speed
+    double      vs_fpm = 0.0;           ///< vertical speed
+    bool        bGnd = true;            ///< on the ground?
+    LGPointTy   target;                 ///< where to taxi to
+    int         legsLeft = 0;           ///< taxiing: number of legs still to taxi
+    double      nextSend = 0.0;         ///< [s] simulation time of next position output
+
+public:
+    /// Create a new aircraft of the given kind
+    LGAircraft (LGKindTy _kind) { Spawn(_kind); }
+
+    /// (Re)initializes the aircraft, so that it starts a new life with a new identity
+    void Spawn (LGKindTy _kind);
+    /// Move the aircraft by `dt` seconds, returns `false` if the aircraft has finished
+    bool Step (double dt);
+
+protected:
+    /// Steers towards `target` at ground speed `gs_kn`, returns `true` when reached
+    bool TaxiTo (double dt);
+    /// Runway threshold used for take off and landing
+    static LGPointTy Threshold () { return LGPointTy().Moved(cfg.rwyHdg, -LG_RWY_LEN / 2.0); }
+    /// A random point on the apron
+    static LGPointTy Apron ()
+    { return LGPointTy().Moved(cfg.rwyHdg + 90.0, LG_APRON_DIST).Moved(cfg.rwyHdg, RndRange(-LG_RWY_LEN/3, LG_RWY_LEN/3)); }
+    /// A random point on the parallel taxiway
+    static LGPointTy Taxiway ()
+    { return LGPointTy().Moved(cfg.rwyHdg + 90.0, LG_TWY_DIST).Moved(cfg.rwyHdg, RndRange(-LG_RWY_LEN/2, LG_RWY_LEN/2)); }
+};
+
+// (Re)initializes the aircraft, so that it starts a new life with a new identity
+void LGAircraft::Spawn (LGKindTy _kind)
+{
+    static const std::array<const char*,10> AC_TYPES = { "A320", "B738", "A21N", "B38M", "A333", "B77W", "B789", "E190", "CRJ9", "DH8D" };
+    static const std::array<const char*,10> OPS      = { "DLH", "BAW", "AFR", "KLM", "UAL", "DAL", "RYR", "EZY", "SWR", "AUA" };
+    static const std::array<const char*,10> APTS     = { "FRA", "LHR", "CDG", "AMS", "JFK", "ATL", "DUB", "LGW", "ZRH", "VIE" };
+
+    ++gnAcCreated;
+    kind    = _kind;
+    hexId   = 0xC00000 + (gnAcCreated % 0x100000);     // private range, unlikely to match real aircraft
+    squawk  = 1000 * int(RndRange(1, 7)) + 100 * int(RndRange(0, 7)) + 10 * int(RndRange(0, 7)) + int(RndRange(0, 7));
+    call    = std::string(RndOf(OPS)) + std::to_string(100 + gnAcCreated % 9900);
+    acType  = RndOf(AC_TYPES);
+    reg     = "LG" + std::to_string(gnAcCreated % 100000);
+    from    = RndOf(APTS);
+    to      = RndOf(APTS);
+    vs_fpm  = 0.0;
+
+    switch (kind) {
+        case LG_DEP:
+            phase   = PH_TAXI_OUT;
+            pos     = Apron();
+            target  = Threshold();
+            alt_ft  = cfg.elev_ft;
+            gs_kn   = LG_TAXI_KN;
+            bGnd    = true;
+            break;
+        case LG_ARR: {
+            // somewhere on the extended center line, following the glide slope
+            phase   = PH_APPROACH;
+            const double dist = RndRange(3.0, cfg.radius_nm * 0.8) * M_per_NM;
+            pos     = Threshold().Moved(cfg.rwyHdg, -dist);
+            alt_ft  = cfg.elev_ft + dist * std::tan(deg2rad(LG_GS_DEG)) / M_per_FT;
+            trk     = cfg.rwyHdg;
+            gs_kn   = LG_APPR_KN;
+            vs_fpm  = -gs_kn * FPM_per_KN * std::tan(deg2rad(LG_GS_DEG));
+            bGnd    = false;
+            break;
+        }
+        case LG_TAXI:
+            phase   = PH_TAXI;
+            pos     = Apron();
+            target  = Taxiway();
+            legsLeft= int(RndRange(2.0, 8.0));
+            alt_ft  = cfg.elev_ft;
+            gs_kn   = LG_TAXI_KN;
+            bGnd    = true;
+            break;
+        case LG_OVF:
+        case LG_CNT_KIND: {
+            // enter the area at a random point, cross it roughly through the middle
+            kind    = LG_OVF;
+            phase   = PH_CRUISE;
+            const double brg = RndRange(0.0, 360.0);
+            pos     = LGPointTy().Moved(brg, cfg.radius_nm * M_per_NM);
+            trk     = HeadingNormalize(brg + 180.0 + RndRange(-40.0, 40.0));
+            alt_ft  = 1000.0 * std::round(RndRange(25.0, 39.0));
+            gs_kn   = RndRange(420.0, 480.0);
+            bGnd    = false;
+            break;
+        }
+    }
+    if (phase != PH_APPROACH && phase != PH_CRUISE)
+        trk = pos.Angle(target);
+}
+
+// Steers towards `target` at ground speed `gs_kn`, returns `true` when reached
+bool LGAircraft::TaxiTo (double dt)
+{
+    const double step = gs_kn * M_per_S_per_KN * dt;
+    const double dist = pos.Dist(target);
+    if (dist <= step) {
+        pos = target;
+        return true;
+    }
+    trk = pos.Angle(target);
+    pos = pos.Moved(trk, step);
+    return false;
+}
+
+// Move the aircraft by `dt` seconds, returns `false` if the aircraft has finished
+bool LGAircraft::Step (double dt)
+{
+    switch (phase) {
+        case PH_TAXI_OUT:
+            if (TaxiTo(dt)) {
+                phase = PH_TAKEOFF;
+                trk = cfg.rwyHdg;
+            }
+            break;
+
+        case PH_TAKEOFF:
+            gs_kn += 3.0 * dt;
+            pos = pos.Moved(trk, gs_kn * M_per_S_per_KN * dt);
+            if (gs_kn >= LG_ROTATE_KN) {
+                phase = PH_CLIMB;
+                bGnd = false;
+                vs_fpm = LG_CLIMB_FPM;
+            }
+            break;
+
+        case PH_CLIMB:
+            gs_kn = std::min(gs_kn + 1.0 * dt, LG_CLIMB_KN);
+            pos = pos.Moved(trk, gs_kn * M_per_S_per_KN * dt);
+            alt_ft += vs_fpm * dt / 60.0;
+            if (alt_ft >= cfg.elev_ft + LG_CLIMB_TO_FT) {
+                alt_ft = cfg.elev_ft + LG_CLIMB_TO_FT;
+                vs_fpm = 0.0;
+            }
+            return pos.Len() < cfg.radius_nm * M_per_NM;
+
+        case PH_APPROACH: {
+            pos = pos.Moved(trk, gs_kn * M_per_S_per_KN * dt);
+            // distance to threshold, negative once passed
+            const LGPointTy thr = Threshold();
+            const double dist = std::cos(deg2rad(thr.Angle(pos) - cfg.rwyHdg)) > 0.0 ? -thr.Dist(pos) : thr.Dist(pos);
+            if (dist <= 0.0) {                  // touch down
+                phase = PH_ROLLOUT;
+                alt_ft = cfg.elev_ft;
+                vs_fpm = 0.0;
+                bGnd = true;
+            } else
+                alt_ft = cfg.elev_ft + dist * std::tan(deg2rad(LG_GS_DEG)) / M_per_FT;
+            break;
+        }
+
+        case PH_ROLLOUT:
+            gs_kn = std::max(gs_kn - 4.0 * dt, 20.0);
+            pos = pos.Moved(trk, gs_kn * M_per_S_per_KN * dt);
+            if (gs_kn <= 20.0) {
+                phase = PH_TAXI_IN;
+                gs_kn = LG_TAXI_KN;
+                target = Apron();
+            }
+            break;
+
+        case PH_TAXI_IN:
+            return !TaxiTo(dt);
+
+        case PH_TAXI:
+            if (TaxiTo(dt)) {
+                if (--legsLeft <= 0)
+                    return false;
+                target = legsLeft % 2 ? Apron() : Taxiway();
+            }
+            break;
+
+        case PH_CRUISE:
+            pos = pos.Moved(trk, gs_kn * M_per_S_per_KN * dt);
+            return pos.Len() < cfg.radius_nm * M_per_NM * 1.05;
+    }
+    return true;
+}
+
+//
+// MARK: Output
+//
+
+static std::atomic<bool> gbStop {false};    ///< stop everything, e.g. after Ctrl-C
+static unsigned long gnSent = 0;            ///< number of records sent
+static unsigned long gnBytes = 0;           ///< number of bytes sent
+
+/// Convert local position to lat/lon
+static void LocalToGeo (const LGPointTy& p, double& lat, double& lon)
+{
+    lat = cfg.lat + rad2deg(p.y / (EARTH_D_M / 2.0));
+    lon = cfg.lon + rad2deg(p.x / (EARTH_D_M / 2.0 * std::cos(deg2rad(cfg.lat))));
+}
+
+/// Format a RealTraffic `RTTFC` record, same layout as LiveTraffic's export
+static int FormatRTTFC (char* buf, size_t bufSize, const LGAircraft& ac, double ts)
+{
+    double lat, lon;
+    LocalToGeo(ac.pos, lat, lon);
+    return std::snprintf(buf, bufSize,
+                         "RTTFC,%lu,%.6f,%.6f,%.0f,%.0f,%c,%.0f,%.0f,%s,%s,%s,%s,%s,%.2f,"
+                         "lt_loadgen,%s,adsb_icao,%.0f,"
+                         "-1,-1,-1,-1,-1,-1,"                       // IAS, TAS, Mach, track_rate, roll, mag_heading
+                         "%.2f,%.0f,none,A3,"
+                         "-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,"        // nav_qnh, nav_altitude_mcp, nav_altitude_fms, nav_heading, nav_modes, seen, rssi, winddir, windspd, OAT, TAT
+                         "1,,",
+                         ac.hexId, lat, lon,
+                         ac.alt_ft, ac.vs_fpm,                      // baro_alt, baro_rate
+                         ac.bGnd ? '0' : '1',                       // airborne
+                         ac.trk, ac.gs_kn,
+                         ac.call.c_str(), ac.acType.c_str(), ac.reg.c_str(),
+                         ac.from.c_str(), ac.to.c_str(),
+                         ts,
+                         ac.call.c_str(),                           // cs_iata
+                         ac.alt_ft,                                 // alt_geom
+                         ac.trk, ac.vs_fpm);                        // true_heading, geom_rate
+}
+
+/// Format an SBS `MSG,3` record, which combines all fields LiveTraffic's ADSBHub channel reads
+static int FormatSBS (char* buf, size_t bufSize, const LGAircraft& ac, double ts)
+{
+    double lat, lon;
+    LocalToGeo(ac.pos, lat, lon);
+    const std::time_t t = std::time_t(ts);
+    const int ms = int((ts - double(t)) * 1000.0);
+    std::tm tm;
+    gmtime_r(&t, &tm);
+    char sDate[16], sTime[16];
+    std::strftime(sDate, sizeof(sDate), "%Y/%m/%d", &tm);
+    std::snprintf(sTime, sizeof(sTime), "%02d:%02d:%02d.%03d", tm.tm_hour, tm.tm_min, tm.tm_sec, ms);
+    return std::snprintf(buf, bufSize,
+                         "MSG,3,1,1,%06lX,1,%s,%s,%s,%s,%s,%.0f,%.0f,%.0f,%.6f,%.6f,%.0f,%04d,0,0,0,%d\r\n",
+                         ac.hexId, sDate, sTime, sDate, sTime,
+                         ac.call.c_str(), ac.alt_ft, ac.gs_kn, ac.trk,
+                         lat, lon, ac.vs_fpm, ac.squawk,
+                         ac.bGnd ? 1 : 0);
+}
+
+/// Sends records either via UDP or via a TCP stream
+class LGSender {
+protected:
+    int sock = -1;                      ///< UDP socket, or TCP listening socket
+    int sockClient = -1;                ///< TCP client connection
+    sockaddr_storage addr = {};         ///< UDP target address
+    socklen_t addrLen = 0;              ///< length of `addr`
+    std::string sBuf;                   ///< TCP: collects records of one tick, sent at once
+public:
+    /// Opens the socket
+    bool Open ();
+    /// Closes all sockets
+    ~LGSender ();
+    /// TCP: blocks until a client connects, UDP: no-op, returns `false` if stopped
+    bool WaitForClient ();
+    /// Sends one record
+    void Send (const char* rec, int len);
+    /// TCP: Sends out all records collected
+    void Flush ();
+};
+
+// Opens the socket
+bool LGSender::Open ()
+{
+    if (cfg.fmt == LG_FMT_RT) {
+        addrinfo hints = {};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_DGRAM;
+        addrinfo* pRes = nullptr;
+        if (getaddrinfo(cfg.host.c_str(), std::to_string(cfg.port).c_str(), &hints, &pRes) != 0 || !pRes) {
+            std::fprintf(stderr, "Could not resolve '%s'\n", cfg.host.c_str());
+            return false;
+        }
+        std::memcpy(&addr, pRes->ai_addr, pRes->ai_addrlen);
+        addrLen = pRes->ai_addrlen;
+        sock = socket(pRes->ai_family, SOCK_DGRAM, 0);
+        freeaddrinfo(pRes);
+    } else {
+        sock = socket(AF_INET, SOCK_STREAM, 0);
+        if (sock >= 0) {
+            const int on = 1;
+            setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+            sockaddr_in sin = {};
+            sin.sin_family = AF_INET;
+            sin.sin_port = htons(uint16_t(cfg.port));
+            sin.sin_addr.s_addr = htonl(INADDR_ANY);
+            if (bind(sock, (const sockaddr*)&sin, sizeof(sin)) < 0 || listen(sock, 1) < 0) {
+                std::perror("Could not listen on TCP port");
+                return false;
+            }
+        }
+    }
+    if (sock < 0) {
+        std::perror("Could not create socket");
+        return false;
+    }
+    return true;
+}
+
+// Closes all sockets
+LGSender::~LGSender ()
+{
+    if (sockClient >= 0) close(sockClient);
+    if (sock >= 0) close(sock);
+}
+
+// TCP: blocks until a client connects, UDP: no-op, returns `false` if stopped
+bool LGSender::WaitForClient ()
+{
+    if (cfg.fmt != LG_FMT_SBS || sockClient >= 0)
+        return true;
+    std::printf("Waiting for LiveTraffic to connect to TCP port %d...\n", cfg.port);
+    while (!gbStop && sockClient < 0) {
+        sockClient = accept(sock, nullptr, nullptr);
+        if (sockClient < 0 && errno != EINTR) {
+            std::perror("accept failed");
+            return false;
+        }
+    }
+    if (sockClient >= 0)
+        std::printf("Client connected.\n");
+    return !gbStop;
+}
+
+// Sends one record
+void LGSender::Send (const char* rec, int len)
+{
+    if (len <= 0) return;
+    if (cfg.bVerbose)
+        std::printf("%s\n", rec);
+    if (cfg.fmt == LG_FMT_RT) {
+        // one datagram per record, as RealTraffic does
+        if (sendto(sock, rec, size_t(len), 0, (const sockaddr*)&addr, addrLen) < 0)
+            return;
+    } else
+        sBuf.append(rec, size_t(len));
+    ++gnSent;
+    gnBytes += (unsigned long)len;
+}
+
+// TCP: Sends out all records collected
+void LGSender::Flush ()
+{
+    if (sockClient < 0 || sBuf.empty()) {
+        sBuf.clear();
+        return;
+    }
+    size_t off = 0;
+    while (off < sBuf.size()) {
+        const ssize_t n = send(sockClient, sBuf.data() + off, sBuf.size() - off, 0);
+        if (n <= 0) {
+            std::printf("Client disconnected.\n");
+            close(sockClient);
+            sockClient = -1;
+            break;
+        }
+        off += size_t(n);
+    }
+    sBuf.clear();
+}
+
+//
+// MARK: Main
+//
+
+/// Signal handler for Ctrl-C
+static void OnSignal (int)
+{
+    gbStop = true;
+}
+
+/// Choose kind of traffic as per configured mix
+static LGKindTy RndKind ()
+{
+    std::discrete_distribution<int> dist (cfg.mix.begin(), cfg.mix.end());
+    return LGKindTy(dist(gRnd));
+}
+
+int main (int argc, char* argv[])
+{
+    if (!ParseArgs(argc, argv)) {
+        Usage(argv[0]);
+        return 1;
+    }
+    gRnd.seed(cfg.seed ? cfg.seed : std::random_device()());
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+    std::signal(SIGPIPE, SIG_IGN);          // a disconnecting TCP client is handled in LGSender::Flush()
+
+    LGSender sender;
+    if (!sender.Open())
+        return 2;
+
+    // Create all aircraft, spread them out by simulating a random amount of time
+    std::vector<LGAircraft> vAc;
+    vAc.reserve(size_t(cfg.num));
+    for (int i = 0; i < cfg.num; ++i) {
+        vAc.emplace_back(RndKind());
+        LGAircraft& ac = vAc.back();
+        for (double t = RndRange(0.0, 300.0); t > 0.0; t -= 1.0)
+            if (!ac.Step(1.0))
+                ac.Spawn(RndKind());
+        // spread position output evenly
+        ac.nextSend = RndRange(0.0, 1.0 / cfg.rate);
+    }
+    std::printf("Simulating %d aircraft around %.4f/%.4f, runway heading %.0f, sending %.1f updates/s per aircraft as %s to %s:%d\n",
+                cfg.num, cfg.lat, cfg.lon, cfg.rwyHdg, cfg.rate,
+                cfg.fmt == LG_FMT_RT ? "RTTFC via UDP" : "SBS via TCP",
+                cfg.fmt == LG_FMT_RT ? cfg.host.c_str() : "*", cfg.port);
+
+    if (!sender.WaitForClient())
+        return 0;
+
+    // *** Main Loop ***
+    using clock = std::chrono::steady_clock;
+    const clock::time_point tStart = clock::now();
+    clock::time_point tNext = tStart;
+    double simTime = 0.0;
+    double nextReport = LG_REPORT_S;
+    unsigned long lastSent = 0, lastBytes = 0;
+    char buf[1024];
+    while (!gbStop && (cfg.duration <= 0.0 || simTime < cfg.duration))
+    {
+        // move all aircraft, send out the positions, which are due
+        simTime += LG_TICK_S;
+        const double ts =
+        double(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count()) / 1000.0
+        - cfg.delay;
+        std::array<int,LG_CNT_KIND> cntKind = {0,0,0,0};
+        for (LGAircraft& ac: vAc) {
+            if (!ac.Step(LG_TICK_S))
+                ac.Spawn(RndKind());
+            ++cntKind[ac.kind];
+            if (ac.nextSend <= simTime) {
+                ac.nextSend += 1.0 / cfg.rate;
+                sender.Send(buf, cfg.fmt == LG_FMT_RT ?
+                            FormatRTTFC(buf, sizeof(buf), ac, ts) :
+                            FormatSBS(buf, sizeof(buf), ac, ts));
+            }
+        }
+        sender.Flush();
+        if (!sender.WaitForClient())
+            break;
+
+        // Report
+        if (simTime >= nextReport) {
+            std::printf("%7.0fs: %lu departures, %lu arrivals, %lu taxiing, %lu overflights, sent %7.0f records/s, %8.1f kB/s\n",
+                        simTime,
+                        (unsigned long)cntKind[LG_DEP], (unsigned long)cntKind[LG_ARR],
+                        (unsigned long)cntKind[LG_TAXI], (unsigned long)cntKind[LG_OVF],
+                        double(gnSent - lastSent) / LG_REPORT_S,
+                        double(gnBytes - lastBytes) / LG_REPORT_S / 1024.0);
+            std::fflush(stdout);
+            lastSent = gnSent;
+            lastBytes = gnBytes;
+            nextReport += LG_REPORT_S;
+        }
+
+        // pace in real time
+        tNext += std::chrono::microseconds(long(LG_TICK_S * 1e6));
+        std::this_thread::sleep_until(tNext);
+    }
+
+    std::printf("Sent %lu records, %lu aircraft created in total\n", gnSent, gnAcCreated);
+    return 0;
+}
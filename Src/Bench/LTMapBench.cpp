@@ -0,0 +1,204 @@
+/// @file       LTMapBench.cpp
+/// @brief      `lt_map_bench`: Insert/lookup rate of the flight data map under concurrent channel load
+/// @details    Simulates a number of channel threads, each repeatedly
+///             creating a key from its hex text and finding or creating
+///             the flight data in `mapFd` under its segment's lock,
+///             as the channels' data processing does for every message.\n
+///             One more thread plays the flight loop's maintenance: Every few
+///             milliseconds it iterates the whole map segment by segment
+///             and removes some flight data, so that inserts keep happening.\n
+///             Reported are lookups and inserts per second,
+///             and average and maximum wait times for the segment locks.
+/// @author     Birger Hoppe
+/// @copyright  (c) 2024 Birger Hoppe
+/// @copyright  Permission is hereby granted, free of charge, to any person obtaining a
+///             copy of this software and associated documentation files (the "Software"),
+///             to deal in the Software without restriction, including without limitation
+///             the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the
+///             Software is furnished to do so, subject to the following conditions:\n
+///             The above copyright notice and this permission notice shall be included in
+///             all copies or substantial portions of the Software.\n
+///             THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///             IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///             FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///             AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///             LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///             OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+///             THE SOFTWARE.
+
+#include "LiveTraffic.h"
+
+#include <random>
+
+// Replacements for what LiveTraffic.cpp provides: see LTBenchStubs.cpp
+
+//
+// MARK: Configuration
+//
+
+/// Bench parameters as per command line
+struct BenchCfgTy {
+    int         nThreads = 4;           ///< number of simulated channel threads
+    unsigned long nAc = 2000;           ///< number of distinct aircraft keys
+    double      duration = 5.0;         ///< run time in seconds
+    int         maintMs = 20;           ///< interval of the maintenance pass in milliseconds
+    int         removePct = 2;          ///< percentage of flight data removed per maintenance pass
+};
+static BenchCfgTy cfg;                  ///< the bench's configuration
+
+/// Print usage info
+static void Usage (const char* prog)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --threads <n>       simulated channel threads (default: %d)\n"
+        "  --ac <n>            number of distinct aircraft (default: %lu)\n"
+        "  --duration <s>      run time in seconds (default: %.0f)\n"
+        "  --maint <ms>        interval of the maintenance pass over the whole map (default: %d)\n"
+        "  --remove <pct>      percentage of flight data removed per maintenance pass (default: %d)\n",
+        prog, cfg.nThreads, cfg.nAc, cfg.duration, cfg.maintMs, cfg.removePct);
+}
+
+/// Parse command line
+static bool ParseArgs (int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool bHasVal = i+1 < argc;
+        if      (arg == "--threads"  && bHasVal) cfg.nThreads = std::stoi(argv[++i]);
+        else if (arg == "--ac"       && bHasVal) cfg.nAc = std::stoul(argv[++i]);
+        else if (arg == "--duration" && bHasVal) cfg.duration = std::stod(argv[++i]);
+        else if (arg == "--maint"    && bHasVal) cfg.maintMs = std::stoi(argv[++i]);
+        else if (arg == "--remove"   && bHasVal) cfg.removePct = std::stoi(argv[++i]);
+        else return false;
+    }
+    return cfg.nThreads > 0 && cfg.nAc > 0 && cfg.duration > 0.0 && cfg.maintMs > 0;
+}
+
+//
+// MARK: Load threads
+//
+
+/// Statistics collected by one thread
+struct ThreadStatsTy {
+    unsigned long long nLookups = 0;    ///< found existing flight data
+    unsigned long long nInserts = 0;    ///< created new flight data
+    unsigned long long nRemoved = 0;    ///< removed flight data (maintenance only)
+    unsigned long long nLocks = 0;      ///< number of times the lock was acquired
+    double waitTotal = 0.0;             ///< [µs] total wait time for the lock
+    double waitMax = 0.0;               ///< [µs] maximum wait time for the lock
+
+    /// Account for one lock wait
+    void AddWait (std::chrono::steady_clock::time_point t0,
+                  std::chrono::steady_clock::time_point t1)
+    {
+        const double w = std::chrono::duration<double,std::micro>(t1-t0).count();
+        ++nLocks;
+        waitTotal += w;
+        if (w > waitMax) waitMax = w;
+    }
+};
+
+static std::atomic<bool> gbStop {false};    ///< stop all threads
+
+/// A channel thread: creates keys from text and finds or creates flight data
+static void ChannelMain (unsigned seed, ThreadStatsTy& st)
+{
+    std::mt19937 rnd (seed);
+    std::uniform_int_distribution<unsigned long> distAc (0, cfg.nAc-1);
+    char hex[10];
+    while (!gbStop) {
+        // like the channels do: the key arrives as text
+        snprintf(hex, sizeof(hex), "%06lX", 0x400000UL + distAc(rnd));
+        const LTFlightData::FDKeyTy fdKey (LTFlightData::KEY_ICAO, hex);
+
+        const auto t0 = std::chrono::steady_clock::now();
+        FDMapTy::LockTy lock = mapFd.Lock(fdKey);
+        st.AddWait(t0, std::chrono::steady_clock::now());
+        LTFlightData& fd = mapFd[fdKey];
+        if (fd.key().empty()) {
+            fd.SetKey(fdKey);
+            ++st.nInserts;
+        } else
+            ++st.nLookups;
+    }
+}
+
+/// @brief The maintenance thread: iterates the whole map and removes some flight data
+/// @note Segment locks are taken inside FDMapTy::EraseIf(), so wait times are not recorded here
+static void MaintMain (ThreadStatsTy& st)
+{
+    std::mt19937 rnd (42);
+    std::uniform_int_distribution<int> distPct (0, 99);
+    while (!gbStop) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(cfg.maintMs));
+
+        mapFd.EraseIf([&](LTFlightData&)
+        {
+            if (distPct(rnd) < cfg.removePct) {
+                ++st.nRemoved;
+                return true;
+            }
+            ++st.nLookups;
+            return false;
+        });
+    }
+}
+
+//
+// MARK: Main
+//
+
+int main (int argc, char* argv[])
+{
+    if (!ParseArgs(argc, argv)) {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    // Start all threads
+    std::vector<ThreadStatsTy> vStats ((size_t)cfg.nThreads + 1);
+    std::vector<std::thread> vThr;
+    const auto tStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < cfg.nThreads; ++i)
+        vThr.emplace_back(ChannelMain, unsigned(i+1), std::ref(vStats[(size_t)i]));
+    vThr.emplace_back(MaintMain, std::ref(vStats.back()));
+
+    // Let them run, then stop
+    std::this_thread::sleep_for(std::chrono::duration<double>(cfg.duration));
+    gbStop = true;
+    for (std::thread& t: vThr)
+        t.join();
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+
+    // Report
+    printf("%d channel threads, %lu aircraft, %.1f s, final map size %lu\n",
+           cfg.nThreads, cfg.nAc, secs, (unsigned long)mapFd.size());
+    printf("%-12s %14s %14s %12s %14s %14s\n",
+           "thread", "lookups/s", "inserts/s", "removed/s", "avg wait [us]", "max wait [us]");
+    ThreadStatsTy tot;
+    for (size_t i = 0; i < vStats.size(); ++i) {
+        const ThreadStatsTy& st = vStats[i];
+        const std::string name = i+1 < vStats.size() ? "channel " + std::to_string(i+1) : "maintenance";
+        printf("%-12s %14.0f %14.0f %12.0f %14.2f %14.2f\n",
+               name.c_str(),
+               double(st.nLookups) / secs, double(st.nInserts) / secs, double(st.nRemoved) / secs,
+               st.nLocks ? st.waitTotal / double(st.nLocks) : 0.0, st.waitMax);
+        if (i+1 < vStats.size()) {
+            tot.nLookups  += st.nLookups;
+            tot.nInserts  += st.nInserts;
+            tot.nLocks    += st.nLocks;
+            tot.waitTotal += st.waitTotal;
+            tot.waitMax    = std::max(tot.waitMax, st.waitMax);
+        }
+    }
+    printf("%-12s %14.0f %14.0f %12s %14.2f %14.2f\n",
+           "all channels",
+           double(tot.nLookups) / secs, double(tot.nInserts) / secs, "",
+           tot.nLocks ? tot.waitTotal / double(tot.nLocks) : 0.0, tot.waitMax);
+
+    // Flight data destructors expect the segment locks to be available
+    mapFd.clear();
+    return 0;
+}
@@ -0,0 +1,415 @@
+/// @file       LTReplayBench.cpp
+/// @brief      `lt_replay_bench`: Replays tracking data through LTCore without X-Plane
+/// @details    Reads an export file as written by "Export Tracking Data"
+///             (`AITFC` and `RTTFC` lines, see also `Resources/SendTraffic.py`),
+///             and sends it via UDP to LiveTraffic's RealTraffic channel,
+///             so that the complete path from parsing to position calculation
+///             and XPMP2 instance updates is exercised.\n
+///             Time is simulated: A replay clock, installed via `gpfnSysTime`,
+///             runs up to 100 times faster than real time. Each simulated frame
+///             advances the clock by `speed / fps` seconds and calls all flight loops.\n
+///             X-Plane itself is replaced by XPLMHeadless.cpp, a temporary directory
+///             plays X-Plane's root folder, receives `Log.txt` and `LiveTraffic.prf`,
+///             and optionally an `apt.dat` file for taxiway snapping.\n
+///             Reported are positions received and calculated per second,
+///             latency of the position calculation queue, frame times, and memory usage.
+/// @author     Birger Hoppe
+/// @copyright  (c) 2024 Birger Hoppe
+/// @copyright  Permission is hereby granted, free of charge, to any person obtaining a
+///             copy of this software and associated documentation files (the "Software"),
+///             to deal in the Software without restriction, including without limitation
+///             the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the
+///             Software is furnished to do so, subject to the following conditions:\n
+///             The above copyright notice and this permission notice shall be included in
+///             all copies or substantial portions of the Software.\n
+///             THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///             IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///             FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///             AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///             LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///             OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+///             THE SOFTWARE.
+
+#include "LiveTraffic.h"
+#include "XPLMHeadless.h"
+
+#include <csignal>
+#include <filesystem>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// in LTVersion.cpp:
+extern bool InitFullVersion ();
+
+#ifndef LT_SOURCE_DIR
+#define LT_SOURCE_DIR "."
+#endif
+
+// Replacements for what LiveTraffic.cpp provides: see LTBenchStubs.cpp
+
+//
+// MARK: Configuration
+//
+
+/// Bench parameters as per command line
+struct BenchCfgTy {
+    std::string sExportFile;            ///< file to replay
+    std::string sAptDat;                ///< apt.dat to read, empty: none
+    std::vector<std::string> vCSL;      ///< CSL packages to load
+    std::string sPluginDir = LT_SOURCE_DIR;    ///< LiveTraffic's directory, containing `Resources`
+    double      speed = 10.0;           ///< replay speed factor
+    int         fps = 30;               ///< simulated frame rate
+    double      duration = 0.0;         ///< max replay duration in simulated seconds, 0 = all
+    int         port = 49005;           ///< UDP port of the RealTraffic channel
+    double      reportIntvl = 5.0;      ///< reporting interval in real seconds
+    double      elev = 0.0;             ///< terrain elevation
+    bool        bKeepDir = false;       ///< keep the temporary X-Plane directory
+};
+static BenchCfgTy cfg;                  ///< the bench's configuration
+
+/// Print usage info
+static void Usage (const char* prog)
+{
+    std::printf(
+        "Usage: %s <export file> [options]\n"
+        "Replays RealTraffic-style tracking data (AITFC/RTTFC lines) through LiveTraffic without X-Plane.\n"
+        "  --apt <apt.dat>     apt.dat file to read, enables snapping to taxiways\n"
+        "  --csl <dir>         CSL package to load, can be repeated (default: <plugin dir>/Resources/CSL)\n"
+        "  --plugin-dir <dir>  LiveTraffic plugin directory with Resources (default: %s)\n"
+        "  --speed <1..100>    replay speed factor (default: %.0f)\n"
+        "  --fps <n>           simulated frame rate (default: %d)\n"
+        "  --duration <s>      stop after this many simulated seconds (default: whole file)\n"
+        "  --port <n>          UDP port of the RealTraffic channel (default: %d)\n"
+        "  --elev <m>          terrain elevation in meters (default: 0)\n"
+        "  --report <s>        reporting interval in real seconds (default: %.0f)\n"
+        "  --keep              keep the temporary X-Plane directory with Log.txt\n",
+        prog, cfg.sPluginDir.c_str(), cfg.speed, cfg.fps, cfg.port, cfg.reportIntvl);
+}
+
+/// Parse the command line into `cfg`
+static bool ParseArgs (int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool bHasVal = i+1 < argc;
+        if      (arg == "--apt"        && bHasVal) cfg.sAptDat = argv[++i];
+        else if (arg == "--csl"        && bHasVal) cfg.vCSL.emplace_back(argv[++i]);
+        else if (arg == "--plugin-dir" && bHasVal) cfg.sPluginDir = argv[++i];
+        else if (arg == "--speed"      && bHasVal) cfg.speed = std::stod(argv[++i]);
+        else if (arg == "--fps"        && bHasVal) cfg.fps = std::stoi(argv[++i]);
+        else if (arg == "--duration"   && bHasVal) cfg.duration = std::stod(argv[++i]);
+        else if (arg == "--port"       && bHasVal) cfg.port = std::stoi(argv[++i]);
+        else if (arg == "--elev"       && bHasVal) cfg.elev = std::stod(argv[++i]);
+        else if (arg == "--report"     && bHasVal) cfg.reportIntvl = std::stod(argv[++i]);
+        else if (arg == "--keep")                  cfg.bKeepDir = true;
+        else if (arg[0] != '-' && cfg.sExportFile.empty()) cfg.sExportFile = arg;
+        else return false;
+    }
+    cfg.speed = std::clamp(cfg.speed, 1.0, 100.0);
+    cfg.fps = std::clamp(cfg.fps, 1, 200);
+    if (cfg.vCSL.empty())
+        cfg.vCSL.push_back(cfg.sPluginDir + "/Resources/CSL");
+    return !cfg.sExportFile.empty();
+}
+
+//
+// MARK: Replay data
+//
+
+/// One line of tracking data to replay
+struct ReplayLnTy {
+    double      ts;                     ///< timestamp from the data
+    std::string ln;                     ///< line as to be sent
+};
+static std::vector<ReplayLnTy> vReplay; ///< all lines, sorted by timestamp
+static size_t nWeatherLn = 0;           ///< number of skipped weather lines
+
+/// Timestamp field in both AITFC and RTTFC lines
+constexpr size_t BENCH_TS_FIELD = 14;
+
+/// Read the export file into `vReplay`
+static bool ReadExportFile (double& refLat, double& refLon)
+{
+    std::ifstream fIn (cfg.sExportFile);
+    if (!fIn) {
+        std::fprintf(stderr, "Can't open '%s'\n", cfg.sExportFile.c_str());
+        return false;
+    }
+    double sumLat = 0.0, sumLon = 0.0;
+    size_t nPos = 0;
+    std::string ln;
+    while (safeGetline(fIn, ln)) {
+        if (ln.empty()) continue;
+        if (!begins_with<std::string>(ln, RT_TRAFFIC_AITFC) &&
+            !begins_with<std::string>(ln, RT_TRAFFIC_RTTFC)) {
+            ++nWeatherLn;               // RealTraffic's UDP mode has no use for weather
+            continue;
+        }
+        const std::vector<std::string> f = str_tokenize(ln, ",", false);
+        if (f.size() <= BENCH_TS_FIELD) continue;
+        try {
+            vReplay.push_back({std::stod(f[BENCH_TS_FIELD]), ln});
+            // average of the first positions determines the reference position
+            if (nPos < 100) {
+                sumLat += std::stod(f[2]);
+                sumLon += std::stod(f[3]);
+                ++nPos;
+            }
+        } catch (const std::exception&) {}
+    }
+    if (vReplay.empty() || !nPos) {
+        std::fprintf(stderr, "No AITFC/RTTFC lines found in '%s'\n", cfg.sExportFile.c_str());
+        return false;
+    }
+    std::stable_sort(vReplay.begin(), vReplay.end(),
+                     [](const ReplayLnTy& a, const ReplayLnTy& b){ return a.ts < b.ts; });
+    refLat = sumLat / double(nPos);
+    refLon = sumLon / double(nPos);
+    return true;
+}
+
+//
+// MARK: Replay clock and sender
+//
+
+/// Current replay time, seconds since the epoch, read by all of LTCore's threads
+static std::atomic<double> gReplayNow {0.0};
+/// The clock function installed into `gpfnSysTime`
+static double ReplayClock () { return gReplayNow.load(); }
+
+static std::atomic<bool> gbStop {false};            ///< stop everything, e.g. after Ctrl-C
+static std::atomic<size_t> gnSent {0};              ///< number of lines sent
+
+/// Sends all lines, which are due as per the replay clock, via UDP to the RealTraffic channel
+static void SenderMain ()
+{
+    const int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) { gbStop = true; return; }
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(uint16_t(cfg.port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    for (const ReplayLnTy& r: vReplay) {
+        // wait till the line is due
+        while (!gbStop && r.ts > ReplayClock())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (gbStop) break;
+        sendto(sock, r.ln.data(), r.ln.size(), 0, (const sockaddr*)&addr, sizeof(addr));
+        ++gnSent;
+    }
+    close(sock);
+}
+
+//
+// MARK: Statistics
+//
+
+/// Read a value in kB from `/proc/self/status`, returned in MB
+static double ProcStatusMB (const char* key)
+{
+    std::ifstream fIn ("/proc/self/status");
+    std::string ln;
+    const size_t keyLen = std::strlen(key);
+    while (safeGetline(fIn, ln))
+        if (ln.compare(0, keyLen, key) == 0)
+            return std::atof(ln.c_str() + keyLen) / 1024.0;
+    return 0.0;
+}
+
+/// Frame time statistics
+struct FrameStatsTy {
+    unsigned long   n = 0;
+    double          sum_ms = 0.0;
+    double          max_ms = 0.0;
+    void Add (double ms) { ++n; sum_ms += ms; max_ms = std::max(max_ms, ms); }
+    double Avg () const { return n ? sum_ms / double(n) : 0.0; }
+};
+
+/// Signal handler for Ctrl-C
+static void OnSignal (int)
+{
+    gbStop = true;
+}
+
+//
+// MARK: Main
+//
+
+int main (int argc, char* argv[])
+{
+    if (!ParseArgs(argc, argv)) {
+        Usage(argv[0]);
+        return 1;
+    }
+    double refLat = 0.0, refLon = 0.0;
+    if (!ReadExportFile(refLat, refLon))
+        return 1;
+
+    // Temporary X-Plane root directory
+    std::error_code ec;
+    const fs::path root = fs::temp_directory_path() / ("lt_replay_bench_" + std::to_string(getpid()));
+    fs::create_directories(root / "Output" / "preferences", ec);
+    fs::create_directories(root / "Custom Scenery", ec);
+    if (!cfg.sAptDat.empty()) {
+        const fs::path aptDir = root / "Resources" / "default scenery" / "default apt dat" / "Earth nav data";
+        fs::create_directories(aptDir, ec);
+        fs::create_symlink(fs::absolute(cfg.sAptDat), aptDir / "apt.dat", ec);
+        if (ec) fs::copy_file(cfg.sAptDat, aptDir / "apt.dat", ec);
+    }
+    const std::string sRoot = root.string() + "/";
+    XPLMHeadless::Init(sRoot,
+                       fs::absolute(cfg.sPluginDir).string() + "/lin_x64/LiveTraffic.xpl",
+                       PLUGIN_SIGNATURE,
+                       sRoot + "Log.txt");
+    XPLMHeadless::SetTerrainElev(cfg.elev);
+    XPLMHeadless::SetRefPos(refLat, refLon, cfg.elev + 500.0);
+
+    // Startup like XPluginStart, without menus, commands, and windows
+    dataRefs.ThisThreadIsXP();
+    if (!InitFullVersion()) return 2;
+    {
+        // Configuration: only the RealTraffic channel, listening on UDP
+        std::ofstream fCfg (sRoot + PATH_CONFIG_FILE);
+        fCfg << LIVE_TRAFFIC << ' ' << LT_VERSION << '\n';
+        for (int ch = DR_CHANNEL_FIRST; ch <= DR_CHANNEL_LAST; ++ch)
+            if (DATA_REFS_LT[ch].isCfgFile())
+                fCfg << DATA_REFS_LT[ch].getDataNameStr() << ' ' << (ch == DR_CHANNEL_REAL_TRAFFIC_ONLINE) << '\n';
+        fCfg << DATA_REFS_LT[DR_CFG_RT_CONNECT_TYPE].getDataNameStr() << ' ' << int(RT_CONN_APP) << '\n';
+        fCfg << DATA_REFS_LT[DR_CFG_RT_TRAFFIC_PORT].getDataNameStr() << ' ' << cfg.port << '\n';
+        fCfg << '\n' << CFG_CSL_SECTION << '\n';
+        for (const std::string& csl: cfg.vCSL)
+            fCfg << "1|" << fs::absolute(csl).string() << '\n';
+    }
+    XPMPSetPluginName(LIVE_TRAFFIC, LIVE_TRAFFIC_XPMP2);
+    if (!dataRefs.Init()) return 2;
+    LTAircraft::FlightModel::ReadFlightModelFile();
+    if (!LTMainInit()) return 2;
+
+    // Install the replay clock: the first positions are "live" right away
+    gReplayNow = vReplay.front().ts + dataRefs.GetFdBufPeriod();
+    gpfnSysTime = ReplayClock;
+    const double tsStart = gReplayNow;
+    const double tsEnd = cfg.duration > 0.0 ?
+                         tsStart + cfg.duration :
+                         vReplay.back().ts + dataRefs.GetFdBufPeriod() + 10.0;
+
+    // Enable like XPluginEnable, then show aircraft
+    if (!cfg.sAptDat.empty())
+        LTAptEnable();
+    if (!LTMainEnable()) return 2;
+    dataRefs.SetAircraftDisplayed(true);
+    if (!dataRefs.AreAircraftDisplayed()) {
+        FlushMsg();
+        std::fprintf(stderr, "Could not start showing aircraft, see %sLog.txt (CSL models available?)\n", sRoot.c_str());
+        return 2;
+    }
+
+    // Warm-up: give the channel time to open its UDP port, the clock doesn't move
+    const float frameDur = 1.0f / float(cfg.fps);
+    for (int i = 0; i < cfg.fps; ++i) {
+        XPLMHeadless::RunFrame(0.0f);
+        std::this_thread::sleep_for(std::chrono::duration<float>(frameDur));
+    }
+
+    std::signal(SIGINT, OnSignal);
+    std::thread sender (SenderMain);
+    std::printf("Replaying %zu positions (%zu weather lines skipped) at %.0fx, %d fps, apt.dat: %s\n",
+                vReplay.size(), nWeatherLn, cfg.speed, cfg.fps,
+                cfg.sAptDat.empty() ? "-" : cfg.sAptDat.c_str());
+    std::printf("%8s %8s %8s %6s %6s %9s %8s %8s %8s %8s %8s\n",
+                "sim s", "rcvd/s", "calc/s", "ac", "inst", "calcQLen", "qAvg ms", "qMax ms",
+                "frm ms", "frmMax", "RSS MB");
+
+    // --- Main loop: simulated frames ---
+    using clock = std::chrono::steady_clock;
+    const clock::time_point tRealStart = clock::now();
+    clock::time_point tNextFrame = tRealStart;
+    clock::time_point tNextReport = tRealStart + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(cfg.reportIntvl));
+    FrameStatsTy frmTotal, frmReport;
+    size_t nSentLastReport = 0;
+    unsigned long nCalcTotal = 0;
+    LTFlightData::GetCalcQueueStats(true);
+    const double vStep = cfg.speed / double(cfg.fps);
+    double vElapsed = 0.0;
+    while (!gbStop && gReplayNow < tsEnd)
+    {
+        // advance the replay clock and run one frame
+        vElapsed += vStep;
+        gReplayNow = tsStart + vElapsed;
+        XPLMHeadless::SetElapsedTime(vElapsed);
+        const clock::time_point tFrm = clock::now();
+        XPLMHeadless::RunFrame(float(vStep));
+        const double frm_ms = std::chrono::duration<double,std::milli>(clock::now() - tFrm).count();
+        frmTotal.Add(frm_ms);
+        frmReport.Add(frm_ms);
+
+        // periodic report
+        const clock::time_point now = clock::now();
+        if (now >= tNextReport) {
+            const double dReal = cfg.reportIntvl;
+            const LTFlightData::CalcQueueStatsTy q = LTFlightData::GetCalcQueueStats(true);
+            nCalcTotal += q.cnt;
+            const size_t nSent = gnSent;
+            std::printf("%8.0f %8.0f %8.0f %6d %6zu %9zu %8.2f %8.2f %8.2f %8.2f %8.1f\n",
+                        vElapsed,
+                        double(nSent - nSentLastReport) / dReal,
+                        double(q.cnt) / dReal,
+                        dataRefs.GetNumAc(),
+                        XPLMHeadless::GetNumInstances(),
+                        q.len, q.avgWait_ms, q.maxWait_ms,
+                        frmReport.Avg(), frmReport.max_ms,
+                        ProcStatusMB("VmRSS:"));
+            std::fflush(stdout);
+            nSentLastReport = nSent;
+            frmReport = FrameStatsTy();
+            tNextReport += std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(dReal));
+        }
+
+        // pace frames in real time
+        tNextFrame += std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(frameDur));
+        if (tNextFrame > now)
+            std::this_thread::sleep_until(tNextFrame);
+        else
+            tNextFrame = now;           // we are behind, don't try to catch up
+    }
+    const double realDur = std::chrono::duration<double>(clock::now() - tRealStart).count();
+    nCalcTotal += LTFlightData::GetCalcQueueStats(true).cnt;
+
+    // Stop sending
+    gbStop = true;
+    sender.join();
+
+    // --- Summary ---
+    std::printf("\nReplayed %.0f simulated seconds in %.1f real seconds (%.1fx)\n",
+                vElapsed, realDur, vElapsed / std::max(realDur, 0.001));
+    std::printf("Positions received:   %zu (%.0f/s)\n", size_t(gnSent), double(gnSent) / std::max(realDur, 0.001));
+    std::printf("Positions calculated: %lu (%.0f/s)\n", nCalcTotal, double(nCalcTotal) / std::max(realDur, 0.001));
+    std::printf("Instance updates:     %llu, terrain probes: %llu\n",
+                XPLMHeadless::GetNumInstancePosUpdates(), XPLMHeadless::GetNumProbes());
+    std::printf("Frame time:           avg %.2f ms, max %.2f ms over %lu frames\n",
+                frmTotal.Avg(), frmTotal.max_ms, frmTotal.n);
+    std::printf("Memory:               RSS %.1f MB, peak %.1f MB\n",
+                ProcStatusMB("VmRSS:"), ProcStatusMB("VmHWM:"));
+
+    // Shutdown like XPluginDisable and XPluginStop
+    dataRefs.SetAircraftDisplayed(false);
+    LTMainDisable();
+    LTAptDisable();
+    LTMainStop();
+    dataRefs.Stop();
+    FlushMsg();
+    gpfnSysTime = nullptr;
+    XPLMHeadless::Cleanup();
+
+    if (cfg.bKeepDir)
+        std::printf("Log and config kept in %s\n", sRoot.c_str());
+    else
+        fs::remove_all(root, ec);
+    return 0;
+}
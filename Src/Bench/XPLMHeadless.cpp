@@ -0,0 +1,1308 @@
+/// @file       XPLMHeadless.cpp
+/// @brief      Headless implementation of the XPLM API for running LTCore outside X-Plane
+/// @details    Implements the subset of the XPLM API used by LiveTraffic, XPMP2, and ImgWindow.
+///             Functionality, which does not make sense without a simulator
+///             (windows, menus, drawing, maps), is accepted and ignored.\n
+///             Like in X-Plane, all functions are to be called from the main thread only,
+///             with the exception of XPLMDebugString().\n
+///             Should a future version of LiveTraffic or XPMP2 use another XPLM function,
+///             linking `lt_replay_bench` will fail on that symbol, which then needs adding here.
+/// @see        XPLMHeadless.h for the functions controlling the environment
+/// @author     Birger Hoppe
+/// @copyright  (c) 2024 Birger Hoppe
+/// @copyright  Permission is hereby granted, free of charge, to any person obtaining a
+///             copy of this software and associated documentation files (the "Software"),
+///             to deal in the Software without restriction, including without limitation
+///             the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the
+///             Software is furnished to do so, subject to the following conditions:\n
+///             The above copyright notice and this permission notice shall be included in
+///             all copies or substantial portions of the Software.\n
+///             THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///             IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///             FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///             AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///             LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///             OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+///             THE SOFTWARE.
+
+#include "XPLMHeadless.h"
+
+#include "XPLMCamera.h"
+#include "XPLMDataAccess.h"
+#include "XPLMDisplay.h"
+#include "XPLMGraphics.h"
+#include "XPLMInstance.h"
+#include "XPLMMap.h"
+#include "XPLMMenus.h"
+#include "XPLMNavigation.h"
+#include "XPLMPlanes.h"
+#include "XPLMPlugin.h"
+#include "XPLMProcessing.h"
+#include "XPLMScenery.h"
+#include "XPLMUtilities.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//
+// MARK: Environment
+//
+
+/// Our own plugin id, X-Plane itself is XPLM_PLUGIN_XPLANE
+constexpr XPLMPluginID HL_MY_ID = 1;
+/// Meters per degree latitude (and longitude at the equator)
+constexpr double HL_M_PER_DEG = 111319.49079327357;
+/// Simulated screen size
+constexpr int HL_SCREEN_W = 1920;
+constexpr int HL_SCREEN_H = 1080;
+
+static std::string gXPRoot;                     ///< X-Plane's root path
+static std::string gPluginFile;                 ///< path to the plugin file
+static std::string gPluginSig;                  ///< plugin signature
+static std::FILE* gLogFile = nullptr;           ///< receives XPLMDebugString() output
+static std::mutex gLogMutex;                    ///< guards gLogFile, XPLMDebugString() is thread-safe in X-Plane
+static XPLMError_f gErrCB = nullptr;            ///< error callback, kept but never called
+
+static double gElapsed = 0.0;                   ///< simulated time since startup
+static int    gCycle = 0;                       ///< flight loop cycle counter
+static double gRefLat = 0.0;                    ///< reference latitude, origin of local coordinates
+static double gRefLon = 0.0;                    ///< reference longitude, origin of local coordinates
+static double gRefAlt = 0.0;                    ///< reference altitude, camera and user's plane
+static double gTerrainElev = 0.0;               ///< elevation returned by terrain probes
+
+static size_t gNumInstances = 0;                ///< number of existing instances
+static unsigned long long gNumInstPosUpd = 0;   ///< number of XPLMInstanceSetPosition() calls
+static unsigned long long gNumProbes = 0;       ///< number of terrain probes
+
+static std::map<std::string,int> gFeatures;     ///< features and their enabled status
+
+//
+// MARK: DataRefs
+//
+
+/// A dataRef, either with its own storage or with accessors registered by a plugin
+struct HLDataRefTy {
+    std::string     name;
+    XPLMDataTypeID  type = xplmType_Int | xplmType_Float | xplmType_Double;
+    bool            bGood = true;           ///< false after the owning plugin unregistered it
+    // own storage
+    double              val = 0.0;
+    std::vector<int>    vi;
+    std::vector<float>  vf;
+    std::vector<char>   vb;
+    std::list<std::pair<XPLMDataChanged_f,void*>> listNotify;   ///< shared dataRef notifications
+    // accessors
+    bool                bAccessor = false;
+    bool                bWritable = true;
+    XPLMGetDatai_f      getI  = nullptr;    XPLMSetDatai_f      setI  = nullptr;
+    XPLMGetDataf_f      getF  = nullptr;    XPLMSetDataf_f      setF  = nullptr;
+    XPLMGetDatad_f      getD  = nullptr;    XPLMSetDatad_f      setD  = nullptr;
+    XPLMGetDatavi_f     getVI = nullptr;    XPLMSetDatavi_f     setVI = nullptr;
+    XPLMGetDatavf_f     getVF = nullptr;    XPLMSetDatavf_f     setVF = nullptr;
+    XPLMGetDatab_f      getB  = nullptr;    XPLMSetDatab_f      setB  = nullptr;
+    void*               readRefcon  = nullptr;
+    void*               writeRefcon = nullptr;
+
+    /// Inform sharing plugins about a change
+    void Notify () const { for (const auto& p: listNotify) if (p.first) p.first(p.second); }
+};
+
+/// All dataRefs by name
+static std::map<std::string,std::unique_ptr<HLDataRefTy>> gDataRefs;
+
+/// Find a dataRef by name, optionally create it with own storage
+static HLDataRefTy* HLFindDataRef (const std::string& name, bool bCreate)
+{
+    auto iter = gDataRefs.find(name);
+    if (iter != gDataRefs.end())
+        return iter->second.get();
+    if (!bCreate)
+        return nullptr;
+    HLDataRefTy* pDr = (gDataRefs[name] = std::make_unique<HLDataRefTy>()).get();
+    pDr->name = name;
+    return pDr;
+}
+
+/// Copy a range of array values out of own storage
+template <class T>
+static int HLGetArr (const std::vector<T>& v, T* out, int inOffset, int inMax)
+{
+    if (!out) return (int)v.size();
+    int n = 0;
+    for (int i = inOffset; i >= 0 && i < (int)v.size() && n < inMax; ++i, ++n)
+        out[n] = v[size_t(i)];
+    return n;
+}
+
+/// Copy a range of array values into own storage
+template <class T>
+static void HLSetArr (std::vector<T>& v, const T* in, int inOffset, int inCount)
+{
+    if (!in || inOffset < 0 || inCount <= 0) return;
+    if (v.size() < size_t(inOffset + inCount))
+        v.resize(size_t(inOffset + inCount));
+    std::copy(in, in + inCount, v.begin() + inOffset);
+}
+
+//
+// MARK: Flight Loops
+//
+
+/// A flight loop callback
+struct HLFlightLoopTy {
+    XPLMFlightLoop_f    cb = nullptr;
+    void*               refcon = nullptr;
+    bool                bScheduled = false;     ///< to be called at all?
+    bool                bFrames = false;        ///< counting frames (or seconds)?
+    double              tNext = 0.0;            ///< next call due at this elapsed time
+    int                 framesLeft = 0;         ///< next call due after this many frames
+    double              tLastCall = 0.0;        ///< elapsed time of last call
+    bool                bDeleted = false;       ///< unregistered/destroyed, to be removed after current frame
+
+    /// Schedule the next call as per XPLM's interval semantics
+    void Schedule (float interval, double tBase)
+    {
+        bScheduled = std::abs(interval) > 0.0f;
+        bFrames = interval < 0.0f;
+        framesLeft = bFrames ? std::max(1, int(-interval)) : 0;
+        tNext = tBase + double(interval);
+    }
+};
+
+/// All flight loops, a list so that entries stay valid while callbacks register new ones
+static std::list<HLFlightLoopTy> gFlightLoops;
+
+/// Find an old-style flight loop by callback and refcon
+static HLFlightLoopTy* HLFindFlightLoop (XPLMFlightLoop_f cb, void* refcon)
+{
+    for (HLFlightLoopTy& fl: gFlightLoops)
+        if (!fl.bDeleted && fl.cb == cb && fl.refcon == refcon)
+            return &fl;
+    return nullptr;
+}
+
+//
+// MARK: Objects and Instances
+//
+
+/// A loaded object, we only remember its path
+struct HLObjectTy {
+    std::string path;
+};
+
+/// A pending asynchronous object load
+struct HLObjLoadTy {
+    std::string         path;
+    XPLMObjectLoaded_f  cb = nullptr;
+    void*               refcon = nullptr;
+};
+static std::list<HLObjLoadTy> gObjLoads;
+
+/// An object instance
+struct HLInstanceTy {
+    XPLMObjectRef   obj = nullptr;
+    XPLMDrawInfo_t  pos;
+};
+
+//
+// MARK: Commands, Windows, Menus
+//
+
+/// A command with its handlers
+struct HLCommandTy {
+    std::string name;
+    struct HandlerTy {
+        XPLMCommandCallback_f   cb = nullptr;
+        int                     before = 0;
+        void*                   refcon = nullptr;
+    };
+    std::list<HandlerTy> listHandlers;
+
+    /// Call all handlers for one phase
+    void Call (XPLMCommandPhase phase)
+    {
+        for (const HandlerTy& h: listHandlers)
+            if (h.cb && !h.cb(this, phase, h.refcon))
+                break;
+    }
+};
+static std::map<std::string,std::unique_ptr<HLCommandTy>> gCommands;
+
+/// A window, which is never drawn, but remembers its settings
+struct HLWindowTy {
+    int     left = 0, top = 0, right = 0, bottom = 0;
+    int     visible = 0;
+    void*   refcon = nullptr;
+};
+
+/// Menus are just numbered, number of items per menu
+static std::map<XPLMMenuID,int> gMenus;
+static intptr_t gNextMenuId = 1;
+
+static int gNextTextureId = 1;                  ///< texture ids handed out
+
+//
+// MARK: Environment control
+//
+
+namespace XPLMHeadless {
+
+// Initialize the environment
+void Init (const std::string& _xpRoot,
+           const std::string& _pluginFile,
+           const std::string& _pluginSig,
+           const std::string& _logFile)
+{
+    gXPRoot     = _xpRoot;
+    gPluginFile = _pluginFile;
+    gPluginSig  = _pluginSig;
+    {
+        std::lock_guard<std::mutex> lock(gLogMutex);
+        if (gLogFile) std::fclose(gLogFile);
+        gLogFile = std::fopen(_logFile.c_str(), "w");
+    }
+    SetDataRef("sim/time/use_system_time", 1.0);
+    SetDataRef("sim/graphics/view/view_is_external", 1.0);
+    SetDataRef("sim/graphics/view/using_modern_driver", 1.0);
+    SetElapsedTime(0.0);
+}
+
+// Cleanup, closes the log file
+void Cleanup ()
+{
+    std::lock_guard<std::mutex> lock(gLogMutex);
+    if (gLogFile) std::fclose(gLogFile);
+    gLogFile = nullptr;
+}
+
+// Set the reference position
+void SetRefPos (double lat, double lon, double alt_m)
+{
+    gRefLat = lat;
+    gRefLon = lon;
+    gRefAlt = alt_m;
+    SetDataRef("sim/flightmodel/position/latitude", lat);
+    SetDataRef("sim/flightmodel/position/longitude", lon);
+    SetDataRef("sim/flightmodel/position/elevation", alt_m);
+    SetDataRef("sim/flightmodel/position/local_x", 0.0);
+    SetDataRef("sim/flightmodel/position/local_y", alt_m);
+    SetDataRef("sim/flightmodel/position/local_z", 0.0);
+    SetDataRef("sim/flightmodel/position/y_agl", alt_m - gTerrainElev);
+}
+
+// Set the terrain elevation
+void SetTerrainElev (double alt_m)
+{
+    gTerrainElev = alt_m;
+}
+
+// Set the (simulated) time since startup
+void SetElapsedTime (double t)
+{
+    gElapsed = t;
+    SetDataRef("sim/time/total_running_time_sec", t);
+    SetDataRef("sim/time/total_flight_time_sec", t);
+    SetDataRef("sim/network/misc/network_time_sec", t);
+}
+
+// Executes one frame
+void RunFrame (float frameDur_s)
+{
+    ++gCycle;
+
+    // Pending object loads finish now
+    while (!gObjLoads.empty()) {
+        HLObjLoadTy ol = std::move(gObjLoads.front());
+        gObjLoads.pop_front();
+        if (ol.cb)
+            ol.cb(XPLMLoadObject(ol.path.c_str()), ol.refcon);
+    }
+
+    // Call all due flight loops. Callbacks may register new ones,
+    // which are appended to the list and considered in the same frame.
+    for (HLFlightLoopTy& fl: gFlightLoops) {
+        if (fl.bDeleted || !fl.bScheduled) continue;
+        if (fl.bFrames ? --fl.framesLeft > 0 : fl.tNext > gElapsed) continue;
+        const float elapsedSince = float(gElapsed - fl.tLastCall);
+        fl.tLastCall = gElapsed;
+        const float next = fl.cb(elapsedSince, frameDur_s, gCycle, fl.refcon);
+        if (!fl.bDeleted)
+            fl.Schedule(next, gElapsed);
+    }
+    gFlightLoops.remove_if([](const HLFlightLoopTy& fl){ return fl.bDeleted; });
+}
+
+// Set a dataRef held by the headless environment
+void SetDataRef (const std::string& name, double val)
+{
+    HLDataRefTy* pDr = HLFindDataRef(name, true);
+    if (pDr->bAccessor) return;
+    pDr->val = val;
+    pDr->Notify();
+}
+
+// Number of currently existing object instances
+size_t GetNumInstances ()
+{
+    return gNumInstances;
+}
+
+// Total number of XPLMInstanceSetPosition() calls so far
+unsigned long long GetNumInstancePosUpdates ()
+{
+    return gNumInstPosUpd;
+}
+
+// Total number of terrain probe calls so far
+unsigned long long GetNumProbes ()
+{
+    return gNumProbes;
+}
+
+}
+
+//
+// MARK: XPLMDataAccess
+//
+
+XPLMDataRef XPLMFindDataRef (const char* inDataRefName)
+{
+    if (!inDataRefName) return nullptr;
+    // X-Plane's own dataRefs all exist, reading 0 unless set,
+    // everything else must have been registered or shared
+    const bool bSim = std::strncmp(inDataRefName, "sim/", 4) == 0;
+    HLDataRefTy* pDr = HLFindDataRef(inDataRefName, bSim);
+    return pDr && pDr->bGood ? pDr : nullptr;
+}
+
+int XPLMCanWriteDataRef (XPLMDataRef inDataRef)
+{
+    const HLDataRefTy* pDr = static_cast<const HLDataRefTy*>(inDataRef);
+    return pDr && pDr->bWritable;
+}
+
+int XPLMIsDataRefGood (XPLMDataRef inDataRef)
+{
+    const HLDataRefTy* pDr = static_cast<const HLDataRefTy*>(inDataRef);
+    return pDr && pDr->bGood;
+}
+
+XPLMDataTypeID XPLMGetDataRefTypes (XPLMDataRef inDataRef)
+{
+    const HLDataRefTy* pDr = static_cast<const HLDataRefTy*>(inDataRef);
+    return pDr ? pDr->type : xplmType_Unknown;
+}
+
+int XPLMGetDatai (XPLMDataRef inDataRef)
+{
+    const HLDataRefTy* pDr = static_cast<const HLDataRefTy*>(inDataRef);
+    if (!pDr || !pDr->bGood) return 0;
+    if (pDr->bAccessor) return pDr->getI ? pDr->getI(pDr->readRefcon) : 0;
+    return int(pDr->val);
+}
+
+void XPLMSetDatai (XPLMDataRef inDataRef, int inValue)
+{
+    HLDataRefTy* pDr = static_cast<HLDataRefTy*>(inDataRef);
+    if (!pDr || !pDr->bGood) return;
+    if (pDr->bAccessor) { if (pDr->setI) pDr->setI(pDr->writeRefcon, inValue); return; }
+    pDr->val = double(inValue);
+    pDr->Notify();
+}
+
+float XPLMGetDataf (XPLMDataRef inDataRef)
+{
+    const HLDataRefTy* pDr = static_cast<const HLDataRefTy*>(inDataRef);
+    if (!pDr || !pDr->bGood) return 0.0f;
+    if (pDr->bAccessor) return pDr->getF ? pDr->getF(pDr->readRefcon) : 0.0f;
+    return float(pDr->val);
+}
+
+void XPLMSetDataf (XPLMDataRef inDataRef, float inValue)
+{
+    HLDataRefTy* pDr = static_cast<HLDataRefTy*>(inDataRef);
+    if (!pDr || !pDr->bGood) return;
+    if (pDr->bAccessor) { if (pDr->setF) pDr->setF(pDr->writeRefcon, inValue); return; }
+    pDr->val = double(inValue);
+    pDr->Notify();
+}
+
+double XPLMGetDatad (XPLMDataRef inDataRef)
+{
+    const HLDataRefTy* pDr = static_cast<const HLDataRefTy*>(inDataRef);
+    if (!pDr || !pDr->bGood) return 0.0;
+    if (pDr->bAccessor) return pDr->getD ? pDr->getD(pDr->readRefcon) : 0.0;
+    return pDr->val;
+}
+
+void XPLMSetDatad (XPLMDataRef inDataRef, double inValue)
+{
+    HLDataRefTy* pDr = static_cast<HLDataRefTy*>(inDataRef);
+    if (!pDr || !pDr->bGood) return;
+    if (pDr->bAccessor) { if (pDr->setD) pDr->setD(pDr->writeRefcon, inValue); return; }
+    pDr->val = inValue;
+    pDr->Notify();
+}
+
+int XPLMGetDatavi (XPLMDataRef inDataRef, int* outValues, int inOffset, int inMax)
+{
+    const HLDataRefTy* pDr = static_cast<const HLDataRefTy*>(inDataRef);
+    if (!pDr || !pDr->bGood) return 0;
+    if (pDr->bAccessor) return pDr->getVI ? pDr->getVI(pDr->readRefcon, outValues, inOffset, inMax) : 0;
+    return HLGetArr(pDr->vi, outValues, inOffset, inMax);
+}
+
+void XPLMSetDatavi (XPLMDataRef inDataRef, int* inValues, int inoffset, int inCount)
+{
+    HLDataRefTy* pDr = static_cast<HLDataRefTy*>(inDataRef);
+    if (!pDr || !pDr->bGood) return;
+    if (pDr->bAccessor) { if (pDr->setVI) pDr->setVI(pDr->writeRefcon, inValues, inoffset, inCount); return; }
+    HLSetArr(pDr->vi, inValues, inoffset, inCount);
+    pDr->Notify();
+}
+
+int XPLMGetDatavf (XPLMDataRef inDataRef, float* outValues, int inOffset, int inMax)
+{
+    const HLDataRefTy* pDr = static_cast<const HLDataRefTy*>(inDataRef);
+    if (!pDr || !pDr->bGood) return 0;
+    if (pDr->bAccessor) return pDr->getVF ? pDr->getVF(pDr->readRefcon, outValues, inOffset, inMax) : 0;
+    return HLGetArr(pDr->vf, outValues, inOffset, inMax);
+}
+
+void XPLMSetDatavf (XPLMDataRef inDataRef, float* inValues, int inoffset, int inCount)
+{
+    HLDataRefTy* pDr = static_cast<HLDataRefTy*>(inDataRef);
+    if (!pDr || !pDr->bGood) return;
+    if (pDr->bAccessor) { if (pDr->setVF) pDr->setVF(pDr->writeRefcon, inValues, inoffset, inCount); return; }
+    HLSetArr(pDr->vf, inValues, inoffset, inCount);
+    pDr->Notify();
+}
+
+int XPLMGetDatab (XPLMDataRef inDataRef, void* outValue, int inOffset, int inMaxBytes)
+{
+    const HLDataRefTy* pDr = static_cast<const HLDataRefTy*>(inDataRef);
+    if (!pDr || !pDr->bGood) return 0;
+    if (pDr->bAccessor) return pDr->getB ? pDr->getB(pDr->readRefcon, outValue, inOffset, inMaxBytes) : 0;
+    return HLGetArr(pDr->vb, static_cast<char*>(outValue), inOffset, inMaxBytes);
+}
+
+void XPLMSetDatab (XPLMDataRef inDataRef, void* inValue, int inOffset, int inLength)
+{
+    HLDataRefTy* pDr = static_cast<HLDataRefTy*>(inDataRef);
+    if (!pDr || !pDr->bGood) return;
+    if (pDr->bAccessor) { if (pDr->setB) pDr->setB(pDr->writeRefcon, inValue, inOffset, inLength); return; }
+    HLSetArr(pDr->vb, static_cast<const char*>(inValue), inOffset, inLength);
+    pDr->Notify();
+}
+
+XPLMDataRef XPLMRegisterDataAccessor (const char* inDataName,
+                                      XPLMDataTypeID inDataType, int inIsWritable,
+                                      XPLMGetDatai_f inReadInt, XPLMSetDatai_f inWriteInt,
+                                      XPLMGetDataf_f inReadFloat, XPLMSetDataf_f inWriteFloat,
+                                      XPLMGetDatad_f inReadDouble, XPLMSetDatad_f inWriteDouble,
+                                      XPLMGetDatavi_f inReadIntArray, XPLMSetDatavi_f inWriteIntArray,
+                                      XPLMGetDatavf_f inReadFloatArray, XPLMSetDatavf_f inWriteFloatArray,
+                                      XPLMGetDatab_f inReadData, XPLMSetDatab_f inWriteData,
+                                      void* inReadRefcon, void* inWriteRefcon)
+{
+    if (!inDataName) return nullptr;
+    HLDataRefTy* pDr = HLFindDataRef(inDataName, true);
+    pDr->type       = inDataType;
+    pDr->bGood      = true;
+    pDr->bAccessor  = true;
+    pDr->bWritable  = inIsWritable != 0;
+    pDr->getI  = inReadInt;         pDr->setI  = inWriteInt;
+    pDr->getF  = inReadFloat;       pDr->setF  = inWriteFloat;
+    pDr->getD  = inReadDouble;      pDr->setD  = inWriteDouble;
+    pDr->getVI = inReadIntArray;    pDr->setVI = inWriteIntArray;
+    pDr->getVF = inReadFloatArray;  pDr->setVF = inWriteFloatArray;
+    pDr->getB  = inReadData;        pDr->setB  = inWriteData;
+    pDr->readRefcon  = inReadRefcon;
+    pDr->writeRefcon = inWriteRefcon;
+    return pDr;
+}
+
+void XPLMUnregisterDataAccessor (XPLMDataRef inDataRef)
+{
+    HLDataRefTy* pDr = static_cast<HLDataRefTy*>(inDataRef);
+    if (!pDr) return;
+    pDr->bAccessor = false;
+    pDr->bGood = false;
+}
+
+int XPLMShareData (const char* inDataName, XPLMDataTypeID inDataType,
+                   XPLMDataChanged_f inNotificationFunc, void* inNotificationRefcon)
+{
+    if (!inDataName) return 0;
+    HLDataRefTy* pDr = HLFindDataRef(inDataName, true);
+    if (pDr->bAccessor) return 0;               // owned by someone else
+    if (!pDr->listNotify.empty() && pDr->type != inDataType)
+        return 0;                               // shared already with another type
+    pDr->type = inDataType;
+    pDr->bGood = true;
+    pDr->listNotify.emplace_back(inNotificationFunc, inNotificationRefcon);
+    return 1;
+}
+
+int XPLMUnshareData (const char* inDataName, XPLMDataTypeID /*inDataType*/,
+                     XPLMDataChanged_f inNotificationFunc, void* inNotificationRefcon)
+{
+    if (!inDataName) return 0;
+    HLDataRefTy* pDr = HLFindDataRef(inDataName, false);
+    if (!pDr) return 0;
+    pDr->listNotify.remove(std::make_pair(inNotificationFunc, inNotificationRefcon));
+    return 1;
+}
+
+//
+// MARK: XPLMProcessing
+//
+
+float XPLMGetElapsedTime ()
+{
+    return float(gElapsed);
+}
+
+int XPLMGetCycleNumber ()
+{
+    return gCycle;
+}
+
+void XPLMRegisterFlightLoopCallback (XPLMFlightLoop_f inFlightLoop, float inInterval, void* inRefcon)
+{
+    HLFlightLoopTy fl;
+    fl.cb = inFlightLoop;
+    fl.refcon = inRefcon;
+    fl.tLastCall = gElapsed;
+    fl.Schedule(inInterval, gElapsed);
+    gFlightLoops.push_back(fl);
+}
+
+void XPLMUnregisterFlightLoopCallback (XPLMFlightLoop_f inFlightLoop, void* inRefcon)
+{
+    HLFlightLoopTy* pFl = HLFindFlightLoop(inFlightLoop, inRefcon);
+    if (pFl) pFl->bDeleted = true;
+}
+
+void XPLMSetFlightLoopCallbackInterval (XPLMFlightLoop_f inFlightLoop, float inInterval,
+                                        int inRelativeToNow, void* inRefcon)
+{
+    HLFlightLoopTy* pFl = HLFindFlightLoop(inFlightLoop, inRefcon);
+    if (pFl) pFl->Schedule(inInterval, inRelativeToNow ? gElapsed : pFl->tLastCall);
+}
+
+XPLMFlightLoopID XPLMCreateFlightLoop (XPLMCreateFlightLoop_t* inParams)
+{
+    if (!inParams) return nullptr;
+    HLFlightLoopTy fl;
+    fl.cb = inParams->callbackFunc;
+    fl.refcon = inParams->refcon;
+    fl.tLastCall = gElapsed;
+    gFlightLoops.push_back(fl);
+    return &gFlightLoops.back();
+}
+
+void XPLMDestroyFlightLoop (XPLMFlightLoopID inFlightLoopID)
+{
+    HLFlightLoopTy* pFl = static_cast<HLFlightLoopTy*>(inFlightLoopID);
+    if (pFl) pFl->bDeleted = true;
+}
+
+void XPLMScheduleFlightLoop (XPLMFlightLoopID inFlightLoopID, float inInterval, int inRelativeToNow)
+{
+    HLFlightLoopTy* pFl = static_cast<HLFlightLoopTy*>(inFlightLoopID);
+    if (pFl) pFl->Schedule(inInterval, inRelativeToNow ? gElapsed : pFl->tLastCall);
+}
+
+//
+// MARK: XPLMGraphics
+//
+
+void XPLMSetGraphicsState (int, int, int, int, int, int, int)
+{}
+
+void XPLMBindTexture2d (int /*inTextureNum*/, int /*inTextureUnit*/)
+{}
+
+void XPLMGenerateTextureNumbers (int* outTextureIDs, int inCount)
+{
+    for (int i = 0; outTextureIDs && i < inCount; ++i)
+        outTextureIDs[i] = gNextTextureId++;
+}
+
+int XPLMGetTexture (XPLMTextureID /*inTexture*/)
+{
+    return 0;
+}
+
+void XPLMWorldToLocal (double inLatitude, double inLongitude, double inAltitude,
+                       double* outX, double* outY, double* outZ)
+{
+    if (outX) *outX = (inLongitude - gRefLon) * HL_M_PER_DEG * std::cos(gRefLat * M_PI / 180.0);
+    if (outY) *outY = inAltitude;
+    if (outZ) *outZ = -(inLatitude - gRefLat) * HL_M_PER_DEG;
+}
+
+void XPLMLocalToWorld (double inX, double inY, double inZ,
+                       double* outLatitude, double* outLongitude, double* outAltitude)
+{
+    if (outLatitude)  *outLatitude  = gRefLat - inZ / HL_M_PER_DEG;
+    if (outLongitude) *outLongitude = gRefLon + inX / (HL_M_PER_DEG * std::cos(gRefLat * M_PI / 180.0));
+    if (outAltitude)  *outAltitude  = inY;
+}
+
+void XPLMDrawTranslucentDarkBox (int, int, int, int)
+{}
+
+void XPLMDrawString (float* /*inColorRGB*/, int /*inXOffset*/, int /*inYOffset*/,
+                     char* /*inChar*/, int* /*inWordWrapWidth*/, XPLMFontID /*inFontID*/)
+{}
+
+void XPLMGetFontDimensions (XPLMFontID /*inFontID*/, int* outCharWidth, int* outCharHeight, int* outDigitsOnly)
+{
+    if (outCharWidth)  *outCharWidth = 8;
+    if (outCharHeight) *outCharHeight = 12;
+    if (outDigitsOnly) *outDigitsOnly = 0;
+}
+
+float XPLMMeasureString (XPLMFontID /*inFontID*/, const char* /*inChar*/, int inNumChars)
+{
+    return 8.0f * float(inNumChars);
+}
+
+//
+// MARK: XPLMDisplay
+//
+
+int XPLMRegisterDrawCallback (XPLMDrawCallback_f, XPLMDrawingPhase, int, void*)
+{
+    return 1;
+}
+
+int XPLMUnregisterDrawCallback (XPLMDrawCallback_f, XPLMDrawingPhase, int, void*)
+{
+    return 1;
+}
+
+XPLMWindowID XPLMCreateWindowEx (XPLMCreateWindow_t* inParams)
+{
+    HLWindowTy* pWnd = new HLWindowTy();
+    if (inParams) {
+        pWnd->left      = inParams->left;
+        pWnd->top       = inParams->top;
+        pWnd->right     = inParams->right;
+        pWnd->bottom    = inParams->bottom;
+        pWnd->visible   = inParams->visible;
+        pWnd->refcon    = inParams->refcon;
+    }
+    return pWnd;
+}
+
+void XPLMDestroyWindow (XPLMWindowID inWindowID)
+{
+    delete static_cast<HLWindowTy*>(inWindowID);
+}
+
+void XPLMGetScreenSize (int* outWidth, int* outHeight)
+{
+    if (outWidth)  *outWidth  = HL_SCREEN_W;
+    if (outHeight) *outHeight = HL_SCREEN_H;
+}
+
+void XPLMGetScreenBoundsGlobal (int* outLeft, int* outTop, int* outRight, int* outBottom)
+{
+    if (outLeft)   *outLeft   = 0;
+    if (outTop)    *outTop    = HL_SCREEN_H;
+    if (outRight)  *outRight  = HL_SCREEN_W;
+    if (outBottom) *outBottom = 0;
+}
+
+void XPLMGetAllMonitorBoundsGlobal (XPLMReceiveMonitorBoundsGlobal_f inMonitorBoundsCallback, void* inRefcon)
+{
+    if (inMonitorBoundsCallback)
+        inMonitorBoundsCallback(0, 0, HL_SCREEN_H, HL_SCREEN_W, 0, inRefcon);
+}
+
+void XPLMGetMouseLocationGlobal (int* outX, int* outY)
+{
+    if (outX) *outX = 0;
+    if (outY) *outY = 0;
+}
+
+void XPLMGetWindowGeometry (XPLMWindowID inWindowID, int* outLeft, int* outTop, int* outRight, int* outBottom)
+{
+    const HLWindowTy* pWnd = static_cast<const HLWindowTy*>(inWindowID);
+    if (!pWnd) return;
+    if (outLeft)   *outLeft   = pWnd->left;
+    if (outTop)    *outTop    = pWnd->top;
+    if (outRight)  *outRight  = pWnd->right;
+    if (outBottom) *outBottom = pWnd->bottom;
+}
+
+void XPLMSetWindowGeometry (XPLMWindowID inWindowID, int inLeft, int inTop, int inRight, int inBottom)
+{
+    HLWindowTy* pWnd = static_cast<HLWindowTy*>(inWindowID);
+    if (!pWnd) return;
+    pWnd->left   = inLeft;
+    pWnd->top    = inTop;
+    pWnd->right  = inRight;
+    pWnd->bottom = inBottom;
+}
+
+void XPLMGetWindowGeometryOS (XPLMWindowID inWindowID, int* outLeft, int* outTop, int* outRight, int* outBottom)
+{
+    XPLMGetWindowGeometry(inWindowID, outLeft, outTop, outRight, outBottom);
+}
+
+void XPLMSetWindowGeometryOS (XPLMWindowID inWindowID, int inLeft, int inTop, int inRight, int inBottom)
+{
+    XPLMSetWindowGeometry(inWindowID, inLeft, inTop, inRight, inBottom);
+}
+
+void XPLMGetWindowGeometryVR (XPLMWindowID inWindowID, int* outWidthBoxels, int* outHeightBoxels)
+{
+    const HLWindowTy* pWnd = static_cast<const HLWindowTy*>(inWindowID);
+    if (!pWnd) return;
+    if (outWidthBoxels)  *outWidthBoxels  = pWnd->right - pWnd->left;
+    if (outHeightBoxels) *outHeightBoxels = pWnd->top - pWnd->bottom;
+}
+
+void XPLMSetWindowGeometryVR (XPLMWindowID inWindowID, int widthBoxels, int heightBoxels)
+{
+    HLWindowTy* pWnd = static_cast<HLWindowTy*>(inWindowID);
+    if (!pWnd) return;
+    pWnd->right = pWnd->left + widthBoxels;
+    pWnd->bottom = pWnd->top - heightBoxels;
+}
+
+int XPLMGetWindowIsVisible (XPLMWindowID inWindowID)
+{
+    const HLWindowTy* pWnd = static_cast<const HLWindowTy*>(inWindowID);
+    return pWnd ? pWnd->visible : 0;
+}
+
+void XPLMSetWindowIsVisible (XPLMWindowID inWindowID, int inIsVisible)
+{
+    HLWindowTy* pWnd = static_cast<HLWindowTy*>(inWindowID);
+    if (pWnd) pWnd->visible = inIsVisible;
+}
+
+void* XPLMGetWindowRefCon (XPLMWindowID inWindowID)
+{
+    const HLWindowTy* pWnd = static_cast<const HLWindowTy*>(inWindowID);
+    return pWnd ? pWnd->refcon : nullptr;
+}
+
+void XPLMSetWindowRefCon (XPLMWindowID inWindowID, void* inRefcon)
+{
+    HLWindowTy* pWnd = static_cast<HLWindowTy*>(inWindowID);
+    if (pWnd) pWnd->refcon = inRefcon;
+}
+
+int XPLMWindowIsPoppedOut (XPLMWindowID /*inWindowID*/)                 { return 0; }
+int XPLMWindowIsInVR (XPLMWindowID /*inWindowID*/)                      { return 0; }
+void XPLMSetWindowGravity (XPLMWindowID, float, float, float, float)   {}
+void XPLMSetWindowResizingLimits (XPLMWindowID, int, int, int, int)    {}
+void XPLMSetWindowPositioningMode (XPLMWindowID, XPLMWindowPositioningMode, int) {}
+void XPLMSetWindowTitle (XPLMWindowID, const char*)                     {}
+void XPLMTakeKeyboardFocus (XPLMWindowID /*inWindow*/)                  {}
+int XPLMHasKeyboardFocus (XPLMWindowID /*inWindow*/)                    { return 0; }
+void XPLMBringWindowToFront (XPLMWindowID /*inWindow*/)                 {}
+int XPLMIsWindowInFront (XPLMWindowID /*inWindow*/)                     { return 1; }
+
+//
+// MARK: XPLMMap
+//
+
+int XPLMMapExists (const char* /*mapIdentifier*/)                       { return 0; }
+XPLMMapLayerID XPLMCreateMapLayer (XPLMCreateMapLayer_t* /*inParams*/)  { return nullptr; }
+int XPLMDestroyMapLayer (XPLMMapLayerID /*inLayer*/)                    { return 0; }
+void XPLMRegisterMapCreationHook (XPLMMapCreatedCallback_f, void*)      {}
+
+void XPLMDrawMapIconFromSheet (XPLMMapLayerID, const char*, int, int, int, int,
+                               float, float, XPLMMapOrientation, float, float)
+{}
+
+void XPLMDrawMapLabel (XPLMMapLayerID, const char*, float, float, XPLMMapOrientation, float)
+{}
+
+void XPLMMapProject (XPLMMapProjectionID, double, double, float* outX, float* outY)
+{
+    if (outX) *outX = 0.0f;
+    if (outY) *outY = 0.0f;
+}
+
+void XPLMMapUnproject (XPLMMapProjectionID, float, float, double* outLatitude, double* outLongitude)
+{
+    if (outLatitude)  *outLatitude  = gRefLat;
+    if (outLongitude) *outLongitude = gRefLon;
+}
+
+float XPLMMapScaleMeter (XPLMMapProjectionID, float, float)             { return 1.0f; }
+float XPLMMapGetNorthHeading (XPLMMapProjectionID, float, float)        { return 0.0f; }
+
+//
+// MARK: XPLMMenus
+//
+
+XPLMMenuID XPLMFindPluginsMenu ()
+{
+    return reinterpret_cast<XPLMMenuID>(intptr_t(-1));
+}
+
+XPLMMenuID XPLMFindAircraftMenu ()
+{
+    return nullptr;
+}
+
+XPLMMenuID XPLMCreateMenu (const char*, XPLMMenuID, int, XPLMMenuHandler_f, void*)
+{
+    XPLMMenuID id = reinterpret_cast<XPLMMenuID>(gNextMenuId++);
+    gMenus[id] = 0;
+    return id;
+}
+
+void XPLMDestroyMenu (XPLMMenuID inMenuID)
+{
+    gMenus.erase(inMenuID);
+}
+
+void XPLMClearAllMenuItems (XPLMMenuID inMenuID)
+{
+    gMenus[inMenuID] = 0;
+}
+
+int XPLMAppendMenuItem (XPLMMenuID inMenu, const char*, void*, int)
+{
+    return gMenus[inMenu]++;
+}
+
+int XPLMAppendMenuItemWithCommand (XPLMMenuID inMenu, const char*, XPLMCommandRef)
+{
+    return gMenus[inMenu]++;
+}
+
+void XPLMAppendMenuSeparator (XPLMMenuID inMenu)
+{
+    gMenus[inMenu]++;
+}
+
+void XPLMSetMenuItemName (XPLMMenuID, int, const char*, int)            {}
+void XPLMCheckMenuItem (XPLMMenuID, int, XPLMMenuCheck)                 {}
+void XPLMEnableMenuItem (XPLMMenuID, int, int)                          {}
+void XPLMRemoveMenuItem (XPLMMenuID, int)                               {}
+
+void XPLMCheckMenuItemState (XPLMMenuID, int, XPLMMenuCheck* outCheck)
+{
+    if (outCheck) *outCheck = xplm_Menu_NoCheck;
+}
+
+//
+// MARK: XPLMNavigation
+//
+
+XPLMNavRef XPLMFindNavAid (const char*, const char*, float*, float*, int*, XPLMNavType)
+{
+    return XPLM_NAV_NOT_FOUND;
+}
+
+void XPLMGetNavAidInfo (XPLMNavRef, XPLMNavType* outType, float*, float*, float*,
+                        int*, float*, char* outID, char* outName, char* outReg)
+{
+    if (outType) *outType = xplm_Nav_Unknown;
+    if (outID)   *outID   = 0;
+    if (outName) *outName = 0;
+    if (outReg)  *outReg  = 0;
+}
+
+//
+// MARK: XPLMPlanes
+//
+
+static bool gbPlanesAcquired = false;       ///< did we acquire the planes?
+static int  gActiveAircraft = 1;            ///< number of active AI aircraft
+
+int XPLMAcquirePlanes (char** /*inAircraft*/, XPLMPlanesAvailable_f, void*)
+{
+    gbPlanesAcquired = true;
+    return 1;
+}
+
+void XPLMReleasePlanes ()
+{
+    gbPlanesAcquired = false;
+}
+
+void XPLMSetActiveAircraftCount (int inCount)
+{
+    gActiveAircraft = inCount;
+}
+
+void XPLMCountAircraft (int* outTotalAircraft, int* outActiveAircraft, XPLMPluginID* outController)
+{
+    if (outTotalAircraft)  *outTotalAircraft  = std::max(gActiveAircraft, 20);
+    if (outActiveAircraft) *outActiveAircraft = gActiveAircraft;
+    if (outController)     *outController     = gbPlanesAcquired ? HL_MY_ID : XPLM_NO_PLUGIN_ID;
+}
+
+void XPLMGetNthAircraftModel (int /*inIndex*/, char* outFileName, char* outPath)
+{
+    if (outFileName) *outFileName = 0;
+    if (outPath)     *outPath     = 0;
+}
+
+void XPLMDisableAIForPlane (int /*inPlaneIndex*/)
+{}
+
+//
+// MARK: XPLMPlugin
+//
+
+XPLMPluginID XPLMGetMyID ()
+{
+    return HL_MY_ID;
+}
+
+int XPLMCountPlugins ()
+{
+    return 1;
+}
+
+XPLMPluginID XPLMGetNthPlugin (int inIndex)
+{
+    return inIndex == 0 ? HL_MY_ID : XPLM_NO_PLUGIN_ID;
+}
+
+XPLMPluginID XPLMFindPluginBySignature (const char* inSignature)
+{
+    return inSignature && gPluginSig == inSignature ? HL_MY_ID : XPLM_NO_PLUGIN_ID;
+}
+
+void XPLMGetPluginInfo (XPLMPluginID inPlugin, char* outName, char* outFilePath,
+                        char* outSignature, char* outDescription)
+{
+    const bool bMe = inPlugin == HL_MY_ID;
+    // buffers are 256 bytes as per SDK documentation, we stay safely below
+    if (outName)        std::snprintf(outName, 256, "%s", bMe ? "LiveTraffic" : "X-Plane");
+    if (outFilePath)    std::snprintf(outFilePath, 256, "%s", bMe ? gPluginFile.c_str() : "");
+    if (outSignature)   std::snprintf(outSignature, 256, "%s", bMe ? gPluginSig.c_str() : "xplane");
+    if (outDescription) std::snprintf(outDescription, 256, "%s", bMe ? "headless" : "X-Plane");
+}
+
+int XPLMIsPluginEnabled (XPLMPluginID inPluginID)
+{
+    return inPluginID == HL_MY_ID;
+}
+
+int XPLMEnablePlugin (XPLMPluginID inPluginID)
+{
+    return inPluginID == HL_MY_ID;
+}
+
+void XPLMDisablePlugin (XPLMPluginID /*inPluginID*/)                    {}
+void XPLMReloadPlugins ()                                               {}
+void XPLMSendMessageToPlugin (XPLMPluginID, int, void*)                 {}
+
+int XPLMHasFeature (const char* /*inFeature*/)
+{
+    return 1;
+}
+
+int XPLMIsFeatureEnabled (const char* inFeature)
+{
+    if (!inFeature) return 0;
+    auto iter = gFeatures.find(inFeature);
+    return iter != gFeatures.end() ? iter->second : 0;
+}
+
+void XPLMEnableFeature (const char* inFeature, int inEnable)
+{
+    if (inFeature) gFeatures[inFeature] = inEnable;
+}
+
+void XPLMEnumerateFeatures (XPLMFeatureEnumerator_f inEnumerator, void* inRef)
+{
+    for (const auto& p: gFeatures)
+        if (inEnumerator) inEnumerator(p.first.c_str(), inRef);
+}
+
+//
+// MARK: XPLMScenery
+//
+
+XPLMProbeRef XPLMCreateProbe (XPLMProbeType /*inProbeType*/)
+{
+    static int probeToken = 0;
+    return &probeToken;
+}
+
+void XPLMDestroyProbe (XPLMProbeRef /*inProbe*/)
+{}
+
+XPLMProbeResult XPLMProbeTerrainXYZ (XPLMProbeRef /*inProbe*/, float inX, float /*inY*/, float inZ,
+                                     XPLMProbeInfo_t* outInfo)
+{
+    ++gNumProbes;
+    if (outInfo && outInfo->structSize >= int(sizeof(XPLMProbeInfo_t))) {
+        outInfo->locationX = inX;
+        outInfo->locationY = float(gTerrainElev);
+        outInfo->locationZ = inZ;
+        outInfo->normalX = 0.0f;
+        outInfo->normalY = 1.0f;
+        outInfo->normalZ = 0.0f;
+        outInfo->velocityX = outInfo->velocityY = outInfo->velocityZ = 0.0f;
+        outInfo->is_wet = 0;
+    }
+    return xplm_ProbeHitTerrain;
+}
+
+XPLMObjectRef XPLMLoadObject (const char* inPath)
+{
+    return new HLObjectTy{inPath ? inPath : ""};
+}
+
+void XPLMLoadObjectAsync (const char* inPath, XPLMObjectLoaded_f inCallback, void* inRefcon)
+{
+    // finishes with the next frame
+    gObjLoads.push_back({inPath ? inPath : "", inCallback, inRefcon});
+}
+
+void XPLMUnloadObject (XPLMObjectRef inObject)
+{
+    delete static_cast<HLObjectTy*>(inObject);
+}
+
+int XPLMLookupObjects (const char*, float, float, XPLMLibraryEnumerator_f, void*)
+{
+    return 0;
+}
+
+//
+// MARK: XPLMInstance
+//
+
+XPLMInstanceRef XPLMCreateInstance (XPLMObjectRef obj, const char** /*datarefs*/)
+{
+    HLInstanceTy* pInst = new HLInstanceTy();
+    pInst->obj = obj;
+    pInst->pos = XPLMDrawInfo_t();
+    ++gNumInstances;
+    return pInst;
+}
+
+void XPLMDestroyInstance (XPLMInstanceRef instance)
+{
+    if (!instance) return;
+    delete static_cast<HLInstanceTy*>(instance);
+    --gNumInstances;
+}
+
+void XPLMInstanceSetPosition (XPLMInstanceRef instance, const XPLMDrawInfo_t* new_position, const float* /*data*/)
+{
+    HLInstanceTy* pInst = static_cast<HLInstanceTy*>(instance);
+    if (pInst && new_position)
+        pInst->pos = *new_position;
+    ++gNumInstPosUpd;
+}
+
+//
+// MARK: XPLMCamera
+//
+
+static XPLMCameraControl_f gCamCtrlFunc = nullptr;    ///< camera control callback, never called
+
+void XPLMControlCamera (XPLMCameraControlDuration, XPLMCameraControl_f inControlFunc, void*)
+{
+    gCamCtrlFunc = inControlFunc;
+}
+
+void XPLMDontControlCamera ()
+{
+    gCamCtrlFunc = nullptr;
+}
+
+int XPLMIsCameraBeingControlled (XPLMCameraControlDuration* outCameraControlDuration)
+{
+    if (outCameraControlDuration) *outCameraControlDuration = xplm_ControlCameraUntilViewChanges;
+    return gCamCtrlFunc != nullptr;
+}
+
+void XPLMReadCameraPosition (XPLMCameraPosition_t* outCameraPosition)
+{
+    if (!outCameraPosition) return;
+    outCameraPosition->x = 0.0f;
+    outCameraPosition->y = float(gRefAlt);
+    outCameraPosition->z = 0.0f;
+    outCameraPosition->pitch = outCameraPosition->heading = outCameraPosition->roll = 0.0f;
+    outCameraPosition->zoom = 1.0f;
+}
+
+//
+// MARK: XPLMUtilities
+//
+
+void XPLMDebugString (const char* inString)
+{
+    if (!inString) return;
+    std::lock_guard<std::mutex> lock(gLogMutex);
+    if (gLogFile) {
+        std::fputs(inString, gLogFile);
+        std::fflush(gLogFile);
+    }
+}
+
+void XPLMSetErrorCallback (XPLMError_f inCallback)
+{
+    gErrCB = inCallback;
+}
+
+void* XPLMFindSymbol (const char* /*inString*/)
+{
+    return nullptr;
+}
+
+void XPLMSpeakString (const char* /*inString*/)
+{}
+
+XPLMLanguageCode XPLMGetLanguage ()
+{
+    return xplm_Language_English;
+}
+
+void XPLMGetVersions (int* outXPlaneVersion, int* outXPLMVersion, XPLMHostApplicationID* outHostID)
+{
+    if (outXPlaneVersion) *outXPlaneVersion = 12100;
+    if (outXPLMVersion)   *outXPLMVersion   = 410;
+    if (outHostID)        *outHostID        = xplm_Host_XPlane;
+}
+
+void XPLMGetSystemPath (char* outSystemPath)
+{
+    // buffer is 512 bytes as per SDK documentation
+    if (outSystemPath) std::snprintf(outSystemPath, 512, "%s", gXPRoot.c_str());
+}
+
+void XPLMGetPrefsPath (char* outPrefsPath)
+{
+    if (outPrefsPath) std::snprintf(outPrefsPath, 512, "%sOutput/preferences/X-Plane.prf", gXPRoot.c_str());
+}
+
+const char* XPLMGetDirectorySeparator ()
+{
+    return "/";
+}
+
+char* XPLMExtractFileAndPath (char* inFullPath)
+{
+    if (!inFullPath) return nullptr;
+    char* pSep = std::strrchr(inFullPath, '/');
+    if (!pSep) return inFullPath;
+    *pSep = 0;
+    return pSep + 1;
+}
+
+int XPLMGetDirectoryContents (const char* inDirectoryPath, int inFirstReturn,
+                              char* outFileNames, int inFileNameBufSize,
+                              char** outIndices, int inIndexCount,
+                              int* outTotalFiles, int* outReturnedFiles)
+{
+    // Collect all names first, sorted for reproducibility
+    std::vector<std::string> vNames;
+    std::error_code ec;
+    if (inDirectoryPath)
+        for (const auto& entry: std::filesystem::directory_iterator(inDirectoryPath, ec))
+            vNames.push_back(entry.path().filename().string());
+    std::sort(vNames.begin(), vNames.end());
+    if (outTotalFiles) *outTotalFiles = int(vNames.size());
+
+    // Copy as many as fit into the buffer
+    int nRet = 0;
+    size_t bufUsed = 0;
+    for (size_t i = size_t(std::max(inFirstReturn, 0)); i < vNames.size(); ++i) {
+        const std::string& s = vNames[i];
+        if (!outFileNames ||
+            bufUsed + s.size() + 1 > size_t(inFileNameBufSize) ||
+            (outIndices && nRet >= inIndexCount))
+            break;
+        std::memcpy(outFileNames + bufUsed, s.c_str(), s.size() + 1);
+        if (outIndices) outIndices[nRet] = outFileNames + bufUsed;
+        bufUsed += s.size() + 1;
+        ++nRet;
+    }
+    if (outIndices && nRet < inIndexCount)
+        outIndices[nRet] = nullptr;
+    if (outReturnedFiles) *outReturnedFiles = nRet;
+    return size_t(std::max(inFirstReturn, 0)) + size_t(nRet) >= vNames.size();
+}
+
+XPLMCommandRef XPLMFindCommand (const char* inName)
+{
+    if (!inName) return nullptr;
+    auto iter = gCommands.find(inName);
+    if (iter != gCommands.end())
+        return iter->second.get();
+    // X-Plane's own commands all exist
+    if (std::strncmp(inName, "sim/", 4) != 0)
+        return nullptr;
+    return XPLMCreateCommand(inName, "");
+}
+
+XPLMCommandRef XPLMCreateCommand (const char* inName, const char* /*inDescription*/)
+{
+    if (!inName) return nullptr;
+    std::unique_ptr<HLCommandTy>& pCmd = gCommands[inName];
+    if (!pCmd) {
+        pCmd = std::make_unique<HLCommandTy>();
+        pCmd->name = inName;
+    }
+    return pCmd.get();
+}
+
+void XPLMCommandBegin (XPLMCommandRef inCommand)
+{
+    if (inCommand) static_cast<HLCommandTy*>(inCommand)->Call(xplm_CommandBegin);
+}
+
+void XPLMCommandEnd (XPLMCommandRef inCommand)
+{
+    if (inCommand) static_cast<HLCommandTy*>(inCommand)->Call(xplm_CommandEnd);
+}
+
+void XPLMCommandOnce (XPLMCommandRef inCommand)
+{
+    XPLMCommandBegin(inCommand);
+    XPLMCommandEnd(inCommand);
+}
+
+void XPLMRegisterCommandHandler (XPLMCommandRef inComand, XPLMCommandCallback_f inHandler,
+                                 int inBefore, void* inRefcon)
+{
+    HLCommandTy* pCmd = static_cast<HLCommandTy*>(inComand);
+    if (!pCmd) return;
+    HLCommandTy::HandlerTy h;
+    h.cb = inHandler;
+    h.before = inBefore;
+    h.refcon = inRefcon;
+    if (inBefore)
+        pCmd->listHandlers.push_front(h);
+    else
+        pCmd->listHandlers.push_back(h);
+}
+
+void XPLMUnregisterCommandHandler (XPLMCommandRef inComand, XPLMCommandCallback_f inHandler,
+                                   int inBefore, void* inRefcon)
+{
+    HLCommandTy* pCmd = static_cast<HLCommandTy*>(inComand);
+    if (!pCmd) return;
+    pCmd->listHandlers.remove_if([&](const HLCommandTy::HandlerTy& h)
+                                 { return h.cb == inHandler && h.before == inBefore && h.refcon == inRefcon; });
+}
@@ -0,0 +1,77 @@
+/// @file       XPLMHeadless.h
+/// @brief      Headless implementation of the XPLM API for running LTCore outside X-Plane
+/// @details    LiveTraffic's core only talks to X-Plane through the XPLM C API
+///             (time and dataRefs, terrain probes, object instances used by XPMP2
+///             for drawing aircraft, flight loop callbacks). XPLMHeadless.cpp implements
+///             that API without any simulator: dataRefs live in a table,
+///             flight loops are called from RunFrame(), terrain is flat,
+///             and local coordinates are a simple projection around a reference position.\n
+///             Functions in this header let the host (like `lt_replay_bench`)
+///             drive the simulated environment.
+/// @author     Birger Hoppe
+/// @copyright  (c) 2024 Birger Hoppe
+/// @copyright  Permission is hereby granted, free of charge, to any person obtaining a
+///             copy of this software and associated documentation files (the "Software"),
+///             to deal in the Software without restriction, including without limitation
+///             the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the
+///             Software is furnished to do so, subject to the following conditions:\n
+///             The above copyright notice and this permission notice shall be included in
+///             all copies or substantial portions of the Software.\n
+///             THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///             IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///             FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///             AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///             LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///             OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+///             THE SOFTWARE.
+
+#ifndef XPLMHeadless_h
+#define XPLMHeadless_h
+
+#include <string>
+
+namespace XPLMHeadless {
+
+/// Initialize the environment
+/// @param _xpRoot Directory playing X-Plane's root folder, must end with a separator
+/// @param _pluginFile Path to the "plugin" file, which determines the plugin's directory
+/// @param _pluginSig Plugin signature returned by XPLMGetPluginInfo() & Co.
+/// @param _logFile Path to the file that receives XPLMDebugString() output
+void Init (const std::string& _xpRoot,
+           const std::string& _pluginFile,
+           const std::string& _pluginSig,
+           const std::string& _logFile);
+
+/// Cleanup, closes the log file
+void Cleanup ();
+
+/// @brief Set the reference position: origin of local coordinates, user's plane, and camera
+/// @details Also sets the `sim/flightmodel/position/...` dataRefs accordingly
+void SetRefPos (double lat, double lon, double alt_m);
+
+/// Set the terrain elevation [m] returned by all terrain probes
+void SetTerrainElev (double alt_m);
+
+/// Set the (simulated) time since startup [s], also feeds the time-related `sim/time/...` dataRefs
+void SetElapsedTime (double t);
+
+/// @brief Executes one frame: calls all due flight loop callbacks and pending object load callbacks
+/// @param frameDur_s Simulated duration of the frame, passed as elapsed time to the callbacks
+void RunFrame (float frameDur_s);
+
+/// Set a dataRef held by the headless environment (not one registered by a plugin)
+void SetDataRef (const std::string& name, double val);
+
+/// Number of currently existing object instances (drawn aircraft)
+size_t GetNumInstances ();
+
+/// Total number of XPLMInstanceSetPosition() calls so far
+unsigned long long GetNumInstancePosUpdates ();
+
+/// Total number of terrain probe calls so far
+unsigned long long GetNumProbes ();
+
+}
+
+#endif /* XPLMHeadless_h */
@@ -343,6 +343,8 @@ positionTy& positionTy::operator |= (const positionTy& pos)
     f.specialPos = SPOS_NONE;
     f.bCutCorner = false;
     edgeIdx      = EDGE_UNKNOWN;
+    // merged with live data it is no longer just a prediction
+    f.bPredicted = f.bPredicted && pos.f.bPredicted;
     
     return normalize();
 }
@@ -391,7 +393,7 @@ std::string positionTy::dbgTxt () const
              alt_ft(),
              GrndE2String(f.onGrnd),
              SpecialPosE2String(f.specialPos),
-             f.bCutCorner ? "CT" : "  ",
+             f.bCutCorner ? "CT" : f.bPredicted ? "PR" : "  ",
              f.flightPhase ? (LTAircraft::FlightPhase2String(f.flightPhase)).c_str() : "",
              HasTaxiEdge() ? 1 : 0,
              HasTaxiEdge() ? edgeIdx : 0,
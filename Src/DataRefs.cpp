@@ -50,28 +50,28 @@ void conv_color (int inCol, float outColor[4])
 // MARK: Doc8643
 //
 
-// global map, which stores the content of the doc8643 file
-std::map<std::string, Doc8643> mapDoc8643;
+// global map, which stores the content of the doc8643 file, keyed by interned type designator
+std::unordered_map<LTAtom, Doc8643, LTAtom::HashTy> mapDoc8643;
 const Doc8643 DOC8643_EMPTY;    // objet returned if Doc8643::get fails
 
 // constructor setting all elements
-Doc8643::Doc8643 (std::string&& _manufacturer,
-                  std::string&& _model,
-                  std::string&& _typeDesignator,
-                  std::string&& _classification,
-                  std::string&& _wtc) :
-manufacturer    (std::move(_manufacturer)),
-model           (std::move(_model)),
-typeDesignator  (std::move(_typeDesignator)),
-classification  (std::move(_classification)),
-wtc             (std::move(_wtc))
+Doc8643::Doc8643 (const std::string& _manufacturer,
+                  const std::string& _model,
+                  const std::string& _typeDesignator,
+                  const std::string& _classification,
+                  const std::string& _wtc) :
+manufacturer    (_manufacturer),
+model           (_model),
+typeDesignator  (_typeDesignator),
+classification  (_classification),
+wtc             (_wtc)
 {}
 
 // return the string for FlightModel matching
 Doc8643::operator std::string() const
 {
-    return wtc + ';' + classification + ';' + typeDesignator + ';' +
-    model + ';' + manufacturer;
+    return wtc.str() + ';' + classification.str() + ';' + typeDesignator.str() + ';' +
+    model.str() + ';' + manufacturer.str();
 }
 
 //
@@ -121,7 +121,7 @@ bool Doc8643::ReadDoc8643File ()
         
         // add to map (if matched)
         if (m.size() == DOC_EXPECTED) {
-            mapDoc8643.emplace(m[DOC_TYPE],
+            mapDoc8643.emplace(LTAtom(m[DOC_TYPE].str()),
                                Doc8643(m[DOC_MANU],
                                        m[DOC_MODEL],
                                        m[DOC_TYPE],
@@ -157,7 +157,7 @@ bool Doc8643::ReadDoc8643File ()
 }
 
 // return the matching Doc8643 object from the global map
-const Doc8643& Doc8643::get (const std::string& _type)
+const Doc8643& Doc8643::get (const LTAtom& _type)
 try
 {
     return mapDoc8643.at(_type);
@@ -174,11 +174,11 @@ catch (...)
 namespace ModelIcaoType
 {
     /// Map, which stores the content of the model_typecode.txt file:
-    /// human-readable model text maps to ICAO type cide
-    std::map<std::string, std::string> mapModelIcaoType;
+    /// human-readable model text (upper case) maps to ICAO type code
+    std::unordered_map<LTAtom, LTAtom, LTAtom::HashTy> mapModelIcaoType;
     
-    /// global empty string returned if nothing is found in map
-    const std::string gEmptyString;
+    /// global empty atom returned if nothing is found in map
+    const LTAtom gEmptyAtom;
 
     // Read the `model_typecode.txt` file
     bool ReadFile ()
@@ -243,9 +243,8 @@ namespace ModelIcaoType
             }
 #endif
             
-            // and just move it to the map:
-            mapModelIcaoType.emplace(std::move(mdl),
-                                     std::move(type));
+            // and add it to the map:
+            mapModelIcaoType.emplace(LTAtom(mdl), LTAtom(type));
         }
 
         // close file
@@ -263,16 +262,11 @@ namespace ModelIcaoType
     }
     
     // Lookup ICAO type designator for human-readable model text, empty if nothing found
-    const std::string& getIcaoType (const std::string& _model)
+    const LTAtom& getIcaoType (const LTAtom& _model)
     {
-        try {
-            // lookup a value on the map, throws std::out_of_range if nothing found
-            return mapModelIcaoType.at(str_toupper_c(_model));
-        }
-        catch (...) {
-            // caught exception -> nothing found in map, return something empty
-            return gEmptyString;
-        }
+        // the upper-case atom of the model text is remembered, so no conversion needed
+        const auto iter = mapModelIcaoType.find(_model.upper());
+        return iter == mapModelIcaoType.end() ? gEmptyAtom : iter->second;
     }
 
 }
@@ -496,6 +490,10 @@ DataRefs::dataRefDefinitionT DATA_REFS_LT[CNT_DATAREFS_LT] = {
     {"livetraffic/ver/nr",                          GetLTVerNum,  NULL, NULL, false },
     {"livetraffic/ver/date",                        GetLTVerDate, NULL, NULL, false },
     
+    // frame-time governor
+    {"livetraffic/gov/level",                       DataRefs::LTGetInt, NULL,                       GET_VAR, false },
+    {"livetraffic/gov/frame_time_us",               DataRefs::LTGetInt, NULL,                       GET_VAR, false },
+    
     // UI information
     {"livetraffic/ui/opacity",                      DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true },
     {"livetraffic/ui/font_scale",                   DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true },
@@ -526,6 +524,11 @@ DataRefs::dataRefDefinitionT DATA_REFS_LT[CNT_DATAREFS_LT] = {
     {"livetraffic/cfg/fd_long_refresh_intvl",       DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true, true },
     {"livetraffic/cfg/fd_buf_period",               DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true, true },
     {"livetraffic/cfg/fd_reduce_height",            DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true, true },
+    {"livetraffic/cfg/fd_full_area_every",          DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true, true },
+    {"livetraffic/cfg/fd_predict",                  DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true, true },
+    {"livetraffic/cfg/lod_near_dist",               DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true, true },
+    {"livetraffic/cfg/lod_far_dist",                DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true, true },
+    {"livetraffic/cfg/frame_budget_ms",             DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true, true },
     {"livetraffic/cfg/network_timeout",             DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true },
     {"livetraffic/cfg/lnd_lights_taxi",             DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true },
     {"livetraffic/cfg/hide_below_agl",              DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true, true },
@@ -553,6 +556,8 @@ DataRefs::dataRefDefinitionT DATA_REFS_LT[CNT_DATAREFS_LT] = {
     {"livetraffic/dbg/export_user_ac",              DataRefs::LTGetInt, DataRefs::LTSetBool,        GET_VAR, false },
     {"livetraffic/dbg/export_normalize_ts",         DataRefs::LTGetInt, DataRefs::LTSetBool,        GET_VAR, true },
     {"livetraffic/dbg/export_format",               DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true },
+    {"livetraffic/dbg/file_rotate_mb",              DataRefs::LTGetInt, DataRefs::LTSetCfgValue,    GET_VAR, true },
+    {"livetraffic/dbg/stress_mode",                 DataRefs::LTGetInt, DataRefs::LTSetBool,        GET_VAR, false },
 
     // channel configuration options
     {"livetraffic/channel/fscharter/environment",   DataRefs::LTGetInt, DataRefs::LTSetBool,        GET_VAR, true },
@@ -590,6 +595,10 @@ DataRefs::dataRefDefinitionT DATA_REFS_LT[CNT_DATAREFS_LT] = {
 void* DataRefs::getVarAddr (dataRefsLT dr)
 {
     switch (dr) {
+        // frame-time governor
+        case DR_GOV_LEVEL:                  return &govLevel;
+        case DR_GOV_FRAME_TIME:             return &govFrameTime_us;
+
         // UI information
         case DR_UI_OPACITY:                 return &UIopacity;
         case DR_UI_FONT_SCALE:              return &UIFontScale;
@@ -619,6 +628,11 @@ void* DataRefs::getVarAddr (dataRefsLT dr)
         case DR_CFG_FD_LONG_REFRESH_INTVL:  return &fdLongRefrIntvl;
         case DR_CFG_FD_BUF_PERIOD:          return &fdBufPeriod;
         case DR_CFG_FD_REDUCE_HEIGHT:       return &fdReduceHeight;
+        case DR_CFG_FD_FULL_AREA_EVERY:     return &fdFullAreaEvery;
+        case DR_CFG_FD_PREDICT:             return &bFdPredict;
+        case DR_CFG_LOD_NEAR_DIST:          return &lodNearDist;
+        case DR_CFG_LOD_FAR_DIST:           return &lodFarDist;
+        case DR_CFG_FRAME_BUDGET:           return &frameBudget_ms;
         case DR_CFG_MAX_NETW_TIMEOUT:       return &netwTimeoutMax;
         case DR_CFG_LND_LIGHTS_TAXI:        return &bLndLightsTaxi;
         case DR_CFG_HIDE_BELOW_AGL:         return &hideBelowAGL;
@@ -646,6 +660,8 @@ void* DataRefs::getVarAddr (dataRefsLT dr)
         case DR_DBG_EXPORT_USER_AC:         return &bDebugExportUserAc;
         case DR_DBG_EXPORT_NORMALIZE_TS:    return &bDebugExportNormTS;
         case DR_DBG_EXPORT_FORMAT:          return &eDebugExportFdFormat;
+        case DR_DBG_FILE_ROTATE_MB:         return &debugFileRotateMB;
+        case DR_DBG_STRESS_MODE:            return &bDebugStressMode;
 
         // channel configuration options
         case DR_CFG_FSC_ENV:                return &fscEnv;
@@ -725,7 +741,7 @@ const std::string& DataRefs::CSLPathCfgTy::operator= (const std::string& _p)
 
 //MARK: DataRefs Constructor - just plain variable init, no API calls
 
-/// Mutex guarding updates to cached values
+/// Mutex guarding weather information, which the weather thread updates
 static std::recursive_mutex mutexDrUpdate;
 /// Flag to ignore this sharedDataref callback
 static bool gbIgnoreItsMe = false;
@@ -1014,13 +1030,13 @@ bool DataRefs::RegisterCommands()
 }
 
 // Return current network time
-// In main thred read directly from the dataRef, otherwise a cached value
+// In main thred read directly from the dataRef, otherwise the published value
 float DataRefs::GetMiscNetwTime() const
 {
     if (IsXPThread())
         return XPLMGetDataf(adrXP[DR_MISC_NETW_TIME]);
     else
-        return lastNetwTime;
+        return simState.Load().netwTime;
 }
 
 
@@ -1137,13 +1153,11 @@ positionTy DataRefs::GetUsersPlanePos(double& trueAirspeed_m, double& track ) co
         track = lastUsersTrack;
         return lastUsersPlanePos;
     } else {
-        // in a worker thread, we need to have the lock, and copy before release
-        std::unique_lock<std::recursive_mutex> lock(mutexDrUpdate);
-        positionTy ret = lastUsersPlanePos;
-        trueAirspeed_m = lastUsersTrueAirspeed;
-        track = lastUsersTrack;
-        lock.unlock();
-        return ret;
+        // in a worker thread, we copy the published state
+        const SimStateTy st = simState.Load();
+        trueAirspeed_m = st.usersTrueAirspeed;
+        track = st.usersTrack;
+        return st.usersPlanePos;
     }
 }
 
@@ -1351,22 +1365,25 @@ int DataRefs::LTGetBulkAc (void* inRefcon, void * outData,
     const int startAc = 1 + inStartPos / size;      // first a/c index (1-based)
     const int endAc = startAc + (inNumBytes / size);// last+1 a/c index (passed-the-end)
     char* pOut = (char*)outData;                    // point to current output position
-    int iAc = startAc;                              // current a/c index (1-based)
-    for (mapLTFlightDataTy::iterator fdIter = mapFdAcByIdx(iAc);
-         fdIter != mapFd.end() && iAc < endAc;
-         // iterator to next FlighData _with_ aircraft; advance output pointer
-         fdIter = mapFdNextWithAc(fdIter), iAc++, pOut += size)
+    int iAc = 0;                                    // current a/c index (1-based)
+    int numCopied = 0;                              // number of a/c copied
+    mapFd.ForEach([&](const LTFlightData& fd)
     {
-        // copy data of the current aircraft
-        const LTAircraft& ac = *fdIter->second.GetAircraft();
+        // only FlightData _with_ aircraft count, and only those requested
+        if (!fd.hasAc() || ++iAc < startAc || iAc >= endAc)
+            return;
+        // copy data of the current aircraft, advance output pointer
+        const LTAircraft& ac = *fd.GetAircraft();
         if (dr == DR_AC_BULK_QUICK)
             ac.CopyBulkData ((LTAPIAircraft::LTAPIBulkData*)pOut, (size_t)size);
         else
             ac.CopyBulkData((LTAPIAircraft::LTAPIBulkInfoTexts*)pOut, (size_t)size);
-    }
+        pOut += size;
+        ++numCopied;
+    });
     
     // how many bytes copied?
-    return (iAc - startAc) * size;
+    return numCopied * size;
 }
 
 
@@ -1388,10 +1405,10 @@ bool DataRefs::FetchPAc ()
     
     // find that key's element
     LTFlightData::FDKeyTy fdKey (LTFlightData::KEY_ICAO, keyAc);
-    mapLTFlightDataTy::const_iterator fdIter = mapFd.find(fdKey);
-    if (fdIter != mapFd.end()) {
+    const LTFlightData* pFd = mapFd.FindMain(fdKey);
+    if (pFd) {
         // found, save ptr to a/c
-        pAc = fdIter->second.GetAircraft();
+        pAc = pFd->GetAircraft();
         // that pointer might be NULL if a/c has not yet been created!
         return pAc != nullptr;
     }
@@ -1424,10 +1441,10 @@ void DataRefs::LTSetAcKey(void*, int key)
     else if ( key <= dataRefs.cntAc )
     {
         // let's find the i-th aircraft
-        mapLTFlightDataTy::iterator fdIter = mapFdAcByIdx(key);
-        if (fdIter != mapFd.end()) {
-            dataRefs.keyAc = fdIter->second.key();
-            dataRefs.pAc = fdIter->second.GetAircraft();
+        const LTFlightData* pFd = mapFdAcByIdx(key);
+        if (pFd) {
+            dataRefs.keyAc = pFd->key();
+            dataRefs.pAc = pFd->GetAircraft();
             return;
         }
     }
@@ -1530,8 +1547,8 @@ void DataRefs::ClearCameraAc(void*)
         char keyHex[10];
         snprintf ( keyHex, sizeof(keyHex), "%06X",
                   (unsigned int)XPLMGetDatai(dataRefs.adrXP[DR_CAMERA_AC_ID]) );
-        mapLTFlightDataTy::iterator iter = mapFdSearchAc(keyHex);
-        LTAircraft::SetCameraAcExternally(iter != mapFd.end() ? iter->second.GetAircraft() : nullptr);
+        const LTFlightData* pFd = mapFdSearchAc(keyHex);
+        LTAircraft::SetCameraAcExternally(pFd ? pFd->GetAircraft() : nullptr);
     }
     else
         // Clear our aircraft under the camera
@@ -1721,6 +1738,11 @@ bool DataRefs::SetCfgValue (void* p, int val)
         fdLongRefrIntvl < fdRefreshIntvl    || fdLongRefrIntvl  > 180   ||
         fdBufPeriod     < fdLongRefrIntvl   || fdBufPeriod      > 180   ||
         fdReduceHeight  < 1000              || fdReduceHeight   > 100000||
+        fdFullAreaEvery < 1                 || fdFullAreaEvery  > 10    ||
+        lodNearDist     < 1                 || lodNearDist      > 100   ||
+        lodFarDist      < 1                 || lodFarDist       > 100   ||
+        frameBudget_ms  < 0                 || frameBudget_ms   > 50    ||
+        debugFileRotateMB < 0               || debugFileRotateMB > 10000||
         fdSnapTaxiDist  < 0                 || fdSnapTaxiDist   > 50    ||
         netwTimeoutMax  < 5                 ||
         hideBelowAGL    < 0                 || hideBelowAGL     > MDL_ALT_MAX ||
@@ -1790,6 +1812,11 @@ void DataRefs::ResetAdvCfgToDefaults ()
     fdLongRefrIntvl = DEF_FD_LONG_REFR_INTVL;
     fdBufPeriod     = DEF_FD_BUF_PERIOD;
     fdReduceHeight  = DEF_FD_REDUCE_HEIGHT;
+    fdFullAreaEvery = DEF_FD_FULL_AREA_EVERY;
+    bFdPredict      = DEF_FD_PREDICT;
+    lodNearDist     = DEF_LOD_NEAR_DIST;
+    lodFarDist      = DEF_LOD_FAR_DIST;
+    frameBudget_ms  = DEF_FRAME_BUDGET_MS;
     netwTimeoutMax      = DEF_MAX_NETW_TIMEOUT;
     contrailAltMin_ft   = DEF_CONTR_ALT_MIN;
     contrailAltMax_ft   = DEF_CONTR_ALT_MAX;
@@ -2207,6 +2234,8 @@ bool DataRefs::LoadConfigFile()
                 SetFSCharterUser(sVal);
             else if (sDataRef == CFG_FSC_PWD)
                 SetFSCharterPwd(Cleartext(sVal));
+            else if (sDataRef == CFG_ADSBHUB_HOST)
+                SetADSBHubHost(sVal);
             else
             {
                 // unknown config entry, ignore
@@ -2353,6 +2382,8 @@ bool DataRefs::SaveConfigFile()
         fOut << CFG_FSC_USER << ' ' << sFSCUser << '\n';
     if (!sFSCPwd.empty())
         fOut << CFG_FSC_PWD << ' ' << Obfuscate(sFSCPwd) << '\n';
+    if (!sADSBHubHost.empty())
+        fOut << CFG_ADSBHUB_HOST << ' ' << sADSBHubHost << '\n';
 
     // *** [FlarmAcTypes] ***
     fOut << '\n' << CFG_FLARM_ACTY_SECTION << '\n';
@@ -2513,8 +2544,6 @@ void DataRefs::ChTsOffsetAdd (double aNetTS)
 // update all cached values for thread-safe access
 void DataRefs::UpdateCachedValues ()
 {
-    std::lock_guard<std::recursive_mutex> lock(mutexDrUpdate);
-
     lastNetwTime = XPLMGetDataf(adrXP[DR_MISC_NETW_TIME]);
     lastReplay = XPLMGetDatai(adrXP[DR_REPLAY_MODE]);
     lastVREnabled =                         // is VR enabled?
@@ -2529,9 +2558,27 @@ void DataRefs::UpdateCachedValues ()
     UpdateUsersPlanePos();
     UpdateSimWind();
     UpdateXPSimTime();
+    PublishSimState();
     ExportUserAcData();
 }
 
+// publish cached values as SimStateTy for other threads
+void DataRefs::PublishSimState ()
+{
+    SimStateTy st;
+    st.camPos               = lastCamPos;
+    st.usersPlanePos        = lastUsersPlanePos;
+    st.usersTrueAirspeed    = lastUsersTrueAirspeed;
+    st.usersTrack           = lastUsersTrack;
+    st.simTime              = lastSimTime;
+    st.netwTime             = lastNetwTime;
+    st.XPSimTime_ms         = lastXPSimTime_ms;
+    st.bReplay              = lastReplay;
+    st.bVREnabled           = lastVREnabled;
+    st.wind                 = lastWind;
+    simState.Store(st);
+}
+
 
 // Local (in sim!) wind at user's plane
 void DataRefs::UpdateSimWind ()
@@ -2585,7 +2632,7 @@ void DataRefs::UpdateSimWind ()
         XPLMGetDatavf(drRegAlt_m,       afAlt_m.data(),     0, (int)afAlt_m.size());
         XPLMGetDatavf(drRegSpeed_mcs,   afSpd_mcs.data(),   0, (int)afSpd_mcs.size());
         XPLMGetDatavf(drRegDir_degt,    afDir_degt.data(),  0, (int)afDir_degt.size());
-        // Proces wind layer values
+        // Proces wind layer values, lowest first (up to SIM_WIND_MAX_LAYERS)
         for (size_t i = 0; i < afAlt_m.size(); ++i) {
             if (afSpd_mcs[i] < 0.0f) continue;      // skip unused layers
             lastWind.emplace_back(afAlt_m[i], afSpd_mcs[i], afDir_degt[i]);
@@ -2625,13 +2672,8 @@ positionTy DataRefs::GetViewPos()
     if (dataRefs.IsXPThread())
         return lastCamPos;
     else
-    {
-        // calling from another thread: safely copy the cached value
-        std::unique_lock<std::recursive_mutex> lock(mutexDrUpdate);
-        positionTy camPos = lastCamPos;
-        lock.unlock();
-        return camPos;
-    }
+        // calling from another thread: copy the published value
+        return dataRefs.simState.Load().camPos;
 }
 
 // return the direction the camera is looking to
@@ -2641,13 +2683,8 @@ double DataRefs::GetViewHeading()
     if (dataRefs.IsXPThread())
         return lastCamPos.heading();
     else
-    {
-        // calling from another thread: safely copy the cached value
-        std::unique_lock<std::recursive_mutex> lock(mutexDrUpdate);
-        double h = lastCamPos.heading();
-        lock.unlock();
-        return h;
-    }
+        // calling from another thread: copy the published value
+        return dataRefs.simState.Load().camPos.heading();
 }
 
 // in current situation, shall we draw labels?
@@ -2757,23 +2794,35 @@ void DataRefs::GetWeather (float& hPa, std::string& stationId, std::string& META
 // Local (in sim!) wind at given altitude
 const vectorTy DataRefs::GetSimWind (double alt_m) const
 {
+    // In main thread use the latest layers, otherwise the published ones
+    if (IsXPThread())
+        return lastWind.At(alt_m);
+    else
+        return simState.Load().wind.At(alt_m);
+}
+
+// Wind at given altitude, interpolated between layers
+vectorTy DataRefs::SimWindTy::At (double alt_m) const
+{
+    const WindLayerTy* const first = layer;
+    const WindLayerTy* const last  = layer + n;
     // No wind layers known? -> return "no wind"
-    if (lastWind.empty())
+    if (n == 0)
         return vectorTy(0.0, NAN, NAN, 0.0);
     // Just one wind layer? Or plane is lower than first layer? -> return first layer's wind
-    if (lastWind.size() == 1 || std::isnan(alt_m) || alt_m <= lastWind[0].alt_m)
-        return vectorTy(lastWind.front().dir_degt, NAN, NAN, lastWind.front().spd_msc);
+    if (n == 1 || std::isnan(alt_m) || alt_m <= first->alt_m)
+        return vectorTy(first->dir_degt, NAN, NAN, first->spd_msc);
     // More than one layer and plane is flying higher than first layer
     // Find the fist layer, which is higher than the plane
-    auto iter = std::find_if(lastWind.cbegin(), lastWind.cend(),
-                             [alt_m](const WindLayerTy& wl){ return alt_m <= wl.alt_m; });
+    const WindLayerTy* iter = std::find_if(first, last,
+                                           [alt_m](const WindLayerTy& wl){ return alt_m <= wl.alt_m; });
     // If not found, then plane is flying higher than highest layer -> return highest wind
-    if (iter == lastWind.cend())
-        return vectorTy(lastWind.back().dir_degt, NAN, NAN, lastWind.back().spd_msc);
+    if (iter == last)
+        return vectorTy(last[-1].dir_degt, NAN, NAN, last[-1].spd_msc);
     // else we found a higher wind layer, but is it right away the first?
     // (should not happen...but just to be on the safe side we catch the case)
-    if (iter == lastWind.cbegin())
-        return vectorTy(lastWind.front().dir_degt, NAN, NAN, lastWind.front().spd_msc);
+    if (iter == first)
+        return vectorTy(first->dir_degt, NAN, NAN, first->spd_msc);
     // Now really...plane is in the middle between two layers
     // return an average value between them
     const WindLayerTy& low = *std::prev(iter);
@@ -2783,4 +2832,4 @@ const vectorTy DataRefs::GetSimWind (double alt_m) const
     const double hdg_diff = HeadingDiff(low.dir_degt, hgh.dir_degt);    // heading diff
     const double hdg = low.dir_degt + f*hdg_diff;                       // "average" of heading
     return vectorTy(HeadingNormalize(hdg), NAN, NAN, spd);
-};
+}
@@ -20,9 +20,6 @@
 
 #include "LiveTraffic.h"
 
-// Controls access to the log list (defined in TextIO)
-extern std::recursive_mutex gLogMutex;
-
 // Defined in LTVersion.cpp, contain the build date (like 20200811)
 extern int verBuildDate;
 
@@ -105,6 +102,9 @@ void InfoListWnd::TabActive (ILWTabTy _tab)
 // Some setup before UI building starts, here text size calculations
 ImGuiWindowFlags_ InfoListWnd::beforeBegin()
 {
+    // Parent class starts timing for the frame-time governor
+    LTImgWindow::beforeBegin();
+    
     // Save latest screen size to configuration (if not popped out)
     if (!IsPoppedOut())
         dataRefs.ILWrect = GetCurrentWindowGeometry();
@@ -220,12 +220,9 @@ void InfoListWnd::buildInterface()
                 // Messages are added to the beginning of the list
                 const LogMsgIterListTy::iterator insBefore = msgIterList.begin();
                     
-                // Access to static buffer and list guarded by a lock
+                // gLog is only ever accessed from the main thread, so no lock needed
                 if (!gLog.empty())
                 {
-                    // We lock once here to avoid re-locking with every match attempt
-                    std::lock_guard<std::recursive_mutex> lock(gLogMutex);
-                    
                     // Loop all messages and remember those which match
                     for (LogMsgListTy::const_iterator iMsg = gLog.cbegin();
                          iMsg != gLog.cend() && iMsg->counter != msgCounterReadTo;
@@ -333,6 +330,24 @@ void InfoListWnd::buildInterface()
                             if (ImGui::TableSetColumnIndex(0)) ImGui::TextUnformatted("Live aircraft shown");
                             if (ImGui::TableSetColumnIndex(1)) ImGui::Text("%d", dataRefs.GetNumAc());
                             ImGui::TableNextRow();
+                            if (ImGui::TableSetColumnIndex(0)) ImGui::TextUnformatted("...by level of detail");
+                            if (ImGui::TableSetColumnIndex(1)) ImGui::Text("%d full, %d reduced, %d far or hidden",
+                                                                           LTAircraft::GetNumAcLOD(LOD_NEAR),
+                                                                           LTAircraft::GetNumAcLOD(LOD_MID),
+                                                                           LTAircraft::GetNumAcLOD(LOD_FAR));
+                            ImGui::TableNextRow();
+                            if (ImGui::TableSetColumnIndex(0)) ImGui::TextUnformatted("Frame-time governor");
+                            if (ImGui::TableSetColumnIndex(1)) {
+                                if (dataRefs.GetFrameBudget_ms() <= 0)
+                                    ImGui::Text("off, %.2f ms per frame", dataRefs.GetGovFrameTime_us() / 1000.0);
+                                else
+                                    ImGui::Text("level %d, %.2f ms per frame (budget %d ms), max %d aircraft",
+                                                dataRefs.GetGovLevel(),
+                                                dataRefs.GetGovFrameTime_us() / 1000.0,
+                                                dataRefs.GetFrameBudget_ms(),
+                                                dataRefs.GetEffMaxNumAc());
+                            }
+                            ImGui::TableNextRow();
                             if (ImGui::TableSetColumnIndex(0)) ImGui::TextUnformatted("Aircraft seen in tracking data");
                             if (ImGui::TableSetColumnIndex(1)) ImGui::Text("%lu", (long unsigned)mapFd.size());
                             
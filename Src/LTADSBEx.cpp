@@ -42,6 +42,10 @@ bool ADSBBase::ProcessFetchedData ()
         SetValid(false);
         return false;
     }
+    
+    // conditional request told us that nothing changed
+    if (httpResponse == HTTP_NOT_MODIFIED)
+        return true;
 
     // data is expected to be in netData string
     // short-cut if there is nothing
@@ -245,7 +249,7 @@ void ADSBBase::ProcessV2 (JSON_Object* pJAc,
 
     // from here on access to fdMap guarded by a mutex
     // until FD object is inserted and updated
-    std::unique_lock<std::mutex> mapFdLock (mapFdMutex);
+    FDMapTy::LockTy mapFdLock = mapFd.Lock(fdKey);
     
     // Check for duplicates with OGN/FLARM, potentially replaces the key type
     LTFlightData::CheckDupKey(fdKey, LTFlightData::KEY_FLARM);
@@ -329,7 +333,7 @@ void ADSBBase::ProcessV1 (JSON_Object* pJAc,
 
     // from here on access to fdMap guarded by a mutex
     // until FD object is inserted and updated
-    std::unique_lock<std::mutex> mapFdLock (mapFdMutex);
+    FDMapTy::LockTy mapFdLock = mapFd.Lock(fdKey);
     
     // Check for duplicates with OGN/FLARM, potentially replaces the key type
     LTFlightData::CheckDupKey(fdKey, LTFlightData::KEY_FLARM);
@@ -512,9 +516,7 @@ void ADSBExchangeConnection::Main ()
             // sleep for FD_REFRESH_INTVL or if woken up for termination
             // by condition variable trigger
             {
-                std::unique_lock<std::mutex> lk(FDThreadSynchMutex);
-                FDThreadSynchCV.wait_until(lk, tNextWakeup,
-                                           [this]{return !shallRun();});
+                wakeup.WaitUntil(tNextWakeup, [this]{return !shallRun();});
             }
             
         } catch (const std::exception& e) {
@@ -550,8 +552,8 @@ bool ADSBExchangeConnection::InitCurl ()
     if (!LTOnlineChannel::InitCurl())
         return false;
 
-    // maybe read headers
-    curl_easy_setopt(pCurl, CURLOPT_HEADERFUNCTION, keyTy == ADSBEX_KEY_RAPIDAPI ? ReceiveHeader : NULL);
+    // maybe read headers (must not be NULL as CURLOPT_HEADERDATA is set, which would route headers into the data buffer)
+    curl_easy_setopt(pCurl, CURLOPT_HEADERFUNCTION, keyTy == ADSBEX_KEY_RAPIDAPI ? ReceiveHeader : LTOnlineChannel::ReceiveHeader);
 
     // did the API key change?
     if (!slistKey || theKey != apiKey) {
@@ -621,7 +623,7 @@ struct curl_slist* ADSBExchangeConnection::MakeCurlSList (keyTypeE keyTy, const
 }
 
 // read header and parse for request limit/remaining
-size_t ADSBExchangeConnection::ReceiveHeader(char *buffer, size_t size, size_t nitems, void *)
+size_t ADSBExchangeConnection::ReceiveHeader(char *buffer, size_t size, size_t nitems, void *userdata)
 {
     const size_t len = nitems * size;
     static size_t lenRLimit  = strlen(ADSBEX_RAPIDAPI_RLIMIT);
@@ -653,8 +655,8 @@ size_t ADSBExchangeConnection::ReceiveHeader(char *buffer, size_t size, size_t n
         dataRefs.ADSBExRRemain = std::atol(num);
     }
 
-    // always say we processed everything, otherwise HTTP processing would stop!
-    return len;
+    // let the base class look for validators, it always says we processed everything
+    return LTOnlineChannel::ReceiveHeader(buffer, size, nitems, userdata);
 }
 
 //
@@ -844,9 +846,10 @@ ADSBBase(DR_CHANNEL_ADSB_FI_ONLINE, ADSBFI_NAME, ADSBFI_SLUG_BASE)
 // put together the URL to fetch based on current view position
 std::string ADSBfiConnection::GetURL (const positionTy& pos)
 {
+    const RequAreaTy& area = PlanRequestArea(pos, double(dataRefs.GetFdStdDistance_m()));
     char url[128] = "";
-    snprintf(url, sizeof(url), ADSBFI_URL, pos.lat(), pos.lon(),
-             dataRefs.GetFdStdDistance_nm());
+    snprintf(url, sizeof(url), ADSBFI_URL, area.center.lat(), area.center.lon(),
+             int(std::lround(area.extent_m / M_per_NM)));
     return std::string(url);
 }
 
@@ -885,9 +888,7 @@ void ADSBfiConnection::Main ()
             // sleep for FD_REFRESH_INTVL or if woken up for termination
             // by condition variable trigger
             {
-                std::unique_lock<std::mutex> lk(FDThreadSynchMutex);
-                FDThreadSynchCV.wait_until(lk, tNextWakeup,
-                                           [this]{return !shallRun();});
+                wakeup.WaitUntil(tNextWakeup, [this]{return !shallRun();});
             }
             
         } catch (const std::exception& e) {
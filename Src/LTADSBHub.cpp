@@ -119,6 +119,18 @@ void ADSBHubConnection::Main ()
     // This is a communication thread's main function, set thread's name and C locale
     ThreadSettings TS ("LT_ADSBHub", LC_ALL_MASK);
 
+    // Server to connect to, can be overridden in the config file, e.g. to connect to a local load generator
+    std::string host = ADSBHUB_HOST;
+    int port = ADSBHUB_PORT;
+    if (!dataRefs.GetADSBHubHost().empty()) {
+        host = dataRefs.GetADSBHubHost();
+        const size_t posColon = host.rfind(':');
+        if (posColon != std::string::npos) {
+            port = std::atoi(host.c_str() + posColon + 1);
+            host.erase(posColon);
+        }
+    }
+
     try {
         // Clear some data so we can also cleanly restart
         eFormat = FMT_UNKNOWN;
@@ -128,8 +140,8 @@ void ADSBHubConnection::Main ()
         dyn = LTFlightData::FDDynamicData();
         pos = positionTy();
 
-        // open a TCP connection to APRS.glidernet.org
-        tcpStream.Connect(ADSBHUB_HOST, ADSBHUB_PORT, ADSBHUB_BUF_SIZE, unsigned(ADSBHUB_TIMEOUT_S * 1000));
+        // open a TCP connection to data.adsbhub.org
+        tcpStream.Connect(host, port, ADSBHUB_BUF_SIZE, unsigned(ADSBHUB_TIMEOUT_S * 1000));
         int maxSock = (int)tcpStream.getSocket() + 1;
 #if APL == 1 || LIN == 1
         // the self-pipe to shut down the TCP socket gracefully
@@ -185,13 +197,19 @@ void ADSBHubConnection::Main ()
                     lastData = std::chrono::steady_clock::now();
                     switch (eFormat) {
                         case FMT_SBS:
+                        {
+                            StressTimer st(STS_CHN_PROCESS);
                             if (!StreamProcessDataSBS(size_t(rcvdBytes), tcpStream.getBuf()))
                                 throw XPMP2::NetRuntimeError("StreamProcessDataSBS failed");
                             break;
+                        }
                         case FMT_ComprVRS:
+                        {
+                            StressTimer st(STS_CHN_PROCESS);
                             if (!StreamProcessDataVRS(size_t(rcvdBytes), (const uint8_t*)tcpStream.getBuf()))
                                 throw XPMP2::NetRuntimeError("StreamProcessDataVRS failed");
                             break;
+                        }
                         case FMT_NULL_DATA:
                         case FMT_UNKNOWN:
                             throw XPMP2::NetRuntimeError("Format yet unknown, received too few data");
@@ -209,7 +227,7 @@ void ADSBHubConnection::Main ()
     }
     catch (std::runtime_error& e) {
         LOG_MSG(logERR, ERR_TCP_LISTENACCEPT, ChName(),
-                ADSBHUB_HOST, std::to_string(ADSBHUB_PORT).c_str(),
+                host.c_str(), std::to_string(port).c_str(),
                 e.what());
         // Set channel to invalid
         SetValid(false,true);
@@ -627,7 +645,7 @@ void ADSBHubConnection::ProcessPlaneData ()
             try {
                 // from here on access to fdMap guarded by a mutex
                 // until FD object is inserted and updated
-                std::unique_lock<std::mutex> mapFdLock (mapFdMutex);
+                FDMapTy::LockTy mapFdLock = mapFd.Lock(fdKey);
 
                 // get the fd object from the map, key is the transpIcao
                 // this fetches an existing or, if not existing, creates a new one
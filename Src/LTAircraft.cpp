@@ -1233,6 +1233,42 @@ std::string LTAircraft::FlightPhase2String (flightPhaseE phase)
 
 constexpr float ACI_NEAR_AIRPRT_PERIOD =180.0f; ///< How often update the nearest airport? [s]
 
+/// Pool of memory blocks of removed aircraft, for quick re-creation
+static struct AcPoolTy {
+    std::vector<void*> vec;             ///< the memory blocks, each `sizeof(LTAircraft)`
+    ~AcPoolTy () { for (void* p: vec) ::operator delete(p); }
+} gAcPool;
+
+// Allocates from the pool of memory blocks of removed aircraft
+void* LTAircraft::operator new (size_t sz)
+{
+    if (sz == sizeof(LTAircraft) && !gAcPool.vec.empty()) {
+        void* p = gAcPool.vec.back();
+        gAcPool.vec.pop_back();
+        return p;
+    }
+    return ::operator new(sz);
+}
+
+// Returns the memory block to the pool for re-use
+void LTAircraft::operator delete (void* p, size_t sz)
+{
+    if (p && sz == sizeof(LTAircraft) && gAcPool.vec.size() < AC_POOL_MAX)
+        gAcPool.vec.push_back(p);
+    else
+        ::operator delete(p);
+}
+
+/// Key for LTFlightData::cslMdlCache: the type, operator, and livery a CSL model is matched for
+static std::string CslMdlCacheKey (const LTFlightData& fd)
+{
+    const LTFlightData::FDStaticData stat = fd.WaitForSafeCopyStat();
+    return
+    str_first_non_empty({dataRefs.cslFixAcIcaoType, stat.acTypeIcao}) + '|' +
+    str_first_non_empty({dataRefs.cslFixOpIcao,     stat.airlineCode()}) + '|' +
+    str_first_non_empty({dataRefs.cslFixLivery,     stat.reg});
+}
+
 // Constructor: create an aircraft from Flight Data
 LTAircraft::LTAircraft(LTFlightData& inFd) :
 // Base class -> this registers with XPMP API for actual display in XP!
@@ -1242,7 +1278,9 @@ LTAircraft::LTAircraft(LTFlightData& inFd) :
 XPMP2::Aircraft(str_first_non_empty({dataRefs.cslFixAcIcaoType, inFd.WaitForSafeCopyStat().acTypeIcao}).c_str(),
                 str_first_non_empty({dataRefs.cslFixOpIcao,     inFd.WaitForSafeCopyStat().airlineCode()}).c_str(),
                 str_first_non_empty({dataRefs.cslFixLivery,     inFd.WaitForSafeCopyStat().reg}).c_str(),
-                inFd.key().num < MAX_MODE_S_ID ? (XPMPPlaneID)inFd.key().num : 0),      // OGN Ids can be larger than MAX_MODE_S_ID, in that case let XPMP2 assign a synthetic id
+                inFd.key().num < MAX_MODE_S_ID ? (XPMPPlaneID)inFd.key().num : 0,       // OGN Ids can be larger than MAX_MODE_S_ID, in that case let XPMP2 assign a synthetic id
+                // if re-created for the same type/operator/livery then re-use the CSL model matched last time
+                !inFd.cslMdlCache.empty() && inFd.cslMdlCacheKey == CslMdlCacheKey(inFd) ? inFd.cslMdlCache : std::string()),
 // class members
 fd(inFd),
 pMdl(&FlightModel::FindFlightModel(inFd, true)),      // find matching flight model
@@ -1263,6 +1301,9 @@ tireRpm(MDL_TIRE_SLOW_TIME, MDL_TIRE_MAX_RPM),
 gearDeflection(MDL_GEAR_DEFL_TIME, pMdl->GEAR_DEFLECTION),
 probeNextTs(0), terrainAlt_m(0.0)
 {
+    // we start with full detail
+    ++cntLOD[lodTier];
+
     // for some calcs we need correct timestamps _before_ first draw already
     // so make sure the currCycle struct is up-to-date
     int cycle = XPLMGetCycleNumber();
@@ -1327,7 +1368,12 @@ LTAircraft::~LTAircraft()
     if (IsInCameraView())
         ToggleCameraView();
     
+    // Remember the CSL model for a quick re-creation
+    fd.cslMdlCacheKey = CslMdlCacheKey(fd);
+    fd.cslMdlCache = GetModelName();
+
     // Decrease number of visible aircraft and log a message about that fact
+    --cntLOD[lodTier];
     dataRefs.DecNumAc();
     LOG_MSG(logINFO,INFO_AC_REMOVED,labelInternal.c_str());
 }
@@ -1377,7 +1423,7 @@ LTAircraft::operator std::string() const
 // We do all logic and string handling here so we can just copy chars later in the callback
 void LTAircraft::LabelUpdate()
 {
-    label = fd.ComposeLabel();
+    fd.ComposeLabel(label, labelVals);
     
     // color depends on setting and maybe model
     if (dataRefs.IsLabelColorDynamic())
@@ -1901,8 +1947,10 @@ bool LTAircraft::CalcPPos()
 
     // *** Attitude ***
     
-    // Calculate roll based on heading change
-    CalcRoll(prevHead);
+    // Calculate roll based on heading change since the previous full calculation,
+    // which for less detailed aircraft is more than just one frame ago
+    CalcRoll(prevHead,
+             lodBasePos.ts() < ppos.ts() ? ppos.ts() - lodBasePos.ts() : currCycle.diffTime);
 
     // current pitch
     ppos.pitch() = pitch.get();
@@ -2288,11 +2336,13 @@ void LTAircraft::CalcFlightModel (const positionTy& /*from*/, const positionTy&
 /// @details We assume that max bank angle (`pMdl->ROLL_MAX_BANK`) is applied for
 ///          the fastest possible turn (pMdl->MIN_FLIGHT_TURN_TIME).
 ///          If we are turning more slowly then we apply less bank angle.
-void LTAircraft::CalcRoll (double _prevHeading)
+/// @param _prevHeading Heading at the previous calculation
+/// @param _dt [s] Time passed since the previous calculation
+void LTAircraft::CalcRoll (double _prevHeading, double _dt)
 {
-    // How much of a turn did we do since last frame?
+    // How much of a turn did we do since the previous calculation?
     const double partOfCircle = HeadingDiff(_prevHeading, ppos.heading()) / 360.0;
-    const double timeFullCircle = currCycle.diffTime / partOfCircle;  // at current turn rate (if small then we turn _very_ fast!)
+    const double timeFullCircle = _dt / partOfCircle;   // at current turn rate (if small then we turn _very_ fast!)
 
     // On the ground we should actually better be levelled, but we turn the nose wheel
     if (IsOnGrnd()) {
@@ -2318,9 +2368,9 @@ void LTAircraft::CalcRoll (double _prevHeading)
                             std::abs(timeFullCircle) < pMdl->MIN_FLIGHT_TURN_TIME ? std::copysign(pMdl->ROLL_MAX_BANK,timeFullCircle) :
                             pMdl->ROLL_MAX_BANK * pMdl->MIN_FLIGHT_TURN_TIME / timeFullCircle);
     // safeguard against to harsh roll rates:
-    if (std::abs(ppos.roll()-newRoll) > currCycle.diffTime * pMdl->ROLL_RATE) {
-        if (newRoll < ppos.roll()) ppos.roll() -= currCycle.diffTime * pMdl->ROLL_RATE;
-        else                       ppos.roll() += currCycle.diffTime * pMdl->ROLL_RATE;
+    if (std::abs(ppos.roll()-newRoll) > _dt * pMdl->ROLL_RATE) {
+        if (newRoll < ppos.roll()) ppos.roll() -= _dt * pMdl->ROLL_RATE;
+        else                       ppos.roll() += _dt * pMdl->ROLL_RATE;
     }
     else
         ppos.roll() = newRoll;
@@ -2368,12 +2418,13 @@ bool LTAircraft::YProbe ()
     
     if (currCycle.simTime >= probeNextTs)
     {
-        // lastly determine when to do a probe next, more often if closer to the ground
+        // lastly determine when to do a probe next, more often if closer to the ground,
+        // less often if the frame-time governor reduced limits
         static_assert(sizeof(PROBE_HEIGHT_LIM) == sizeof(PROBE_DELAY));
         for ( size_t i=0; i < sizeof(PROBE_HEIGHT_LIM)/sizeof(PROBE_HEIGHT_LIM[0]); i++)
         {
             if ( GetPHeight_ft() >= PROBE_HEIGHT_LIM[i] ) {
-                probeNextTs = currCycle.simTime + PROBE_DELAY[i];
+                probeNextTs = currCycle.simTime + PROBE_DELAY[i] / dataRefs.GetGovFactor();
                 break;
             }
         }
@@ -2385,10 +2436,15 @@ bool LTAircraft::YProbe ()
         vecView = dataRefs.GetViewPos().between(ppos);
         // update AI slotting priority
         CalcAIPrio();
-        // update the a/c label with fresh values
-        LabelUpdate();
+        // update the a/c label with fresh values (less often if the frame-time governor says so)
+        if (currCycle.simTime >= labelNextTs) {
+            LabelUpdate();
+            labelNextTs = currCycle.simTime + dataRefs.GetLabelUpdIntvl();
+        }
         // are we visible?
         CalcVisible();
+        // how detailed shall we be updated?
+        CalcLODTier();
     }
     
     // Success
@@ -2621,6 +2677,86 @@ void LTAircraft::CalcAIPrio ()
         aiPrio += 3;
 }
 
+//
+// MARK: Level of Detail
+//
+
+int LTAircraft::cntLOD[LOD_CNT] = {0, 0, 0};
+
+// Determines level of detail based on distance to camera and visibility
+void LTAircraft::CalcLODTier ()
+{
+    lodTierE tier = LOD_NEAR;
+    // The aircraft in camera view always gets full detail
+    if (!IsInCameraView()) {
+        if (!IsVisible() || vecView.dist > dataRefs.GetLODFarDist_m())
+            tier = LOD_FAR;
+        else if (vecView.dist > dataRefs.GetLODNearDist_m())
+            tier = LOD_MID;
+    }
+    if (tier != lodTier) {
+        --cntLOD[lodTier];
+        ++cntLOD[tier];
+        // getting more detailed? Then calculate fully right away
+        if (tier < lodTier)
+            lodNextCalcTs = NAN;
+        lodTier = tier;
+    }
+}
+
+// Is a full position calculation due in this frame?
+bool LTAircraft::IsLODCalcDue () const
+{
+    return
+        lodTier == LOD_NEAR ||
+        phase == FPH_UNKNOWN ||
+        !(currCycle.simTime < lodNextCalcTs);       // (also true if `lodNextCalcTs` is NAN)
+}
+
+// After a full position calculation: remember ppos for extrapolation, schedule next calculation
+void LTAircraft::LODSaveCalc ()
+{
+    // Change per second since last full calculation
+    const double dt = ppos.ts() - lodBasePos.ts();
+    if (dt > 0.0) {
+        double dLon = ppos.lon() - lodBasePos.lon();
+        if (dLon > 180.0)       dLon -= 360.0;      // crossing the antimeridian
+        else if (dLon < -180.0) dLon += 360.0;
+        lodDLat = (ppos.lat()   - lodBasePos.lat())   / dt;
+        lodDLon = dLon / dt;
+        lodDAlt = (ppos.alt_m() - lodBasePos.alt_m()) / dt;
+    } else {
+        lodDLat = lodDLon = lodDAlt = 0.0;
+    }
+    lodBasePos = ppos;
+
+    // Less detailed aircraft re-evaluate their level of detail with every full calculation,
+    // so that they quickly get more detailed when the camera comes closer
+    if (lodTier != LOD_NEAR) {
+        vecView = dataRefs.GetViewPos().between(ppos);
+        CalcLODTier();
+    }
+    // Schedule by the current tier, near aircraft are calculated every frame anyway,
+    // and when demoted their first calculation in the new tier is due right away
+    switch (lodTier) {
+        case LOD_MID: lodNextCalcTs = currCycle.simTime + LOD_MID_CALC_INTVL; break;
+        case LOD_FAR: lodNextCalcTs = currCycle.simTime + LOD_FAR_CALC_INTVL; break;
+        default:      lodNextCalcTs = NAN;                                    break;
+    }
+}
+
+// In between full calculations: linearly extrapolate ppos
+void LTAircraft::LODExtrapolate ()
+{
+    const double dt = currCycle.simTime - lodBasePos.ts();
+    ppos.lat()   = lodBasePos.lat()   + lodDLat * dt;
+    ppos.lon()   = lodBasePos.lon()   + lodDLon * dt;
+    ppos.alt_m() = lodBasePos.alt_m() + lodDAlt * dt;
+    if (ppos.lon() > 180.0)       ppos.lon() -= 360.0;
+    else if (ppos.lon() < -180.0) ppos.lon() += 360.0;
+    ppos.ts()    = currCycle.simTime;
+}
+
 //
 // MARK: External Camera View
 //
@@ -2859,6 +2995,8 @@ int LTAircraft::CameraCommandsCB(
 //
 void LTAircraft::UpdatePosition (float, int cycle)
 {
+    GovTimer gt;
+    StressTimer st(STS_AC_UPDATE);
     try {
         // We (LT) don't get called anywhere else once per frame.
         // XPMP API calls directly for aircraft positions.
@@ -2877,8 +3015,19 @@ void LTAircraft::UpdatePosition (float, int cycle)
         
         
         // *** Position ***
-        if (!CalcPPos())
-            return;
+        // Near aircraft are fully calculated every frame,
+        // farther ones only every so often and extrapolated in between
+        const bool bFullCalc = IsLODCalcDue();
+        if (bFullCalc) {
+            // continue from the last calculated position, not an extrapolated one
+            if (lodBasePos.ts() < ppos.ts())
+                ppos = lodBasePos;
+            if (!CalcPPos())
+                return;
+            LODSaveCalc();
+        }
+        else
+            LODExtrapolate();
         
         // If needed update the chosen CSL model
         if (ShallUpdateModel())
@@ -2891,41 +3040,49 @@ void LTAircraft::UpdatePosition (float, int cycle)
         drawInfo.heading = float(nanToZero(GetHeading()));
         
         // *** Configuration ***
+        // (changes slowly, so only with full calculations)
         
-        SetGearRatio((float)gear.get());                // gear
-        SetFlapRatio((float)flaps.get());               // flaps, and slats the same
-        SetSlatRatio(GetFlapRatio());
-        SetSpoilerRatio((float)spoilers.get());         // spoilers, and speed brakes the same
-        SetSpeedbrakeRatio(GetSpoilerRatio());
-        SetReversDeployRatio((float)reversers.get());   // opening reversers
-        SetThrustReversRatio((float)reversers.get());
-
-        // for engine / prop rotation we derive a value based on flight model
-        if (pDoc8643->hasRotor())
-            SetEngineRotRpm(float(pMdl->PROP_RPM_MAX));
-        else
-            SetEngineRotRpm(float(pMdl->PROP_RPM_MAX/2 + GetThrustRatio() * pMdl->PROP_RPM_MAX/2));
-        SetPropRotRpm(GetEngineRotRpm());
-        
-        // Make props and rotors move based on rotation speed and time passed since last cycle
-        SetEngineRotAngle(GetEngineRotAngle() + RpmToDegree(GetEngineRotRpm(), currCycle.diffTime));
+        if (bFullCalc) {
+            SetGearRatio((float)gear.get());                // gear
+            SetFlapRatio((float)flaps.get());               // flaps, and slats the same
+            SetSlatRatio(GetFlapRatio());
+            SetSpoilerRatio((float)spoilers.get());         // spoilers, and speed brakes the same
+            SetSpeedbrakeRatio(GetSpoilerRatio());
+            SetReversDeployRatio((float)reversers.get());   // opening reversers
+            SetThrustReversRatio((float)reversers.get());
+        }
 
-        while (GetEngineRotAngle() >= 360.0f)
-            SetEngineRotAngle(GetEngineRotAngle() - 360.0f);
-        SetPropRotAngle(GetEngineRotAngle());
-        
-        // Gear deflection - has an effect during touch-down only
-        SetTireDeflection((float)gearDeflection.get());
+        // *** Animations ***
+        // (only for near aircraft, none of that is visible farther away)
         
-        // Tire rotation similarly
-        SetTireRotRpm((float)tireRpm.get());
-        SetTireRotAngle(GetTireRotAngle() + RpmToDegree(GetTireRotRpm(), currCycle.diffTime));
-        while (GetTireRotAngle() >= 360.0f)
-            SetTireRotAngle(GetTireRotAngle() - 360.0f);
-
-        // 'moment' of touch down?
-        // (We use the reversers deploy time for this...that's 2s)
-        SetTouchDown(reversers.isIncrease() && reversers.inMotion());
+        if (lodTier == LOD_NEAR) {
+            // for engine / prop rotation we derive a value based on flight model
+            if (pDoc8643->hasRotor())
+                SetEngineRotRpm(float(pMdl->PROP_RPM_MAX));
+            else
+                SetEngineRotRpm(float(pMdl->PROP_RPM_MAX/2 + GetThrustRatio() * pMdl->PROP_RPM_MAX/2));
+            SetPropRotRpm(GetEngineRotRpm());
+            
+            // Make props and rotors move based on rotation speed and time passed since last cycle
+            SetEngineRotAngle(GetEngineRotAngle() + RpmToDegree(GetEngineRotRpm(), currCycle.diffTime));
+
+            while (GetEngineRotAngle() >= 360.0f)
+                SetEngineRotAngle(GetEngineRotAngle() - 360.0f);
+            SetPropRotAngle(GetEngineRotAngle());
+            
+            // Gear deflection - has an effect during touch-down only
+            SetTireDeflection((float)gearDeflection.get());
+            
+            // Tire rotation similarly
+            SetTireRotRpm((float)tireRpm.get());
+            SetTireRotAngle(GetTireRotAngle() + RpmToDegree(GetTireRotRpm(), currCycle.diffTime));
+            while (GetTireRotAngle() >= 360.0f)
+                SetTireRotAngle(GetTireRotAngle() - 360.0f);
+
+            // 'moment' of touch down?
+            // (We use the reversers deploy time for this...that's 2s)
+            SetTouchDown(reversers.isIncrease() && reversers.inMotion());
+        }
         
         // *** Radar ***
         
@@ -29,6 +29,14 @@
 
 #include "LiveTraffic.h"
 
+#include <charconv>
+#include <string_view>
+#if APL == 1 || LIN == 1
+#include <sys/mman.h>       // for memory-mapping apt.dat files
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 // File paths
 
 /// Path to the `scenery_packs.ini` file, which defines order and activation status of scenery packs
@@ -54,6 +62,9 @@ volatile bool bStopThread = false;
 
 class Apt;
 
+/// Map of airports, key is the id (typically: ICAO code)
+typedef std::map<std::string, Apt> mapAptTy;
+
 //
 // MARK: Airports, Runways and Taxiways
 //
@@ -286,10 +297,123 @@ public:
 /// Vector of taxi edges
 typedef std::vector<TaxiEdge> vecTaxiEdgeTy;
 
+/// @brief Uniform grid of node or edge indexes, speeds up proximity searches while building an airport's taxi network
+/// @details Cells are APT_GRID_CELL_M wide. Objects are listed in all cells they touch,
+///          possibly more than once, and are never removed.
+///          A search therefore returns a superset of the objects in range,
+///          the caller needs to do the exact checks.
+class TaxiGridTy {
+protected:
+    double cellLat = NAN;               ///< [°] height of a cell
+    double cellLon = NAN;               ///< [°] width of a cell, determined at the latitude of the first object added
+    std::unordered_map<uint64_t, vecIdxTy> mapCells;    ///< cells with the indexes of their objects
+    
+    /// Key of the cell with given column/row number
+    static uint64_t CellKey (long x, long y)
+    { return (uint64_t(uint32_t(x)) << 32) | uint64_t(uint32_t(y)); }
+    /// Column number of a longitude
+    long CellX (double lon) const { return long(std::floor(lon / cellLon)); }
+    /// Row number of a latitude
+    long CellY (double lat) const { return long(std::floor(lat / cellLat)); }
+    
+public:
+    /// Remove everything
+    void clear ()
+    {
+        mapCells.clear();
+        cellLat = cellLon = NAN;
+    }
+    
+    /// Add an object at a given location
+    void Add (double lat, double lon, size_t idx)
+    {
+        if (std::isnan(cellLon)) {
+            cellLat = Dist2Lat(APT_GRID_CELL_M);
+            cellLon = Dist2Lon(APT_GRID_CELL_M, lat);
+        }
+        vecIdxTy& vec = mapCells[CellKey(CellX(lon), CellY(lat))];
+        if (vec.empty() || vec.back() != idx)
+            vec.push_back(idx);
+    }
+    
+    /// @brief Add a line object by sampling it every half cell
+    /// @note Any point on the line is then less than a quarter cell away from a sample,
+    ///       which searches need to add to their search distance, see AddLineDist()
+    void AddLine (double lat1, double lon1, double lat2, double lon2, size_t idx)
+    {
+        const double dist = DistLatLon(lat1, lon1, lat2, lon2);
+        if (std::isnan(dist)) return;
+        const int n = int(dist / (APT_GRID_CELL_M / 2.0)) + 1;
+        for (int i = 0; i <= n; ++i)
+            Add(lat1 + (lat2-lat1) * i / n,
+                lon1 + (lon2-lon1) * i / n, idx);
+    }
+    
+    /// Additional search distance for finding objects added by AddLine()
+    static constexpr double AddLineDist () { return APT_GRID_CELL_M / 4.0; }
+    
+    /// @brief Find all objects listed in cells within `dist_m` around a location
+    /// @param[out] vecOut Receives the objects' indexes, sorted and unique
+    void Find (double lat, double lon, double dist_m, vecIdxTy& vecOut) const
+    {
+        vecOut.clear();
+        if (std::isnan(cellLon)) return;
+        const double latDiff = Dist2Lat(dist_m);
+        const double lonDiff = Dist2Lon(dist_m, lat);
+        const long xMax = CellX(lon + lonDiff);
+        const long yMax = CellY(lat + latDiff);
+        for (long y = CellY(lat - latDiff); y <= yMax; ++y)
+            for (long x = CellX(lon - lonDiff); x <= xMax; ++x) {
+                const auto iter = mapCells.find(CellKey(x, y));
+                if (iter != mapCells.end())
+                    vecOut.insert(vecOut.end(), iter->second.cbegin(), iter->second.cend());
+            }
+        std::sort(vecOut.begin(), vecOut.end());
+        vecOut.erase(std::unique(vecOut.begin(), vecOut.end()), vecOut.end());
+    }
+};
+
+/// @brief An airport tile, covering APT_TILE_DEG degrees of latitude and longitude
+/// @details Airports are read and evicted tile by tile.
+///          An airport belongs to the tile of its first runway end.
+struct AptTileTy {
+    int lat = INT_MIN;                  ///< southern boundary in multiples of APT_TILE_DEG
+    int lon = INT_MIN;                  ///< western boundary in multiples of APT_TILE_DEG
+    
+    /// The tile containing the given location
+    static AptTileTy Of (double _lat, double _lon)
+    { return AptTileTy { int(std::floor(_lat / APT_TILE_DEG)), int(std::floor(_lon / APT_TILE_DEG)) }; }
+    /// Center of the tile
+    positionTy center () const
+    { return positionTy((lat + 0.5) * APT_TILE_DEG, (lon + 0.5) * APT_TILE_DEG); }
+    
+    bool operator== (const AptTileTy& o) const { return lat == o.lat && lon == o.lon; }
+    bool operator< (const AptTileTy& o) const { return lat < o.lat || (lat == o.lat && lon < o.lon); }
+};
+
+/// Set of airport tiles
+typedef std::set<AptTileTy> setAptTileTy;
+
+/// Add all tiles to `tiles`, which overlap with the given box
+static void AptTilesOf (const boundingBoxTy& box, setAptTileTy& tiles)
+{
+    const int nLonTiles = int(std::lround(360.0 / APT_TILE_DEG));
+    const AptTileTy sw = AptTileTy::Of(box.se.lat(), box.nw.lon());
+    const AptTileTy ne = AptTileTy::Of(box.nw.lat(), box.se.lon());
+    const int lonEnd = box.nw.lon() > box.se.lon() ?    // box crossing the antimeridian?
+                       ne.lon + nLonTiles : ne.lon;
+    for (int lat = sw.lat; lat <= ne.lat; ++lat)
+        for (int lon = sw.lon; lon <= lonEnd; ++lon)
+            // normalize the longitude index into [-180°, 180°)
+            tiles.insert(AptTileTy { lat,
+                ((lon + nLonTiles/2) % nLonTiles + nLonTiles) % nLonTiles - nLonTiles/2 });
+}
+
 /// Represents an airport as read from apt.dat
 class Apt {
 protected:
     std::string id;                     ///< ICAO code or other unique id
+    AptTileTy tile;                     ///< the tile the airport belongs to
     boundingBoxTy bounds;               ///< bounding box around airport, calculated from rwy and taxiway extensions
     double alt_m = NAN;                 ///< the airport's altitude
     vecTaxiNodesTy vecTaxiNodes;        ///< vector of taxi network nodes
@@ -298,10 +422,13 @@ protected:
     vecIdxTy       vecTaxiEdgesIdxHead; ///< vector of indexes into Apt::vecTaxiEdges, sorted by TaxiEdge::angle
     vecStartupLocTy vecStartupLocs;     ///< vector of startup locations
     
-    static vecTaxiNodesTy vecRwyNodes;  ///< temporary storage for rwy ends (to add egdes for the rwy later)
-    static mapTaxiTmpPosTy mapPos;      ///< temporary storage for positions while reading apt.dat
-    static listTaxiTmpPathTy listPaths; ///< temporary storage for paths while reading apt.dat
-    static vecIdxTy vecPathEnds;        ///< temporary storage for path endpoints (idx into Apt::vecTaxiNodes)
+    // Temporary storage is per thread as several apt.dat files are read in parallel
+    static thread_local vecTaxiNodesTy vecRwyNodes;     ///< temporary storage for rwy ends (to add egdes for the rwy later)
+    static thread_local mapTaxiTmpPosTy mapPos;         ///< temporary storage for positions while reading apt.dat
+    static thread_local listTaxiTmpPathTy listPaths;    ///< temporary storage for paths while reading apt.dat
+    static thread_local vecIdxTy vecPathEnds;           ///< temporary storage for path endpoints (idx into Apt::vecTaxiNodes)
+    static thread_local TaxiGridTy gridNodes;           ///< temporary grid index of Apt::vecTaxiNodes while building the taxi network
+    static thread_local TaxiGridTy gridEdges;           ///< temporary grid index of Apt::vecTaxiEdges while building the taxi network
     static XPLMProbeRef YProbe;         ///< Y Probe for terrain altitude computation
     
 #ifdef DEBUG
@@ -326,6 +453,25 @@ public:
     /// Return a reasonable altitude...effectively one of the rwy ends' altitude
     double GetAlt_m () const { return alt_m; }
     
+    /// The tile the airport belongs to
+    const AptTileTy& GetTile () const { return tile; }
+    /// Set the tile the airport belongs to
+    void SetTile (const AptTileTy& _tile) { tile = _tile; }
+    
+    /// Rough estimate of the memory used by the airport, for keeping within APT_MEM_BUDGET
+    size_t GetMemSize () const
+    {
+        size_t sz = sizeof(Apt) +
+        vecTaxiNodes.capacity()         * sizeof(TaxiNode) +
+        vecRwyEndPts.capacity()         * sizeof(RwyEndPt) +
+        vecTaxiEdges.capacity()         * sizeof(TaxiEdge) +
+        vecTaxiEdgesIdxHead.capacity()  * sizeof(size_t) +
+        vecStartupLocs.capacity()       * sizeof(StartupLoc);
+        for (const TaxiNode& n: vecTaxiNodes)
+            sz += n.vecEdges.capacity() * sizeof(size_t);
+        return sz;
+    }
+    
     // --- MARK: Temporary data while reading apt.dat
     
     /// @brief Find a similar position in Apt::mapPos
@@ -414,38 +560,39 @@ public:
         return EDGE_UNAVAIL;
     }
 
-    /// return index of closest taxi node within a "close-by" distance (or ULONG_MAX if none close enough)
+    /// @brief return index of closest taxi node within a "close-by" distance (or ULONG_MAX if none close enough)
+    /// @note Only searches the nodes listed in Apt::gridNodes, i.e. only available while building the taxi network
     size_t GetSimilarTaxiNode (double _lat, double _lon,
                                size_t dontCombineWith = ULONG_MAX) const
     {
         constexpr double latDiff = Dist2Lat(APT_MAX_SIMILAR_NODE_DIST_M);
         const     double lonDiff = Dist2Lon(APT_MAX_SIMILAR_NODE_DIST_M, _lat);
         
+        // Candidates: nodes in the grid cells around the position, sorted by index
+        static thread_local vecIdxTy vecCand;
+        gridNodes.Find(_lat, _lon, APT_MAX_SIMILAR_NODE_DIST_M, vecCand);
+        
         double bestDist2 = HUGE_VAL;
-        const vecTaxiNodesTy::const_iterator dontIter =
-        dontCombineWith == ULONG_MAX ? vecTaxiNodes.cend() :
-                                       std::next(vecTaxiNodes.cbegin(),(long)dontCombineWith);
-        vecTaxiNodesTy::const_iterator bestIter = vecTaxiNodes.cend();
-        for (auto iter = vecTaxiNodes.cbegin(); iter != vecTaxiNodes.cend(); ++iter)
+        size_t bestIdx = ULONG_MAX;
+        for (size_t idx: vecCand)
         {
             // quick check: reasonable lat/lon range
-            if (iter != dontIter &&         // not the one node to skip
-                std::abs(iter->lat - _lat) < latDiff &&
-                std::abs(iter->lon - _lon) < lonDiff)
+            const TaxiNode& n = vecTaxiNodes[idx];
+            if (idx != dontCombineWith &&   // not the one node to skip
+                std::abs(n.lat - _lat) < latDiff &&
+                std::abs(n.lon - _lon) < lonDiff)
             {
                 // find shortest distance
-                const double dist2 = DistLatLonSqr(_lat, _lon, iter->lat, iter->lon);
+                const double dist2 = DistLatLonSqr(_lat, _lon, n.lat, n.lon);
                 if (dist2 < bestDist2) {
                     bestDist2 = dist2;
-                    bestIter = iter;
+                    bestIdx = idx;
                 }
             }
         }
         
         // Found something?
-        return (bestIter != vecTaxiNodes.cend() ?
-                (size_t)std::distance(vecTaxiNodes.cbegin(), bestIter) :
-                ULONG_MAX);
+        return bestIdx;
     }
     
     /// @brief Add a new taxi network node
@@ -463,6 +610,7 @@ public:
         
         bounds.enlarge_pos(lat, lon);           // Potentially expands the airport's boundary
         vecTaxiNodes.emplace_back(lat, lon);    // Add the node to the back of the list
+        gridNodes.Add(lat, lon, vecTaxiNodes.size()-1);
         return vecTaxiNodes.size()-1;           // return the index
     }
     
@@ -482,6 +630,7 @@ public:
             // then assign the value
             vecTaxiNodes[idx] = TaxiNode(lat,lon);
         }
+        gridNodes.Add(lat, lon, idx);
     }
     
     /// @brief Add a new taxi network edge, which must connect 2 existing nodes
@@ -508,6 +657,7 @@ public:
         const size_t eIdx = vecTaxiEdges.size()-1;
         a.vecEdges.push_back(eIdx);
         b.vecEdges.push_back(eIdx);
+        gridEdges.AddLine(a.lat, a.lon, b.lat, b.lon, eIdx);
         
         return eIdx;
     }
@@ -704,13 +854,15 @@ public:
     /// @param _angleTolerance Maximum difference between `pos.heading()` and TaxiEdge::angle to be considered a match
     /// @param _angleToleranceExt Second priority tolerance, considered only if such a node is more than 5m closer than one that better fits angle
     /// @param _vecSkipEIdx (optional) Do not return any of these edge
+    /// @param _pCandidates (optional) Search only these edges, e.g. found in Apt::gridEdges, instead of Apt::vecTaxiEdgesIdxHead
     /// @return Pointer to closest taxiway edge or `nullptr` if no match was found
     const TaxiEdge* FindClosestEdge (const positionTy& _pos,
                                      positionTy& _basePt,
                                      double _maxDist_m,
                                      double _angleTolerance,
                                      double _angleToleranceExt,
-                                     const vecIdxTy& _vecSkipEIdx = vecIdxTy()) const
+                                     const vecIdxTy& _vecSkipEIdx = vecIdxTy(),
+                                     const vecIdxTy* _pCandidates = nullptr) const
     {
         const TaxiEdge* bestEdge = nullptr;
         size_t bestEdgeIdx = EDGE_UNKNOWN;
@@ -732,7 +884,8 @@ public:
         // Get a list of edges matching pos.heading()
         vecIdxTy lstEdges;
         const double headSearch = HeadingNormalize(_pos.heading());
-        if (_angleToleranceExt < 90.0) {            // ...if there actually is a limiting heading tolerance
+        if (_angleToleranceExt < 90.0 &&            // ...if there actually is a limiting heading tolerance
+            !_pCandidates) {                        // (candidates are checked for heading in the loop below)
             if (!FindEdgesForHeading(headSearch,
                                      std::max(_angleTolerance, _angleToleranceExt),
                                      lstEdges))
@@ -740,8 +893,9 @@ public:
         }
         
         // Analyze the edges to find the closest edge
-        // Either use the limited list of edges matching a heading or just all edges
-        const vecIdxTy& edgesToSearch = lstEdges.empty() ? vecTaxiEdgesIdxHead : lstEdges;
+        // Either use the given candidates, the limited list of edges matching a heading, or just all edges
+        const vecIdxTy& edgesToSearch = _pCandidates ? *_pCandidates :
+                                        lstEdges.empty() ? vecTaxiEdgesIdxHead : lstEdges;
         for (size_t eIdx: edgesToSearch)
         {
             // Skip edge if wanted so
@@ -763,6 +917,11 @@ public:
             const TaxiNode& from  = e.startByHeading(*this, headSearch);
             const TaxiNode& to    = e.endByHeading(*this, headSearch);
             const double edgeAngle = e.GetAngleByHead(headSearch);
+            
+            // Candidates haven't been pre-selected by heading
+            if (_pCandidates && _angleToleranceExt < 90.0 &&
+                std::abs(HeadingDiff(edgeAngle, headSearch)) > std::max(_angleTolerance, _angleToleranceExt))
+                continue;
 
             // Compute temporary "coordinates", relative to the search position
             const double from_x = Lon2Dist(from.lon - _pos.lon(), _pos.lat());      // x is eastward
@@ -966,7 +1125,9 @@ public:
     /// @brief For each path end, try connecting them to some edge (which might by a rwy)
     /// @details This shall\n
     ///          a) connect runways to taxiways\n
-    ///          b) taxiway joints (which don't happen to have a directly overlapping node)
+    ///          b) taxiway joints (which don't happen to have a directly overlapping node)\n
+    ///          Edges to join with are searched for in Apt::gridEdges,
+    ///          Apt::vecTaxiEdgesIdxHead is sorted only once at the end.
     void JoinPathEnds ()
     {
         // We had added entpoints to vecPathsEnds in a random order.
@@ -976,6 +1137,7 @@ public:
         vecPathEnds.erase(lastPE,vecPathEnds.end());
         
         // Loop all path ends and see if they are in need of another connection
+        vecIdxTy vecCand;
         for (size_t idxN: vecPathEnds)
         {
             // The node we deal with
@@ -989,14 +1151,17 @@ public:
             auto lastEExcl = std::unique(vecEdgeExclusions.begin(), vecEdgeExclusions.end());
             vecEdgeExclusions.erase(lastEExcl,vecEdgeExclusions.end());
 
-            // Try finding _another_ edge this one can connect to
+            // Try finding _another_ edge this one can connect to,
+            // larger distance allowed if I'm a single node, smaller only if I already have connections
+            const double maxDist = n.vecEdges.size() <= 1 ? APT_JOIN_MAX_DIST_M : APT_MAX_SIMILAR_NODE_DIST_M;
+            gridEdges.Find(n.lat, n.lon, maxDist + TaxiGridTy::AddLineDist(), vecCand);
             positionTy pos(n.lat, n.lon, 0.0, NAN, vecTaxiEdges[n.vecEdges.front()].GetAngleFrom(idxN));
             const TaxiEdge* pJoinE = FindClosestEdge(pos, pos,
-                                                     // larger distance allowed if I'm a single node, smaller only if I already have connections
-                                                     n.vecEdges.size() <= 1 ? APT_JOIN_MAX_DIST_M : APT_MAX_SIMILAR_NODE_DIST_M,
+                                                     maxDist,
                                                      APT_JOIN_ANGLE_TOLERANCE,
                                                      90.0,      // don't limit by heading...search all edges!
-                                                     vecEdgeExclusions);
+                                                     vecEdgeExclusions,
+                                                     &vecCand);
             if (!pJoinE)
                 continue;
             
@@ -1033,6 +1198,8 @@ public:
             // One of the nodes is indeed nearby?
             if (nearIdxN < ULONG_MAX) {
                 ReplaceNode(idxN, nearIdxN);
+                // edges, which moved over to the near node, need to be found at their new location
+                GridAddEdgesOf(nearIdxN);
             }
             // Not nearby:
             else {
@@ -1041,14 +1208,29 @@ public:
                     RecalcTaxiEdge(idxEE);
                 // Split pJoinE at the base position, now n (whose index is idxN)
                 SplitEdge(joinIdxE, idxN);
+                // n and its edges need to be found at their new location
+                gridNodes.Add(n.lat, n.lon, idxN);
+                GridAddEdgesOf(idxN);
             }
 
-            // To ensure FindClosestEdge works we need to sort
-            SortTaxiEdges();
     #ifdef DEBUG
-            LOG_ASSERT(ValidateNodesEdges());
+            LOG_ASSERT(ValidateNodesEdges(false));
     #endif
         }           // for all path ends (which are nodes)
+        
+        // To ensure FindClosestEdge works (again) we need to sort
+        SortTaxiEdges();
+    }
+    
+    /// Add all edges of the given node to Apt::gridEdges (again), e.g. after the node moved
+    void GridAddEdgesOf (size_t idxN)
+    {
+        for (size_t idxE: vecTaxiNodes[idxN].vecEdges) {
+            const TaxiEdge& e = vecTaxiEdges[idxE];
+            const TaxiNode& a = e.GetA(*this);
+            const TaxiNode& b = e.GetB(*this);
+            gridEdges.AddLine(a.lat, a.lon, b.lat, b.lon, idxE);
+        }
     }
     
     /// @brief Find shortest path in taxi network with a maximum length between 2 nodes
@@ -1882,35 +2064,45 @@ public:
     
     // --- MARK: Static Functions
     
-    /// @brief Add airport to list of airports
-    static void AddApt (Apt&& apt);
+    /// @brief Add airport to the list of airports read from one `apt.dat` file
+    static void AddApt (Apt&& apt, mapAptTy& mapApt);
+    
+    /// Clear all temporary storage used while reading one airport
+    static void ClearTempStorage ();
 
 
 };  // class Apt
 
-/// Map of airports, key is the id (typically: ICAO code)
-typedef std::map<std::string, Apt> mapAptTy;
-
 /// Global map of airports
 static mapAptTy gmapApt;
 
 /// Lock to access global map of airports
 static std::mutex mtxGMapApt;
 
+/// Is the airport already defined in the global map of airports?
+static bool IsAptKnown (const std::string& id)
+{
+    std::lock_guard<std::mutex> lock(mtxGMapApt);
+    return gmapApt.count(id) > 0;
+}
+
 // Temporary storage while reading an airport from apt.dat
-vecTaxiNodesTy Apt::vecRwyNodes;
-mapTaxiTmpPosTy Apt::mapPos;
-listTaxiTmpPathTy Apt::listPaths;
-vecIdxTy Apt::vecPathEnds;
+thread_local vecTaxiNodesTy Apt::vecRwyNodes;
+thread_local mapTaxiTmpPosTy Apt::mapPos;
+thread_local listTaxiTmpPathTy Apt::listPaths;
+thread_local vecIdxTy Apt::vecPathEnds;
+thread_local TaxiGridTy Apt::gridNodes;
+thread_local TaxiGridTy Apt::gridEdges;
 
 // Y Probe for terrain altitude computation
 XPLMProbeRef Apt::YProbe = NULL;
 
-// Add airport to list of airports
+// Add airport to the list of airports read from one `apt.dat` file
 /// @details It is actually expected that `apt` is not yet known and really added to the map,
 ///          that's why the fancy debug log message is formatted first.
 ///          In the end, map::emplace certainly makes sure and wouldn't actually add duplicates.
-void Apt::AddApt (Apt&& apt)
+///          Which file's definition makes it into ::gmapApt is decided later by MergeAptFiles().
+void Apt::AddApt (Apt&& apt, mapAptTy& mapApt)
 {
     // At this stage the airport is defined.
     // We'll now add as much space to the bounding box as
@@ -1931,11 +2123,9 @@ void Apt::AddApt (Apt&& apt)
 //#endif
     }
     
-    // Prepare the indirect array, which sorts by edge angle
+    // Now connect open ends, ie. try finding joints between a node and existing edges,
+    // this also prepares the indirect array, which sorts by edge angle
     // for faster finding of edges by heading
-    apt.SortTaxiEdges();
-    
-    // Now connect open ends, ie. try finding joints between a node and existing edges
     apt.JoinPathEnds();
 #ifdef DEBUG
     LOG_ASSERT(apt.ValidateNodesEdges());
@@ -1943,7 +2133,7 @@ void Apt::AddApt (Apt&& apt)
 
     // Fancy debug-level logging message, listing all runways
     // (here already as `apt` gets moved soon and becomes reset)
-    LOG_MSG(logDEBUG, "apt.dat: Added %s at %s with %lu runways (%s) and [%lu|%lu] taxi nodes|edges",
+    LOG_MSG(logDEBUG, "apt.dat: Read %s at %s with %lu runways (%s) and [%lu|%lu] taxi nodes|edges",
             apt.GetId().c_str(),
             std::string(apt.GetBounds()).c_str(),
             (long unsigned)(apt.GetRwyEndPtVec().size() / 2),
@@ -1951,18 +2141,23 @@ void Apt::AddApt (Apt&& apt)
             (long unsigned)apt.GetTaxiNodesVec().size(),
             (long unsigned)apt.GetTaxiEdgeVec().size());
 
-    // Access to the list of airports is guarded by a lock
+    // The file's list of airports is only accessed by the reading thread
     const std::string key = apt.GetId();          // make a copy of the key, as `apt` gets moved soon:
-    {
-        std::lock_guard<std::mutex> lock(mtxGMapApt);
-        gmapApt.emplace(key, std::move(apt));
-    }
+    mapApt.emplace(key, std::move(apt));
     
     // clear all temporary storage
+    ClearTempStorage();
+}
+
+// Clear all temporary storage used while reading one airport
+void Apt::ClearTempStorage ()
+{
     vecRwyNodes.clear();
     mapPos.clear();
     listPaths.clear();
     vecPathEnds.clear();
+    gridNodes.clear();
+    gridEdges.clear();
 }
 
 /// Return the a node, ie. the starting point of the edge
@@ -1990,6 +2185,323 @@ static const std::array<int,8> APT_LINE_TYPES { 1, 7, 10, 11, 51, 57, 60, 61 };
 /// @see   More information on reading from `apt.dat` is on [a separate page](@ref apt_dat).
 static const std::array<int,4> APT_PATH_TERM_ROW_CODES { 113, 114, 115, 116 };
 
+//
+// MARK: Scanning apt.dat
+//
+
+/// @brief A memory-mapped, read-only file
+/// @details Lets the `apt.dat` scanner look at the file's content directly
+///          instead of copying it line by line into strings.
+class MappedFileTy {
+protected:
+    const char* pData = nullptr;        ///< start of the mapped file content
+    size_t      len = 0;                ///< file size
+    uint64_t    mtime = 0;              ///< last modification time, in some platform-specific unit
+    int         err = 0;                ///< `errno`-like error code if the file could not be mapped
+#if IBM
+    HANDLE      hFile = INVALID_HANDLE_VALUE;   ///< the file
+    HANDLE      hMap = NULL;            ///< the file mapping object
+#else
+    int         fd = -1;                ///< the file descriptor
+#endif
+    
+public:
+    /// Opens and maps the file, check isOpen() for success
+    MappedFileTy (const std::string& path);
+    /// Unmaps and closes the file
+    ~MappedFileTy ();
+    
+    // not copyable
+    MappedFileTy (const MappedFileTy&) = delete;
+    MappedFileTy& operator= (const MappedFileTy&) = delete;
+    
+    /// Could the file be opened and mapped?
+    bool isOpen () const { return err == 0; }
+    /// `errno`-like error code if the file could not be opened
+    int GetErr () const { return err; }
+    /// File content
+    const char* data () const { return pData; }
+    /// File size
+    size_t size () const { return len; }
+    /// Last modification time
+    uint64_t GetMTime () const { return mtime; }
+};
+
+// Opens and maps the file
+MappedFileTy::MappedFileTy (const std::string& path)
+{
+#if IBM
+    hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        const DWORD e = GetLastError();
+        err = (e == ERROR_FILE_NOT_FOUND || e == ERROR_PATH_NOT_FOUND) ? ENOENT : EIO;
+        return;
+    }
+    LARGE_INTEGER sz;
+    FILETIME ft;
+    if (!GetFileSizeEx(hFile, &sz) || !GetFileTime(hFile, NULL, NULL, &ft)) {
+        err = EIO;
+        return;
+    }
+    len = size_t(sz.QuadPart);
+    mtime = (uint64_t(ft.dwHighDateTime) << 32) | uint64_t(ft.dwLowDateTime);
+    if (len == 0) return;                   // nothing to map in an empty file
+    hMap = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (hMap)
+        pData = static_cast<const char*>(MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0));
+    if (!pData)
+        err = EIO;
+#else
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        err = errno;
+        return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        err = errno;
+        return;
+    }
+    len = size_t(st.st_size);
+    mtime = uint64_t(st.st_mtime);
+    if (len == 0) return;                   // nothing to map in an empty file
+    void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+        err = errno;
+        return;
+    }
+    pData = static_cast<const char*>(p);
+#endif
+}
+
+// Unmaps and closes the file
+MappedFileTy::~MappedFileTy ()
+{
+#if IBM
+    if (pData) UnmapViewOfFile(pData);
+    if (hMap) CloseHandle(hMap);
+    if (hFile != INVALID_HANDLE_VALUE) CloseHandle(hFile);
+#else
+    if (pData) munmap(const_cast<char*>(pData), len);
+    if (fd >= 0) close(fd);
+#endif
+}
+
+/// Reads lines from a memory-mapped file without copying them
+class AptLineScannerTy {
+protected:
+    const char* const pBegin;           ///< start of the file
+    const char* p;                      ///< current read position
+    const char* pEnd;                   ///< end of the file or the current section
+public:
+    unsigned long lnNr = 0;             ///< number of the line returned last, for debugging purposes
+    
+public:
+    /// Scan the entire file
+    AptLineScannerTy (const MappedFileTy& f) :
+    pBegin(f.data()), p(f.data()), pEnd(f.data() + f.size()) {}
+    
+    /// Current read position as offset from the beginning of the file
+    size_t GetOffset () const { return size_t(p - pBegin); }
+    
+    /// Restrict scanning to a section of the file, `_lnNr` being the number of the line before `_begin`
+    void SetSection (size_t _begin, size_t _end, unsigned long _lnNr)
+    {
+        p = pBegin + _begin;
+        pEnd = pBegin + _end;
+        lnNr = _lnNr;
+    }
+    
+    /// Returns the next line without line ending, `false` at the end of the file or section
+    bool GetLine (std::string_view& ln)
+    {
+        if (p >= pEnd) return false;
+        const char* const s = p;
+        while (p < pEnd && *p != '\n' && *p != '\r')
+            ++p;
+        ln = std::string_view(s, size_t(p - s));
+        // skip the line ending, which is any of \n, \r\n, or \r
+        if (p < pEnd && *p == '\r')
+            ++p;
+        if (p < pEnd && *p == '\n')
+            ++p;
+        ++lnNr;
+        return true;
+    }
+};
+
+/// Fields of one line, pointing into the memory-mapped file
+typedef std::vector<std::string_view> vecFieldsTy;
+
+/// Is `c` a field separator?
+inline bool AptIsBlank (char c) { return c == ' ' || c == '\t'; }
+
+/// Split a line into its fields, separated by any number of blanks or tabs
+static void AptTokenize (std::string_view ln, vecFieldsTy& fields)
+{
+    fields.clear();
+    size_t i = 0;
+    while (i < ln.size()) {
+        while (i < ln.size() && AptIsBlank(ln[i])) ++i;
+        const size_t b = i;
+        while (i < ln.size() && !AptIsBlank(ln[i])) ++i;
+        if (i > b)
+            fields.push_back(ln.substr(b, i-b));
+    }
+}
+
+/// Convert a field to an integer, `0` if not a number
+static long AptToLong (std::string_view f)
+{
+    long l = 0;
+    std::from_chars(f.data(), f.data() + f.size(), l);
+    return l;
+}
+
+/// Convert a field to an unsigned integer, `0` if not a number
+static unsigned long AptToULong (std::string_view f)
+{
+    unsigned long ul = 0;
+    std::from_chars(f.data(), f.data() + f.size(), ul);
+    return ul;
+}
+
+/// Convert a field to a floating point number, `NAN` if not a number
+static double AptToDouble (std::string_view f)
+{
+    // strtod requires a zero-terminated string
+    char buf[64];
+    if (f.empty() || f.size() >= sizeof(buf))
+        return NAN;
+    memcpy(buf, f.data(), f.size());
+    buf[f.size()] = '\0';
+    char* pNumEnd = nullptr;
+    const double d = std::strtod(buf, &pNumEnd);
+    return pNumEnd == buf ? NAN : d;
+}
+
+/// Location of one airport in an `apt.dat` file
+struct AptIndexEntryTy {
+    std::string id;                     ///< airport id
+    size_t begin = 0;                   ///< offset of the line following the airport header
+    size_t end = 0;                     ///< offset of the next airport header, or end of file
+    unsigned long lnNr = 0;             ///< line number of the airport header
+    double lat = NAN;                   ///< latitude of the first runway end
+    double lon = NAN;                   ///< longitude of the first runway end
+};
+
+/// Index of all land airports with runways in one `apt.dat` file
+struct AptIndexTy {
+    size_t fileSize = 0;                ///< size of the file the index was built for
+    uint64_t mtime = 0;                 ///< modification time of the file the index was built for
+    std::vector<AptIndexEntryTy> vecApt;///< the airports in order of appearance
+};
+
+/// @brief Build the index of airports in a memory-mapped `apt.dat` file
+/// @details Looks at the first few characters of each line only, and tokenizes just
+///          the airport headers (row code 1) and each airport's first runway (row code 100).
+///          Seaports (16) and heliports (17) only end the previous airport,
+///          as do airports without runway, none of them are included.
+/// @return The index, or `nullptr` if reading was stopped
+static std::shared_ptr<const AptIndexTy> BuildAptIndex (const MappedFileTy& file)
+{
+    std::shared_ptr<AptIndexTy> pIdx = std::make_shared<AptIndexTy>();
+    pIdx->fileSize = file.size();
+    pIdx->mtime = file.GetMTime();
+    
+    AptLineScannerTy scan (file);
+    vecFieldsTy fields;
+    std::string_view ln;
+    AptIndexEntryTy entry;              // the airport currently being indexed
+    
+    // Finish the current airport, add it to the index if it has a runway
+    auto FinishApt = [&pIdx,&entry](size_t endOfs)
+    {
+        if (!entry.id.empty() && !std::isnan(entry.lat)) {
+            entry.end = endOfs;
+            pIdx->vecApt.push_back(std::move(entry));
+        }
+        entry = AptIndexEntryTy();
+    };
+    
+    for (size_t lnOfs = 0;
+         !bStopThread && scan.GetLine(ln);
+         lnOfs = scan.GetOffset())
+    {
+        // quick exit for the vast majority of lines
+        if (ln.size() < 3 || ln[0] != '1')
+            continue;
+        
+        // row code 1: land airport header
+        if (ln.size() > 10 && AptIsBlank(ln[1]))
+        {
+            FinishApt(lnOfs);
+            AptTokenize(ln, fields);
+            if (fields.size() >= 5) {           // line contains an airport id
+                entry.id = fields[4];
+                entry.begin = scan.GetOffset();
+                entry.lnNr = scan.lnNr;
+            }
+        }
+        // row codes 16 and 17: seaport and heliport
+        else if ((ln[1] == '6' || ln[1] == '7') && AptIsBlank(ln[2]))
+        {
+            FinishApt(lnOfs);
+        }
+        // row code 100: runway, we need the location of the first valid one
+        else if (!entry.id.empty() && std::isnan(entry.lat) &&
+                 ln.size() > 20 &&
+                 ln[1] == '0' && ln[2] == '0' && AptIsBlank(ln[3]))
+        {
+            AptTokenize(ln, fields);
+            if (fields.size() == 26) {          // runway description has to have 26 fields
+                const double lat = AptToDouble(fields[ 9]);
+                const double lon = AptToDouble(fields[10]);
+                if (-90.0 <= lat && lat <= 90.0 &&
+                    -180.0 <= lon && lon < 180.0)
+                {
+                    entry.lat = lat;
+                    entry.lon = lon;
+                }
+            }
+        }
+    }
+    if (bStopThread)
+        return nullptr;
+    FinishApt(scan.GetOffset());
+    return pIdx;
+}
+
+/// Indexes of `apt.dat` files already scanned, by file path
+static std::map<std::string, std::shared_ptr<const AptIndexTy>> gmapAptIndex;
+
+/// Lock to access the indexes of `apt.dat` files
+static std::mutex mtxAptIndex;
+
+/// @brief Return the index of the given memory-mapped `apt.dat` file
+/// @details The index is built on first use and rebuilt only if the file changed.
+/// @return The index, or `nullptr` if reading was stopped
+static std::shared_ptr<const AptIndexTy> GetAptIndex (const std::string& path, const MappedFileTy& file)
+{
+    {
+        std::lock_guard<std::mutex> lock(mtxAptIndex);
+        auto iter = gmapAptIndex.find(path);
+        if (iter != gmapAptIndex.end() &&
+            iter->second->fileSize == file.size() &&
+            iter->second->mtime == file.GetMTime())
+            return iter->second;
+    }
+    
+    // Build the index outside the lock, other files are indexed in parallel
+    std::shared_ptr<const AptIndexTy> pIdx = BuildAptIndex(file);
+    if (pIdx) {
+        std::lock_guard<std::mutex> lock(mtxAptIndex);
+        gmapAptIndex[path] = pIdx;
+    }
+    return pIdx;
+}
+
 /// @brief Process one "120" section of an `apt.dat` file, which contains a taxi line definitions in the subsequent 111-116 lines
 /// @details Starts reading in the next line, expecting nodes in lines starting with 111-116.
 ///          According to specs, such a section has to end with 113-116. But we don't rely on it,
@@ -2005,29 +2517,29 @@ static const std::array<int,4> APT_PATH_TERM_ROW_CODES { 113, 114, 115, 116 };
 ///          from the orginal heading. Then only the next edge begins. This thins out nodes and egdes.
 ///          The remaining nodes and edges are added to the apt's taxiway network.
 /// @see     More information on reading from `apt.dat` is on [a separate page](@ref apt_dat).
-/// @returns the next line read from the file, which is after the "120" section
-static std::string ReadOneTaxiLine (std::ifstream& fIn, Apt& apt, unsigned long& lnNr)
+/// @returns the next line read from the file, which is after the "120" section, empty at the end of the airport
+static std::string_view ReadOneTaxiLine (AptLineScannerTy& scan, Apt& apt, vecFieldsTy& fields)
 {
     TaxiTmpPath path;               // holds the path (centerline positions) we are reading now
     ptTy prevBezPt;                 // previous bezier point
-    std::string ln;
-    while (fIn)
+    std::string_view ln;
+    for (;;)
     {
         // read a line from the input file
-        safeGetline(fIn, ln);
-        ++lnNr;
+        if (!scan.GetLine(ln))
+            return std::string_view();
 
         // ignore empty lines
         if (ln.empty()) continue;
         
         // tokenize the line
-        std::vector<std::string> fields = str_tokenize(ln, " \t", true);
+        AptTokenize(ln, fields);
         
         // We need at minimum 3 fields (line id, latitude, longitude)
         if (fields.size() < 3) break;
         
         // Not any of "our" line codes (we treat them all equal)? -> stop
-        int lnCod = std::stoi(fields[0]);
+        int lnCod = int(AptToLong(fields[0]));
         if (lnCod < 111 || lnCod > 116)
             break;
         
@@ -2037,11 +2549,11 @@ static std::string ReadOneTaxiLine (std::ifstream& fIn, Apt& apt, unsigned long&
         // In case of line codes 111, 113 the Line Type Code is in field 3
         if (lnCod == 111 || lnCod == 113) {
             if (fields.size() >= 4)
-                lnTypeCode = std::stoi(fields[3]);
+                lnTypeCode = int(AptToLong(fields[3]));
         // In case of line codes 112, 114 the Line Type Code is in field 5
         } else if (lnCod == 112 || lnCod == 114) {
             if (fields.size() >= 6)
-                lnTypeCode = std::stoi(fields[5]);
+                lnTypeCode = int(AptToLong(fields[5]));
         }
         
         // Is this a node starting/continuing a taxi centerline?
@@ -2057,18 +2569,20 @@ static std::string ReadOneTaxiLine (std::ifstream& fIn, Apt& apt, unsigned long&
         if (bIsCenterline || bEndsCenterline)
         {
             // Read location and Bezier control point
-            ptTy pos (std::stod(fields[2]), std::stod(fields[1]));    // lon, lat
+            ptTy pos (AptToDouble(fields[2]), AptToDouble(fields[1]));    // lon, lat
+            if (!pos.isValid())
+                break;
             ptTy bezPt;
             if ((lnCod == 112 || lnCod == 114 || lnCod == 116) &&
                 fields.size() >= 5)
             {
                 // read Bezier control point
-                bezPt.x = std::stod(fields[4]);         // lon
-                bezPt.y = std::stod(fields[3]);         // lat
+                bezPt.x = AptToDouble(fields[4]);       // lon
+                bezPt.y = AptToDouble(fields[3]);       // lat
 #ifdef DEBUG
                 // remember Bezier handle for output to GPS Visualizer
                 TaxiNode& n = apt.vecBezierHandles.emplace_back(pos.y, pos.x);
-                n.prevIdx = lnNr;
+                n.prevIdx = scan.lnNr;
                 n.bVisited = false;
                 apt.vecBezierHandles.emplace_back(bezPt.y, bezPt.x);
                 // if there is a previous pos (to which we will apply the control point, too, just mirrored)
@@ -2076,7 +2590,7 @@ static std::string ReadOneTaxiLine (std::ifstream& fIn, Apt& apt, unsigned long&
                 if (!path.listPos.empty())
                 {
                     TaxiNode& n2 = apt.vecBezierHandles.emplace_back(pos.y, pos.x);
-                    n2.prevIdx = lnNr;
+                    n2.prevIdx = scan.lnNr;
                     n2.bVisited = true;                 // indicates "mirrored"
                     apt.vecBezierHandles.emplace_back(bezPt.mirrorAt(pos).y, bezPt.mirrorAt(pos).x);
                 }
@@ -2157,216 +2671,303 @@ static std::string ReadOneTaxiLine (std::ifstream& fIn, Apt& apt, unsigned long&
 }
 
 /// @brief Read airports in the one given `apt.dat` file
-/// @details    The function process the following line types:\n
-///             1 - Airport header to start a new airport and learn its name/id\n
+/// @details    Only airports listed in the file's index are read,
+///             and of those only the ones with their first runway in one of the `tiles`
+///             and not yet defined elsewhere. All other airports' lines are skipped.
+///             The function process the following line types:\n
 ///             100 - Runway definitions\n
 ///             120 - Line segments (incl. subsequent 111-116 codes), or alternatively, if no 120 code is found:\n
-///             1201, 1202  - Taxi route netwirk
+///             1201, 1202  - Taxi route netwirk\n
+///             1300 - Startup locations
 /// @see        More information on reading from `apt.dat` is on [a separate page](@ref apt_dat).
-static void ReadOneAptFile (std::ifstream& fIn, const boundingBoxTy& box)
+/// @param file The memory-mapped `apt.dat` file
+/// @param idx The file's index of airports
+/// @param tiles Only airports with their first runway in these tiles are read
+/// @param[out] mapApt Receives the airports read from this file
+static void ReadOneAptFile (const MappedFileTy& file, const AptIndexTy& idx,
+                            const setAptTileTy& tiles, mapAptTy& mapApt)
 {
-    // Walk the file
-    std::string ln;
-    unsigned long lnNr = 0;             // for debugging purposes we are interested to track the file's line number
-    bool bProcessGivenLn = false;       // process a line returned by a sub-routine?
-    // Are we reading 120 taxi centerlines or 1200 taxi route network?
-    enum netwTypeTy { NETW_UNKOWN=0, NETW_CENTERLINES, NETW_TAXIROUTES } netwType = NETW_UNKOWN;
-    Apt apt;
-    while (!bStopThread && (bProcessGivenLn || fIn))
+    AptLineScannerTy scan (file);
+    vecFieldsTy fields;
+    std::string_view ln;
+    for (const AptIndexEntryTy& entry: idx.vecApt)
     {
-        // Either process a given line or fetch a new one
-        if (bProcessGivenLn) {
-            // the line is in `ln` already, just reset the flag
-            bProcessGivenLn = false;
-        } else {
-            // read a fresh line from the file
-            ln.clear();
-            safeGetline(fIn, ln);
-            ++lnNr;
-        }
+        if (bStopThread)
+            return;
         
-        // ignore empty lines
-        if (ln.empty()) continue;
+        // Skip airports outside the tiles or already defined without even looking at their lines
+        const AptTileTy tile = AptTileTy::Of(entry.lat, entry.lon);
+        if (tiles.count(tile) == 0 ||
+            mapApt.count(entry.id) > 0 ||           // airport is already defined in this file
+            IsAptKnown(entry.id))                   // or in the global map
+            continue;
         
-        // test for beginning of an airport (row code 1)
-        if (ln.size() > 10 &&
-            ln[0] == '1' &&
-            (ln[1] == ' ' || ln[1] == '\t'))
-        {
-            // found an airport's beginning
-            
-            // If the previous airport is valid add it to the list
-            if (apt.IsValid())
-                Apt::AddApt(std::move(apt));
-            else
-                // clear the airport object nonetheless
-                apt = Apt();
-            
-            // separate the line into its field values
-            std::vector<std::string> fields = str_tokenize(ln, " \t", true);
-            if (fields.size() >= 5 &&           // line contains an airport id, and
-                gmapApt.count(fields[4]) == 0)  // airport is not yet defined in map
+        // Walk the airport's lines
+        scan.SetSection(entry.begin, entry.end, entry.lnNr);
+        Apt apt (entry.id);
+        apt.SetTile(tile);
+        bool bProcessGivenLn = false;       // process a line returned by a sub-routine?
+        // Are we reading 120 taxi centerlines or 1200 taxi route network?
+        enum netwTypeTy { NETW_UNKOWN=0, NETW_CENTERLINES, NETW_TAXIROUTES } netwType = NETW_UNKOWN;
+        try {
+            // Either process a given line or fetch a new one
+            while (bProcessGivenLn || scan.GetLine(ln))
             {
-                // re-init apt object, now with the proper id defined
-                apt = Apt(fields[4]);
-                netwType = NETW_UNKOWN;
-            }
-        }
-        
-        // We skip over Seaports (row code 16) and Heliports (17)
-        else if (ln.size() > 3 &&
-            ln[0] == '1' && (ln[1] == '6' || ln[1] == '7') &&
-            (ln[2] == ' ' || ln[2] == '\t'))
-        {
-            // If the previous airport is valid add it to the list
-            if (apt.IsValid())
-                Apt::AddApt(std::move(apt));
-            else
-                // clear the airport object nonetheless
-                apt = Apt();
-        }
-        
-        // test for a runway...just to find location info
-        else if (apt.HasId() &&             // an airport identified and of interest?
-            ln.size() > 20 &&            // line long enough?
-            ln[0] == '1' &&              // starting with "100 "?
-            ln[1] == '0' &&
-            ln[2] == '0' &&
-            (ln[3] == ' ' || ln[3] == '\t'))
-        {
-            // separate the line into its field values
-            std::vector<std::string> fields = str_tokenize(ln, " \t", true);
-            if (fields.size() == 26) {      // runway description has to have 26 fields
-                const double lat = std::stod(fields[ 9]);
-                const double lon = std::stod(fields[10]);
-                if (-90.0 <= lat && lat <= 90.0 &&
-                    -180.0 <= lon && lon < 180.0)
+                bProcessGivenLn = false;
+                
+                // ignore empty lines
+                if (ln.empty()) continue;
+                
+                // test for a runway
+                if (ln.size() > 20 &&            // line long enough?
+                    ln[0] == '1' &&              // starting with "100 "?
+                    ln[1] == '0' &&
+                    ln[2] == '0' &&
+                    AptIsBlank(ln[3]))
                 {
-                    // Have we accepted the airport already?
-                    // Or - this being the first rwy - does the rwy lie in the search bounding box?
-                    if (apt.HasRwyEndpoints() ||
-                        box.contains(positionTy(lat,lon)))
-                    {
-                        // add both runway ends to the airport
-                        apt.AddRwyEnds(lat, lon,
-                                       std::stod(fields[11]),       // displaced
-                                       fields[ 8],                  // id
-                                       // other rwy end:
-                                       std::stod(fields[18]),       // lat
-                                       std::stod(fields[19]),       // lon
-                                       std::stod(fields[20]),       // displayced
-                                       fields[17]);                 // id
+                    // separate the line into its field values
+                    AptTokenize(ln, fields);
+                    if (fields.size() == 26) {      // runway description has to have 26 fields
+                        const double lat = AptToDouble(fields[ 9]);
+                        const double lon = AptToDouble(fields[10]);
+                        if (-90.0 <= lat && lat <= 90.0 &&
+                            -180.0 <= lon && lon < 180.0)
+                        {
+                            // add both runway ends to the airport
+                            // (the index made sure the first runway lies in one of the tiles)
+                            apt.AddRwyEnds(lat, lon,
+                                           AptToDouble(fields[11]),     // displaced
+                                           std::string(fields[ 8]),     // id
+                                           // other rwy end:
+                                           AptToDouble(fields[18]),     // lat
+                                           AptToDouble(fields[19]),     // lon
+                                           AptToDouble(fields[20]),     // displayced
+                                           std::string(fields[17]));    // id
+                        }   // if lat/lon in acceptable range
+                    }       // if line contains 26 field values
+                }           // if a runway line startin with "100 "
+                
+                // test for the start of a taxi line segment
+                // This is valid for 120 as well as 120x:
+                else if (apt.HasRwyEndpoints() &&
+                         ln.size() >= 3 &&
+                         ln[0] == '1' &&
+                         ln[1] == '2' &&
+                         ln[2] == '0')
+                {
+                    if (ln == "120 RM" || ln == "120 TB") {
+                        // specifically ignore these sections, they draw markings
+                        // for gate positions, taxiway borders etc.
+                        // often using taxi centerline codes,
+                        // but the markings aren't actually taxiways
                     }
-                    // airport is outside bounding box -> mark it uninteresting
-                    else
+                    // Standard Line segment, that could be a centerline?
+                    else if (netwType != NETW_TAXIROUTES &&                         // not yet decided for the other type of network?
+                        (ln.size() == 3 ||                                          // was just the text "120"
+                         (ln.size() >= 4 && AptIsBlank(ln[3]))))                    // or "120 " plus more
                     {
-                        // clear the airport object
-                        apt = Apt();
+                        // Read the entire line segment
+                        ln = ReadOneTaxiLine(scan, apt, fields);
+                        bProcessGivenLn = !ln.empty();  // process the returned line read from the file
+                        if (apt.HasTempNodesEdges())    // did we (latest now) add taxi segments?
+                            netwType = NETW_CENTERLINES;
                     }
-                }   // if lat/lon in acceptable range
-            }       // if line contains 26 field values
-        }           // if a runway line startin with "100 "
-        
-        // test for the start of a taxi line segment
-        // This is valid for 120 as well as 120x:
-        else if (apt.HasRwyEndpoints() &&
-                 ln.size() >= 3 &&
-                 ln[0] == '1' &&
-                 ln[1] == '2' &&
-                 ln[2] == '0')
-        {
-            if (ln == "120 RM" || ln == "120 TB") {
-                // specifically ignore these sections, they draw markings
-                // for gate positions, taxiway borders etc.
-                // often using taxi centerline codes,
-                // but the markings aren't actually taxiways
-            }
-            // Standard Line segment, that could be a centerline?
-            else if (netwType != NETW_TAXIROUTES &&                         // not yet decided for the other type of network?
-                (ln.size() == 3 ||                                          // was just the text "120"
-                 (ln.size() >= 4 && (ln[3] == ' ' || ln[3] == '\t'))))      // or "120 " plus more
-            {
-                // Read the entire line segment
-                ln = ReadOneTaxiLine(fIn, apt, lnNr);
-                bProcessGivenLn = true;         // process the returned line read from the file
-                if (apt.HasTempNodesEdges())    // did we (latest now) add taxi segments?
-                    netwType = NETW_CENTERLINES;
-            }
-            else if (netwType != NETW_CENTERLINES)
-            {
-                // separate the line into its field values
-                std::vector<std::string> fields = str_tokenize(ln, " \t", true);
-                int lnCode = std::stoi(fields[0]);
+                    else if (netwType != NETW_CENTERLINES)
+                    {
+                        // separate the line into its field values
+                        AptTokenize(ln, fields);
+                        const long lnCode = AptToLong(fields[0]);
+                        
+                        // 1201 - Taxi route network node
+                        if (lnCode == 1201 && fields.size() >= 5) {
+                            // Convert and briefly test the given location
+                            const double lat = AptToDouble(fields[1]);
+                            const double lon = AptToDouble(fields[2]);
+                            const size_t idxN = AptToULong(fields[4]);
+                            if (-90.0 <= lat && lat <= 90.0 &&
+                                -180.0 <= lon && lon < 180.0)
+                            {
+                                netwType = NETW_TAXIROUTES;
+                                apt.AddTaxiNodeFixed(lat, lon, idxN);
+                            }   // has valid location
+                        }
+                        else if (lnCode == 1202 && fields.size() >= 3) {
+                            // Convert indexes and try adding the node
+                            const size_t n1 = AptToULong(fields[1]);
+                            const size_t n2 = AptToULong(fields[2]);
+                            bool bRunway = (fields.size() >= 5 &&
+                                            fields[4] == "runway");
+                            apt.AddTaxiEdge(n1, n2,
+                                            bRunway ? TaxiEdge::RUN_WAY : TaxiEdge::TAXI_WAY);
+                        }
+                    }       // not NETW_CENTERLINE
+                }           // "120"
                 
-                // 1201 - Taxi route network node
-                if (lnCode == 1201 && fields.size() >= 5) {
-                    // Convert and briefly test the given location
-                    const double lat = std::stod(fields[1]);
-                    const double lon = std::stod(fields[2]);
-                    const size_t idx = std::stoul(fields[4]);
-                    if (-90.0 <= lat && lat <= 90.0 &&
-                        -180.0 <= lon && lon < 180.0)
+                // Startup locations, row code 1300
+                else if (apt.HasRwyEndpoints() &&
+                         ln.size() > 20 &&            // line long enough?
+                         ln[0] == '1' &&              // starting with "1300 "?
+                         ln[1] == '3' &&
+                         ln[2] == '0' &&
+                         ln[3] == '0' &&
+                         AptIsBlank(ln[4]))
+                {
+                    // separate the line into its field values
+                    AptTokenize(ln, fields);
+                    if (fields.size() >= 4)
                     {
-                        netwType = NETW_TAXIROUTES;
-                        apt.AddTaxiNodeFixed(lat, lon, idx);
-                    }   // has valid location
-                }
-                else if (lnCode == 1202 && fields.size() >= 3) {
-                    // Convert indexes and try adding the node
-                    const size_t n1 = std::stoul(fields[1]);
-                    const size_t n2 = std::stoul(fields[2]);
-                    bool bRunway = (fields.size() >= 5 &&
-                                    fields[4] == "runway");
-                    apt.AddTaxiEdge(n1, n2,
-                                    bRunway ? TaxiEdge::RUN_WAY : TaxiEdge::TAXI_WAY);
+                        const double lat  = AptToDouble(fields[1]);     // latitude
+                        const double lon  = AptToDouble(fields[2]);     // longigtude
+                        const double head = AptToDouble(fields[3]);     // heading
+                        std::string id;                                 // all the rest makes up the id
+                        for (size_t i = 4; i < fields.size(); ++i)
+                            id.append(fields[i]) += ' ';
+                        if (!id.empty()) id.pop_back();                 // remove the last separating space
+                        apt.AddStartupLoc(id, lat, lon, head);
+                    }
                 }
-            }       // not NETW_CENTERLINE
-        }           // "120"
-        
-        // Startup locations, row code 1300
-        else if (apt.HasRwyEndpoints() &&
-                 ln.size() > 20 &&            // line long enough?
-                 ln[0] == '1' &&              // starting with "100 "?
-                 ln[1] == '3' &&
-                 ln[2] == '0' &&
-                 ln[3] == '0' &&
-                 (ln[4] == ' ' || ln[4] == '\t'))
-        {
-            // separate the line into its field values
-            std::vector<std::string> fields = str_tokenize(ln, " \t", true);
-            if (fields.size() >= 4)
-            {
-                const double lat  = std::stod(fields[1]);       // latitude
-                const double lon  = std::stod(fields[2]);       // longigtude
-                const double head = std::stod(fields[3]);       // heading
-                std::string id;                                 // all the rest makes up the id
-                for (size_t i = 4; i < fields.size(); ++i)
-                    id += fields[i] + ' ';
-                if (!id.empty()) id.pop_back();                 // remove the last separating space
-                apt.AddStartupLoc(id, lat, lon, head);
-            }
+                
+            }               // for each line of the airport
+            
+            // If the airport is valid add it to the list
+            if (!bStopThread && apt.IsValid())
+                Apt::AddApt(std::move(apt), mapApt);
+            else
+                Apt::ClearTempStorage();
+        }
+        catch (const std::exception& e) {
+            // Just skip this one airport
+            LOG_MSG(logWARN, "apt.dat: Skipped %s, line %lu: %s",
+                    entry.id.c_str(), scan.lnNr, e.what());
+            Apt::ClearTempStorage();
         }
+    }               // for each airport in the index
+}
 
-    }               // for each line of the apt.dat file
+/// One `apt.dat` file to read, and the airports read from it
+struct AptFileTy {
+    std::string path;                   ///< full path to the `apt.dat` file
+    bool bMustExist = false;            ///< report an error also if the file does not exist (as opposed to optional scenery packs)
+    bool bRead = false;                 ///< file was opened and read
+    mapAptTy mapApt;                    ///< airports read from this file, not yet merged into ::gmapApt
+};
+
+/// Vector of `apt.dat` files in order of precedence
+typedef std::vector<AptFileTy> vecAptFileTy;
+
+/// Read one `apt.dat` file into its own map of airports
+static void ReadAptFile (AptFileTy& aptFile, const setAptTileTy& tiles)
+{
+    const MappedFileTy file (aptFile.path);
+    if (!file.isOpen()) {
+        // problem was not just "not found" (which we ignore for scenery packs)?
+        if (aptFile.bMustExist || file.GetErr() != ENOENT) {
+            char sErr[SERR_LEN];
+            strerror_s(sErr, sizeof(sErr), file.GetErr());
+            LOG_MSG(logERR, ERR_CFG_FILE_READ,
+                    aptFile.path.c_str(), sErr);
+        }
+        return;
+    }
     
-    // If the last airport read is valid don't forget to add it to the list
-    if (!bStopThread && apt.IsValid())
-        Apt::AddApt(std::move(apt));
+    LOG_MSG(logDEBUG, "Reading apt.dat from %s", aptFile.path.c_str());
+    aptFile.bRead = true;
+    std::shared_ptr<const AptIndexTy> pIdx = GetAptIndex(aptFile.path, file);
+    if (pIdx)
+        ReadOneAptFile(file, *pIdx, tiles, aptFile.mapApt);
 }
 
-/// @brief Remove airports that are now considered too far away
-void PurgeApt (const boundingBoxTy& _box)
+/// @brief Read all given `apt.dat` files, several in parallel
+/// @details Up to APT_READ_MAX_THREADS threads, including the calling one,
+///          take the next file not yet read from the list until all are done.
+static void ReadAptFiles (vecAptFileTy& vecFiles, const setAptTileTy& tiles)
 {
-    // Access is guarded by a lock
+    std::atomic<size_t> nextFile {0};
+    auto ReadNext = [&vecFiles,&tiles,&nextFile]()
+    {
+        for (size_t i = nextFile++;
+             !bStopThread && i < vecFiles.size();
+             i = nextFile++)
+            ReadAptFile(vecFiles[i], tiles);
+    };
+    
+    const size_t nThreads = std::min<size_t>({
+        std::max<size_t>(std::thread::hardware_concurrency(), 1),
+        APT_READ_MAX_THREADS,
+        vecFiles.size() });
+    std::vector<std::thread> vecThr;
+    for (size_t t = 1; t < nThreads; ++t)
+        vecThr.emplace_back([&ReadNext]()
+        {
+            // This is a communication thread's main function, set thread's name and C locale
+            ThreadSettings TS ("LT_ReadApt", LC_ALL_MASK);
+            ReadNext();
+        });
+    ReadNext();
+    for (std::thread& thr: vecThr)
+        thr.join();
+}
+
+/// @brief Add the airports read from the files to ::gmapApt
+/// @details The first definition of an airport wins: Airports already in ::gmapApt are kept,
+///          and files are merged in the order of `vecFiles`, ie. in order of scenery pack precedence.
+/// @return Number of files, which were read
+static int MergeAptFiles (vecAptFileTy& vecFiles)
+{
+    int cntFiles = 0;
     std::lock_guard<std::mutex> lock(mtxGMapApt);
+    for (AptFileTy& aptFile: vecFiles) {
+        if (aptFile.bRead)
+            cntFiles++;
+        for (mapAptTy::value_type& p: aptFile.mapApt)
+            gmapApt.try_emplace(p.first, std::move(p.second));
+        aptFile.mapApt.clear();
+    }
+    return cntFiles;
+}
 
-    // loop all airports and remove those, whose center point is outside the box
+/// @brief Evict airports of tiles no longer wanted until all airports' estimated memory use is within APT_MEM_BUDGET
+/// @details Tiles farthest away from `ctr` are evicted first.
+/// @return The evicted tiles
+static std::vector<AptTileTy> EvictAptTiles (const setAptTileTy& tilesWanted, const positionTy& ctr)
+{
+    std::vector<AptTileTy> vecEvicted;
+    
+    // Access is guarded by a lock
+    std::lock_guard<std::mutex> lock(mtxGMapApt);
+    
+    // Estimated memory use per tile
+    std::map<AptTileTy, size_t> mapTileMem;
+    size_t memTotal = 0;
+    for (const mapAptTy::value_type& p: gmapApt) {
+        const size_t sz = p.second.GetMemSize();
+        mapTileMem[p.second.GetTile()] += sz;
+        memTotal += sz;
+    }
+    if (memTotal <= APT_MEM_BUDGET)
+        return vecEvicted;
+    
+    // Tiles not wanted, farthest first, are evicted until we are within budget
+    std::vector<std::pair<double,AptTileTy>> vecCand;
+    for (const std::pair<const AptTileTy, size_t>& p: mapTileMem)
+        if (tilesWanted.count(p.first) == 0)
+            vecCand.emplace_back(p.first.center().dist(ctr), p.first);
+    std::sort(vecCand.begin(), vecCand.end(),
+              [](const std::pair<double,AptTileTy>& a, const std::pair<double,AptTileTy>& b)
+              { return a.first > b.first; });
+    for (const std::pair<double,AptTileTy>& c: vecCand) {
+        if (memTotal <= APT_MEM_BUDGET)
+            break;
+        memTotal -= mapTileMem[c.second];
+        vecEvicted.push_back(c.second);
+    }
+    
+    // Remove the airports of evicted tiles
     mapAptTy::iterator iter = gmapApt.begin();
     while (iter != gmapApt.end())
     {
-        // Is airport still in box?
-        Apt& apt = iter->second;
-        if (apt.GetBounds().overlap(_box)) {
+        const Apt& apt = iter->second;
+        if (std::find(vecEvicted.cbegin(), vecEvicted.cend(), apt.GetTile()) == vecEvicted.cend()) {
             // keep it, move on to next airport
             ++iter;
         } else {
@@ -2378,34 +2979,34 @@ void PurgeApt (const boundingBoxTy& _box)
         }
     }
     
-    LOG_MSG(logDEBUG, "Done purging, %d airports left", (int)gmapApt.size());
+    LOG_MSG(logDEBUG, "Done evicting %lu tiles, %d airports left using about %.1f MB",
+            (unsigned long)vecEvicted.size(), (int)gmapApt.size(),
+            double(memTotal) / (1024.0 * 1024.0));
+    return vecEvicted;
 }
 
-/// @brief Read airports from apt.dat files around a given center position
+/// @brief Read airports in the given tiles from apt.dat files
 /// @details This function first walks along the `scenery_packs.ini` file
-///          and reads all `apt.dat` files available in the scenery packs listed there in the given order.
-///          Lastly, it also reads the generic `apt.dat` file given in `APTDAT_RESOURCES_DEFAULT`.
+///          and collects all `apt.dat` files available in the scenery packs listed there in the given order.
+///          Lastly, it also adds the generic `apt.dat` file given in `APTDAT_RESOURCES_DEFAULT`.
+///          The files are then read in parallel, and the airports merged in that order,
+///          so that an airport's definition in a higher-priority scenery pack wins.
+///          Finally, airports in tiles no longer wanted are evicted if beyond the memory budget.
 /// @see Understanding scener order: https://www.x-plane.com/kb/changing-custom-scenery-load-order-in-x-plane-10/
-/// @param ctr Center position
-/// @param radius Search radius around center position in meter
-void AsyncReadApt (positionTy ctr, double radius)
+/// @param tilesRead Tiles to read airports for
+/// @param tilesWanted Tiles, whose airports must not be evicted
+/// @param ctr Current position, tiles farthest away are evicted first
+/// @return Tiles evicted
+std::vector<AptTileTy> AsyncReadApt (setAptTileTy tilesRead, setAptTileTy tilesWanted, positionTy ctr)
 {
     // This is a communication thread's main function, set thread's name and C locale
     ThreadSettings TS ("LT_ReadApt", LC_ALL_MASK);
+    const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
 
     static size_t lenSceneryLnBegin = strlen(APTDAT_SCENERY_LN_BEGIN);
     
-    // To avoid costly distance calculations we define a bounding box
-    // just by calculating lat/lon values north/east/south/west of given pos
-    // and include all airports with coordinates falling into it
-    const boundingBoxTy box (ctr, radius);
-    
-    // --- Cleanup first: Remove too far away airports ---
-    PurgeApt(box);
-    
-    // --- Add new airports ---
-    // Count the number of files we have accessed
-    int cntFiles = 0;
+    // --- Collect all apt.dat files in order of precedence ---
+    vecAptFileTy vecFiles;
     bool bLooksLikeXP12 = false;            // XP12 Alpha introduced the *GLOBAL AIRPORTS* entry
 
     // Try opening scenery_packs.ini
@@ -2432,59 +3033,37 @@ void AsyncReadApt (positionTy ctr, double radius)
         }
 
         // the remainder is a path into X-Plane's main folder
-        lnScenery = LTCalcFullPath(lnScenery);      // make it a full path
-        lnScenery += APTDAT_SCENERY_ADD_LOC;        // add the location to the actual `apt.dat` file
-        
-        // open that apt.dat
-        std::ifstream fIn (lnScenery);
-        if (fIn.good() && fIn.is_open()) {
-            LOG_MSG(logDEBUG, "Reading apt.dat from %s", lnScenery.c_str());
-            ReadOneAptFile(fIn, box);
-            cntFiles++;
-        }
-        
-        // problem was not just "not found" (which we ignore for scenery packs) or eof?
-        if (!fIn && errno != ENOENT && !fIn.eof()) {
-            char sErr[SERR_LEN];
-            strerror_s(sErr, sizeof(sErr), errno);
-            LOG_MSG(logERR, ERR_CFG_FILE_READ,
-                    lnScenery.c_str(), sErr);
-        }
-        
-        fIn.close();
-
+        AptFileTy& aptFile = vecFiles.emplace_back();
+        aptFile.path = LTCalcFullPath(lnScenery);   // make it a full path
+        aptFile.path += APTDAT_SCENERY_ADD_LOC;     // add the location to the actual `apt.dat` file
     } // processing scenery_packs.ini
     
     // Last but not least we also process the global generic apt.dat file
-    if (!bStopThread)
     {
-        const std::string sFileName = LTCalcFullPath(bLooksLikeXP12 ? APTDAT_GLOBAL_AIRPORTS APTDAT_SCENERY_ADD_LOC : APTDAT_RESOURCES_DEFAULT APTDAT_SCENERY_ADD_LOC);
-        std::ifstream fIn (sFileName);
-        if (fIn.good() && fIn.is_open()) {
-            LOG_MSG(logDEBUG, "Reading global apt.dat from %s", sFileName.c_str());
-            ReadOneAptFile(fIn, box);
-            cntFiles++;
-        }
-
-        // problem was not just eof?
-        if (!fIn && !fIn.eof()) {
-            char sErr[SERR_LEN];
-            strerror_s(sErr, sizeof(sErr), errno);
-            LOG_MSG(logERR, ERR_CFG_FILE_READ,
-                    sFileName.c_str(), sErr);
-        }
-        
-        fIn.close();
+        AptFileTy& aptFile = vecFiles.emplace_back();
+        aptFile.path = LTCalcFullPath(bLooksLikeXP12 ? APTDAT_GLOBAL_AIRPORTS APTDAT_SCENERY_ADD_LOC : APTDAT_RESOURCES_DEFAULT APTDAT_SCENERY_ADD_LOC);
+        aptFile.bMustExist = true;
     }
     
+    // --- Read all files, then add new airports ---
+    ReadAptFiles(vecFiles, tilesRead);
+    if (bStopThread)
+        return std::vector<AptTileTy>();
+    const int cntFiles = MergeAptFiles(vecFiles);
+    
     // Not successful in opening ANY apt.dat file?
     if (!cntFiles) {
         SHOW_MSG(logWARN, WARN_APTDAT_FAILED);
-        return;
+        return std::vector<AptTileTy>();
     }
     
-    LOG_MSG(logINFO, "Done reading from %d apt.dat files, have now %d airports",
-            cntFiles, (int)gmapApt.size());
+    LOG_MSG(logINFO, "Done reading %lu tiles from %d apt.dat files in %.1fs, have now %d airports",
+            (unsigned long)tilesRead.size(), cntFiles,
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count(),
+            (int)gmapApt.size());
+    
+    // --- Cleanup: Remove airports no longer needed if using too much memory ---
+    return EvictAptTiles(tilesWanted, ctr);
 }
 
 //
@@ -2505,14 +3084,23 @@ Apt* LTAptFind (const positionTy& pos)
 // This code runs in X-Plane's thread, called from XP callbacks
 //
 
-/// Is currently an async operation running to refresh the airports from apt.dat?
-static std::future<void> futRefreshing;
+/// Is currently an async operation running to refresh the airports from apt.dat? Returns the evicted tiles.
+static std::future<std::vector<AptTileTy>> futRefreshing;
         
-/// Last position for which airports have been read
+/// Camera position, for which the tiles to read have last been determined
 static positionTy lastCameraPos;
 
-/// New airports added, so that a call to LTAptUpdateRwyAltitude(9 is necessary?
-static bool bAptsAdded = false;
+/// Shall the tiles to read be determined again, even if the camera didn't move far?
+static bool bReEvaluate = true;
+
+/// Tiles, which have been read (or are being read) and not evicted since
+static setAptTileTy setTilesLoaded;
+
+/// Tiles, which the currently running `futRefreshing` reads, to be retried if reading fails
+static setAptTileTy setTilesReading;
+
+/// Tiles, for which runway altitudes have been updated
+static setAptTileTy setTilesAltDone;
         
 // Start reading apt.dat file(s)
 bool LTAptEnable ()
@@ -2521,20 +3109,58 @@ bool LTAptEnable ()
     return true;
 }
 
-/// Update altitudes of runways
-void LTAptUpdateRwyAltitudes ()
+/// Update altitudes of runways of airports in the given tiles
+void LTAptUpdateRwyAltitudes (const setAptTileTy& tiles)
 {
     // access is guarded by a lock
     std::lock_guard<std::mutex> lock(mtxGMapApt);
 
     // loop all airports and their runways
     for (mapAptTy::value_type& p: gmapApt)
-        p.second.UpdateAltitudes();
+        if (tiles.count(p.second.GetTile()) > 0)
+            p.second.UpdateAltitudes();
+    
+    LOG_MSG(logDEBUG, "apt.dat: Finished updating ground altitudes in %lu tiles",
+            (unsigned long)tiles.size());
+}
+
+/// @brief Tiles along the user's track ahead, in order of arrival
+/// @details Extrapolates the user's plane position along its track
+///          for APT_PREFETCH_LOOKAHEAD_S seconds, if the user's plane is moving fast enough
+///          and the camera is actually following it.
+/// @param camera Current camera position
+/// @param radius Standard search distance, which we also use as step size along the track
+/// @param tilesCamera Tiles around the camera, not included in the result
+/// @param[out] vecAhead Receives the tiles ahead
+static void AptTilesAhead (const positionTy& camera, double radius,
+                           const setAptTileTy& tilesCamera,
+                           std::vector<AptTileTy>& vecAhead)
+{
+    double speed = NAN, track = NAN;
+    const positionTy plane = dataRefs.GetUsersPlanePos(speed, track);
+    if (!plane.isNormal(true) ||
+        std::isnan(speed) || speed < APT_PREFETCH_MIN_SPEED ||
+        std::isnan(track) ||
+        plane.dist(camera) > APT_PREFETCH_MAX_CAM_DIST)
+        return;
     
-    LOG_MSG(logDEBUG, "apt.dat: Finished updating ground altitudes");
+    // Walk along the track, collecting the tiles of a box as large as the one around the camera
+    const double lookAhead = speed * APT_PREFETCH_LOOKAHEAD_S;
+    setAptTileTy tiles;
+    for (double d = radius; d <= lookAhead; d += radius) {
+        tiles.clear();
+        AptTilesOf(boundingBoxTy(plane.destPos(vectorTy(track, d)), 2 * radius), tiles);
+        for (const AptTileTy& t: tiles)
+            if (tilesCamera.count(t) == 0 &&
+                std::find(vecAhead.cbegin(), vecAhead.cend(), t) == vecAhead.cend())
+                vecAhead.push_back(t);
+    }
 }
 
-// Update the airport data with airports around current camera position
+// Update the airport data with airports around current camera position and ahead of the user's plane
+/// @details Airports are read in tiles. All tiles around the camera are read right away,
+///          tiles ahead of the user's plane only a few at a time,
+///          so that the reading load is spread out over the flight.
 void LTAptRefresh ()
 {
     // If not doing snapping, then not doing reading...
@@ -2543,42 +3169,93 @@ void LTAptRefresh ()
     
     // Safety check: Thread already running?
     // Future object is valid, i.e. initialized with an async operation?
-    if (futRefreshing.valid() &&
+    if (futRefreshing.valid()) {
         // but status is not yet ready?
-        futRefreshing.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        if (futRefreshing.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
             // then stop here
             return;
-        
-    // Distance since last read not far enough?
-    // Must have travelled at least as far as standard search radius for planes:
+        // Reading finished: forget about the evicted tiles
+        bool bFailed = false;
+        try {
+            for (const AptTileTy& t: futRefreshing.get()) {
+                setTilesLoaded.erase(t);
+                setTilesAltDone.erase(t);
+            }
+            // There might be more to read, or rwy altitudes to update
+            bReEvaluate = true;
+        } catch (const std::exception& e) {
+            LOG_MSG(logERR, ERR_TOP_LEVEL_EXCEPTION, e.what());
+            bFailed = true;
+        } catch (...) {
+            LOG_MSG(logERR, ERR_TOP_LEVEL_EXCEPTION, "(unknown type)");
+            bFailed = true;
+        }
+        // Reading failed: the tiles aren't loaded, retry them once the camera moved
+        if (bFailed)
+            for (const AptTileTy& t: setTilesReading)
+                setTilesLoaded.erase(t);
+        setTilesReading.clear();
+    }
+    
+    // Camera didn't move far since we last checked?
     const positionTy camera = DataRefs::GetViewPos();
     if (!camera.isNormal(true))                     // have no good camery position (yet)
         return;
-
-    double radius = dataRefs.GetFdStdDistance_m();
-    if (lastCameraPos.dist(camera) < radius)        // is false if lastCameraPos is NAN
-    {
-        // Didn't move far, so no new scan for new airports needed.
-        // But do we need to check for rwy altitudes after last scan of apt.dat file?
-        if (bAptsAdded) {
-            LTAptUpdateRwyAltitudes();
-        }
-        bAptsAdded = false;
+    const double radius = dataRefs.GetFdStdDistance_m();
+    if (!bReEvaluate &&
+        lastCameraPos.dist(camera) < radius / 4.0)  // is false if lastCameraPos is NAN
         return;
+    lastCameraPos = camera;
+    bReEvaluate = false;
+    
+    // Tiles around the camera, which we need now
+    setAptTileTy tilesCamera;
+    AptTilesOf(boundingBoxTy(camera, 2 * radius), tilesCamera);
+    
+    // Runway altitudes can only be probed where X-Plane has scenery loaded, ie. around the camera
+    setAptTileTy tilesAlt;
+    for (const AptTileTy& t: tilesCamera)
+        if (setTilesLoaded.count(t) > 0 && setTilesAltDone.count(t) == 0)
+            tilesAlt.insert(t);
+    if (!tilesAlt.empty()) {
+        LTAptUpdateRwyAltitudes(tilesAlt);
+        setTilesAltDone.insert(tilesAlt.cbegin(), tilesAlt.cend());
     }
-    else
-        lastCameraPos = camera;
+    
+    // Tiles ahead of the user's plane
+    std::vector<AptTileTy> vecAhead;
+    AptTilesAhead(camera, radius, tilesCamera, vecAhead);
+    
+    // Tiles to read now: All missing ones around the camera, and the next few ahead
+    setAptTileTy tilesRead;
+    for (const AptTileTy& t: tilesCamera)
+        if (setTilesLoaded.count(t) == 0)
+            tilesRead.insert(t);
+    size_t nAhead = 0;
+    for (const AptTileTy& t: vecAhead) {
+        if (nAhead >= APT_PREFETCH_TILES_PER_READ)
+            break;
+        if (setTilesLoaded.count(t) == 0) {
+            tilesRead.insert(t);
+            ++nAhead;
+        }
+    }
+    if (tilesRead.empty())
+        return;
+    
+    // Airports in these tiles will not be evicted
+    setAptTileTy tilesWanted (tilesCamera);
+    tilesWanted.insert(vecAhead.cbegin(), vecAhead.cend());
 
-    // Start the thread to read apt.dat, using current camera position as center point
-    // and _double_ plane search radius as search radius
-    radius *= 2;
-    LOG_MSG(logINFO, "Starting thread to read apt.dat for airports %.1fnm around %s",
-            radius / M_per_NM, std::string(lastCameraPos).c_str());
+    // Start the thread to read apt.dat
+    LOG_MSG(logINFO, "Starting thread to read apt.dat for %lu tiles (%lu ahead of the user's plane) around %s",
+            (unsigned long)tilesRead.size(), (unsigned long)nAhead,
+            std::string(camera).c_str());
+    setTilesLoaded.insert(tilesRead.cbegin(), tilesRead.cend());
+    setTilesReading = tilesRead;
     bStopThread = false;
     futRefreshing = std::async(std::launch::async,
-                               AsyncReadApt, lastCameraPos, radius);
-    // need to check for rwy altitudes soon!
-    bAptsAdded = true;
+                               AsyncReadApt, std::move(tilesRead), std::move(tilesWanted), camera);
 }
 
 // Return the best possible runway to auto-land at
@@ -2758,8 +3435,15 @@ void LTAptDisable ()
     bStopThread = true;
     
     // wait for refresh function
-    if (futRefreshing.valid())
-        futRefreshing.wait();
+    if (futRefreshing.valid()) {
+        try {
+            futRefreshing.get();
+        } catch (const std::exception& e) {
+            LOG_MSG(logERR, ERR_TOP_LEVEL_EXCEPTION, e.what());
+        } catch (...) {
+            LOG_MSG(logERR, ERR_TOP_LEVEL_EXCEPTION, "(unknown type)");
+        }
+    }
     
     // destroy the Y Probe
     Apt::DestroyYProbe();
@@ -2767,9 +3451,40 @@ void LTAptDisable ()
     // remove all airport data
     gmapApt.clear();
     lastCameraPos = positionTy();
-    bAptsAdded = false;
+    bReEvaluate = true;
+    setTilesLoaded.clear();
+    setTilesReading.clear();
+    setTilesAltDone.clear();
+}
+
+
+// Synchronously read airports from one given `apt.dat` file
+int LTAptReadFile (const std::string& _path, const boundingBoxTy& _box)
+{
+    vecAptFileTy vecFiles (1);
+    vecFiles.front().path = _path;
+    vecFiles.front().bMustExist = true;
+    setAptTileTy tiles;
+    AptTilesOf(_box, tiles);
+    bStopThread = false;
+    ReadAptFile(vecFiles.front(), tiles);
+    if (!MergeAptFiles(vecFiles))
+        return -1;
+
+    std::lock_guard<std::mutex> lock(mtxGMapApt);
+    return (int)gmapApt.size();
 }
 
+// List all currently known airports with the size of their taxi network
+std::vector<LTAptInfoTy> LTAptList ()
+{
+    std::vector<LTAptInfoTy> vec;
+    std::lock_guard<std::mutex> lock(mtxGMapApt);
+    vec.reserve(gmapApt.size());
+    for (const mapAptTy::value_type& p: gmapApt)
+        vec.push_back({p.first, p.second.GetTaxiNodesVec().size(), p.second.GetTaxiEdgeVec().size()});
+    return vec;
+}
 
 // Dumps the entire taxi network into a CSV file readable by GPS Visualizer
 /// @see For a suggestion of settings for display:
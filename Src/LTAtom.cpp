@@ -0,0 +1,85 @@
+/// @file       LTAtom.cpp
+/// @brief      Interned strings for repeated static aircraft data
+/// @details    Implements the global table of interned texts.
+/// @see        LTAtom.h
+/// @author     Birger Hoppe
+/// @copyright  (c) 2024 Birger Hoppe
+/// @copyright  Permission is hereby granted, free of charge, to any person obtaining a
+///             copy of this software and associated documentation files (the "Software"),
+///             to deal in the Software without restriction, including without limitation
+///             the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the
+///             Software is furnished to do so, subject to the following conditions:\n
+///             The above copyright notice and this permission notice shall be included in
+///             all copies or substantial portions of the Software.\n
+///             THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///             IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///             FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///             AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///             LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///             OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+///             THE SOFTWARE.
+
+#include "LiveTraffic.h"
+
+#include <string_view>
+
+//
+// MARK: Table
+//
+
+const std::string LTAtom::emptyStr;
+
+/// @brief The table of interned texts
+/// @details Keys are views into the entry's own text, entries are heap objects
+///          so that they never move.
+struct LTAtom::TableTy {
+    std::mutex mtx;                         ///< guards `map`
+    std::unordered_map<std::string_view, std::unique_ptr<EntryTy>> map;
+};
+
+// The one table, a function-local static so that atoms can already be created during static initialization
+LTAtom::TableTy& LTAtom::GetTable ()
+{
+    static TableTy tbl;
+    return tbl;
+}
+
+// Intern text
+LTAtom::LTAtom (const std::string& s)
+{
+    if (s.empty()) return;                  // empty string is `nullptr`
+
+    TableTy& tbl = GetTable();
+    std::lock_guard<std::mutex> lock (tbl.mtx);
+    auto iter = tbl.map.find(std::string_view(s));
+    if (iter == tbl.map.end()) {
+        std::unique_ptr<EntryTy> pNew = std::make_unique<EntryTy>(s);
+        const std::string_view key (pNew->s);
+        iter = tbl.map.emplace(key, std::move(pNew)).first;
+    }
+    p = iter->second.get();
+}
+
+// The upper-case variant of this atom
+LTAtom LTAtom::upper () const
+{
+    LTAtom ret;
+    if (!p) return ret;
+    ret.p = p->pUpper.load(std::memory_order_acquire);
+    if (!ret.p) {
+        // First request: intern the upper-case text and remember it.
+        // Concurrent requests may do the same, but get the same atom anyway.
+        ret = LTAtom(str_toupper_c(p->s));
+        p->pUpper.store(ret.p, std::memory_order_release);
+    }
+    return ret;
+}
+
+// Number of interned texts
+size_t LTAtom::TableSize ()
+{
+    TableTy& tbl = GetTable();
+    std::lock_guard<std::mutex> lock (tbl.mtx);
+    return tbl.map.size();
+}
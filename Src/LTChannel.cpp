@@ -24,6 +24,7 @@
 #include "LiveTraffic.h"
 
 #include <fstream>
+#include <filesystem>
 
 // access to chrono literals like s for seconds
 using namespace std::chrono_literals;
@@ -38,8 +39,6 @@ double initTimeBufFilled = 0;       // in 'simTime'
 
 // Thread synch support (specifically for stopping them)
 std::thread CalcPosThread;              // the thread for pos calc (TriggerCalcNewPos)
-std::mutex  FDThreadSynchMutex;         // supports wake-up and stop synchronization
-std::condition_variable FDThreadSynchCV;
 volatile bool bFDMainStop = true;       // will be reset once the main thread starts
 
 // the global vector of all flight and master data connections
@@ -138,6 +137,56 @@ JSON_Value* jag_FindFirstNonNull(const JSON_Array* pArr, std::initializer_list<s
     return nullptr;
 }
 
+//
+//MARK: LTWakeup
+//
+
+/// Protects the list of all wakeups, function-local static as wakeups can be static objects, too
+static std::mutex& WakeupMtxAll ()
+{
+    static std::mutex mtxAll;
+    return mtxAll;
+}
+
+/// All existing wakeups, for WakeAll()
+static std::set<LTWakeup*>& WakeupSetAll ()
+{
+    static std::set<LTWakeup*> setAll;
+    return setAll;
+}
+
+// Constructor registers for WakeAll()
+LTWakeup::LTWakeup ()
+{
+    std::lock_guard<std::mutex> lock (WakeupMtxAll());
+    WakeupSetAll().insert(this);
+}
+
+// Destructor unregisters
+LTWakeup::~LTWakeup ()
+{
+    std::lock_guard<std::mutex> lock (WakeupMtxAll());
+    WakeupSetAll().erase(this);
+}
+
+// Wake up the owning thread now
+void LTWakeup::Wake ()
+{
+    {
+        std::lock_guard<std::mutex> lock (mtx);
+        bSignaled = true;
+    }
+    cv.notify_one();
+}
+
+// Wake up all threads, e.g. to have them check for stopping
+void LTWakeup::WakeAll ()
+{
+    std::lock_guard<std::mutex> lock (WakeupMtxAll());
+    for (LTWakeup* p: WakeupSetAll())
+        p->Wake();
+}
+
 //
 //MARK: LTChannel
 //
@@ -165,6 +214,7 @@ void LTChannel::Stop (bool bWaitJoin)
     if (isRunning()) {
         if (eThrStatus < THR_STOP)
             eThrStatus = THR_STOP;          // indicate to the thread that it has to end itself
+        wakeup.Wake();                      // wake it up so it can see that
         if (bWaitJoin) {
             thr.join();                     // wait for the thread to actually end
             thr = std::thread();
@@ -245,6 +295,10 @@ void LTChannel::SetEnable (bool bEnable)
     
     // then we actually enable
     dataRefs.SetChannelEnabled(channel,bEnable);
+    
+    // a running thread shall know quickly
+    if (!bEnable)
+        wakeup.Wake();
 }
 
 std::string LTChannel::GetStatusText () const
@@ -274,17 +328,18 @@ std::string LTChannel::GetStatusText () const
 // how many a/c do we feed when counted last?
 int LTFlightDataChannel::GetNumAcServed () const
 {
-    // only try to re-count every second, and needs the mapFd lock
+    // only try to re-count every second, and only if no segment of mapFd is busy
     if (timeLastAcCnt + 1.0f < dataRefs.GetMiscNetwTime()) {
-        std::unique_lock<std::mutex> lockFd(mapFdMutex, std::try_to_lock);
-        if (lockFd) {
+        int numAc = 0;                      // start counting flight data served by _this_ channel
+        if (mapFd.TryForEach([this,&numAc](const LTFlightData& fd)
+        {
+            const LTChannel* pCh = nullptr;
+            if (fd.GetCurrChannel(pCh) && pCh == this)
+                ++numAc;
+        }))
+        {
             timeLastAcCnt = dataRefs.GetMiscNetwTime();
-            numAcServed = 0;                // start counting flight data served by _this_ channel
-            for (const mapLTFlightDataTy::value_type& p: mapFd) {
-                const LTChannel* pCh = nullptr;
-                if (p.second.GetCurrChannel(pCh) && pCh == this)
-                    ++numAcServed;
-            }
+            numAcServed = numAc;
         }
     }
 
@@ -292,6 +347,428 @@ int LTFlightDataChannel::GetNumAcServed () const
     return numAcServed;
 }
 
+// Fetches data, remembers validators of the requested area for the next conditional request
+bool LTFlightDataChannel::FetchAllData (const positionTy& pos)
+{
+    nAreaPlanned = -1;                      // GetURL() will tell if it planned the area
+    const bool bRet = LTOnlineChannel::FetchAllData(pos);
+    
+    // Remember validators for next time the same area is requested
+    if (bRet && nAreaPlanned >= 0 && httpResponse == HTTP_OK) {
+        areaLast[nAreaPlanned].eTag         = respETag;
+        areaLast[nAreaPlanned].lastModified = respLastModified;
+    }
+    return bRet;
+}
+
+// Is this the same area as `o`? (Only then validators can be reused)
+bool LTFlightDataChannel::RequAreaTy::sameArea (const RequAreaTy& o) const
+{
+    return dequal(extent_m, o.extent_m) &&
+           dequal(center.lat(), o.center.lat()) &&
+           dequal(center.lon(), o.center.lon());
+}
+
+// Plans which area to request around the camera
+const LTFlightDataChannel::RequAreaTy& LTFlightDataChannel::PlanRequestArea (const positionTy& pos,
+                                                                             double fullExtent_m)
+{
+    const int nFullEvery = dataRefs.GetFdFullAreaEvery();
+    
+    // Is it time for the full area? It is if
+    // - not planning at all (always request full area), or
+    // - full area was never requested or is due, or
+    // - camera moved so far that the near area leaves the last full area
+    bool bFull = nFullEvery <= 1 ||
+                 !posLastFull.isNormal() ||
+                 areaLast[1].extent_m < fullExtent_m ||
+                 ++nRequSinceFull >= unsigned(nFullEvery) ||
+                 pos.dist(posLastFull) > fullExtent_m * (1.0 - FD_NEAR_AREA_F) / 2.0;
+    
+    // Planner not active: Request exactly as asked, no grid, no validators
+    if (nFullEvery <= 1) {
+        requETag.clear();
+        requLastModified.clear();
+        nAreaPlanned = 1;
+        areaLast[1].center = pos;
+        areaLast[1].extent_m = fullExtent_m;
+        areaLast[1].eTag.clear();
+        areaLast[1].lastModified.clear();
+        posLastFull = pos;
+        return areaLast[1];
+    }
+    
+    // Snap the center to a grid so that the URL stays the same for small
+    // camera movements, and enlarge the area by one grid cell to still cover
+    // everything around the actual camera position
+    const double grid_m = fullExtent_m * FD_AREA_GRID_F;
+    RequAreaTy area;
+    const double gridLat = Dist2Lat(grid_m);
+    area.center.lat() = std::round(pos.lat() / gridLat) * gridLat;
+    const double gridLon = Dist2Lon(grid_m, area.center.lat());
+    area.center.lon() = std::round(pos.lon() / gridLon) * gridLon;
+    area.extent_m = (bFull ? fullExtent_m : fullExtent_m * FD_NEAR_AREA_F) + grid_m;
+    area.bFull = bFull;
+    if (bFull) {
+        nRequSinceFull = 0;
+        posLastFull = pos;
+    }
+    
+    // Same area as last time? Then we can send a conditional request
+    nAreaPlanned = bFull ? 1 : 0;
+    RequAreaTy& last = areaLast[nAreaPlanned];
+    if (!last.sameArea(area))
+        last = std::move(area);
+    requETag = last.eTag;
+    requLastModified = last.lastModified;
+    return last;
+}
+
+//
+//MARK: Master data request queue
+//
+
+// Set priority based on current distance to camera and if the aircraft is rendered already
+void acStatUpdateTy::SetPrio (double distance, bool bRendered)
+{
+    dist = std::isnan(distance) ? UINT_MAX : (unsigned long)(distance);
+    if (bRendered)
+        tier = 1;
+    else if (dist <= (unsigned long)dataRefs.GetFdStdDistance_m())
+        tier = 0;                               // about to be rendered: most urgent
+    else
+        tier = 2;
+}
+
+// Add a new request, or update an existing one for the same a/c and type
+bool MasterDataQueueTy::push (const acStatUpdateTy& r)
+{
+    auto iter = idx.find(IdxKey(r));
+    if (iter == idx.end()) {
+        heap.emplace_back();
+        place(heap.size()-1, acStatUpdateTy(r));
+        siftUp(heap.size()-1);
+        return true;
+    }
+    
+    // Exists already: take over call sign, and decrease-key if the new priority is better
+    const size_t i = iter->second;
+    acStatUpdateTy& e = heap[i];
+    e.callSign = r.callSign;
+    if (r < e) {
+        e.dist = r.dist;
+        e.tier = r.tier;
+        siftUp(i);
+    }
+    return false;
+}
+
+// remove element at position `i`
+void MasterDataQueueTy::erase (size_t i)
+{
+    idx.erase(IdxKey(heap[i]));
+    const size_t last = heap.size()-1;
+    if (i != last) {
+        place(i, std::move(heap[last]));
+        heap.pop_back();
+        siftDown(i);
+        siftUp(i);
+    } else
+        heap.pop_back();
+}
+
+// move element at `i` up as far as needed
+void MasterDataQueueTy::siftUp (size_t i)
+{
+    while (i > 0) {
+        const size_t parent = (i-1) / 2;
+        if (!(heap[i] < heap[parent])) break;
+        acStatUpdateTy tmp (std::move(heap[i]));
+        place(i, std::move(heap[parent]));
+        place(parent, std::move(tmp));
+        i = parent;
+    }
+}
+
+// move element at `i` down as far as needed
+void MasterDataQueueTy::siftDown (size_t i)
+{
+    for (;;) {
+        const size_t l = 2*i+1, r = l+1;
+        size_t best = i;
+        if (l < heap.size() && heap[l] < heap[best]) best = l;
+        if (r < heap.size() && heap[r] < heap[best]) best = r;
+        if (best == i) break;
+        acStatUpdateTy tmp (std::move(heap[i]));
+        place(i, std::move(heap[best]));
+        place(best, std::move(tmp));
+        i = best;
+    }
+}
+
+// put `r` at `heap[i]` and update the index
+void MasterDataQueueTy::place (size_t i, acStatUpdateTy&& r)
+{
+    heap[i] = std::move(r);
+    idx[IdxKey(heap[i])] = i;
+}
+
+//
+//MARK: Master data cache
+//
+
+// The one global master data cache
+MasterDataCacheTy mdCache;
+
+// start reading the cache file in a worker thread, which then opens it for appending
+void MasterDataCacheTy::Open (const std::string& _path)
+{
+    Close();
+    
+    // The cache directory might not exist yet
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(_path).parent_path(), ec);
+    
+    std::lock_guard<std::mutex> lock (mtx);
+    bLoading = true;
+    futLoad = std::async(std::launch::async, &MasterDataCacheTy::Load, this, _path);
+}
+
+// wait for any reading to finish, close the cache file, clear memory
+void MasterDataCacheTy::Close ()
+{
+    if (futLoad.valid())
+        futLoad.get();
+    std::lock_guard<std::mutex> lock (mtx);
+    if (fOut.is_open()) fOut.close();
+    mapEntries.clear();
+}
+
+// wait till the worker thread has read the file
+void MasterDataCacheTy::WaitLoaded ()
+{
+    std::unique_lock<std::mutex> lock (mtx);
+    cvLoaded.wait(lock, [this]{ return !bLoading; });
+}
+
+// Worker thread: read the cache file, compact it if needed, and open it for appending
+void MasterDataCacheTy::Load (const std::string& _path)
+{
+    ThreadSettings TS ("LT_MDCache", LC_ALL_MASK);
+    // LiveTraffic Top Level Exception Handling
+    try {
+        // Read all existing records, later lines override earlier ones
+        std::unordered_map<std::string, EntryTy> mapRead;
+        const time_t now = time(nullptr);
+        size_t nLines = 0;
+        std::ifstream fIn (_path);
+        std::string ln;
+        while (fIn.good()) {
+            safeGetline(fIn, ln);
+            std::vector<std::string> v = str_tokenize(ln, "\t", false);
+            if (v.size() < 2 || v[0].size() < 2)
+                continue;
+            ++nLines;
+            EntryTy e;
+            e.tExpire = (time_t)std::strtoll(v[1].c_str(), nullptr, 10);
+            if (e.tExpire <= now) {                 // outdated, also removes any earlier valid version
+                mapRead.erase(v[0]);
+                continue;
+            }
+            e.fields.assign(std::make_move_iterator(v.begin()+2),
+                            std::make_move_iterator(v.end()));
+            mapRead[v[0]] = std::move(e);
+        }
+        fIn.close();
+        LOG_MSG(logDEBUG, DBG_MD_CACHE_LOADED, (unsigned long)mapRead.size(),
+                (unsigned long)nLines, _path.c_str());
+        
+        // Too many records? Drop those, which expire first
+        const bool bCapped = mapRead.size() > MD_CACHE_MAX_ENTRIES;
+        if (bCapped) {
+            std::vector<time_t> vExp;
+            vExp.reserve(mapRead.size());
+            for (const auto& p: mapRead)
+                vExp.push_back(p.second.tExpire);
+            auto iterCut = vExp.end() - MD_CACHE_MAX_ENTRIES;
+            std::nth_element(vExp.begin(), iterCut, vExp.end());
+            const time_t tCut = *iterCut;               // keep what expires at or after this
+            for (auto iter = mapRead.begin(); iter != mapRead.end(); )
+                if (iter->second.tExpire < tCut)
+                    iter = mapRead.erase(iter);
+                else
+                    ++iter;
+        }
+        
+        // Compact the file if too many records are outdated, overridden, or dropped
+        if (bCapped || nLines > MD_CACHE_COMPACT_F * mapRead.size()) {
+            const std::string tmpPath = _path + ".tmp";
+            std::ofstream fTmp (tmpPath, std::ios_base::out | std::ios_base::trunc);
+            for (const auto& p: mapRead)
+                WriteLine(fTmp, p.first, p.second);
+            fTmp.close();
+            if (fTmp) {
+                std::remove(_path.c_str());         // Windows' rename doesn't replace existing files
+                if (std::rename(tmpPath.c_str(), _path.c_str()) == 0)
+                    LOG_MSG(logDEBUG, DBG_MD_CACHE_COMPACTED, _path.c_str(),
+                            (unsigned long)mapRead.size());
+            }
+        }
+        
+        // Take over what we read, records put meanwhile are newer
+        std::lock_guard<std::mutex> lock (mtx);
+        path = _path;
+        fOut.open(path, std::ios_base::out | std::ios_base::app);
+        if (fOut.is_open()) {
+            // persist the records put meanwhile
+            for (const auto& p: mapEntries)
+                WriteLine(fOut, p.first, p.second);
+            fOut.flush();
+        } else {
+            char sErr[SERR_LEN];
+            strerror_s(sErr, sizeof(sErr), errno);
+            LOG_MSG(logWARN, ERR_MD_CACHE_OPEN, path.c_str(), sErr);
+        }
+        for (auto& p: mapRead)
+            mapEntries.emplace(std::move(p));       // doesn't replace records put meanwhile
+    } catch (const std::exception& e) {
+        LOG_MSG(logERR, ERR_TOP_LEVEL_EXCEPTION, e.what());
+    } catch (...) {
+        LOG_MSG(logERR, ERR_TOP_LEVEL_EXCEPTION, "(unknown type)");
+    }
+    
+    // Loading done, wake up anyone waiting for it
+    {
+        std::lock_guard<std::mutex> lock (mtx);
+        bLoading = false;
+    }
+    cvLoaded.notify_all();
+}
+
+// Fetch cached master data for the a/c
+bool MasterDataCacheTy::GetMaster (const LTFlightData::FDKeyTy& key, LTFlightData::FDStaticData& dat)
+{
+    std::lock_guard<std::mutex> lock (mtx);
+    const EntryTy* pE = Find(REC_MASTER, key.key);
+    if (!pE || pE->fields.size() < 10) return false;
+    const std::vector<std::string>& f = pE->fields;
+    dat.reg         = f[0];
+    dat.country     = f[1];
+    dat.acTypeIcao  = f[2];
+    dat.man         = f[3];
+    dat.mdl         = f[4];
+    dat.catDescr    = f[5];
+    dat.op          = f[6];
+    dat.opIcao      = f[7];
+    dat.year        = std::atoi(f[8].c_str());
+    dat.mil         = f[9] == "1";
+    return true;
+}
+
+// Fetch cached route info for the call sign
+bool MasterDataCacheTy::GetRoute (const std::string& callSign, LTFlightData::FDStaticData& dat)
+{
+    std::lock_guard<std::mutex> lock (mtx);
+    const EntryTy* pE = Find(REC_ROUTE, callSign);
+    if (!pE || pE->fields.size() < 2) return false;
+    dat.flight      = pE->fields[0];
+    const std::vector<std::string> vStops = str_tokenize(pE->fields[1], ",");
+    dat.stops.assign(vStops.begin(), vStops.end());
+    return true;
+}
+
+// Fill the channel's ignore lists from cache
+void MasterDataCacheTy::GetIgnores (const char* chName, setFdKeyTy& setAc, setStringTy& setCallSign)
+{
+    std::lock_guard<std::mutex> lock (mtx);
+    const std::string prefix = std::string(chName) + ':';
+    const time_t now = time(nullptr);
+    for (const auto& p: mapEntries) {
+        if (p.second.tExpire <= now ||
+            p.first.compare(1, prefix.size(), prefix) != 0)
+            continue;
+        const std::string id = p.first.substr(1 + prefix.size());
+        switch (p.first.front()) {
+            case REC_IGN_AC: setAc.emplace(LTFlightData::KEY_ICAO, id); break;
+            case REC_IGN_CS: setCallSign.insert(id);                    break;
+        }
+    }
+}
+
+// Store master data received for the a/c
+void MasterDataCacheTy::PutMaster (const LTFlightData::FDKeyTy& key, const LTFlightData::FDStaticData& dat)
+{
+    if (key.empty()) return;
+    Put(REC_MASTER, key.key, MD_CACHE_TTL_MASTER,
+        { dat.reg, dat.country.str(), dat.acTypeIcao.str(), dat.man.str(), dat.mdl.str(),
+          dat.catDescr.str(), dat.op.str(), dat.opIcao.str(),
+          std::to_string(dat.year), dat.mil ? "1" : "0" });
+}
+
+// Store route info received for the call sign
+void MasterDataCacheTy::PutRoute (const std::string& callSign, const LTFlightData::FDStaticData& dat)
+{
+    if (callSign.empty()) return;
+    std::string sStops;
+    for (const LTAtom& s: dat.stops) {
+        if (!sStops.empty()) sStops += ',';
+        sStops += s;
+    }
+    Put(REC_ROUTE, callSign, MD_CACHE_TTL_ROUTE,
+        { dat.flight, sStops });
+}
+
+// Store that the channel found no data for the request
+void MasterDataCacheTy::PutIgnore (const char* chName, const acStatUpdateTy& requ)
+{
+    switch (requ.type) {
+        case DATREQU_AC_MASTER:
+            Put(REC_IGN_AC, std::string(chName) + ':' + requ.acKey.key, MD_CACHE_TTL_IGNORE, {});
+            break;
+        case DATREQU_ROUTE:
+            Put(REC_IGN_CS, std::string(chName) + ':' + requ.callSign, MD_CACHE_TTL_IGNORE, {});
+            break;
+        case DATREQU_NONE:
+            break;
+    }
+}
+
+// Find a valid record, expects `mtx` to be locked
+const MasterDataCacheTy::EntryTy* MasterDataCacheTy::Find (RecTy t, const std::string& id) const
+{
+    auto iter = mapEntries.find(char(t) + id);
+    if (iter == mapEntries.end() || iter->second.tExpire <= time(nullptr))
+        return nullptr;
+    return &iter->second;
+}
+
+// Add/replace a record in memory and append it to the file
+void MasterDataCacheTy::Put (RecTy t, const std::string& id, time_t ttl, std::vector<std::string>&& fields)
+{
+    // Tabs and line breaks would break the file format
+    for (std::string& s: fields)
+        std::replace_if(s.begin(), s.end(), [](char c){ return c == '\t' || c == '\r' || c == '\n'; }, ' ');
+    
+    std::lock_guard<std::mutex> lock (mtx);
+    const std::string key = char(t) + id;
+    EntryTy& e = mapEntries[key];
+    e.tExpire = time(nullptr) + ttl;
+    e.fields = std::move(fields);
+    if (fOut.is_open()) {
+        WriteLine(fOut, key, e);
+        fOut.flush();
+    }
+}
+
+// Write one record as a line
+void MasterDataCacheTy::WriteLine (std::ostream& o, const std::string& key, const EntryTy& e)
+{
+    o << key << '\t' << (long long)e.tExpire;
+    for (const std::string& s: e.fields)
+        o << '\t' << s;
+    o << '\n';
+}
+
 //
 //MARK: LTACMasterdata
 //
@@ -306,21 +783,17 @@ LTACMasterdataChannel::LTACMasterdataChannel (dataRefsLT ch, const char* chName)
 LTOnlineChannel(ch, CHT_MASTER_DATA, chName)
 {}
 
-/// Add the request to the set if not duplicate
+/// Add the request to the queue if not duplicate
 bool LTACMasterdataChannel::InsertRequest (const acStatUpdateTy& r)
 {
     try {
         std::lock_guard<std::recursive_mutex> lock (mtxMaster);
         
-        // Avoid double entry: Bail if the same kind of request exists already
-        // This is different from the duplication check that std::set::insert does
-        // because it uses operator== (ignoring `distance`) instead operator<
-        if (std::find(setAcStatRequ.begin(), setAcStatRequ.end(), r) != setAcStatRequ.end())
-            return false;
-        
-        // Add the new request to the set and trigger the main loop if really inserted
-        if (setAcStatRequ.insert(r).second) {
-            FDThreadSynchCV.notify_all();
+        // Add the new request to the queue and trigger the main loop if really inserted.
+        // A duplicate request (same a/c and type) only updates priority of the waiting one.
+        if (queAcStatRequ.push(r)) {
+            UpdRequCount();
+            Wake();
             return true;
         }
         
@@ -336,9 +809,10 @@ bool LTACMasterdataChannel::FetchNextRequest ()
 {
     try {
         std::lock_guard<std::recursive_mutex> lock (mtxMaster);
-        if (!setAcStatRequ.empty()) {
-            currRequ = *(setAcStatRequ.begin());        // "pop" "the first request
-            setAcStatRequ.erase(setAcStatRequ.begin());
+        if (!queAcStatRequ.empty()) {
+            currRequ = queAcStatRequ.front();           // pop the first request
+            queAcStatRequ.pop();
+            UpdRequCount();
             return true;
         }
     } catch(const std::system_error& e) {
@@ -352,30 +826,40 @@ bool LTACMasterdataChannel::FetchNextRequest ()
 void LTACMasterdataChannel::MaintainMasterDataRequests ()
 {
     try {
-        // Get both the master data lock and the lock for flight data
-        std::unique_lock<std::recursive_mutex> lock (mtxMaster, std::defer_lock);
-        std::unique_lock<std::mutex> l_fd (mapFdMutex, std::defer_lock);
-        std::lock (lock, l_fd);
+        // Get the master data lock
+        std::unique_lock<std::recursive_mutex> lock (mtxMaster);
         
-        // loop all waiting requests
-        for (setAcStatUpdateTy::iterator i = setAcStatRequ.begin();
-             i != setAcStatRequ.end();)
+        // loop all waiting requests, refresh their priority from current distance to camera
+        const positionTy posView = dataRefs.GetViewPos();
+        queAcStatRequ.reprioritize([&posView](acStatUpdateTy& r)
         {
-            if (mapFd.count(i->acKey) == 0)         // aircraft no longer exists?
-                i = setAcStatRequ.erase(i);         // just delete, don't pass on
-            else
-                ++i;
-        }
-        
-        // done with flight data
-        l_fd.unlock();
+            // Don't wait for a busy segment of the flight data map, keep the request as is then
+            FDMapTy::LockTy l_fd (mapFd.Shard(r.acKey).mtx, std::try_to_lock);
+            if (!l_fd)
+                return true;
+            LTFlightData* pFd = mapFd.Find(r.acKey);
+            if (!pFd)                               // aircraft no longer exists?
+                return false;                       // just delete, don't pass on
+            
+            // Don't wait for busy flight data, keep previous priority then
+            LTFlightData& fd = *pFd;
+            std::unique_lock<std::recursive_mutex> l_dat (fd.dataAccessMutex, std::try_to_lock);
+            if (l_dat) {
+                if (fd.hasAc())
+                    r.SetPrio(fd.GetAircraft()->GetVecView().dist, true);
+                else if (!fd.GetPosDeque().empty())
+                    r.SetPrio(CoordDistance(posView, fd.GetPosDeque().front()), false);
+            }
+            return true;
+        });
         
         // Special case: no longer valid/enabled: Pass on all requests
         if (!IsEnabled()) {
-            for (const acStatUpdateTy& r: setAcStatRequ)
+            for (const acStatUpdateTy& r: queAcStatRequ)
                 PassOnRequest(this, r);
-            setAcStatRequ.clear();
+            queAcStatRequ.clear();
         }
+        UpdRequCount();                         // reprioritizing might have removed requests
 
     } catch(const std::system_error& e) {
         LOG_MSG(logERR, ERR_LOCK_ERROR, "mtxMaster", e.what());
@@ -386,18 +870,25 @@ void LTACMasterdataChannel::MaintainMasterDataRequests ()
 bool LTACMasterdataChannel::UpdateStaticData (const LTFlightData::FDKeyTy& keyAc,
                                               const LTFlightData::FDStaticData& dat)
 {
+    // Remember for next time, even if the a/c is gone already
+    switch (currRequ.type) {
+        case DATREQU_AC_MASTER: mdCache.PutMaster(keyAc, dat);              break;
+        case DATREQU_ROUTE:     mdCache.PutRoute(currRequ.callSign, dat);   break;
+        case DATREQU_NONE:                                                  break;
+    }
+    
     // Find and update respective flight data
     try {
-        // from here on access to fdMap guarded by a mutex
-        std::lock_guard<std::mutex> mapFdLock (mapFdMutex);
+        // from here on access to the flight data's segment of mapFd guarded by a mutex
+        FDMapTy::LockTy mapFdLock = mapFd.Lock(keyAc);
         
         // get the fd object from the map, key is the transpIcao
-        mapLTFlightDataTy::iterator fdIter = mapFd.find(keyAc);
-        if (fdIter == mapFd.end())
+        LTFlightData* pFd = mapFd.Find(keyAc);
+        if (!pFd)
             return false;                   // not found
         
         // do the actual update
-        fdIter->second.UpdateData(dat, NAN, currRequ.type);
+        pFd->UpdateData(dat, NAN, currRequ.type);
         return true;
         
     } catch(const std::system_error& e) {
@@ -424,6 +915,8 @@ void LTACMasterdataChannel::AddIgnore ()
             case DATREQU_NONE:
                 break;
         }
+        // and remember that for next session, too
+        mdCache.PutIgnore(ChName(), currRequ);
     } catch(const std::system_error& e) {
         LOG_MSG(logERR, ERR_LOCK_ERROR, "mtxMaster", e.what());
     }
@@ -455,11 +948,16 @@ bool LTACMasterdataChannel::ShallIgnore (const acStatUpdateTy& requ) const
 // Register a master data channel, that will be called to process requests
 void LTACMasterdataChannel::RegisterMasterDataChn (LTACMasterdataChannel* pChn)
 {
+    // The ignore lists come from the cache file, which might still be read
+    mdCache.WaitLoaded();
     try {
         std::lock_guard<std::recursive_mutex> lock (mtxMaster);
         // just add the channel to the end of the list of channels
-        if (std::find(lstChn.begin(), lstChn.end(), pChn) == lstChn.end())
+        if (std::find(lstChn.begin(), lstChn.end(), pChn) == lstChn.end()) {
             lstChn.push_back(pChn);
+            // restore what the channel didn't find in previous sessions
+            mdCache.GetIgnores(pChn->ChName(), pChn->setIgnoreAc, pChn->setIgnoreCallSign);
+        }
     } catch(const std::system_error& e) {
         LOG_MSG(logERR, ERR_LOCK_ERROR, "mtxMaster", e.what());
     }
@@ -487,8 +985,7 @@ bool LTACMasterdataChannel::RequestMasterData (const LTFlightData::FDKeyTy& keyA
     if (keyAc.empty() || keyAc.eKeyType != LTFlightData::KEY_ICAO) return false;
     
     // Prepare the request object that is to be added later
-    const unsigned long dist = std::isnan(distance) ? UINT_MAX : (unsigned long) (distance);
-    const acStatUpdateTy acUpd (keyAc,str_toupper_c(callSign),dist);
+    const acStatUpdateTy acUpd (keyAc,str_toupper_c(callSign),distance);
 
     // Pass the request to the first channel of our list
     return PassOnRequest(nullptr, acUpd);
@@ -524,7 +1021,7 @@ bool LTACMasterdataChannel::PassOnRequest (LTACMasterdataChannel* pChn, const ac
 //
 
 // the one (hence static) output file for logging raw network data
-std::ofstream LTOnlineChannel::outRaw;
+LTAsyncWriter LTOnlineChannel::outRaw ("LT_RawLog", false);
 
 LTOnlineChannel::LTOnlineChannel (dataRefsLT ch, LTChannelType t, const char* chName) :
 LTChannel(ch, t, chName),
@@ -540,8 +1037,8 @@ curl_errtxt{0}, httpResponse(HTTP_OK)
 LTOnlineChannel::~LTOnlineChannel ()
 {
     // close the raw output file
-    if (outRaw.is_open()) {
-        outRaw.close();
+    if (outRaw.IsOpen()) {
+        outRaw.Close();
         SHOW_MSG(logWARN, DBG_RAW_FD_STOP, PATH_DEBUG_RAW_FD);
     }
 
@@ -572,6 +1069,8 @@ bool LTOnlineChannel::InitCurl ()
     curl_easy_setopt(pCurl, CURLOPT_ERRORBUFFER, curl_errtxt);
     curl_easy_setopt(pCurl, CURLOPT_WRITEFUNCTION, LTOnlineChannel::ReceiveData);
     curl_easy_setopt(pCurl, CURLOPT_WRITEDATA, this);
+    curl_easy_setopt(pCurl, CURLOPT_HEADERFUNCTION, LTOnlineChannel::ReceiveHeader);
+    curl_easy_setopt(pCurl, CURLOPT_HEADERDATA, this);
     curl_easy_setopt(pCurl, CURLOPT_USERAGENT, HTTP_USER_AGENT);
     
     // success
@@ -615,13 +1114,35 @@ size_t LTOnlineChannel::ReceiveData(const char *ptr, size_t size, size_t nmemb,
     return realsize;
 }
 
+// static CURL Header Callback, stores validators for conditional requests
+size_t LTOnlineChannel::ReceiveHeader(char *buffer, size_t size, size_t nitems, void *userdata)
+{
+    const size_t len = nitems * size;
+    LTOnlineChannel* pMe = reinterpret_cast<LTOnlineChannel*>(userdata);
+    if (!pMe) return len;
+    
+    // Header names are case-insensitive
+    const std::string hdr (buffer, len);
+    const std::string::size_type posColon = hdr.find(':');
+    if (posColon == std::string::npos) return len;
+    const std::string name = str_toupper_c(hdr.substr(0, posColon));
+    std::string val = hdr.substr(posColon+1);
+    if (name == "ETAG")
+        pMe->respETag = trim(val);
+    else if (name == "LAST-MODIFIED")
+        pMe->respLastModified = trim(val);
+    
+    // always say we processed everything, otherwise HTTP processing would stop!
+    return len;
+}
+
 // debug: log raw network data to a log file
 void LTOnlineChannel::DebugLogRaw(const char *data, long httpCode, bool bHeader)
 {
     // no logging? return (after closing the file if open)
     if (!dataRefs.GetDebugLogRawFD()) {
-        if (outRaw.is_open()) {
-            outRaw.close();
+        if (outRaw.IsOpen()) {
+            outRaw.Close();
             SHOW_MSG(logWARN, DBG_RAW_FD_STOP, PATH_DEBUG_RAW_FD);
         }
         return;
@@ -629,27 +1150,27 @@ void LTOnlineChannel::DebugLogRaw(const char *data, long httpCode, bool bHeader)
     
     // *** Logging enabled ***
     
-    // As there are different threads (e.g. in LTRealTraffic), which send data,
-    // we guard file writing with a lock, so that no line gets intermingled
-    // with another thread's data:
-    static std::mutex logRawMutex;
-    std::lock_guard<std::mutex> lock(logRawMutex);
-    
     // Need to open the file first?
-    if (!outRaw.is_open()) {
-        // open the file, append to it
-        std::string sFileName (LTCalcFullPath(PATH_DEBUG_RAW_FD));
-        outRaw.open (sFileName, std::ios_base::out | std::ios_base::app);
-        if (!outRaw) {
-            char sErr[SERR_LEN];
-            strerror_s(sErr, sizeof(sErr), errno);
-            // could not open output file: bail out, decativate logging
-            SHOW_MSG(logERR, DBG_RAW_FD_ERR_OPEN_OUT,
-                     sFileName.c_str(), sErr);
-            dataRefs.SetDebugLogRawFD(false);
-            return;
+    // As there are different threads (e.g. in LTRealTraffic), which send data,
+    // we guard opening the file with a lock. Writing is done by the
+    // writer thread, so that no line gets intermingled with another thread's data.
+    if (!outRaw.IsOpen()) {
+        static std::mutex logRawMutex;
+        std::lock_guard<std::mutex> lock(logRawMutex);
+        if (!outRaw.IsOpen()) {
+            // open the file, append to it
+            std::string sFileName (LTCalcFullPath(PATH_DEBUG_RAW_FD));
+            if (!outRaw.Open(sFileName, false)) {
+                char sErr[SERR_LEN];
+                strerror_s(sErr, sizeof(sErr), errno);
+                // could not open output file: bail out, decativate logging
+                SHOW_MSG(logERR, DBG_RAW_FD_ERR_OPEN_OUT,
+                         sFileName.c_str(), sErr);
+                dataRefs.SetDebugLogRawFD(false);
+                return;
+            }
+            SHOW_MSG(logWARN, DBG_RAW_FD_START, PATH_DEBUG_RAW_FD);
         }
-        SHOW_MSG(logWARN, DBG_RAW_FD_START, PATH_DEBUG_RAW_FD);
     }
     
     // Receives modifiable copy of the data
@@ -677,15 +1198,16 @@ void LTOnlineChannel::DebugLogRaw(const char *data, long httpCode, bool bHeader)
     
     // timestamp (numerical and human readable)
     const double now = GetSysTime();
-    outRaw.precision(2);
+    std::ostringstream sOut;
+    sOut.precision(2);
     if (bHeader) {
         
         // Empty line before a (new) SENDING request
         if (httpCode == HTTP_FLAG_SENDING)
-            outRaw << "\n";
+            sOut << "\n";
 
         // Actual header
-        outRaw
+        sOut
         << std::fixed << now << ' ' << ts2string(now,2)
         << " - SimTime "
         << dataRefs.GetSimTimeString()
@@ -694,22 +1216,23 @@ void LTOnlineChannel::DebugLogRaw(const char *data, long httpCode, bool bHeader)
         << ChName();
 
         if (httpCode == HTTP_FLAG_SENDING)
-            outRaw << " SENDING:\n";
+            sOut << " SENDING:\n";
         else if (httpCode == HTTP_FLAG_UDP)
-            outRaw << " RECEIVED UDP:\n";
+            sOut << " RECEIVED UDP:\n";
         else if (httpCode == HTTP_OK)
-            outRaw << " RECEIVED HTTP_OK:\n";
+            sOut << " RECEIVED HTTP_OK:\n";
         else if (httpCode == HTTP_NOT_FOUND)
-            outRaw << " RECEIVED HTTP_NOT_FOUND (404):\n";
+            sOut << " RECEIVED HTTP_NOT_FOUND (404):\n";
         else
-            outRaw << " RECEIVED HTTP " << httpCode << ":\n";
+            sOut << " RECEIVED HTTP " << httpCode << ":\n";
     }
     // Output the actual text
-    outRaw
+    sOut
     // the actual given data, stripped from general personal data
     << str_replPers(dupData)
-    // newlines + flush
-    << std::endl;
+    // newline, the writer thread takes care of flushing
+    << '\n';
+    outRaw.Add(0, sOut.str());
 }
 
 // URL-encode a string
@@ -756,6 +1279,21 @@ bool LTOnlineChannel::FetchAllData (const positionTy& pos)
         // HTTPS POST
         curl_easy_setopt(pCurl, CURLOPT_POSTFIELDS, requBody.data());
     
+    // Conditional request if we know validators from the last request:
+    // Headers are added to a copy of the channel's own headers (like an API key)
+    struct curl_slist* pCondHdr = nullptr;
+    if (!requETag.empty() || !requLastModified.empty())
+        for (const curl_slist* p = GetCurlHeaders(); p; p = p->next)
+            pCondHdr = curl_slist_append(pCondHdr, p->data);
+    if (!requETag.empty())
+        pCondHdr = curl_slist_append(pCondHdr, ("If-None-Match: " + requETag).c_str());
+    if (!requLastModified.empty())
+        pCondHdr = curl_slist_append(pCondHdr, ("If-Modified-Since: " + requLastModified).c_str());
+    if (pCondHdr)
+        curl_easy_setopt(pCurl, CURLOPT_HTTPHEADER, pCondHdr);
+    respETag.clear();
+    respLastModified.clear();
+    
     // get fresh data via the internet
     // this will take a second or more...don't try in render loop ;)
     // it is assumed that this is called in a separate thread,
@@ -782,6 +1320,15 @@ bool LTOnlineChannel::FetchAllData (const positionTy& pos)
         cc = curl_easy_perform(pCurl);
         tEnd = std::chrono::steady_clock::now();
     }
+    
+    // restore the channel's own headers
+    if (pCondHdr) {
+        curl_easy_setopt(pCurl, CURLOPT_HTTPHEADER, GetCurlHeaders());
+        curl_slist_free_all(pCondHdr);
+        pCondHdr = nullptr;
+    }
+    requETag.clear();
+    requLastModified.clear();
 
     // if (still) error, then log error and bail out
     if (cc != CURLE_OK) {
@@ -808,6 +1355,13 @@ bool LTOnlineChannel::FetchAllData (const positionTy& pos)
     switch (httpResponse) {
         case HTTP_OK:
             break;
+            
+        case HTTP_NOT_MODIFIED:
+            // conditional request: nothing changed, so there is nothing to process
+            LOG_MSG(logDEBUG, DBG_NOT_MODIFIED, ChName(), url.c_str());
+            netDataPos = 0;
+            netData[0] = 0;
+            break;
 
         case HTTP_NOT_FOUND:
             // not found is typically handled separately, so only debug-level
@@ -860,6 +1414,9 @@ bool LTFlightDataEnable()
 {
     // create list of flight and master data connections
     listFDC.clear();
+    
+    // read persisted master data
+    mdCache.Open(dataRefs.GetXPSystemPath() + PATH_MASTER_DATA_CACHE);
 
     // load live feed readers (in order of priority)
     listFDC.emplace_back(new RealTrafficConnection());
@@ -885,6 +1442,7 @@ void LTFlightDataDisable()
 {
     // remove all flight data connections
     listFDC.clear();
+    mdCache.Close();
 }
 
 void LTFlightDataStop()
@@ -956,7 +1514,7 @@ void LTFlightDataHideAircraft()
     {
         // Stop all threads
         bFDMainStop = true;                 // the message is: Stop!
-        FDThreadSynchCV.notify_all();       // wake them all up to exit
+        LTWakeup::WakeAll();                // wake them all up to exit
         
         // wait for all network threads
         for (ptrLTChannelTy& p: listFDC)
@@ -968,8 +1526,6 @@ void LTFlightDataHideAircraft()
     
     // Remove all flight data info including displayed aircraft
     try {
-        // access guarded by a mutex
-        std::lock_guard<std::mutex> lock (mapFdMutex);
         mapFd.clear();
         LOG_ASSERT ( dataRefs.GetNumAc() == 0 );
     } catch(const std::system_error& e) {
@@ -1028,42 +1584,35 @@ LTChannel* LTFlightDataGetCh (dataRefsLT ch)
 //      (called from flight loop callback!)
 //
 
-void LTFlightDataAcMaintenance()
+/// State of the current round of aircraft maintenance, which is spread across flight loop calls
+struct AcMaintRoundTy {
+    size_t  nextShard = FD_MAP_SHARDS;  ///< next segment of `mapFd` to maintain, `FD_MAP_SHARDS` if all are done
+    bool    bPending = false;           ///< round started, but UI not yet informed about the result
+    int     numAcBefore = 0;            ///< number of aircraft shown when the round started
+    size_t  numFd = 0;                  ///< number of flight data objects kept so far in this round
+};
+static AcMaintRoundTy acMaint;          ///< the current round of aircraft maintenance
+
+/// Flight data due for aircraft creation
+struct AcCreateCandTy {
+    LTFlightData::FDKeyTy key;          ///< key of the flight data
+    double dist = NAN;                  ///< [m] distance to camera when found due
+};
+/// Flight data due for aircraft creation, created nearest first, only a few per flight loop call
+static std::vector<AcCreateCandTy> vecAcCreate;
+
+/// At the end of a round of aircraft maintenance: UI messages about filling up the buffer and number of aircraft
+static void LTFlightDataAcMaintReport ()
 {
-    // Verify all required channels are running (necessary in case users activates channels via UI)
-    LTFlightDataStartJoinChannels();
-    
-    // Actual aircraft maintenance: call individual FD objects, remove outdated ones
-    int numAcBefore = dataRefs.GetNumAc();
-    
-    try {
-        // access guarded by the fd mutex
-        std::lock_guard<std::mutex> lock (mapFdMutex);
-        double simTime = dataRefs.GetSimTime();
-        
-        // iterate all flight data and remove outdated aircraft along with their fd data
-        for ( auto i = mapFd.begin(); i != mapFd.end(); )
-        {
-            // access guarded by a mutex
-            LTFlightData& fd = i->second;
-            // do the maintenance, remove aircraft if that's the verdict
-            if ( fd.AircraftMaintenance(simTime) )
-                i = mapFd.erase(i);
-            else
-                ++i;
-        }
-
-    } catch(const std::system_error& e) {
-        LOG_MSG(logERR, ERR_LOCK_ERROR, "mapFd", e.what());
-    }
-    
-    /*** UI messages about filling up the buffer ***/
+    acMaint.bPending = false;
+    const int numAcBefore = acMaint.numAcBefore;
+    const size_t numFd = acMaint.numFd;
     int numAcAfter = dataRefs.GetNumAc();
     
     // initially: we might see some a/c but don't have enough data yet
     if ( initTimeBufFilled < 0 ) {
         // did we see any aircraft yet?
-        if ( mapFd.size() > 0 )
+        if ( numFd > 0 )
             // show messages for FD_BUF_PERIOD time
             initTimeBufFilled = dataRefs.GetSimTime() + dataRefs.GetFdBufPeriod();
     }
@@ -1071,13 +1620,13 @@ void LTFlightDataAcMaintenance()
     // if buffer-fill countdown is (still) running, update the figures in UI
     if ( initTimeBufFilled > 0 ) {
         CreateMsgWindow(float(AC_MAINT_INTVL * 1.5),
-                        int(mapFd.size()), numAcAfter,
+                        int(numFd), numAcAfter,
                         int(initTimeBufFilled - dataRefs.GetSimTime()));
         // buffer fill-up time's up
         if (dataRefs.GetSimTime() >= initTimeBufFilled) {
             initTimeBufFilled = 0;
             CreateMsgWindow(float(AC_MAINT_INTVL * 1.5),
-                            int(mapFd.size()), numAcAfter,
+                            int(numFd), numAcAfter,
                             -1);            // clear the message
         }
     } else {
@@ -1095,3 +1644,81 @@ void LTFlightDataAcMaintenance()
 #endif
 }
 
+// Start a new round of aircraft maintenance
+void LTFlightDataAcMaintenance()
+{
+    // Verify all required channels are running (necessary in case users activates channels via UI)
+    LTFlightDataStartJoinChannels();
+    
+    // Previous round still going through mapFd? Then let it finish first
+    if (acMaint.nextShard < FD_MAP_SHARDS)
+        return;
+    // Previous round still creating aircraft? Report now,
+    // remaining creations will be found due again in the new round
+    if (acMaint.bPending)
+        LTFlightDataAcMaintReport();
+    vecAcCreate.clear();
+    
+    acMaint.nextShard = 0;
+    acMaint.bPending = true;
+    acMaint.numAcBefore = dataRefs.GetNumAc();
+    acMaint.numFd = 0;
+    
+    // Do the first slice right away
+    LTFlightDataAcMaintenanceSlice();
+}
+
+// Maintain the next few segments of `mapFd`, create the nearest aircraft due
+void LTFlightDataAcMaintenanceSlice()
+{
+    // Actual aircraft maintenance: call individual FD objects, remove outdated ones
+    if (acMaint.nextShard < FD_MAP_SHARDS)
+    {
+        try {
+            double simTime = dataRefs.GetSimTime();
+            
+            // iterate flight data segment by segment until the slice is big enough,
+            // remove outdated aircraft along with their fd data,
+            // and remember those due for aircraft creation
+            size_t numDone = 0;
+            while (acMaint.nextShard < FD_MAP_SHARDS && numDone < AC_MAINT_FD_PER_CALL)
+            {
+                numDone += mapFd.EraseIfShard(acMaint.nextShard++, [simTime](LTFlightData& fd)
+                {
+                    // do the maintenance, remove aircraft if that's the verdict
+                    double createDist = NAN;
+                    if ( fd.AircraftMaintenance(simTime, createDist) )
+                        return true;
+                    ++acMaint.numFd;
+                    if (!std::isnan(createDist))
+                        vecAcCreate.push_back({fd.key(), createDist});
+                    return false;
+                });
+            }
+        } catch(const std::system_error& e) {
+            LOG_MSG(logERR, ERR_LOCK_ERROR, "mapFd", e.what());
+        }
+    }
+    
+    // Create aircraft, nearest first, just a few per call
+    if (!vecAcCreate.empty()) {
+        const double simTime = dataRefs.GetSimTime();
+        // sort descending by distance, so we can take the nearest from the back
+        std::sort(vecAcCreate.begin(), vecAcCreate.end(),
+                  [](const AcCreateCandTy& a, const AcCreateCandTy& b)
+                  { return a.dist > b.dist; });
+        for (int n = 0; n < AC_MAINT_CREATE_PER_CALL && !vecAcCreate.empty(); ++n) {
+            // flight data might have been removed meanwhile,
+            // CreateAircraft() validates again before creating
+            LTFlightData* pFd = mapFd.FindMain(vecAcCreate.back().key);
+            vecAcCreate.pop_back();
+            if (pFd)
+                pFd->CreateAircraft(simTime);
+        }
+    }
+    
+    // Round done? Then inform the UI
+    if (acMaint.bPending && acMaint.nextShard >= FD_MAP_SHARDS && vecAcCreate.empty())
+        LTFlightDataAcMaintReport();
+}
+
@@ -374,7 +374,7 @@ bool FSCConnection::ProcessFetchedData ()
         try {
             // from here on access to fdMap guarded by a mutex
             // until FD object is inserted and updated
-            std::unique_lock<std::mutex> mapFdLock (mapFdMutex);
+            FDMapTy::LockTy mapFdLock = mapFd.Lock(fdKey);
             
             // get the fd object from the map, key is the transpIcao
             // this fetches an existing or, if not existing, creates a new one
@@ -395,12 +395,13 @@ bool FSCConnection::ProcessFetchedData ()
             stat.reg        =   jog_s(pJAc, FSC_FLIGHT_REG_NO);
             stat.acTypeIcao =   jog_s(pJAc, FSC_FLIGHT_ICAO);
             stat.man        =   jog_s(pJAc, FSC_FLIGHT_MANU);
-            stat.mdl        =   jog_s(pJAc, FSC_FLIGHT_MODEL);
+            std::string mdl =   jog_s(pJAc, FSC_FLIGHT_MODEL);
             s               =   jog_s(pJAc, FSC_FLIGHT_VARIANT);
             if (!s.empty()) {
-                stat.mdl   += ' ';
-                stat.mdl   += s;
+                mdl        += ' ';
+                mdl        += s;
             }
+            stat.mdl        =   mdl;
             stat.call       =   jog_s(pJAc, FSC_FLIGHT_PILOT);
             stat.setOrigDest(jog_s(pJAc, FSC_FLIGHT_DEP), jog_s(pJAc, FSC_FLIGHT_ARR));
             stat.flight     =   jog_s(pJAc, FSC_FLIGHT_ROUTE_NO);
@@ -526,9 +527,7 @@ void FSCConnection::Main ()
             // sleep for FD_REFRESH_INTVL or if woken up for termination
             // by condition variable trigger
             {
-                std::unique_lock<std::mutex> lk(FDThreadSynchMutex);
-                FDThreadSynchCV.wait_until(lk, tNextWakeup,
-                                           [this]{return !shallRun();});
+                wakeup.WaitUntil(tNextWakeup, [this]{return !shallRun();});
             }
             
         } catch (const std::exception& e) {
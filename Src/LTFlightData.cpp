@@ -30,16 +30,29 @@
 
 // the global map of all received flight data,
 // which also includes pointer to the simulated aircraft
-mapLTFlightDataTy mapFd;
-// modifying the map is controlled by a mutex
-// (note that mapFdMutex must be locked before dataAccessMutex
-//  to avoid deadlocks, mapFdMutex is considered a higher-level lock)
-std::mutex      mapFdMutex;
-
-// flag to indicate that there is no new positional data
-// to analyse for terrain altitude and subsequently
-// add to posDeque, i.e. if true AppendAllNewPos returns immediately
-std::atomic_flag flagNoNewPosToAdd = ATOMIC_FLAG_INIT;
+// (note that a segment's lock must be acquired before dataAccessMutex
+//  to avoid deadlocks, segment locks are considered higher-level locks)
+FDMapTy mapFd;
+
+/// A new position on its way from a network thread to the main thread
+struct PosHandoffTy {
+    LTFlightData::FDKeyType eKeyType = LTFlightData::KEY_UNKNOWN;  ///< key type of the flight data
+    unsigned long num = 0;                  ///< numeric key of the flight data
+    positionTy pos;                         ///< the new position
+
+    /// Key type and number packed, same as LTFlightData::FDKeyTy::packed()
+    uint64_t packed () const { return (uint64_t(eKeyType) << 32) | uint64_t(num & 0xFFFFFFFFUL); }
+};
+
+/// @brief New positions handed from network threads to the main thread
+/// @details Filled by LTFlightData::AddNewPos() from any channel thread,
+///          drained by LTFlightData::AppendAllNewPos() in the flight loop,
+///          which then analyses them for terrain altitude and adds them to posDeque
+static LTMPSCQueueTy<PosHandoffTy, FD_POS_HANDOFF_CAP> quPosHandoff;
+/// Positions taken from the queue, whose flight data was busy, to be tried again next time (main thread only)
+static std::vector<PosHandoffTy> vecPosDeferred;
+/// Warned already that the queue is full?
+static std::atomic_flag flagPosHandoffWarned = ATOMIC_FLAG_INIT;
 
 //
 //MARK: Flight Data Subclasses
@@ -47,7 +60,7 @@ std::atomic_flag flagNoNewPosToAdd = ATOMIC_FLAG_INIT;
 LTFlightData::FDDynamicData::FDDynamicData () :
 gnd(false),                             // positional
 heading(NAN),
-spd(0.0), vsi(0.0),                     // movement
+spd(0.0), vsi(0.0), turnRate(NAN),      // movement
 ts(0),
 pChannel(nullptr)
 {}
@@ -159,7 +172,7 @@ bool LTFlightData::FDStaticData::merge (const FDStaticData& other,
     trim(mdl);
     trim(catDescr);
     trim(call);
-    std::for_each(stops.begin(), stops.end(), trim_ws);
+    for (LTAtom& s: stops) trim(s);
     trim(flight);
     trim(op);
     trim(opIcao);
@@ -313,13 +326,10 @@ const char* LTFlightData::FDKeyTy::GetKeyTypeText () const
 /// Question mark for static returns
 std::string LTFlightData::FDStaticData::emptyStr;
 
-// Export file for tracking data
-std::ofstream LTFlightData::fileExport;
-std::string LTFlightData::fileExportName;       // current export file's name
+// Export file for tracking data, sorted by timestamp
+LTAsyncWriter LTFlightData::fileExport ("LT_Export", true);
 double LTFlightData::fileExportTsBase = NAN;    // when normalizing timestamps this is the base
-// the priority queue holding data to be exported for sorting
-LTFlightData::quExportTy LTFlightData::quExport;
-// Coordinates writing into the export file to avoid lines overwriting
+// Coordinates opening/closing the export file
 std::recursive_mutex LTFlightData::exportFdMutex;
 
 // Constructor
@@ -367,14 +377,19 @@ LTFlightData& LTFlightData::operator=(const LTFlightData& fd)
         rcvr                = fd.rcvr;
         sig                 = fd.sig;
         labelStat           = fd.labelStat;
+        labelStatVer        = fd.labelStatVer;
         labelCfg            = fd.labelCfg;
         posDeque            = fd.posDeque;          // dynamic data
         posToAdd            = fd.posToAdd;
+        nPosQueued          = fd.nPosQueued;
+        tsLastQueued        = fd.tsLastQueued;
         dynDataDeque        = fd.dynDataDeque;
+        kf                  = fd.kf;
         rotateTS            = fd.rotateTS;
         youngestTS          = fd.youngestTS;
         statData            = fd.statData;          // static data
         pAc                 = fd.pAc;
+        tsAcHold            = fd.tsAcHold;
         probeRef            = fd.probeRef;
         bValid              = fd.bValid;
     } catch(const std::system_error& e) {
@@ -409,11 +424,12 @@ void LTFlightData::SetKey (const FDKeyTy& _key)
 /// Open Glider Network we now search for the same hex code as FLARM, and if we
 /// find one (which must be relatively close by as we currently "see" it)
 /// then we assume it is the same flight and change key type to FLARM,
-/// so that both OGN and RealTraffic feed the flight:
+/// so that both OGN and RealTraffic feed the flight.\n
+/// Caller must have locked `_key`'s segment of mapFd, which is the same for all key types.
 bool LTFlightData::CheckDupKey(LTFlightData::FDKeyTy& _key, LTFlightData::FDKeyType _ty)
 {
     LTFlightData::FDKeyTy cpyKey(_ty, _key.num);
-    if (mapFd.count(cpyKey) > 0) {
+    if (mapFd.Contains(cpyKey)) {
         LOG_MSG(logDEBUG, "Handling same key %s of different types: %s replaced by %s",
                 _key.c_str(), _key.GetKeyTypeText(), cpyKey.GetKeyTypeText());
         _key = std::move(cpyKey);
@@ -503,6 +519,7 @@ void LTFlightData::UpdateStaticLabel()
         ADD_LABEL(cfg.bCallSign,    statData.call);
         ADD_LABEL(cfg.bFlightNo,    statData.flight);
         ADD_LABEL(cfg.bRoute,       statData.route());
+        labelStatVer++;
         
         // this is the config we did the label for
         labelCfg = cfg;
@@ -512,9 +529,13 @@ void LTFlightData::UpdateStaticLabel()
     }
 }
 
-// produce a/c label
-#define ADD_LABEL_NUM(b,num) if (b) { label += std::to_string(lround(num)); label += ' '; }
-std::string LTFlightData::ComposeLabel() const
+// Label statistics
+static std::atomic<unsigned long> labelCntRebuilt {0};  ///< number of labels rebuilt
+static std::atomic<unsigned long> labelCntSkipped {0};  ///< number of labels left unchanged
+
+// produce a/c label, only if any value changed at display precision
+#define ADD_LABEL_NUM(b,num) if (b) { label += std::to_string(num); label += ' '; }
+bool LTFlightData::ComposeLabel (std::string& label, LabelValsTy& vals) const
 {
     try {
         // access guarded by a mutex
@@ -522,36 +543,75 @@ std::string LTFlightData::ComposeLabel() const
 
         // the configuration: which parts to include in the label?
         const DataRefs::LabelCfgTy cfg = dataRefs.GetLabelCfg();
-        std::string label(labelStat);       // copy static parts
         
-        // only possible if we have an aircraft
+        // current values at display precision, only those to be shown
+        LabelValsTy curr;
+        curr.bInit = true;
+        curr.statVer = labelStatVer;
+        curr.cfg = cfg.GetUInt();
         if (pAc) {
             // current position of a/c
             const positionTy& pos = pAc->GetPPos();
+            if (cfg.bPhase)     curr.phase   = int(pAc->GetFlightPhase());
+            if (cfg.bHeading)   curr.heading = lround(pos.heading());
+            if (cfg.bAlt)       curr.alt     = lround(pos.alt_ft());
+            if (cfg.bHeightAGL) curr.height  = pAc->IsOnGrnd() ? LONG_MIN : long(pAc->GetPHeight_ft());
+            if (cfg.bSpeed)     curr.speed   = lround(pAc->GetSpeed_kt());
+            if (cfg.bVSI)       curr.vsi     = lround(pAc->GetVSI_ft());
+        }
+        
+        // nothing changed? Then the label is still good
+        if (curr == vals) {
+            labelCntSkipped++;
+            return false;
+        }
+        vals = curr;
+        labelCntRebuilt++;
+
+        label = labelStat;                  // static parts, reusing the label's buffer
+        
+        // only possible if we have an aircraft
+        if (pAc) {
             // add more items as per configuration
             if (cfg.bPhase) { label +=  pAc->GetFlightPhaseString(); trim(label); label += ' '; }
-            ADD_LABEL_NUM(cfg.bHeading,     pos.heading());
-            ADD_LABEL_NUM(cfg.bAlt,         pos.alt_ft());
+            ADD_LABEL_NUM(cfg.bHeading,     curr.heading);
+            ADD_LABEL_NUM(cfg.bAlt,         curr.alt);
             if (cfg.bHeightAGL) {
-                label += pAc->IsOnGrnd() ? positionTy::GrndE2String(GND_ON) :
-                           std::to_string(long(pAc->GetPHeight_ft()));
+                label += curr.height == LONG_MIN ? positionTy::GrndE2String(GND_ON) :
+                           std::to_string(curr.height);
                 trim(label);
                 label += ' ';
             }
-            ADD_LABEL_NUM(cfg.bSpeed,       pAc->GetSpeed_kt());
-            ADD_LABEL_NUM(cfg.bVSI,         pAc->GetVSI_ft());
+            ADD_LABEL_NUM(cfg.bSpeed,       curr.speed);
+            ADD_LABEL_NUM(cfg.bVSI,         curr.vsi);
         }
         
         // remove the trailing space
         if (!label.empty())
             label.pop_back();
         
-        return label;
+        return true;
         
     } catch(const std::system_error& e) {
         LOG_MSG(logERR, ERR_LOCK_ERROR, key().c_str(), e.what());
     }
-    return "?";
+    label = "?";
+    vals = LabelValsTy();                   // try again next time
+    return true;
+}
+
+// Returns label composition statistics, optionally resets them
+LTFlightData::LabelStatsTy LTFlightData::GetLabelStats (bool bReset)
+{
+    LabelStatsTy stats;
+    if (bReset) {
+        stats.nRebuilt = labelCntRebuilt.exchange(0);
+        stats.nSkipped = labelCntSkipped.exchange(0);
+    } else {
+        stats.nRebuilt = labelCntRebuilt;
+        stats.nSkipped = labelCntSkipped;
+    }
+    return stats;
 }
 
 
@@ -754,8 +814,9 @@ void LTFlightData::DataSmoothing (bool& bChanged)
         if (itLast->ts() - posFirst.ts() > tsRange  ||
             // don't smooth across gnd status changes
             itLast->f.onGrnd != posFirst.f.onGrnd       ||
-            // don't smooth across artifically calculated positions
-            itLast->f.flightPhase != FPH_UNKNOWN)
+            // don't smooth across artifically calculated or predicted positions
+            itLast->f.flightPhase != FPH_UNKNOWN ||
+            itLast->f.bPredicted)
             break;
     }
     // we went one too far...so how far did we go into the deque?
@@ -977,6 +1038,9 @@ bool LTFlightData::CalcNextPos ( double simTime )
                         bChanged = true;
                     }
                 }
+                // Airborne, but live data is late: Dead-reckon with the state estimator
+                else if (dataRefs.GetFdPredict())
+                    AddPredictedPos(pAc->GetToPos(), simTime, bChanged);
 
                 // still no positions left?
                 if (posDeque.empty())
@@ -1326,10 +1390,21 @@ bool LTFlightData::CalcNextPos ( double simTime )
 
 // the mutex used to synch access to the list of keys which await pos calculation
 std::mutex calcNextPosListMutex;
-// and that list of pairs <key,simTime>
-typedef std::pair<LTFlightData::FDKeyTy,double> keyTimePairTy;
+/// An entry in the list of keys awaiting position calculation
+struct keyTimePairTy {
+    LTFlightData::FDKeyTy key;                      ///< flight data to work on
+    double simTime = NAN;                           ///< sim time to calculate for
+    std::chrono::steady_clock::time_point tEnq;     ///< when the entry was queued, for statistics
+};
 typedef std::deque<keyTimePairTy> dequeKeyTimeTy;
 dequeKeyTimeTy dequeKeyPosCalc;
+/// The calculation thread sleeps on this one till TriggerCalcNewPos() wakes it up
+static LTWakeup calcWakeup;
+
+// Queue statistics, also guarded by calcNextPosListMutex
+static unsigned long calcQuCnt = 0;             ///< number of requests taken off the queue
+static double calcQuWaitSum_ms = 0.0;           ///< sum of their waiting times
+static double calcQuWaitMax_ms = 0.0;           ///< longest waiting time
 
 // The main function for the position calculation thread
 // It receives keys to work on in the dequeKeyPosCalc list and calls
@@ -1342,6 +1417,7 @@ void LTFlightData::CalcNextPosMain ()
     // loop till said to stop
     while ( !bFDMainStop ) {
         keyTimePairTy pair;
+        bool bMore = false;                     // more entries in the list after this one?
         
         // thread-safely access the list of keys to fetch one for processing
         try {
@@ -1349,6 +1425,12 @@ void LTFlightData::CalcNextPosMain ()
             if ( !dequeKeyPosCalc.empty() ) {   // something's in the list, take it
                 pair = dequeKeyPosCalc.front();
                 dequeKeyPosCalc.pop_front();
+                bMore = !dequeKeyPosCalc.empty();
+                // queue statistics
+                const double wait_ms = std::chrono::duration<double,std::milli>(std::chrono::steady_clock::now() - pair.tEnq).count();
+                calcQuCnt++;
+                calcQuWaitSum_ms += wait_ms;
+                if (wait_ms > calcQuWaitMax_ms) calcQuWaitMax_ms = wait_ms;
             }
         } catch(const std::system_error& e) {
             LOG_MSG(logERR, ERR_LOCK_ERROR, "CalcNextPosMain", e.what());
@@ -1356,24 +1438,26 @@ void LTFlightData::CalcNextPosMain ()
         }
         
         // there was something in the list to process? Do so!
-        if (!pair.first.empty()) {
+        if (!pair.key.empty()) {
             try {
-                // To ensure a FD object stays available between mapFd.at and the
+                // To ensure a FD object stays available between map.at and the
                 // call to its local mutex we prohibit removal by locking the
-                // general mapFd mutex.
-                std::unique_lock<std::mutex> lockMap (mapFdMutex);
+                // flight data's segment of mapFd.
+                FDMapTy::LockTy lockMap = mapFd.Lock(pair.key);
                 // find the flight data object in the map and calc position
-                LTFlightData& fd = mapFd.at(pair.first);
+                LTFlightData& fd = mapFd.Shard(pair.key).map.at(pair.key);
                 
                 // LiveTraffic Top Level Exception Handling:
                 // CalcNextPos can cause exceptions. If so make fd object invalid and ignore it
                 try {
                     std::lock_guard<std::recursive_mutex> lockFD (fd.dataAccessMutex);
-                    lockMap.unlock();           // now that we have the detailed mutex we can release the global one
-                    if (fd.IsValid())
-                        fd.CalcNextPos(pair.second);
+                    lockMap.unlock();           // now that we have the detailed mutex we can release the segment
+                    if (fd.IsValid()) {
+                        StressTimer st(STS_CALC_NEXT_POS);
+                        fd.CalcNextPos(pair.simTime);
+                    }
                 } catch (const std::exception& e) {
-                    LOG_MSG(logERR, ERR_TOP_LEVEL_EXCEPTION " - on aircraft %s", e.what(), pair.first.c_str());
+                    LOG_MSG(logERR, ERR_TOP_LEVEL_EXCEPTION " - on aircraft %s", e.what(), pair.key.c_str());
                     fd.SetInvalid();
                 } catch (...) {
                     fd.SetInvalid();
@@ -1382,17 +1466,15 @@ void LTFlightData::CalcNextPosMain ()
             } catch(const std::out_of_range&) {
                 // just ignore exception...fd object might have gone in the meantime
                 if constexpr (LIVETRAFFIC_VERSION_BETA) {
-                    LOG_MSG(logWARN, "No longer found aircraft %s", pair.first.c_str());
+                    LOG_MSG(logWARN, "No longer found aircraft %s", pair.key.c_str());
                 }
             }
         }
             
-        // sleep till woken up for processing or stopping
-        {
-            std::unique_lock<std::mutex> lk(FDThreadSynchMutex);
-            FDThreadSynchCV.wait(lk, []{return bFDMainStop || !dequeKeyPosCalc.empty();});
-            lk.unlock();
-        }
+        // sleep till woken up for processing or stopping,
+        // a wakeup since we looked at the list isn't lost, it returns right away
+        if (!bMore)
+            calcWakeup.Wait([]{return bFDMainStop;});
     }
 }
 
@@ -1406,22 +1488,38 @@ void LTFlightData::TriggerCalcNewPos ( double simTime )
         
         // search for key in the list, if already included update simTime and return
         for (keyTimePairTy &i: dequeKeyPosCalc)
-            if(i.first==key()) {
-                i.second = fmax(simTime,i.second);   // update simTime to latest
+            if(i.key==key()) {
+                i.simTime = fmax(simTime,i.simTime);   // update simTime to latest
                 return;
             }
         
         // not in list, so add to list of keys to calculate including simTime
-        dequeKeyPosCalc.emplace_back(key(),simTime);
+        dequeKeyPosCalc.push_back({key(), simTime, std::chrono::steady_clock::now()});
         
         // trigger the calc thread to wake up
-        FDThreadSynchCV.notify_all();
+        calcWakeup.Wake();
         
     } catch(const std::system_error& e) {
         LOG_MSG(logERR, ERR_LOCK_ERROR, "TriggerCalcNewPos", e.what());
     }
 }
 
+// Returns statistics of the position calculation queue, optionally resets them
+LTFlightData::CalcQueueStatsTy LTFlightData::GetCalcQueueStats (bool bReset)
+{
+    CalcQueueStatsTy stats;
+    std::lock_guard<std::mutex> lock (calcNextPosListMutex);
+    stats.len = dequeKeyPosCalc.size();
+    stats.cnt = calcQuCnt;
+    stats.avgWait_ms = calcQuCnt ? calcQuWaitSum_ms / double(calcQuCnt) : 0.0;
+    stats.maxWait_ms = calcQuWaitMax_ms;
+    if (bReset) {
+        calcQuCnt = 0;
+        calcQuWaitSum_ms = calcQuWaitMax_ms = 0.0;
+    }
+    return stats;
+}
+
 
 // calc heading from positions in a positionList around a given position (it)
 // if there is only (it), then use heading from flight data
@@ -1597,45 +1695,32 @@ bool LTFlightData::ExportOpenClose ()
 {
     // no logging? return (after closing the file if open)
     if (!dataRefs.AnyExportData()) {
-        if (fileExport.is_open()) {
+        if (fileExport.IsOpen()) {
             std::lock_guard<std::recursive_mutex> lock(exportFdMutex);
-            // write remaining lines before close
-            while (!quExport.empty()) {
-                fileExport << quExport.top().s;
-                quExport.pop();
-            }
-            fileExport.close();
-            SHOW_MSG(logWARN, DBG_EXPORT_FD_STOP, fileExportName.c_str());
+            // writes remaining lines before close
+            fileExport.Close();
+            SHOW_MSG(logWARN, DBG_EXPORT_FD_STOP, fileExport.GetFileName().c_str());
         }
         return false;
     }
     // Logging on: Need to open the file first?
-    else if (!fileExport.is_open()) {
+    else if (!fileExport.IsOpen()) {
         std::lock_guard<std::recursive_mutex> lock(exportFdMutex);
         // previous test was unsafe, not locked, so with lock once again:
-        if (!fileExport.is_open()) {
-            // Create the file name from a fixed part and a date/time stamp
+        if (!fileExport.IsOpen()) {
+            // Open the file with a fixed part and a date/time stamp
             // much like X-Plane names screenshots
-            char currFileName[100];
-            const std::time_t t = std::time(nullptr);
-            const std::tm tm = *std::localtime(&t);
-            std::strftime(currFileName, sizeof(currFileName),
-                          PATH_DEBUG_EXPORT_FD, &tm);
-            fileExportName = currFileName;
-            
-            // open the file, append to it
-            fileExport.open (fileExportName, std::ios_base::out | std::ios_base::app);
-            if (!fileExport) {
+            if (!fileExport.Open(PATH_DEBUG_EXPORT_FD, true)) {
                 char sErr[SERR_LEN];
                 strerror_s(sErr, sizeof(sErr), errno);
                 // could not open output file: bail out, decativate logging
                 SHOW_MSG(logERR, DBG_RAW_FD_ERR_OPEN_OUT,
-                         fileExportName.c_str(), sErr);
+                         fileExport.GetFileName().c_str(), sErr);
                 dataRefs.SetAllExportData(false);
                 return false;
             }
             else {
-                SHOW_MSG(logWARN, DBG_EXPORT_FD_START, fileExportName.c_str());
+                SHOW_MSG(logWARN, DBG_EXPORT_FD_START, fileExport.GetFileName().c_str());
                 // In case we are to normalize timestamps we'll do it against NOW
                 fileExportTsBase = dataRefs.ShallExportNormalizeTS() ? dataRefs.GetSimTime() : NAN;
                 // always start with current weather
@@ -1643,31 +1728,19 @@ bool LTFlightData::ExportOpenClose ()
             }
         }
     }
-    return fileExport.is_open();
+    return fileExport.IsOpen();
 }
 
-// Moves a line to the export priority queue, flushes data which is ready to be written
+// Hands a line over to the export writer thread, which sorts by `ts` and writes once due
 void LTFlightData::ExportAddOutput (unsigned long ts, const char* s)
 {
     // make sure a file is open before continuing
     if (!ExportOpenClose())
         return;
     
-    // As there are different threads (e.g. in LTRealTraffic), which send data,
-    // we guard file writing with a lock, so that no line gets intermingled
-    // with another thread's data:
-    std::lock_guard<std::recursive_mutex> lock(exportFdMutex);
-
-    // add the line to the queue
-    quExport.emplace(ts, s);
-    
-    // flush all lines to the file that are due for writing
-    const unsigned long now = (unsigned long)(dataRefs.GetSimTime()) + 5;
-    while (!quExport.empty() && quExport.top().ts < now) {
-        fileExport << quExport.top().s;
-        quExport.pop();
-    }
-    fileExport.flush();
+    // The writer thread takes care of sorting and writing,
+    // adding the line does not block
+    fileExport.Add(ts, std::string(s));
 }
 
 // debug: log raw network data to a log file
@@ -1745,20 +1818,20 @@ void LTFlightData::ExportLastWeather ()
     if (!ExportOpenClose())
         return;
 
-    // make sure no other thread is writing to the file right now
-    std::lock_guard<std::recursive_mutex> lock(exportFdMutex);
-
     // get latest data
     float hPa = NAN;
     std::string stationId, METAR;
     dataRefs.GetWeather(hPa, stationId, METAR);
     
-    fileExport
+    // timestamp 0 makes it being written right away
+    std::ostringstream sWeather;
+    sWeather
     << "{\"ICAO\": \""      << stationId
     << "\",\"QNH\": \""     << std::lround(hPa)
     << "\", \"METAR\": \""  << METAR
     << "\", \"NAME\": \""   << stationId        // don't have a proper name, doesn't matter
     << "\"}\n";
+    fileExport.Add(0, sWeather.str());
 }
 
 // adds a new position to the queue of positions to analyse
@@ -1768,26 +1841,36 @@ void LTFlightData::AddNewPos ( positionTy& pos )
         // access guarded by a mutex
         std::lock_guard<std::recursive_mutex> lock (dataAccessMutex);
 
-        // We only consider data that is newer than what we have already
+        // We only consider data that is newer than what we have already,
+        // including positions still on their way to the main thread
         const positionTy* pLatestPos =
         !posToAdd.empty() ? &(posToAdd.back()) :
         !posDeque.empty() ? &(posDeque.back()) :
         hasAc()           ? &(pAc->GetToPos()) : nullptr;
-        
-        if (pLatestPos) {
-            // pos is before or close to 'to'-position: don't add!
-            if (pos.ts() <= pLatestPos->ts() + SIMILAR_TS_INTVL)
-            {
-                if (dataRefs.GetDebugAcPos(key()))
-                    LOG_MSG(logDEBUG,DBG_SKIP_NEW_POS_TS,pos.dbgTxt().c_str());
-                return;
-            }
+        const double tsLatest =
+        nPosQueued > 0    ? tsLastQueued :
+        pLatestPos && pLatestPos->f.bPredicted ? kf.GetTs() :   // predicted positions give way to live data
+        pLatestPos        ? pLatestPos->ts() : NAN;
+        
+        // pos is before or close to 'to'-position: don't add!
+        if (!std::isnan(tsLatest) &&
+            pos.ts() <= tsLatest + SIMILAR_TS_INTVL)
+        {
+            if (dataRefs.GetDebugAcPos(key()))
+                LOG_MSG(logDEBUG,DBG_SKIP_NEW_POS_TS,pos.dbgTxt().c_str());
+            return;
         }
 
-        // add pos to the queue of data to be added
+        // hand pos over to the main thread, which adds it after analysis
         // (we shall not do Y probes but need accurate GND info...)
-        posToAdd.emplace_back(pos);
-        flagNoNewPosToAdd.clear();
+        if (!quPosHandoff.push(PosHandoffTy{acKey.eKeyType, acKey.num, pos})) {
+            // We don't wait for the flight loop, that could deadlock with the lock we hold
+            if (!flagPosHandoffWarned.test_and_set())
+                LOG_MSG(logWARN, ERR_POS_HANDOFF_FULL, (unsigned long)quPosHandoff.capacity());
+            return;
+        }
+        nPosQueued++;
+        tsLastQueued = pos.ts();
 
         if (dataRefs.GetDebugAcPos(key()))
             LOG_MSG(logDEBUG,DBG_ADDED_NEW_POS,pos.dbgTxt().c_str());
@@ -1796,46 +1879,81 @@ void LTFlightData::AddNewPos ( positionTy& pos )
     }
 }
 
-// walks all flight data objects and works the posToAdd queue
+// takes new positions from the hand-off queue and adds them to their flight data,
 // called from flight loop callback, i.e. from the main thread
 void LTFlightData::AppendAllNewPos()
 {
-    // short-cut if nothing to do
-    if (flagNoNewPosToAdd.test_and_set())
+    // What's to do: Positions deferred last time, then a limited number of new ones from the queue
+    static std::vector<PosHandoffTy> vecTodo;           // keeps its capacity across calls
+    vecTodo.clear();
+    vecTodo.swap(vecPosDeferred);
+    PosHandoffTy ph;
+    const size_t maxTodo = dataRefs.GetPosHandoffPerFrame();
+    while (vecTodo.size() < maxTodo && quPosHandoff.pop(ph))
+        vecTodo.emplace_back(std::move(ph));
+    if (vecTodo.empty()) {
+        flagPosHandoffWarned.clear();                   // caught up, can warn again next time the queue runs full
         return;
+    }
 
-    // somewhere there is something to do
-    // need access to flight data map
-    try {
-        std::unique_lock<std::mutex> lock (mapFdMutex, std::try_to_lock);
-        if (!lock) {
-            // couldn't get the lock right away
-            // -> return, we don't want to hinder rendering
-            flagNoNewPosToAdd.clear();      // but need to try again
-            return;
-        }
-        
-        // loop all flight data objects and check for new data to analyse
-        for (mapLTFlightDataTy::value_type& fdPair: mapFd) {
-            LTFlightData& fd = fdPair.second;
-            try {
+    // Group positions by flight data, keeping their order
+    std::stable_sort(vecTodo.begin(), vecTodo.end(),
+                     [](const PosHandoffTy& a, const PosHandoffTy& b)
+                     { return a.packed() < b.packed(); });
+
+    for (std::vector<PosHandoffTy>::iterator grpBeg = vecTodo.begin();
+         grpBeg != vecTodo.end();)
+    {
+        const uint64_t pk = grpBeg->packed();
+        const std::vector<PosHandoffTy>::iterator grpEnd =
+        std::find_if(grpBeg, vecTodo.end(),
+                     [pk](const PosHandoffTy& i){ return i.packed() != pk; });
+        const FDKeyTy fdKey (grpBeg->eKeyType, grpBeg->num);
+
+        // We don't wait for any lock: we don't want to hinder rendering.
+        // If busy, the positions are tried again next time.
+        bool bBusy = false;
+        try {
+            // find the flight data; as we are the main thread the pointer stays valid after releasing the segment
+            LTFlightData* pFd = nullptr;
+            {
+                FDMapTy::LockTy lockMap (mapFd.Shard(fdKey).mtx, std::try_to_lock);
+                if (lockMap)
+                    pFd = mapFd.Find(fdKey);
+                else
+                    bBusy = true;
+            }
+            // if the flight data is gone we just drop the positions
+            if (pFd) {
+                LTFlightData& fd = *pFd;
                 std::unique_lock<std::recursive_mutex> lockFD (fd.dataAccessMutex, std::try_to_lock);
-                if (!lockFD) {
-                    flagNoNewPosToAdd.clear();          // need to try it again
-                } else {
-                    if (fd.IsValid())
-                        fd.AppendNewPos();
+                if (!lockFD)
+                    bBusy = true;
+                else {
+                    const unsigned n = unsigned(grpEnd - grpBeg);
+                    fd.nPosQueued -= std::min(fd.nPosQueued, n);
+                    if (fd.IsValid()) {
+                        for (std::vector<PosHandoffTy>::iterator i = grpBeg; i != grpEnd; ++i)
+                            fd.posToAdd.emplace_back(std::move(i->pos));
+                        try {
+                            fd.AppendNewPos();
+                        } catch (const std::exception& e) {
+                            LOG_MSG(logERR, ERR_TOP_LEVEL_EXCEPTION, e.what());
+                            fd.SetInvalid();
+                        } catch (...) {
+                            fd.SetInvalid();
+                        }
+                    }
                 }
-            } catch (const std::exception& e) {
-                LOG_MSG(logERR, ERR_TOP_LEVEL_EXCEPTION, e.what());
-                fd.SetInvalid();
-            } catch (...) {
-                fd.SetInvalid();
             }
+        } catch(const std::system_error& e) {
+            LOG_MSG(logERR, ERR_LOCK_ERROR, fdKey.c_str(), e.what());
+            bBusy = true;
         }
-    } catch(const std::system_error& e) {
-        LOG_MSG(logERR, ERR_LOCK_ERROR, "mapFdMutex", e.what());
-        flagNoNewPosToAdd.clear();
+
+        if (bBusy)
+            std::move(grpBeg, grpEnd, std::back_inserter(vecPosDeferred));
+        grpBeg = grpEnd;
     }
 }
 
@@ -1850,10 +1968,8 @@ void LTFlightData::AppendNewPos()
     try {
         // access guarded by a mutex, but we don't wait (inside the flight loop)
         std::unique_lock<std::recursive_mutex> lock (dataAccessMutex, std::try_to_lock);
-        if (!lock) {
-            flagNoNewPosToAdd.clear();          // need to try it again
+        if (!lock)                          // positions stay in posToAdd for next time
             return;
-        }
         
        // loop the positions to add
         while (!posToAdd.empty())
@@ -1862,6 +1978,10 @@ void LTFlightData::AppendNewPos()
             positionTy pos = posToAdd.front();
             posToAdd.pop_front();
             
+            // Live data replaces predicted positions
+            while (!posDeque.empty() && posDeque.back().f.bPredicted)
+                posDeque.pop_back();
+            
             // Once again a final check: We only add data after the last known position
             // We only consider data that is newer than what we have already
             const positionTy* pLatestPos = nullptr;
@@ -1887,6 +2007,12 @@ void LTFlightData::AppendNewPos()
             if (pLatestPos &&
                 pos.ts() <= pLatestPos->ts() + SIMILAR_TS_INTVL)
             {
+                // The aircraft already flies to a predicted position beyond this live one:
+                // Live data still corrects the state estimator, and by that the next predictions
+                if (pLatestPos->f.bPredicted && dataRefs.GetFdPredict()) {
+                    KalmanUpdate(pos);
+                    youngestTS = std::max(youngestTS, pos.ts());
+                }
                 if (dataRefs.GetDebugAcPos(key()))
                     LOG_MSG(logDEBUG,DBG_SKIP_NEW_POS_TS,pos.dbgTxt().c_str());
                 continue;                   // skip
@@ -1896,7 +2022,9 @@ void LTFlightData::AppendNewPos()
             TryDeriveGrndStatus(pos);
             
             // Now that we have a proper Grnd status we can test the pos for validty
-            if (pLatestPos && !IsPosOK(*pLatestPos, pos, &headToLatest)) {
+            // (a predicted position is no reference for that)
+            if (pLatestPos && !pLatestPos->f.bPredicted &&
+                !IsPosOK(*pLatestPos, pos, &headToLatest)) {
                 if (dataRefs.GetDebugAcPos(key()))
                     LOG_MSG(logDEBUG,DBG_SKIP_NEW_POS_NOK,pos.dbgTxt().c_str());
                 return;
@@ -1928,6 +2056,10 @@ void LTFlightData::AppendNewPos()
             
             // should be fully valid position now
             LOG_ASSERT_FD(*this, i->isFullyValid());
+            
+            // feed the state estimator for dead-reckoning
+            if (dataRefs.GetFdPredict())
+                KalmanUpdate(*i);
         }
         
         // posDeque should be sorted, i.e. no two adjacent positions a,b should be a > b
@@ -1956,6 +2088,53 @@ void LTFlightData::AppendNewPos()
     }
 }
 
+// Feed a live position, and the dynamic data of the same time, to the state estimator
+void LTFlightData::KalmanUpdate (const positionTy& pos)
+{
+    LTCtrKalmanTy::MeasTy m;
+    m.ts    = pos.ts();
+    m.lat   = pos.lat();
+    m.lon   = pos.lon();
+    m.alt_m = pos.alt_m();
+    // dynamic data of the same time
+    for (const FDDynamicData& dyn: dynDataDeque) {
+        if (std::abs(dyn.ts - pos.ts()) < SIMILAR_TS_INTVL) {
+            m.spd_m_s   = dyn.spd / KT_per_M_per_S;
+            m.track     = dyn.heading;
+            m.turnRate  = dyn.turnRate;
+            m.vsi_m_s   = dyn.vsi * Ms_per_FTm;
+            break;
+        }
+    }
+    kf.Update(m);
+}
+
+// Live data is late: add a position dead-reckoned by the state estimator after `from`
+void LTFlightData::AddPredictedPos (const positionTy& from, double simTime, bool& bChanged)
+{
+    // Only for as long as the latest live data isn't too old
+    const double ts = std::max(from.ts(), simTime) + FD_PREDICT_STEP;
+    if (!kf.IsInit() || ts > kf.GetTs() + FD_PREDICT_MAX)
+        return;
+    
+    const LTCtrKalmanTy::PredTy pr = kf.Predict(ts);
+    positionTy pos (pr.lat, pr.lon, pr.alt_m, ts,
+                    pr.track,                   // heading
+                    2.0,                        // pitch, just a rough value, like in AppendNewPos()
+                    0.0,                        // roll, LTAircraft::CalcPPos takes care of the details
+                    GND_OFF);
+    pos.f.bPredicted = true;
+    if (!pos.isFullyValid())
+        return;
+    
+    if (dataRefs.GetDebugAcPos(key()))
+        LOG_MSG(logDEBUG, "%s: Added predicted %s",
+                keyDbg().c_str(),
+                std::string(pos).c_str());
+    posDeque.emplace_back(std::move(pos));
+    bChanged = true;
+}
+
 // Called by a/c: reads available positions if lock available
 LTFlightData::tryResult LTFlightData::TryFetchNewPos (dequePositionTy& acPosList,
                                                       double& _rotateTS)
@@ -2409,12 +2588,23 @@ void LTFlightData::UpdateData (const LTFlightData::FDStaticData& inStat,
         if (masterDataType == DATREQU_NONE) {
             // A/c master data: Not yet requested master data and
             //                  critical elements missing?
+            // Try the persistent cache first, only then ask online
+            FDStaticData cached;
             if (!statData.bDataMaster && !statData.hasMdlMatchInfo()) {
-                LTACMasterdataChannel::RequestMasterData(key(), distance);
+                if (key().eKeyType == KEY_ICAO && mdCache.GetMaster(key(), cached)) {
+                    if (statData.merge(cached, DATREQU_AC_MASTER))
+                        bMdlInfoChange = true;
+                }
+                else
+                    LTACMasterdataChannel::RequestMasterData(key(), distance);
             }
             // Route Info missing?
             if (!statData.bDataRoute && !statData.hasRouteInfo()) {
-                LTACMasterdataChannel::RequestRouteInfo(key(), statData.call, distance);
+                cached = FDStaticData();
+                if (!statData.call.empty() && mdCache.GetRoute(str_toupper_c(statData.call), cached))
+                    statData.merge(cached, DATREQU_ROUTE);
+                else
+                    LTACMasterdataChannel::RequestRouteInfo(key(), statData.call, distance);
             }
         }
         
@@ -2481,8 +2671,9 @@ LTFlightData::FDStaticData LTFlightData::WaitForSafeCopyStat() const
 
 // checks if initial position to be calculated or aircraft to be created
 // returns if a/c is to be deleted
-bool LTFlightData::AircraftMaintenance ( double simTime )
+bool LTFlightData::AircraftMaintenance ( double simTime, double& createDist )
 {
+    createDist = NAN;
     try {
         // try to lock data access
         std::unique_lock<std::recursive_mutex> lock (dataAccessMutex, std::try_to_lock);
@@ -2505,9 +2696,14 @@ bool LTFlightData::AircraftMaintenance ( double simTime )
             // if the a/c became invalid or has flown out of sight
             // then remove the aircraft object,
             // but retain the remaining flight data
-            if (!pAc->IsValid() ||
-                pAc->GetVecView().dist > dataRefs.GetFdStdDistance_m())
+            if (!pAc->IsValid())
+                DestroyAircraft();
+            // Out of sight only a bit beyond the standard distance,
+            // and then don't come back too soon (avoids churn at the range edge)
+            else if (pAc->GetVecView().dist > dataRefs.GetFdStdDistance_m() * (1.0 + AC_HYST_DIST_F)) {
+                tsAcHold = (std::isnan(simTime) ? dataRefs.GetSimTime() : simTime) + AC_RECREATE_HOLD;
                 DestroyAircraft();
+            }
             else {
                 // cover the special case of finishing landing and roll-out without live positions
                 // i.e. during approach and landing we don't destroy the aircraft
@@ -2531,9 +2727,12 @@ bool LTFlightData::AircraftMaintenance ( double simTime )
             // Have at least two positions?
             if (posDeque.size() >= 2 ) {
                 // is already valid for a/c creation?
-                if ( validForAcCreate(simTime) )
-                    // then do create the aircraft
-                    CreateAircraft(simTime);
+                if ( validForAcCreate(simTime) ) {
+                    // then the caller shall create the aircraft, nearest first,
+                    // unless it was removed just recently
+                    if (!(simTime < tsAcHold))
+                        createDist = CoordDistance(dataRefs.GetViewPos(), posDeque.front());
+                }
                 else // not yet valid
                     // but the oldest position is at or before current simTime?
                     // then chances are good that we can calculate positions
@@ -2625,7 +2824,7 @@ bool LTFlightData::DetermineAcModel()
 }
 
 // checks if there is a slot available to create this a/c, tries to remove the farest a/c if too many a/c rendered
-/// @warning Caller must own `mapFdMutex`!
+/// @note Called from the main thread during LTFlightDataAcMaintenanceSlice()
 bool LTFlightData::AcSlotAvailable ()
 {
     // time we had shown the "Too many a/c" warning last:
@@ -2645,30 +2844,33 @@ bool LTFlightData::AcSlotAvailable ()
     }
 
     // As long as there are too many a/c remove the ones farest away
-    while (dataRefs.GetNumAc() >= dataRefs.GetMaxNumAc())
+    // (The frame-time governor might have reduced the limit)
+    while (dataRefs.GetNumAc() >= dataRefs.GetEffMaxNumAc())
     {
         // Now we need to see if we are closer to the camera than other a/c.
         // If so remove the farest a/c to make room for us.
         LTFlightData* pFarestAc = nullptr;
 
-        // NOTE: We can loop mapFd without lock only because we assume that
-        //       calling function owns mapFdMutex already!
-        // find the farest a/c...if it is further away than us:
-        double farestDist = CoordDistance(dataRefs.GetViewPos(), posDeque.front());
-        for (mapLTFlightDataTy::value_type& p: mapFd)
+        // find the farest a/c...if it is clearly further away than us
+        // (so that aircraft at similar distance don't take turns removing each other):
+        // NOTE: Segments currently locked by other threads are skipped,
+        //       we'll get another chance during next maintenance.
+        double farestDist = CoordDistance(dataRefs.GetViewPos(), posDeque.front()) * (1.0 + AC_HYST_DIST_F);
+        mapFd.TryForEach([&](LTFlightData& fd)
         {
-            LTFlightData& fd = p.second;
             if (fd.hasAc() && fd.pAc->GetVecView().dist > farestDist) {
                 farestDist = fd.pAc->GetVecView().dist;
                 pFarestAc = &fd;
             }
-        }
+        });
     
         // If we didn't find an active a/c farther away than us then bail
         if (!pFarestAc)
             return false;
     
         // We found the a/c farest away...remove it to make room for us!
+        // (and it shall not come back right away)
+        pFarestAc->tsAcHold = dataRefs.GetSimTime() + AC_RECREATE_HOLD;
         pFarestAc->DestroyAircraft();
     }
     
@@ -2765,17 +2967,16 @@ void LTFlightData::DestroyAircraft ()
 void LTFlightData::UpdateAllModels ()
 {
     try {
-        // access guarded by the fd mutex
-        std::lock_guard<std::mutex> lock (mapFdMutex);
-        
         // iterate all flight data
-        for ( mapLTFlightDataTy::value_type& fdPair: mapFd )
+        mapFd.ForEach([](LTFlightData& fd)
         {
+            // CSL models might have changed, so don't re-use matches
+            fd.cslMdlCache.clear();
             // if there is an aircraft update it's flight model
-            LTAircraft* pAc = fdPair.second.GetAircraft();
+            LTAircraft* pAc = fd.GetAircraft();
             if (pAc)
                 pAc->SetUpdateModel();
-        }
+        });
     } catch(const std::system_error& e) {
         LOG_MSG(logERR, ERR_LOCK_ERROR, "mapFd", e.what());
     }
@@ -2788,20 +2989,18 @@ const LTFlightData* LTFlightData::FindFocusAc (const double bearing)
     const LTFlightData* ret = nullptr;
     double bestRating = std::numeric_limits<double>::max();
     
-    // access guarded by the fd mutex
-    std::lock_guard<std::mutex> lock (mapFdMutex);
     // walk the map of flight data
-    for ( std::pair<const LTFlightData::FDKeyTy,LTFlightData>& fdPair: mapFd )
+    mapFd.ForEach([&](LTFlightData& fd)
     {
         // no a/c? -> not relevant
-        if (!fdPair.second.pAc)
-            continue;
+        if (!fd.pAc)
+            return;
         
         // should be +/- 45° of bearing
-        const vectorTy vecView = fdPair.second.pAc->GetVecView();
+        const vectorTy vecView = fd.pAc->GetVecView();
         double hDiff = std::abs(HeadingDiff(bearing, vecView.angle));
         if (hDiff > maxDiff)
-            continue;
+            return;
         
         // calculate a rating based on deviation from bearing plus distance
         // Reasoning: An a/c directly in front of us shall be prefered if
@@ -2811,9 +3010,9 @@ const LTFlightData* LTFlightData::FindFocusAc (const double bearing)
         // best one so far?
         if ( rating < bestRating ) {
             bestRating = rating;
-            ret = &fdPair.second;
+            ret = &fd;
         }
-    }
+    });
     
     // return what we thing is focus
     return ret;
@@ -2823,18 +3022,8 @@ const LTFlightData* LTFlightData::FindFocusAc (const double bearing)
 // This helps focusing on one aircraft and debug through the position calculation code
 void LTFlightData::RemoveAllAcButSelected ()
 {
-    // access guarded by the fd mutex
-    std::lock_guard<std::mutex> lock (mapFdMutex);
-    
     // hard and directly remove all other aircraft without any further ado
-    for (mapLTFlightDataTy::iterator i = mapFd.begin();
-         i != mapFd.end();)
-    {
-        if (!i->second.bIsSelected)
-            i = mapFd.erase(i);
-        else
-            ++i;
-    }
+    mapFd.EraseIf([](const LTFlightData& fd){ return !fd.bIsSelected; });
     
     // reduce allow a/c to 1 so no new aircraft gets created
     dataRefs.SetMaxNumAc(1);
@@ -2843,32 +3032,41 @@ void LTFlightData::RemoveAllAcButSelected ()
 
 
 //
-// MARK: mapLTFlightDataTy
+// MARK: FDMapTy
 //
 
+// total number of flight data objects, locks all segments one by one
+size_t FDMapTy::size ()
+{
+    size_t n = 0;
+    for (ShardTy& s: aShards) {
+        std::lock_guard<MutexTy> lock (s.mtx);
+        n += s.map.size();
+    }
+    return n;
+}
+
+// remove all flight data, locks all segments one by one
+void FDMapTy::clear ()
+{
+    for (ShardTy& s: aShards) {
+        std::lock_guard<MutexTy> lock (s.mtx);
+        s.map.clear();
+    }
+}
+
 // Find "i-th" aircraft, i.e. the i-th flight data with assigned pAc
-mapLTFlightDataTy::iterator mapFdAcByIdx (int idx)
+LTFlightData* mapFdAcByIdx (int idx)
 {
-    // access guarded by the fd mutex
-    std::lock_guard<std::mutex> lock (mapFdMutex);
     // let's find the i-th aircraft by looping over all flight data
     // and count those objects, which have an a/c
     int i = 0;
-    for (mapLTFlightDataTy::iterator fdIter = mapFd.begin();
-         fdIter != mapFd.end();
-         ++fdIter)
-    {
-        if (fdIter->second.hasAc())         // has an a/c
-            if ( ++i == idx )               // and it's the i-th!
-                return fdIter;
-    }
-    
-    // not found
-    return mapFd.end();
+    return mapFd.FindIf([&i,idx](const LTFlightData& fd)
+                        { return fd.hasAc() && ++i == idx; });
 }
 
 // Find a/c by text input
-mapLTFlightDataTy::iterator mapFdSearchAc (const std::string& _s)
+LTFlightData* mapFdSearchAc (const std::string& _s)
 {
     // is it a small integer number, i.e. used as index?
     if (_s.length() <= 3 &&
@@ -2879,9 +3077,7 @@ mapLTFlightDataTy::iterator mapFdSearchAc (const std::string& _s)
     else
     {
         // search the map of flight data by text key
-        return std::find_if(mapFd.begin(), mapFd.end(),
-                            [&](const mapLTFlightDataTy::value_type& mfd)
-                            { return mfd.second.IsMatch(_s); } );
+        return mapFd.FindIf([&](const LTFlightData& fd)
+                            { return fd.IsMatch(_s); } );
     }
 }
-
@@ -66,9 +66,7 @@ void FlightRadarConnection::Main ()
             // sleep for FD_REFRESH_INTVL or if woken up for termination
             // by condition variable trigger
             {
-                std::unique_lock<std::mutex> lk(FDThreadSynchMutex);
-                FDThreadSynchCV.wait_until(lk, tNextWakeup,
-                                           [this]{return !shallRun();});
+                wakeup.WaitUntil(tNextWakeup, [this]{return !shallRun();});
             }
             
         } catch (const std::exception& e) {
@@ -85,7 +83,8 @@ void FlightRadarConnection::Main ()
 std::string FlightRadarConnection::GetURL (const positionTy& pos)
 {
     // we add 10% to the bounding box to have some data ready once the plane is close enough for display
-    boundingBoxTy box (pos, double(dataRefs.GetFdStdDistance_m()) * 1.10);
+    const RequAreaTy& area = PlanRequestArea(pos, double(dataRefs.GetFdStdDistance_m()) * 1.10);
+    boundingBoxTy box (area.center, area.extent_m);
     char url[128] = "";
     snprintf(url, sizeof(url),
              FR_URL,
@@ -99,6 +98,10 @@ std::string FlightRadarConnection::GetURL (const positionTy& pos)
 
 bool FlightRadarConnection::ProcessFetchedData()
 {
+    // conditional request told us that nothing changed
+    if (httpResponse == HTTP_NOT_MODIFIED)
+        return true;
+    
     // data is expected to be in netData string
     // short-cut if there is nothing
     if (!netDataPos) {
@@ -187,7 +190,7 @@ bool FlightRadarConnection::ProcessFetchedData()
             double dist = acPos.dist(viewPos);
 
             // Access fdMap guarded by a mutex
-            std::unique_lock<std::mutex> mapFdLock (mapFdMutex);
+            FDMapTy::LockTy mapFdLock = mapFd.Lock(fdKey);
 
             // Get or create the LTFlightData object
             LTFlightData& fd = mapFd[fdKey];
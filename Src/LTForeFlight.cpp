@@ -82,7 +82,8 @@ void ForeFlightSender::Main ()
     std::chrono::steady_clock::time_point nextAtt;
     std::chrono::steady_clock::time_point nextTraffic;
     std::chrono::steady_clock::time_point lastStartOfTraffic;
-    LTFlightData::FDKeyTy lastKey;          // last traffic sent out
+    std::vector<LTFlightData::FDKeyTy> vecTrafficKeys;  // a/c still to be sent in the current round
+    bool bTrafficRound = false;             // currently in a round of sending traffic?
 
     const uint16_t portListen   = (uint16_t)DataRefs::GetCfgInt(DR_CFG_FF_LISTEN_PORT);
     const uint16_t portSend     = (uint16_t)DataRefs::GetCfgInt(DR_CFG_FF_SEND_PORT);
@@ -230,43 +231,41 @@ void ForeFlightSender::Main ()
             if (bSendAITraffic && !bDidSendSomething &&
                 now >= nextTraffic)
             {
-                // from here on access to fdMap guarded by a mutex
-                std::unique_lock<std::mutex> lock (mapFdMutex, std::try_to_lock);
-                if (lock) {
-                    if (!mapFd.empty()) {
-                        // just starting with a new round?
-                        if (lastKey == LTFlightData::FDKeyTy())
-                            lastStartOfTraffic = now;
-                        
-                        // next key to send? (shall have an actual a/c)
-                        mapLTFlightDataTy::const_iterator mapIter;
-                        for (mapIter = mapFd.upper_bound(lastKey);
-                             mapIter != mapFd.cend() && !mapIter->second.hasAc();
-                             mapIter++);
-                        
-                        // something left?
-                        if (mapIter != mapFd.cend()) {
-                            // send that plane's info
-                            SendTraffic(mapIter->second);
-                            // wake up soon again for the rest
-                            lastKey = mapIter->first;
-                            nextTraffic = now + FF_INTVL;
-                        }
-                        else {
-                            // we're done with one round, start over
-                            lastKey = LTFlightData::FDKeyTy();
-                            nextTraffic = lastStartOfTraffic + std::chrono::seconds(DataRefs::GetCfgInt(DR_CFG_FF_SEND_TRAFFIC_INTVL));
-                        }
-                    }
-                    else {
-                        // map's empty, so we are done
-                        lastKey = LTFlightData::FDKeyTy();
-                        nextTraffic = lastStartOfTraffic + std::chrono::seconds(DataRefs::GetCfgInt(DR_CFG_FF_SEND_TRAFFIC_INTVL));
+                // just starting with a new round? Collect all a/c to send
+                // (mapFd is unordered, so we can't just continue after the last key)
+                if (!bTrafficRound) {
+                    lastStartOfTraffic = now;
+                    vecTrafficKeys.clear();
+                    mapFd.ForEach([&vecTrafficKeys](const LTFlightData& fd)
+                                  { if (fd.hasAc()) vecTrafficKeys.push_back(fd.key()); });
+                    bTrafficRound = true;
+                }
+                
+                // next key to send? (shall still have an actual a/c)
+                // access to fdMap guarded by the segment's mutex
+                bool bSent = false;
+                while (!bSent && !vecTrafficKeys.empty()) {
+                    const LTFlightData::FDKeyTy key = std::move(vecTrafficKeys.back());
+                    vecTrafficKeys.pop_back();
+                    FDMapTy::LockTy lock = mapFd.Lock(key);
+                    const LTFlightData* pFd = mapFd.Find(key);
+                    if (pFd && pFd->hasAc()) {
+                        // send that plane's info
+                        SendTraffic(*pFd);
+                        bSent = true;
                     }
-                } else {
+                }
+                
+                // something sent?
+                if (bSent) {
                     // wake up soon again for the rest
                     nextTraffic = now + FF_INTVL;
                 }
+                else {
+                    // we're done with one round, start over
+                    bTrafficRound = false;
+                    nextTraffic = lastStartOfTraffic + std::chrono::seconds(DataRefs::GetCfgInt(DR_CFG_FF_SEND_TRAFFIC_INTVL));
+                }
             }
             
             // sleep until time or if woken up for termination
@@ -278,9 +277,7 @@ void ForeFlightSender::Main ()
                 bSendUsersPlane && !bSendAITraffic ? std::min({nextListen, nextGPS, nextAtt}) :
                                                      std::min(nextListen, nextTraffic);
                 
-                std::unique_lock<std::mutex> lk(FDThreadSynchMutex);
-                FDThreadSynchCV.wait_until(lk, nextWakeup,
-                                           [this]{return !shallRun();});
+                wakeup.WaitUntil(nextWakeup, [this]{return !shallRun();});
             }
         }
         
@@ -303,23 +300,16 @@ void ForeFlightSender::Main ()
 // Send all traffic aircraft's data
 void ForeFlightSender::SendAllTraffic ()
 {
-    // from here on access to fdMap guarded by a mutex
-    // until FD object is inserted and updated
-    std::lock_guard<std::mutex> mapFdLock (mapFdMutex);
-    
-    // loop over all flight data objects
-    for (const std::pair<const LTFlightData::FDKeyTy,LTFlightData>& fdPair: mapFd)
+    // loop over all flight data objects,
+    // locking one segment of mapFd at a time
+    mapFd.ForEach([this](const LTFlightData& fd)
     {
-        // get the fd object from the map, key is the transpIcao
-        // this fetches an existing or, if not existing, creates a new one
-        const LTFlightData& fd = fdPair.second;
-        
         // also get the data access lock for consistent data
         std::lock_guard<std::recursive_mutex> fdLock (fd.dataAccessMutex);
         
         // Send traffic data for this object
         SendTraffic(fd);
-    }
+    });
 }
 
 // MARK: Format broadcasts
@@ -663,6 +663,19 @@ LTImgWindow::~LTImgWindow()
     flChangeWndMode = nullptr;
 }
 
+// Starts timing the window's building and rendering
+ImGuiWindowFlags_ LTImgWindow::beforeBegin()
+{
+    tDrawStart = std::chrono::steady_clock::now();
+    return ImgWindow::beforeBegin();
+}
+
+// Records the window's building and rendering time with the frame-time governor
+void LTImgWindow::afterRendering()
+{
+    GovRecord(std::chrono::steady_clock::now() - tDrawStart);
+}
+
 
 
 /// Set the window mode, move the window if needed
@@ -0,0 +1,242 @@
+/// @file       LTKalman.cpp
+/// @brief      State estimator for dead-reckoning aircraft when live data is late
+/// @details    Implements the constant-turn-rate Kalman filter.
+/// @see        LTKalman.h
+/// @author     Birger Hoppe
+/// @copyright  (c) 2024 Birger Hoppe
+/// @copyright  Permission is hereby granted, free of charge, to any person obtaining a
+///             copy of this software and associated documentation files (the "Software"),
+///             to deal in the Software without restriction, including without limitation
+///             the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the
+///             Software is furnished to do so, subject to the following conditions:\n
+///             The above copyright notice and this permission notice shall be included in
+///             all copies or substantial portions of the Software.\n
+///             THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///             IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///             FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///             AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///             LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///             OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+///             THE SOFTWARE.
+
+#include "LiveTraffic.h"
+
+//
+// MARK: Helpers
+//
+
+/// @brief Apply one scalar measurement of state element `i`
+/// @param s State
+/// @param P Covariance
+/// @param i Index of the measured state element
+/// @param y Innovation, i.e. measurement minus state
+/// @param var Variance of the measurement
+template <int N>
+static void ScalarUpdate (double (&s)[N], double (&P)[N][N], int i, double y, double var)
+{
+    const double S = P[i][i] + var;
+    if (S <= 0.0) return;
+    double K[N];
+    double Pi[N];                       // copy of row i, as P changes while we go
+    for (int k = 0; k < N; ++k) {
+        K[k] = P[k][i] / S;
+        Pi[k] = P[i][k];
+    }
+    for (int k = 0; k < N; ++k) {
+        s[k] += K[k] * y;
+        for (int l = 0; l < N; ++l)
+            P[k][l] -= K[k] * Pi[l];
+    }
+}
+
+/// Normalize an angle in radians to [0..2π)
+static double RadNormalize (double a)
+{
+    a = std::fmod(a, 2.0 * PI);
+    return a < 0.0 ? a + 2.0 * PI : a;
+}
+
+//
+// MARK: LTCtrKalmanTy
+//
+
+// Apply a set of measurements
+void LTCtrKalmanTy::Update (const MeasTy& m)
+{
+    if (std::isnan(m.ts) || std::isnan(m.lat) || std::isnan(m.lon))
+        return;
+
+    // First measurement, or live data paused for long? Then (re)start
+    if (!IsInit() || m.ts - ts > FD_KF_RESET_GAP) {
+        Init(m);
+        return;
+    }
+    // Only newer data moves the state
+    const double dt = m.ts - ts;
+    if (dt <= 0.0)
+        return;
+    TimeUpdate(dt);
+    ts = m.ts;
+
+    // Moved far from the reference point? Then move the reference point,
+    // so that the flat-earth approximation stays accurate
+    if (std::abs(x[X_E]) > FD_KF_REBASE_DIST || std::abs(x[X_N]) > FD_KF_REBASE_DIST) {
+        double lat = NAN, lon = NAN;
+        ToLatLon(x[X_E], x[X_N], lat, lon);
+        lat0 = lat;
+        lon0 = lon;
+        x[X_E] = x[X_N] = 0.0;
+    }
+
+    // Horizontal measurements (longitude difference wrapped, in case we crossed the antimeridian)
+    double dLon = m.lon - lon0;
+    if (dLon >= 180.0)      dLon -= 360.0;
+    else if (dLon < -180.0) dLon += 360.0;
+    ScalarUpdate(x, P, X_E, Lon2Dist(dLon, lat0) - x[X_E], sqr(FD_KF_SD_POS));
+    ScalarUpdate(x, P, X_N, Lat2Dist(m.lat - lat0)       - x[X_N], sqr(FD_KF_SD_POS));
+    if (m.spd_m_s > 0.0)
+        ScalarUpdate(x, P, X_V, m.spd_m_s - x[X_V], sqr(FD_KF_SD_SPD));
+    if (!std::isnan(m.track))
+        ScalarUpdate(x, P, X_PSI,
+                     std::remainder(deg2rad(m.track) - x[X_PSI], 2.0 * PI),
+                     sqr(deg2rad(FD_KF_SD_TRACK)));
+    if (!std::isnan(m.turnRate))
+        ScalarUpdate(x, P, X_OMEGA, deg2rad(m.turnRate) - x[X_OMEGA], sqr(deg2rad(FD_KF_SD_TURN)));
+    x[X_PSI] = RadNormalize(x[X_PSI]);
+    const double maxTurn = deg2rad(FD_KF_MAX_TURN);
+    x[X_OMEGA] = std::clamp(x[X_OMEGA], -maxTurn, maxTurn);
+
+    // Vertical measurements
+    if (!std::isnan(m.alt_m))
+        ScalarUpdate(z, Pz, Z_ALT, m.alt_m - z[Z_ALT], sqr(FD_KF_SD_ALT));
+    if (!std::isnan(m.vsi_m_s))
+        ScalarUpdate(z, Pz, Z_VSI, m.vsi_m_s - z[Z_VSI], sqr(FD_KF_SD_VSI));
+}
+
+// Predict the state at time `t`
+LTCtrKalmanTy::PredTy LTCtrKalmanTy::Predict (double t) const
+{
+    PredTy pr;
+    if (!IsInit())
+        return pr;
+    const double dt = t - ts;
+    double s[NX];
+    std::copy(std::begin(x), std::end(x), std::begin(s));
+    Propagate(s, dt);
+    ToLatLon(s[X_E], s[X_N], pr.lat, pr.lon);
+    pr.alt_m    = z[Z_ALT] + z[Z_VSI] * dt;
+    pr.spd_m_s  = s[X_V];
+    pr.track    = rad2deg(RadNormalize(s[X_PSI]));
+    pr.vsi_m_s  = z[Z_VSI];
+    return pr;
+}
+
+// Initialize state from the first measurement
+void LTCtrKalmanTy::Init (const MeasTy& m)
+{
+    lat0 = m.lat;
+    lon0 = m.lon;
+    ts   = m.ts;
+
+    // What isn't measured starts at zero with a large uncertainty
+    const bool bSpd  = m.spd_m_s > 0.0;
+    const bool bTrk  = !std::isnan(m.track);
+    const bool bTurn = !std::isnan(m.turnRate);
+    x[X_E]     = 0.0;
+    x[X_N]     = 0.0;
+    x[X_V]     = bSpd  ? m.spd_m_s : 0.0;
+    x[X_PSI]   = bTrk  ? RadNormalize(deg2rad(m.track)) : 0.0;
+    x[X_OMEGA] = bTurn ? deg2rad(m.turnRate) : 0.0;
+    for (auto& row: P)
+        std::fill(std::begin(row), std::end(row), 0.0);
+    P[X_E][X_E]         = sqr(FD_KF_SD_POS);
+    P[X_N][X_N]         = sqr(FD_KF_SD_POS);
+    P[X_V][X_V]         = bSpd  ? sqr(FD_KF_SD_SPD) : sqr(100.0);
+    P[X_PSI][X_PSI]     = bTrk  ? sqr(deg2rad(FD_KF_SD_TRACK)) : sqr(PI);
+    P[X_OMEGA][X_OMEGA] = bTurn ? sqr(deg2rad(FD_KF_SD_TURN)) : sqr(deg2rad(FD_KF_MAX_TURN));
+
+    z[Z_ALT] = std::isnan(m.alt_m)   ? 0.0 : m.alt_m;
+    z[Z_VSI] = std::isnan(m.vsi_m_s) ? 0.0 : m.vsi_m_s;
+    Pz[Z_ALT][Z_ALT] = std::isnan(m.alt_m)   ? sqr(10000.0) : sqr(FD_KF_SD_ALT);
+    Pz[Z_VSI][Z_VSI] = std::isnan(m.vsi_m_s) ? sqr(20.0)    : sqr(FD_KF_SD_VSI);
+    Pz[Z_ALT][Z_VSI] = Pz[Z_VSI][Z_ALT] = 0.0;
+}
+
+// Move the state (and covariance) forward by `dt` seconds
+void LTCtrKalmanTy::TimeUpdate (double dt)
+{
+    // Jacobian of the motion model by finite differences
+    static constexpr double H[NX] = { 1.0, 1.0, 0.1, 1e-4, 1e-5 };
+    double s0[NX];
+    std::copy(std::begin(x), std::end(x), std::begin(s0));
+    Propagate(s0, dt);
+    double F[NX][NX];
+    for (int j = 0; j < NX; ++j) {
+        double s[NX];
+        std::copy(std::begin(x), std::end(x), std::begin(s));
+        s[j] += H[j];
+        Propagate(s, dt);
+        for (int i = 0; i < NX; ++i)
+            F[i][j] = (i == X_PSI ? std::remainder(s[i] - s0[i], 2.0 * PI) : s[i] - s0[i]) / H[j];
+    }
+    std::copy(std::begin(s0), std::end(s0), std::begin(x));
+    x[X_PSI] = RadNormalize(x[X_PSI]);
+
+    // P = F P F' + Q
+    double FP[NX][NX];
+    for (int i = 0; i < NX; ++i)
+        for (int j = 0; j < NX; ++j) {
+            FP[i][j] = 0.0;
+            for (int k = 0; k < NX; ++k)
+                FP[i][j] += F[i][k] * P[k][j];
+        }
+    for (int i = 0; i < NX; ++i)
+        for (int j = 0; j < NX; ++j) {
+            P[i][j] = 0.0;
+            for (int k = 0; k < NX; ++k)
+                P[i][j] += FP[i][k] * F[j][k];
+        }
+    // Process noise: unknown acceleration and turn acceleration
+    const double acc  = FD_KF_ACC;
+    const double tacc = deg2rad(FD_KF_TURN_ACC);
+    P[X_E][X_E]         += sqr(0.5 * acc * dt * dt);
+    P[X_N][X_N]         += sqr(0.5 * acc * dt * dt);
+    P[X_V][X_V]         += sqr(acc * dt);
+    P[X_PSI][X_PSI]     += sqr(0.5 * tacc * dt * dt);
+    P[X_OMEGA][X_OMEGA] += sqr(tacc * dt);
+
+    // Vertical: constant vertical speed
+    z[Z_ALT] += z[Z_VSI] * dt;
+    const double p00 = Pz[Z_ALT][Z_ALT] + dt * (Pz[Z_VSI][Z_ALT] + Pz[Z_ALT][Z_VSI]) + dt * dt * Pz[Z_VSI][Z_VSI];
+    const double p01 = Pz[Z_ALT][Z_VSI] + dt * Pz[Z_VSI][Z_VSI];
+    Pz[Z_ALT][Z_ALT] = p00 + sqr(0.5 * FD_KF_VACC * dt * dt);
+    Pz[Z_ALT][Z_VSI] = Pz[Z_VSI][Z_ALT] = p01;
+    Pz[Z_VSI][Z_VSI] += sqr(FD_KF_VACC * dt);
+}
+
+// Constant-turn-rate motion model
+void LTCtrKalmanTy::Propagate (double (&s)[NX], double dt)
+{
+    const double v   = s[X_V];
+    const double psi = s[X_PSI];
+    const double om  = s[X_OMEGA];
+    // Track is clockwise from north: east is sin, north is cos
+    if (std::abs(om) > 1e-6) {
+        s[X_E] += v / om * (std::cos(psi) - std::cos(psi + om * dt));
+        s[X_N] += v / om * (std::sin(psi + om * dt) - std::sin(psi));
+    } else {
+        s[X_E] += v * dt * std::sin(psi);
+        s[X_N] += v * dt * std::cos(psi);
+    }
+    s[X_PSI] = psi + om * dt;
+}
+
+// Convert east/north offsets to latitude/longitude
+void LTCtrKalmanTy::ToLatLon (double e, double n, double& lat, double& lon) const
+{
+    lat = lat0 + Dist2Lat(n);
+    lon = lon0 + Dist2Lon(e, lat0);
+    if (lon >  180.0) lon -= 360.0;
+    if (lon < -180.0) lon += 360.0;
+}
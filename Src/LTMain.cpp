@@ -594,6 +594,9 @@ std::string Cleartext (const std::string& _obfuscated)
 // MARK: Time Functions
 //
 
+// Replacement of the system clock, only set by headless tools
+double (*gpfnSysTime)() = nullptr;
+
 // returns offset to UTC in seconds
 /// @see https://stackoverflow.com/questions/13804095/get-the-time-zone-gmt-offset-in-c
 int timeOffsetUTC()
@@ -827,6 +830,162 @@ bool dequal ( const double d1, const double d2 )
     ((d1 + epsilon) > d2);
 }
 
+//
+// MARK: Stress Mode
+//
+
+/// Names of the stages as used in the log
+static const char* STRESS_STAGE_NAMES[STS_CNT] = {
+    "ChnProcess",
+    "AppendNewPos",
+    "CalcNextPos",
+    "AcUpdate",
+    "AcMaint",
+    "AptRefresh",
+};
+
+/// Timings collected per stage, written from any thread
+struct StressStageValTy {
+    std::atomic<unsigned long long> cnt     {0};    ///< number of executions
+    std::atomic<unsigned long long> sum_ns  {0};    ///< [ns] total duration
+    std::atomic<unsigned long long> max_ns  {0};    ///< [ns] longest execution
+};
+static StressStageValTy gStressVals[STS_CNT];
+
+// Record one execution of a stage, thread-safe and lock-free
+void StressRecord (StressStageTy eStage, std::chrono::steady_clock::duration d)
+{
+    const unsigned long long ns = (unsigned long long)
+    std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    StressStageValTy& val = gStressVals[eStage];
+    val.cnt.fetch_add(1, std::memory_order_relaxed);
+    val.sum_ns.fetch_add(ns, std::memory_order_relaxed);
+    unsigned long long prevMax = val.max_ns.load(std::memory_order_relaxed);
+    while (ns > prevMax &&
+           !val.max_ns.compare_exchange_weak(prevMax, ns, std::memory_order_relaxed));
+}
+
+// In stress mode, logs the stage timings collected during the last STRESS_LOG_INTVL seconds
+void StressLogTimings ()
+{
+    static float lastLog = 0.0f;
+    if (!dataRefs.GetDebugStressMode()) {
+        lastLog = 0.0f;
+        return;
+    }
+    
+    // The first call after activation just starts a clean measurement period
+    const bool bFirst = lastLog < 0.00001f;
+    if (!CheckEverySoOften(lastLog, STRESS_LOG_INTVL))
+        return;
+    
+    const LTFlightData::CalcQueueStatsTy qs = LTFlightData::GetCalcQueueStats(true);
+    if (!bFirst)
+        LOG_MSG(logINFO, MSG_STRESS_QUEUE, dataRefs.GetNumAc(),
+                (unsigned long)qs.len, qs.cnt, qs.avgWait_ms, qs.maxWait_ms);
+    const LTFlightData::LabelStatsTy ls = LTFlightData::GetLabelStats(true);
+    if (!bFirst)
+        LOG_MSG(logINFO, MSG_STRESS_LABELS, ls.nRebuilt, ls.nSkipped);
+    for (unsigned i = 0; i < STS_CNT; ++i) {
+        StressStageValTy& val = gStressVals[i];
+        const unsigned long long cnt    = val.cnt.exchange(0);
+        const unsigned long long sum_ns = val.sum_ns.exchange(0);
+        const unsigned long long max_ns = val.max_ns.exchange(0);
+        if (!bFirst && cnt > 0)
+            LOG_MSG(logINFO, MSG_STRESS_STAGE, STRESS_STAGE_NAMES[i], cnt,
+                    double(sum_ns) / double(cnt) / 1e6,
+                    double(max_ns) / 1e6,
+                    double(sum_ns) / 1e6);
+    }
+}
+
+//
+// MARK: Frame-Time Governor
+//
+
+static std::chrono::steady_clock::duration gGovTime {0};   ///< main thread time spent in LiveTraffic since last evaluation
+static int gGovTimerDepth = 0;                              ///< nesting depth of GovTimer objects
+
+// Add main thread time spent in LiveTraffic, to be evaluated by GovEvaluate()
+void GovRecord (std::chrono::steady_clock::duration d)
+{
+    gGovTime += d;
+}
+
+// Starts timing if outermost timer
+GovTimer::GovTimer () :
+bOuter(gGovTimerDepth++ == 0)
+{
+    if (bOuter) tStart = std::chrono::steady_clock::now();
+}
+
+// Records the duration if outermost timer
+GovTimer::~GovTimer ()
+{
+    if (bOuter) GovRecord(std::chrono::steady_clock::now() - tStart);
+    --gGovTimerDepth;
+}
+
+// Every GOV_EVAL_INTVL: determine time per frame, and adjust the governor's level
+void GovEvaluate ()
+{
+    static float lastEval = 0.0f;
+    static int lastCycle = 0;
+    static int nOver = 0;                   // consecutive evaluations over budget
+    static int nUnder = 0;                  // consecutive evaluations well below budget
+    if (!CheckEverySoOften(lastEval, GOV_EVAL_INTVL))
+        return;
+
+    // Main thread time per frame since last evaluation
+    const int cycle = XPLMGetCycleNumber();
+    const int nFrames = cycle - lastCycle;
+    lastCycle = cycle;
+    const std::chrono::steady_clock::duration d = gGovTime;
+    gGovTime = std::chrono::steady_clock::duration::zero();
+    if (nFrames <= 0)
+        return;
+    const double ms = std::chrono::duration<double,std::milli>(d).count() / double(nFrames);
+    dataRefs.SetGovFrameTime_us(int(std::lround(ms * 1000.0)));
+
+    // Governor switched off? Then restore all limits
+    const int budget = dataRefs.GetFrameBudget_ms();
+    int lvl = dataRefs.GetGovLevel();
+    if (budget <= 0) {
+        nOver = nUnder = 0;
+        if (lvl > 0) {
+            dataRefs.SetGovLevel(0);
+            LOG_MSG(logINFO, MSG_GOV_OFF);
+        }
+        return;
+    }
+
+    // Over budget for a while: reduce further
+    if (ms > double(budget)) {
+        nUnder = 0;
+        if (++nOver >= GOV_HOLD_UP && lvl < GOV_MAX_LEVEL) {
+            ++lvl;
+            nOver = 0;
+        }
+    }
+    // Well below budget for a while: relax
+    else if (ms < double(budget) * GOV_RELAX_F) {
+        nOver = 0;
+        if (++nUnder >= GOV_HOLD_DOWN && lvl > 0) {
+            --lvl;
+            nUnder = 0;
+        }
+    }
+    // in between: keep level
+    else
+        nOver = nUnder = 0;
+
+    if (lvl != dataRefs.GetGovLevel()) {
+        dataRefs.SetGovLevel(lvl);
+        LOG_MSG(logINFO, MSG_GOV_LEVEL, ms, budget, lvl, GOV_MAX_LEVEL,
+                dataRefs.GetEffMaxNumAc(), int(std::lround(dataRefs.GetGovFactor() * 100.0)));
+    }
+}
+
 //
 // MARK: Thread Handling
 //
@@ -902,7 +1061,13 @@ void LTRegularUpdates()
     CheckThenShowMsgWindow();
 
     // handle new network data (that func has a short-cut exit if nothing to do)
-    LTFlightData::AppendAllNewPos();
+    {
+        StressTimer st(STS_APPEND_NEW_POS);
+        LTFlightData::AppendAllNewPos();
+    }
+
+    // Frame-time governor: evaluate time spent per frame
+    GovEvaluate();
 
     // Flush out all non-written log messages
     FlushMsg();
@@ -913,6 +1078,7 @@ void LTRegularUpdates()
 // creates/destroys aircraft by looping the flight data map
 float LoopCBAircraftMaintenance (float inElapsedSinceLastCall, float, int, void*)
 {
+    GovTimer gt;
     static float elapsedSinceLastAcMaint = 0.0f;
     do {
         // *** check for new positons that require terrain altitude (Y Probes) ***
@@ -921,6 +1087,12 @@ float LoopCBAircraftMaintenance (float inElapsedSinceLastCall, float, int, void*
             // regular calls collected here
             LTRegularUpdates();
             
+            // next slice of aircraft maintenance (add/remove)
+            {
+                StressTimer st(STS_AC_MAINT);
+                LTFlightDataAcMaintenanceSlice();
+            }
+            
             // all the rest we do only every 2s
             elapsedSinceLastAcMaint += inElapsedSinceLastCall;
             if (elapsedSinceLastAcMaint < AC_MAINT_INTVL)
@@ -965,9 +1137,17 @@ float LoopCBAircraftMaintenance (float inElapsedSinceLastCall, float, int, void*
             // Potentially refresh weather information
             dataRefs.WeatherUpdate();
             // Refresh airport data from apt.dat (in case camera moved far)
-            LTAptRefresh();
-            // maintenance (add/remove)
-            LTFlightDataAcMaintenance();
+            {
+                StressTimer st(STS_APT_REFRESH);
+                LTAptRefresh();
+            }
+            // start a new round of maintenance (add/remove)
+            {
+                StressTimer st(STS_AC_MAINT);
+                LTFlightDataAcMaintenance();
+            }
+            // in stress mode: log stage timings every so often
+            StressLogTimings();
             // updates to menu item status
             MenuUpdateAllItemStatus();
             // Purge messages kept in local storage for display
@@ -45,7 +45,7 @@
 #endif
 
 /// Reference to the global map of flight data
-extern mapLTFlightDataTy mapFd;
+extern FDMapTy mapFd;
 
 //
 // MARK: OGNAnonymousIdMapTy
@@ -218,9 +218,7 @@ void OpenGliderConnection::RRMain ()
             // sleep for FD_REFRESH_INTVL or if woken up for termination
             // by condition variable trigger
             {
-                std::unique_lock<std::mutex> lk(FDThreadSynchMutex);
-                FDThreadSynchCV.wait_until(lk, tNextWakeup,
-                                           [this]{return !shallRun();});
+                wakeup.WaitUntil(tNextWakeup, [this]{return !shallRun();});
             }
             
         } catch (const std::exception& e) {
@@ -318,7 +316,7 @@ bool OpenGliderConnection::ProcessFetchedData ()
         try {
             // from here on access to fdMap guarded by a mutex
             // until FD object is inserted and updated
-            std::unique_lock<std::mutex> mapFdLock (mapFdMutex);
+            FDMapTy::LockTy mapFdLock = mapFd.Lock(fdKey);
             
             // get the fd object from the map
             // this fetches an existing or, if not existing, creates a new one
@@ -677,7 +675,7 @@ bool OpenGliderConnection::APRSProcessLine (const std::string& ln)
     try {
         // from here on access to fdMap guarded by a mutex
         // until FD object is inserted and updated
-        std::unique_lock<std::mutex> mapFdLock (mapFdMutex);
+        FDMapTy::LockTy mapFdLock = mapFd.Lock(fdKey);
         
         // get the fd object from the map
         // this fetches an existing or, if not existing, creates a new one
@@ -975,7 +973,7 @@ bool OpenGliderConnection::AcListLookup (const std::string& sDevId,
                        &rec, sizeof(rec)))
     {
         // copy some information into the stat structure
-        if (*rec.mdl != ' ') { stat.mdl.assign(rec.mdl,sizeof(rec.mdl)); rtrim(stat.mdl); }
+        if (*rec.mdl != ' ') { std::string s(rec.mdl,sizeof(rec.mdl)); stat.mdl = rtrim(s); }
         if (*rec.reg != ' ') { stat.reg.assign(rec.reg,sizeof(rec.reg)); rtrim(stat.reg); }
         if (*rec.cn  != ' ') { stat.call.assign(rec.cn,sizeof(rec.cn));  rtrim(stat.call); }
         
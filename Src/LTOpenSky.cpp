@@ -78,9 +78,7 @@ void OpenSkyConnection::Main ()
             // sleep for FD_REFRESH_INTVL or if woken up for termination
             // by condition variable trigger
             {
-                std::unique_lock<std::mutex> lk(FDThreadSynchMutex);
-                FDThreadSynchCV.wait_until(lk, tNextWakeup,
-                                           [this]{return !shallRun();});
+                wakeup.WaitUntil(tNextWakeup, [this]{return !shallRun();});
             }
             
         } catch (const std::exception& e) {
@@ -119,7 +117,7 @@ bool OpenSkyConnection::InitCurl ()
 }
 
 // read header and parse for request remaining
-size_t OpenSkyConnection::ReceiveHeader(char *buffer, size_t size, size_t nitems, void *)
+size_t OpenSkyConnection::ReceiveHeader(char *buffer, size_t size, size_t nitems, void *userdata)
 {
     const size_t len = nitems * size;
     static size_t lenRRemain = strlen(OPSKY_RREMAIN);
@@ -162,15 +160,16 @@ size_t OpenSkyConnection::ReceiveHeader(char *buffer, size_t size, size_t nitems
         dataRefs.OpenSkyRRemain = 0;
     }
 
-    // always say we processed everything, otherwise HTTP processing would stop!
-    return len;
+    // let the base class look for validators, it always says we processed everything
+    return LTOnlineChannel::ReceiveHeader(buffer, size, nitems, userdata);
 }
 
 // put together the URL to fetch based on current view position
 std::string OpenSkyConnection::GetURL (const positionTy& pos)
 {
     // we add 10% to the bounding box to have some data ready once the plane is close enough for display
-    boundingBoxTy box (pos, double(dataRefs.GetFdStdDistance_m()) * 1.10);
+    const RequAreaTy& area = PlanRequestArea(pos, double(dataRefs.GetFdStdDistance_m()) * 1.10);
+    boundingBoxTy box (area.center, area.extent_m);
     char url[128] = "";
     snprintf(url, sizeof(url),
              OPSKY_URL_ALL,
@@ -191,7 +190,7 @@ bool OpenSkyConnection::ProcessFetchedData ()
     std::string acFilter ( dataRefs.GetDebugAcFilter() );
     
     // data is expected to be in netData string
-    // short-cut if there is nothing
+    // short-cut if there is nothing (also after HTTP_NOT_MODIFIED)
     if ( !netDataPos ) return true;
     
     // Only proceed in case HTTP response was OK
@@ -297,7 +296,7 @@ bool OpenSkyConnection::ProcessFetchedData ()
         try {
             // from here on access to fdMap guarded by a mutex
             // until FD object is inserted and updated
-            std::unique_lock<std::mutex> mapFdLock (mapFdMutex);
+            FDMapTy::LockTy mapFdLock = mapFd.Lock(fdKey);
             
             // Check for duplicates with OGN/FLARM, potentially replaces the key type
             LTFlightData::CheckDupKey(fdKey, LTFlightData::KEY_FLARM);
@@ -450,9 +449,7 @@ void OpenSkyAcMasterdata::Main ()
             // sleep a bit or until woken up for termination by condition variable trigger
             if (!HaveAnyRequest())
             {
-                std::unique_lock<std::mutex> lk(FDThreadSynchMutex);
-                FDThreadSynchCV.wait_for(lk, OPSKY_WAIT_NOQUEUE,
-                                         [this]{return !shallRun() || HaveAnyRequest();});
+                wakeup.WaitFor(OPSKY_WAIT_NOQUEUE, [this]{return !shallRun() || HaveAnyRequest();});
             }
             
             // Every 3s clear up outdated requests waiting in queue
@@ -470,9 +467,10 @@ void OpenSkyAcMasterdata::Main ()
     
     // Before leaving clear the request queue
     std::unique_lock<std::recursive_mutex> lock (mtxMaster);
-    if (bFDMainStop)                        // in case of all stopping just throw them away
-        setAcStatRequ.clear();
-    else
+    if (bFDMainStop) {                      // in case of all stopping just throw them away
+        queAcStatRequ.clear();
+        UpdRequCount();
+    } else
         MaintainMasterDataRequests();       // otherwise clear up and pass on
     UnregisterMasterDataChn(this);          // Unregister myself as a master data channel
 }
@@ -664,9 +662,7 @@ void OpenSkyAcMasterFile::Main ()
             // by condition variable trigger
             if (!HaveAnyRequest())
             {
-                std::unique_lock<std::mutex> lk(FDThreadSynchMutex);
-                FDThreadSynchCV.wait_for(lk,OPSKY_WAIT_NOQUEUE,
-                                         [this]{return !shallRun() || HaveAnyRequest();});
+                wakeup.WaitFor(OPSKY_WAIT_NOQUEUE, [this]{return !shallRun() || HaveAnyRequest();});
             }
             
             // Every 3s clear up outdated requests waiting in queue
@@ -684,9 +680,10 @@ void OpenSkyAcMasterFile::Main ()
     
     // Before leaving clear the request queue
     std::unique_lock<std::recursive_mutex> lock (mtxMaster);
-    if (bFDMainStop)                        // in case of all stopping just throw them away
-        setAcStatRequ.clear();
-    else
+    if (bFDMainStop) {                      // in case of all stopping just throw them away
+        queAcStatRequ.clear();
+        UpdRequCount();
+    } else
         MaintainMasterDataRequests();       // otherwise clear up and pass on
     UnregisterMasterDataChn(this);          // Unregister myself as a master data channel
 }
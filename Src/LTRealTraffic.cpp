@@ -214,9 +214,7 @@ void RealTrafficConnection::MainDirect ()
             // by condition variable trigger
             {
                 tNextWakeup = std::chrono::steady_clock::now() + rrlWait;
-                std::unique_lock<std::mutex> lk(FDThreadSynchMutex);
-                FDThreadSynchCV.wait_until(lk, tNextWakeup,
-                                           [this]{return !shallRun();});
+                wakeup.WaitUntil(tNextWakeup, [this]{return !shallRun();});
             }
             
         } catch (const std::exception& e) {
@@ -657,6 +655,9 @@ bool RealTrafficConnection::ProcessFetchedData ()
                                                        { RT_DRCT_BaroVertRate,
                                                          RT_DRCT_GeoVertRate });
         dyn.vsi = pVal ? json_value_get_number(pVal) : 0.0;
+        // Turn rate, if available
+        pVal                    = jag_FindFirstNonNull(pJAc, { RT_DRCT_TurnRate });
+        dyn.turnRate = pVal ? json_value_get_number(pVal) : NAN;
         
         dyn.ts = pos.ts();
         dyn.pChannel = this;
@@ -664,7 +665,7 @@ bool RealTrafficConnection::ProcessFetchedData ()
         try {
             // from here on access to fdMap guarded by a mutex
             // until FD object is inserted and updated
-            std::unique_lock<std::mutex> mapFdLock (mapFdMutex);
+            FDMapTy::LockTy mapFdLock = mapFd.Lock(fdKey);
 
             // get the fd object from the map, key is the transpIcao
             // this fetches an existing or, if not existing, creates a new one
@@ -772,6 +773,7 @@ void RealTrafficConnection::MainUDP ()
                     SetStatusUdp(true, false);
 
                     // have it processed
+                    StressTimer st(STS_CHN_PROCESS);
                     ProcessRecvedTrafficData(udpTrafficData.getBuf());
                 }
                 else
@@ -1280,7 +1282,7 @@ bool RealTrafficConnection::ProcessRTTFC (LTFlightData::FDKeyTy& fdKey,
     try {
         // from here on access to fdMap guarded by a mutex
         // until FD object is inserted and updated
-        std::unique_lock<std::mutex> mapFdLock (mapFdMutex);
+        FDMapTy::LockTy mapFdLock = mapFd.Lock(fdKey);
         
         // There's a flag telling us if a key is an ICAO code
         if (tfc[RT_RTTFC_ISICAOHEX] != "1")
@@ -1438,7 +1440,7 @@ bool RealTrafficConnection::ProcessAITFC (LTFlightData::FDKeyTy& fdKey,
     try {
         // from here on access to fdMap guarded by a mutex
         // until FD object is inserted and updated
-        std::unique_lock<std::mutex> mapFdLock (mapFdMutex);
+        FDMapTy::LockTy mapFdLock = mapFd.Lock(fdKey);
         
         // Check for duplicates with OGN/FLARM, potentially replaces the key type
         if (fdKey.eKeyType == LTFlightData::KEY_ICAO)
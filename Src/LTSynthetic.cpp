@@ -75,9 +75,7 @@ void SyntheticConnection::Main ()
             // sleep for FD_REFRESH_INTVL or if woken up for termination
             // by condition variable trigger
             {
-                std::unique_lock<std::mutex> lk(FDThreadSynchMutex);
-                FDThreadSynchCV.wait_until(lk, tNextWakeup,
-                                           [this]{return !shallRun();});
+                wakeup.WaitUntil(tNextWakeup, [this]{return !shallRun();});
             }
             
         } catch (const std::exception& e) {
@@ -99,12 +97,10 @@ bool SyntheticConnection::FetchAllData(const positionTy&)
     // - 'Parked' aircraft are in our repository
     // - Not 'Parked' aircraft are not or no longer
     
-    // Lock to acces mapFD
-    std::lock_guard<std::mutex> lock (mapFdMutex);
-    // Loop over all known flight data
-    for (const auto& p: mapFd) {
-        const LTFlightData::FDKeyTy& key = p.first;
-        const LTFlightData& fd = p.second;
+    // Loop over all known flight data, locking one segment of mapFd at a time
+    mapFd.ForEach([this](const LTFlightData& fd)
+    {
+        const LTFlightData::FDKeyTy& key = fd.key();
         std::lock_guard<std::recursive_mutex> fdLock (fd.dataAccessMutex);
         if (fd.hasAc()) {
             const LTAircraft& ac = *fd.GetAircraft();
@@ -121,7 +117,7 @@ bool SyntheticConnection::FetchAllData(const positionTy&)
             }
             else {
                 // this a/c is _not_ or no longer parked, so we should forget about it in our stored data
-                mapSynData.erase(p.first);
+                mapSynData.erase(key);
                 
                 // next test if the aircraft came too close to any of ours on the ground
                 if (ac.IsOnGrnd() && !ac.IsGroundVehicle()) {
@@ -137,7 +133,7 @@ bool SyntheticConnection::FetchAllData(const positionTy&)
                 }
             }
         }
-    }
+    });
     return true;
 }
 
@@ -157,9 +153,9 @@ bool SyntheticConnection::ProcessFetchedData ()
         SynDataTy& parkDat = i->second;
 
         // Find the related flight data
-        std::unique_lock<std::mutex> mapLock (mapFdMutex);      // lock the entire map
+        FDMapTy::LockTy mapLock = mapFd.Lock(key);              // lock the key's segment of the map
         LTFlightData& fd = mapFd[key];                          // fetch or create flight data
-        mapLock.unlock();                                       // release the map lock
+        mapLock.unlock();                                       // release the segment lock
 
         // Haven't yet looked up startup position's heading?
         if (std::isnan(parkDat.pos.heading())) {
@@ -96,6 +96,9 @@ LTSettingsUI::~LTSettingsUI()
 // Some setup before UI building starts, here text size calculations
 ImGuiWindowFlags_ LTSettingsUI::beforeBegin()
 {
+    // Parent class starts timing for the frame-time governor
+    LTImgWindow::beforeBegin();
+    
     // If not yet done calculate some common widths
     if (std::isnan(SUI_LABEL_SIZE)) {
         /// Size of longest text plus some room for tree indenttion, rounded up to the next 10
@@ -955,11 +958,24 @@ void LTSettingsUI::buildInterface()
                 ImGui::FilteredCfgNumber("Above height AGL of",    sFilter, DR_CFG_FD_REDUCE_HEIGHT,    1000, 100000, 1000, "%d ft");
                 ImGui::FilteredCfgNumber("increase refresh to",    sFilter, DR_CFG_FD_LONG_REFRESH_INTVL, 10, 180, 5, "%d s");
                 ImGui::FilteredCfgNumber("Buffering period",       sFilter, DR_CFG_FD_BUF_PERIOD,    10, 180, 5, "%d s");
+                ImGui::FilteredCfgNumber("Full area every n-th",   sFilter, DR_CFG_FD_FULL_AREA_EVERY, 1, 10, 1, "%d. request");
+                ImGui::FilteredCfgCheckbox("Dead-reckon late data", sFilter, DR_CFG_FD_PREDICT,
+                                           "Keeps aircraft flying along their estimated\ntrack and turn when live data is late");
                 ImGui::FilteredCfgNumber("Network timeout",        sFilter, DR_CFG_MAX_NETW_TIMEOUT,  5, 180, 5, "%d s");
 
                 if (!*sFilter) ImGui::TreePop();
             }
 
+            if (ImGui::TreeNodeHelp("Level of Detail", nCol, nullptr, nullptr, sFilter, nOpCl,
+                                    ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_SpanFullWidth))
+            {
+                ImGui::FilteredCfgNumber("Full detail closer than", sFilter, DR_CFG_LOD_NEAR_DIST,   1, 100, 1, "%d nm");
+                ImGui::FilteredCfgNumber("Least detail beyond",    sFilter, DR_CFG_LOD_FAR_DIST,    1, 100, 1, "%d nm");
+                ImGui::FilteredCfgNumber("Frame time budget",      sFilter, DR_CFG_FRAME_BUDGET,    0,  50, 1, "%d ms");
+
+                if (!*sFilter) ImGui::TreePop();
+            }
+
             if (ImGui::TreeNodeHelp("Contrails", nCol, nullptr, nullptr, sFilter, nOpCl,
                                     ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_SpanFullWidth))
             {
@@ -997,6 +1013,7 @@ void LTSettingsUI::buildInterface()
                     if (ImGui::RadioButton("RTTFC", dataRefs.GetDebugExportFormat() == EXP_FD_RTTFC))
                         dataRefs.SetDebugExportFormat(EXP_FD_RTTFC);
                 }
+                ImGui::FilteredCfgNumber("Rotate files after",      sFilter, DR_DBG_FILE_ROTATE_MB, 0, 10000, 10, "%d MB");
                 if (!*sFilter) ImGui::TreePop();
             }
 
@@ -1307,6 +1324,8 @@ void LTSettingsUI::buildInterface()
                                            "Logs detailed position information of currently selected aircraft (into Log.txt)");
                 ImGui::FilteredCfgCheckbox("Log Raw Network Data", sFilter, DR_DBG_LOG_RAW_FD,
                                            "Creates additional log file 'LTRawFD.log'\ncontaining all raw network requests and responses.");
+                ImGui::FilteredCfgCheckbox("Stress Mode: Log Timings", sFilter, DR_DBG_STRESS_MODE,
+                                           "Logs every 10s how long processing stages took (into Log.txt, requires log level 'Info' or 'Debug'),\ne.g. while receiving synthetic traffic from 'lt_loadgen'");
 
                 if (!*sFilter) ImGui::TreePop();
             }
@@ -1339,13 +1358,13 @@ void LTSettingsUI::buildInterface()
             
             if (ImGui::FilteredInputText("Filter single a/c", sFilter, txtDebugFilter, fSmallWidth, nullptr, flags))
             {
-                mapLTFlightDataTy::iterator fdIter = mapFd.end();
+                const LTFlightData* pFd = nullptr;
                 if (!txtDebugFilter.empty())
-                    fdIter = mapFdSearchAc(txtDebugFilter);
+                    pFd = mapFdSearchAc(txtDebugFilter);
                 // found?
-                if (fdIter != mapFd.cend()) {
-                    txtDebugFilter = fdIter->second.key();
-                    DataRefs::LTSetDebugAcFilter(NULL,int(fdIter->second.key().num));
+                if (pFd) {
+                    txtDebugFilter = pFd->key();
+                    DataRefs::LTSetDebugAcFilter(NULL,int(pFd->key().num));
                 }
                 else
                     DataRefs::LTSetDebugAcFilter(NULL,0);
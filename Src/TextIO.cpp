@@ -419,15 +419,13 @@ void DestroyWindow()
 // MARK: Log message storage
 //
 
-/// The global list of log messages
+/// The global list of log messages, only accessed from X-Plane's main thread
 LogMsgListTy gLog;
 
-/// The global counter
-static unsigned long gLogCnt = 0;
-
-/// Controls access to the log list
-std::recursive_mutex gLogMutex;
+/// The global counter, defines the order of messages across all threads
+static std::atomic<unsigned long> gLogCnt {0};
 
+/// Buffer for composing a log line, only used in the main thread
 static char gBuf[4048];
 
 const char* LOG_LEVEL[] = {
@@ -438,18 +436,14 @@ const char* LOG_LEVEL[] = {
 const char* GetLogString (const LogMsgTy& l);
 
 
-// Constructor fills all fields and removes personal info
+// Constructor fills all fields (personal info is removed later in FlushMsg)
 LogMsgTy::LogMsgTy (const char* _fn, int _ln, const char* _func,
                     logLevelTy _lvl, const char* _msg) :
 counter(++gLogCnt),
 wallTime(std::chrono::system_clock::now()),
 netwTime(dataRefs.GetMiscNetwTime()),
 fileName(_fn), ln(_ln), func(_func), lvl(_lvl), msg(_msg), bFlushed(false)
-{
-    // Remove personal information
-    str_replPers(msg);
-
-}
+{}
 
 // does the entry match the given string (expected in upper case)?
 bool LogMsgTy::matches (const char* _s) const
@@ -467,9 +461,6 @@ bool LogMsgTy::matches (const char* _s) const
 // returns ptr to static buffer filled with log string
 const char* GetLogString (const LogMsgTy& l)
 {
-    // Access to static buffer and list guarded by a lock
-    std::lock_guard<std::recursive_mutex> lock(gLogMutex);
-    
     // Network time string
     const std::string netwT = NetwTimeString(l.netwTime);
 
@@ -500,43 +491,166 @@ const char* GetLogString (const LogMsgTy& l)
     return gBuf;
 }
 
-/// Actually adds an entry to the log list, flushes immediately if in main thread
-LogMsgListTy::iterator AddLogMsg (const char* szPath, int ln, const char* szFunc,
-                                  logLevelTy lvl, const char* szMsg, va_list args)
+//
+// MARK: Per-thread message rings
+//
+
+/// @brief Per-thread ring buffer of messages not yet flushed
+/// @details Single producer (the owning thread), single consumer (FlushMsg in the main thread),
+///          so no locks are needed to add or take messages.
+struct LogRingTy {
+    std::array<LogMsgTy*, LOG_RING_SIZE> slots {};  ///< messages, owned by the ring while in it
+    std::atomic<size_t> head {0};                   ///< next slot to write (producer only)
+    std::atomic<size_t> tail {0};                   ///< next slot to read (consumer only)
+    std::atomic<unsigned long> nDropped {0};        ///< number of messages dropped because the ring was full
+    
+    /// Destructor frees messages never taken
+    ~LogRingTy () { while (LogMsgTy* p = pop()) delete p; }
+    
+    /// Producer: Add a message, takes ownership, drops the message if the ring is full
+    void push (LogMsgTy* p)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= LOG_RING_SIZE) {
+            ++nDropped;
+            delete p;
+            return;
+        }
+        slots[h % LOG_RING_SIZE] = p;
+        head.store(h+1, std::memory_order_release);
+    }
+    
+    /// Consumer: Take the oldest message, `nullptr` if empty, passes ownership to caller
+    LogMsgTy* pop ()
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire))
+            return nullptr;
+        LogMsgTy* p = slots[t % LOG_RING_SIZE];
+        tail.store(t+1, std::memory_order_release);
+        return p;
+    }
+    
+    /// Empty?
+    bool empty () const
+    { return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire); }
+};
+
+/// Shared pointer to a ring, shared by the owning thread and the global list of rings
+typedef std::shared_ptr<LogRingTy> LogRingPtrTy;
+
+/// All rings, locked only when a thread registers its ring or during FlushMsg
+static std::mutex gLogRingsMutex;
+static std::vector<LogRingPtrTy> gLogRings;
+
+/// Returns the calling thread's ring, registers a new one on first use
+static LogRingTy& GetThreadLogRing ()
+{
+    thread_local LogRingPtrTy pRing;
+    if (!pRing) {
+        pRing = std::make_shared<LogRingTy>();
+        std::lock_guard<std::mutex> lock(gLogRingsMutex);
+        gLogRings.push_back(pRing);
+    }
+    return *pRing;
+}
+
+//
+// MARK: Per-call-site rate limiting
+//
+
+/// Rate limiting state of one call site
+struct LogRateSlotTy {
+    std::atomic<uintptr_t> site {0};                ///< call site (based on file name pointer and line number)
+    std::atomic<long long> sec {0};                 ///< second of the current counting window
+    std::atomic<unsigned> cnt {0};                  ///< number of messages in the current window
+    std::atomic<unsigned> nSuppressed {0};          ///< number of messages suppressed in the current window
+};
+
+/// Rate limiting slots, indexed by a hash of the call site
+static std::array<LogRateSlotTy, LOG_RATE_SLOTS> gLogRate;
+
+/// @brief Count the message against its call site's limit
+/// @details Deliberately not exact when several threads log from the same
+///          call site at the same time (or two call sites share a slot),
+///          but it never blocks.
+/// @param szPath Source file, string literal `__FILE__`, its address is used to identify the call site
+/// @param ln Source line
+/// @param[out] nPrevSuppr Number of messages suppressed in the previous window
+/// @return Shall the message be logged?
+static bool LogRateCheck (const char* szPath, int ln, unsigned& nPrevSuppr)
 {
-    // We get the lock already to avoid having to lock twice if in main thread
-    std::lock_guard<std::recursive_mutex> lock(gLogMutex);
+    nPrevSuppr = 0;
+    const uintptr_t site = reinterpret_cast<uintptr_t>(szPath) + uintptr_t(ln) * 31;
+    LogRateSlotTy& slot = gLogRate[site % LOG_RATE_SLOTS];
+    const long long now = std::chrono::duration_cast<std::chrono::seconds>
+                          (std::chrono::steady_clock::now().time_since_epoch()).count();
     
+    // Slot used by another call site until now? Then take it over
+    if (slot.site.exchange(site) != site) {
+        slot.sec = now;
+        slot.cnt = 0;
+        slot.nSuppressed = 0;
+    }
+    // New counting window?
+    else if (slot.sec.exchange(now) != now) {
+        slot.cnt = 0;
+        nPrevSuppr = slot.nSuppressed.exchange(0);
+    }
+    
+    // Within limits?
+    if (++slot.cnt <= LOG_RATE_MAX_PER_SEC)
+        return true;
+    ++slot.nSuppressed;
+    return false;
+}
+
+//
+// MARK: Adding and flushing messages
+//
+
+/// @brief Actually adds an entry to the calling thread's ring, flushes immediately if in main thread
+/// @return The formatted message text
+std::string AddLogMsg (const char* szPath, int ln, const char* szFunc,
+                       logLevelTy lvl, const char* szMsg, va_list args,
+                       unsigned nPrevSuppr = 0)
+{
     // Cut off path from file name
     const char* szFile = strrchr(szPath, PATH_DELIM);  // extract file from path
     if (!szFile) szFile = szPath; else szFile++;
 
     // Prepare the formatted string if variable arguments are given
+    // (needs to happen now as the arguments might not survive)
+    char buf[2048];
     if (args)
-        vsnprintf(gBuf, sizeof(gBuf), szMsg, args);
-
-    // Add the list entry
-    gLog.emplace_front(szFile, ln, szFunc, lvl,
-                       args ? gBuf : szMsg);
+        vsnprintf(buf, sizeof(buf), szMsg, args);
+    LogMsgTy* pMsg = new LogMsgTy(szFile, ln, szFunc, lvl, args ? buf : szMsg);
+    if (nPrevSuppr)
+        pMsg->msg += " [" + std::to_string(nPrevSuppr) + " more messages from here suppressed]";
+    std::string ret (pMsg->msg);
+    
+    // Add to this thread's ring, no locking involved
+    GetThreadLogRing().push(pMsg);
 
     // Flush immediately if called from main thread
     if (dataRefs.IsXPThread())
         FlushMsg();
     
-    // was added to the front
-    return gLog.begin();
+    return ret;
 }
 
 // Add a message to the list, flush immediately if in main thread
 void LogMsg ( const char* szPath, int ln, const char* szFunc, logLevelTy lvl, const char* szMsg, ... )
 {
-    // We get the lock already to avoid having to lock twice if in main thread
-    std::lock_guard<std::recursive_mutex> lock(gLogMutex);
-
+    // Rate limiting per call site, except for fatal and always-shown messages
+    unsigned nPrevSuppr = 0;
+    if (lvl < logFATAL && !LogRateCheck(szPath, ln, nPrevSuppr))
+        return;
+    
     // Prepare the formatted message
     va_list args;
     va_start (args, szMsg);
-    AddLogMsg(szPath, ln, szFunc, lvl, szMsg, args);
+    AddLogMsg(szPath, ln, szFunc, lvl, szMsg, args, nPrevSuppr);
     va_end (args);
 
 }
@@ -544,9 +658,6 @@ void LogMsg ( const char* szPath, int ln, const char* szFunc, logLevelTy lvl, co
 // Might be used in macros of other packages like ImGui
 void LogFatalMsg ( const char* szPath, int ln, const char* szFunc, const char* szMsg, ... )
 {
-    // Access to static buffer and list guarded by a lock
-    std::lock_guard<std::recursive_mutex> lock(gLogMutex);
-
     // Add to the message buffer
     va_list args;
     va_start (args, szMsg);
@@ -555,31 +666,55 @@ void LogFatalMsg ( const char* szPath, int ln, const char* szFunc, const char* s
 }
 
 // Force writing of all not yet flushed messages
-/// @details As new messages are added to the front, we start searching from
-///          the front and go forward until we find either the end or
-///          an already flushed message. Then we go back and actually write
-///          message in sequence
+/// @details Takes all messages out of all threads' rings, sorts them by
+///          their global counter, adds them to the front of `gLog`,
+///          and writes all of them with one call to `XPLMDebugString`.
 void FlushMsg ()
 {
-    // Access to static buffer and list guarded by a lock
-    std::lock_guard<std::recursive_mutex> lock(gLogMutex);
-
-    // Quick exit if empty or nothing to write
-    if (gLog.empty() || gLog.front().bFlushed)
+    std::vector<LogMsgTy*> vMsg;
+    unsigned long nDropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(gLogRingsMutex);
+        for (auto iter = gLogRings.begin(); iter != gLogRings.end(); ) {
+            LogRingTy& ring = **iter;
+            while (LogMsgTy* p = ring.pop())
+                vMsg.push_back(p);
+            nDropped += ring.nDropped.exchange(0);
+            // Remove rings of threads which have ended
+            if (iter->use_count() == 1 && ring.empty())
+                iter = gLogRings.erase(iter);
+            else
+                ++iter;
+        }
+    }
+    
+    // Quick exit if nothing to write
+    if (vMsg.empty() && !nDropped)
         return;
     
-    // Move forward to first flushed msg or end
-    LogMsgListTy::iterator logIter = gLog.begin();
-    while (logIter != gLog.end() && !logIter->bFlushed)
-        logIter++;
+    // Report dropped messages, too
+    if (nDropped) {
+        char sDropped[100];
+        snprintf(sDropped, sizeof(sDropped), "%lu log messages dropped, log buffer was full", nDropped);
+        vMsg.push_back(new LogMsgTy(__FILE__, __LINE__, __func__, logWARN, sDropped));
+    }
+    
+    // Sort messages by their counter, i.e. in sequence they were created across all threads
+    std::sort(vMsg.begin(), vMsg.end(),
+              [](const LogMsgTy* a, const LogMsgTy* b){ return a->counter < b->counter; });
+    
+    // Move all into the global list and compose one block of text for `Log.txt`
+    std::string block;
+    for (LogMsgTy* p: vMsg) {
+        str_replPers(p->msg);                   // Remove personal information
+        block += GetLogString(*p);
+        p->bFlushed = true;
+        gLog.emplace_front(std::move(*p));
+        delete p;
+    }
     
-    // Now move back and on the way write out the messages into `Log.txt`
-    do {
-        logIter--;
-        // write to log (flushed immediately -> expensive!)
-        XPLMDebugString (GetLogString(*logIter));
-        logIter->bFlushed = true;
-    } while (logIter != gLog.begin());
+    // write to log (flushed immediately -> expensive, hence only once!)
+    XPLMDebugString (block.c_str());
 }
 
 // Remove old message (>1h XP network time)
@@ -588,8 +723,7 @@ void PurgeMsgList ()
     // How many messages to keep?
     const size_t nKeep = (size_t)DataRefs::GetCfgInt(DR_CFG_LOG_LIST_LEN);
     
-    // Access to static buffer and list guarded by a lock
-    std::lock_guard<std::recursive_mutex> lock(gLogMutex);
+    // gLog is only accessed from the main thread
     if (gLog.size() > nKeep)
         gLog.resize(nKeep);
 }
@@ -609,6 +743,208 @@ ImColor LogLvlColor (logLevelTy _lvl)
 }
 
 
+//
+// MARK: Asynchronous file writer
+//
+
+// Destructor makes sure the file is closed and all memory freed
+LTAsyncWriter::~LTAsyncWriter ()
+{
+    Close();
+    // free lines, which might have been added after closing
+    for (LineTy* p = pHead.exchange(nullptr); p; ) {
+        LineTy* pNext = p->pNext;
+        delete p;
+        p = pNext;
+    }
+}
+
+// Opens the file (appending) and starts the writer thread
+bool LTAsyncWriter::Open (const std::string& _path, bool _bTimeFmt)
+{
+    std::lock_guard<std::mutex> lkOC(mtxOpenClose);
+    if (IsOpen()) return true;
+    DoClose();                          // makes sure a previous thread has ended
+    pathPattern = _path;
+    bTimeFmt = _bTimeFmt;
+    if (!OpenFile())
+        return false;
+    
+    // start the writer thread
+    bStop = false;
+    bOpen = true;
+    thr = std::thread(&LTAsyncWriter::Main, this);
+    return true;
+}
+
+// Stops the writer thread, writes all remaining lines, closes the file
+void LTAsyncWriter::Close ()
+{
+    std::lock_guard<std::mutex> lkOC(mtxOpenClose);
+    DoClose();
+}
+
+// Close() implementation, expects `mtxOpenClose` to be locked
+void LTAsyncWriter::DoClose ()
+{
+    // no longer accept new lines, then wait for Add() calls, which still saw us open
+    bOpen = false;
+    while (nAdding > 0)
+        std::this_thread::yield();
+    
+    // stop the writer thread
+    if (thr.joinable()) {
+        {
+            std::lock_guard<std::mutex> lk(mtxStop);
+            bStop = true;
+        }
+        cvStop.notify_all();
+        thr.join();
+        thr = std::thread();
+    }
+    
+    // write everything that's left (or just free it if the file is gone), then close the file
+    WriteLines(true);
+    if (f.is_open())
+        f.close();
+}
+
+// Adds text to be written, never blocks
+void LTAsyncWriter::Add (unsigned long ts, std::string&& s)
+{
+    // Announce ourselves before checking `bOpen`, so that Close() waits for our push
+    // if we still see it open (both sequentially consistent)
+    ++nAdding;
+    if (IsOpen()) {
+        // push onto the lock-free stack
+        LineTy* p = new LineTy(ts, std::move(s));
+        p->pNext = pHead.load(std::memory_order_relaxed);
+        while (!pHead.compare_exchange_weak(p->pNext, p,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed))
+            ;
+    }
+    --nAdding;
+}
+
+// writer thread's main function
+void LTAsyncWriter::Main ()
+{
+    ThreadSettings TS (szThrName);
+    
+    std::unique_lock<std::mutex> lk(mtxStop);
+    while (!bStop) {
+        // wait for the write interval (or for being stopped)
+        cvStop.wait_for(lk, std::chrono::milliseconds(FILE_WRITE_INTVL_MS),
+                        [this]{ return bStop.load(); });
+        if (bStop) break;
+        
+        // don't hold the lock during disk I/O
+        lk.unlock();
+        // LiveTraffic Top Level Exception Handling
+        try {
+            WriteLines(false);
+            Rotate();
+        } catch (const std::exception& e) {
+            LOG_MSG(logERR, ERR_TOP_LEVEL_EXCEPTION, e.what());
+        } catch (...) {
+            LOG_MSG(logERR, ERR_TOP_LEVEL_EXCEPTION, "(unknown type)");
+        }
+        lk.lock();
+    }
+}
+
+// opens `f` based on `pathPattern`
+bool LTAsyncWriter::OpenFile ()
+{
+    // Create the file name, if requested with a date/time stamp
+    if (bTimeFmt) {
+        char currFileName[250];
+        const std::time_t t = std::time(nullptr);
+        const std::tm tm = *std::localtime(&t);
+        std::strftime(currFileName, sizeof(currFileName),
+                      pathPattern.c_str(), &tm);
+        fileName = currFileName;
+    } else
+        fileName = pathPattern;
+    
+    // open the file, append to it
+    f.open (fileName, std::ios_base::out | std::ios_base::app);
+    nBytesWritten = 0;
+    return f.is_open();
+}
+
+// takes over all pending lines and writes those which are due (or all)
+void LTAsyncWriter::WriteLines (bool bAll)
+{
+    // Take over all lines added so far, they come in reverse order
+    LineTy* pRev = pHead.exchange(nullptr, std::memory_order_acquire);
+    LineTy* p = nullptr;
+    while (pRev) {
+        LineTy* pNext = pRev->pNext;
+        pRev->pNext = p;
+        p = pRev;
+        pRev = pNext;
+    }
+    
+    // Collect all output in one block
+    std::string block;
+    if (bSortByTs) {
+        // merge new lines into the sorted queue
+        for (; p; p = p->pNext)
+            quSorted.push(p);
+        // write out what is due
+        const unsigned long due = bAll ? 0 : (unsigned long)(dataRefs.GetSimTime()) + EXPORT_DUE_AHEAD;
+        while (!quSorted.empty() && (bAll || quSorted.top()->ts < due)) {
+            LineTy* pTop = quSorted.top();
+            quSorted.pop();
+            block += pTop->s;
+            delete pTop;
+        }
+    } else {
+        // write in sequence of adding
+        while (p) {
+            LineTy* pNext = p->pNext;
+            block += p->s;
+            delete p;
+            p = pNext;
+        }
+    }
+    
+    // Actually write
+    if (!block.empty() && f.is_open()) {
+        f.write(block.data(), std::streamsize(block.size()));
+        f.flush();
+        nBytesWritten += block.size();
+    }
+}
+
+// closes and renames/reopens the file if it grew too large
+void LTAsyncWriter::Rotate ()
+{
+    const int rotateMB = dataRefs.GetDebugFileRotateMB();
+    if (rotateMB <= 0 || nBytesWritten < size_t(rotateMB) * 1024 * 1024)
+        return;
+    
+    LOG_MSG(logINFO, DBG_FILE_ROTATED, fileName.c_str(), (unsigned long)nBytesWritten);
+    f.close();
+    // A time-stamped file name will just get a new name when reopened,
+    // otherwise we keep one previous file with a suffix
+    if (!bTimeFmt) {
+        const std::string rotName = fileName + PATH_ROTATED_SUFFIX;
+        std::remove(rotName.c_str());
+        std::rename(fileName.c_str(), rotName.c_str());
+    }
+    if (!OpenFile()) {
+        char sErr[SERR_LEN];
+        strerror_s(sErr, sizeof(sErr), errno);
+        LOG_MSG(logERR, DBG_RAW_FD_ERR_OPEN_OUT, fileName.c_str(), sErr);
+        // No file to write to: accept no more lines and end the writer thread
+        bOpen = false;
+        bStop = true;
+    }
+}
+
 //
 // MARK: LiveTraffic Exception classes
 //
@@ -621,7 +957,7 @@ std::logic_error(_szMsg)
 {
     va_list args;
     va_start (args, _szMsg);
-    msgIter = AddLogMsg(_szFile, _ln, _szFunc, _lvl, _szMsg, args);
+    msg = AddLogMsg(_szFile, _ln, _szFunc, _lvl, _szMsg, args);
     va_end (args);
 }
 
@@ -632,7 +968,7 @@ std::logic_error("")
 
 const char* LTError::what() const noexcept
 {
-    return msgIter->msg.c_str();
+    return msg.c_str();
 }
 
 // includsive reference to LTFlightData
@@ -647,7 +983,7 @@ posStr(_fd.Positions2String())
     // Add the formatted message to the log list
     va_list args;
     va_start (args, _szMsg);
-    msgIter = AddLogMsg(_szFile, _ln, _szFunc, _lvl, _szMsg, args);
+    msg = AddLogMsg(_szFile, _ln, _szFunc, _lvl, _szMsg, args);
     va_end (args);
     
     // Add the position information also to the log list